@@ -44,7 +44,7 @@ OouraFFT* ooura_create (int n)
 
     o     = (OouraFFT*)malloc(sizeof(OouraFFT));
     o->n  = n;
-    o->ip = (int*)malloc(8 + (int)(sqrtf((float)n)));
+    o->ip = (int*)malloc((3 + (int)(sqrtf((float)n2))) * sizeof(int)); // rdft needs 2 + sqrt(n/2) ints
     o->w  = (float*)malloc(n2 * sizeof(float));
     
     ooura_makewt(n4, o->ip, o->w);
@@ -59,9 +59,14 @@
  - PLANK_VEC_VDSP=1 : Use Apple's Accelerate vDSP library for vector processing where possible 
                       (the default is to use scalar code). You must also link to the 
                       Accelerate framework.
+ - PLANK_VEC_SIMD=1 : Use SSE2, AVX or AArch64 NEON intrinsics for vector processing where possible.
+                      The instruction set is chosen from the compiler's target flags (e.g., -mavx2).
  - PLANK_FFT_VDSP=1 : Use Apple's Accelerate vDSP library for FFT processing 
-                      (the default is to use FFTReal which is included in the source tree).
+                      (the default is to use pffft, or FFTReal for sizes pffft can't handle, 
+                      both are included in the source tree).
                       You must also link to the Accelerate framework.
+ - PLANK_FFT_OOURA=1 or PLANK_FFT_FFTREAL=1 : Make Ooura or FFTReal the default FFT engine. The engine
+                      can also be chosen at runtime using pl_FFT_SetDefaultEngine().
  - PLANK_OGGVORBIS=1 : Enable Ogg Vorbis support. You must include the files in ext/vorbis in your project too.
  
  <strong>Plonk</strong>
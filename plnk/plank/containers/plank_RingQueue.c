@@ -0,0 +1,477 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../core/plank_StandardHeader.h"
+#include "plank_RingQueue.h"
+
+static PLANK_INLINE_LOW PlankAtomicLRef pl_RingQueue_GetSequence (PlankRingQueueRef p, const PlankL position)
+{
+    return (PlankAtomicLRef)(p->buffer + (position & p->mask) * p->stride);
+}
+
+static PLANK_INLINE_LOW PlankP pl_RingQueue_GetSlot (PlankRingQueueRef p, const PlankL position)
+{
+    return p->buffer + (position & p->mask) * p->stride + p->itemOffset;
+}
+
+PlankRingQueueRef pl_RingQueue_CreateAndInit (const PlankL itemSize, const PlankL capacity, const int mode)
+{
+    PlankRingQueueRef p;
+    p = pl_RingQueue_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_RingQueue_Init (p, itemSize, capacity, mode) != PlankResult_OK)
+            pl_RingQueue_Destroy (p);
+        else
+            return p;
+    }
+    
+    return PLANK_NULL;
+}
+
+PlankRingQueueRef pl_RingQueue_Create()
+{
+    PlankMemoryRef m;
+    PlankRingQueueRef p;
+    
+    m = pl_MemoryGlobal(); // creation of the queue isn't itself lock free
+    p = (PlankRingQueueRef)pl_Memory_AllocateBytes (m, sizeof (PlankRingQueue));
+    
+    if (p != PLANK_NULL)
+        pl_MemoryZero (p, sizeof (PlankRingQueue));
+    
+    return p;
+}
+
+PlankResult pl_RingQueue_Init (PlankRingQueueRef p, const PlankL itemSize, const PlankL capacity, const int mode)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    PlankL i;
+    
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((itemSize <= 0) || (capacity <= 0))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    pl_MemoryZero (p, sizeof (PlankRingQueue));
+    
+    pl_AtomicL_Init (&p->head);
+    pl_AtomicL_Init (&p->tail);
+    
+    p->mode = mode;
+    p->itemSize = itemSize;
+    p->capacity = 2;
+    
+    while (p->capacity < capacity)
+        p->capacity <<= 1;
+    
+    p->mask = p->capacity - 1;
+    
+    if (mode == PLANKRINGQUEUE_SPSC)
+    {
+        // items are packed so bulk operations are at most two copies
+        p->itemOffset = 0;
+        p->stride = itemSize;
+    }
+    else
+    {
+        // each slot is a sequence number followed by the item
+        p->itemOffset = ((PlankL)sizeof (PlankAtomicL) + PLANKRINGQUEUE_ITEMALIGN - 1) & ~(PlankL)(PLANKRINGQUEUE_ITEMALIGN - 1);
+        p->stride = (p->itemOffset + itemSize + PLANKRINGQUEUE_ITEMALIGN - 1) & ~(PlankL)(PLANKRINGQUEUE_ITEMALIGN - 1);
+    }
+    
+    p->allocation = (PlankUC*)pl_Memory_AllocateBytes (m, p->stride * p->capacity + PLANKRINGQUEUE_CACHELINESIZE);
+    
+    if (p->allocation == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    p->buffer = (PlankUC*)(((PlankUL)p->allocation + PLANKRINGQUEUE_CACHELINESIZE - 1) & ~(PlankUL)(PLANKRINGQUEUE_CACHELINESIZE - 1));
+    pl_MemoryZero (p->buffer, p->stride * p->capacity);
+    
+    if (mode != PLANKRINGQUEUE_SPSC)
+    {
+        for (i = 0; i < p->capacity; ++i)
+        {
+            pl_AtomicL_Init (pl_RingQueue_GetSequence (p, i));
+            pl_AtomicL_SetUnchecked (pl_RingQueue_GetSequence (p, i), i);
+        }
+    }
+    
+    pl_AtomicMemoryBarrier();
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingQueue_DeInit (PlankRingQueueRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    
+    m = pl_MemoryGlobal();
+
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if (p->allocation != PLANK_NULL)
+    {
+        if ((result = pl_Memory_Free (m, p->allocation)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    pl_AtomicL_DeInit (&p->head);
+    pl_AtomicL_DeInit (&p->tail);
+    pl_MemoryZero (p, sizeof (PlankRingQueue));
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingQueue_Destroy (PlankRingQueueRef p)
+{
+    PlankResult result;
+    PlankMemoryRef m;
+    
+    result = PlankResult_OK;
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((result = pl_RingQueue_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);
+    
+exit:
+    return result;
+}
+
+PlankP pl_RingQueue_BeginPush (PlankRingQueueRef p)
+{
+    PlankAtomicLRef sequence;
+    PlankL position, diff;
+    
+    if (p->mode == PLANKRINGQUEUE_SPSC)
+    {
+        // only this thread writes the tail
+        position = pl_AtomicL_GetUnchecked (&p->tail);
+        
+        if ((position - p->headCache) >= p->capacity)
+        {
+            p->headCache = pl_AtomicL_Get (&p->head);
+            
+            if ((position - p->headCache) >= p->capacity)
+                return PLANK_NULL;
+            
+            pl_AtomicMemoryBarrier();
+        }
+        
+        return pl_RingQueue_GetSlot (p, position);
+    }
+    
+    position = pl_AtomicL_Get (&p->tail);
+    
+    for (;;)
+    {
+        sequence = pl_RingQueue_GetSequence (p, position);
+        diff = pl_AtomicL_Get (sequence) - position;
+        
+        if (diff == 0)
+        {
+            if (pl_AtomicL_CompareAndSwap (&p->tail, position, position + 1))
+                return pl_RingQueue_GetSlot (p, position);
+        }
+        else if (diff < 0)
+        {
+            return PLANK_NULL;
+        }
+        
+        position = pl_AtomicL_Get (&p->tail);
+    }
+}
+
+PlankResult pl_RingQueue_EndPush (PlankRingQueueRef p, PlankP slot)
+{
+    PlankAtomicLRef sequence;
+    
+    pl_AtomicMemoryBarrier(); // the item must be visible before it is published
+    
+    if (p->mode == PLANKRINGQUEUE_SPSC)
+    {
+        pl_AtomicL_SetUnchecked (&p->tail, pl_AtomicL_GetUnchecked (&p->tail) + 1);
+    }
+    else
+    {
+        // the slot was claimed so its sequence is still its position
+        sequence = (PlankAtomicLRef)((PlankUC*)slot - p->itemOffset);
+        pl_AtomicL_SetUnchecked (sequence, pl_AtomicL_GetUnchecked (sequence) + 1);
+    }
+    
+    return PlankResult_OK;
+}
+
+PlankP pl_RingQueue_BeginPop (PlankRingQueueRef p)
+{
+    PlankAtomicLRef sequence;
+    PlankL position, diff;
+    
+    if (p->mode == PLANKRINGQUEUE_SPSC)
+    {
+        // only this thread writes the head
+        position = pl_AtomicL_GetUnchecked (&p->head);
+        
+        if (position == p->tailCache)
+        {
+            p->tailCache = pl_AtomicL_Get (&p->tail);
+            
+            if (position == p->tailCache)
+                return PLANK_NULL;
+            
+            pl_AtomicMemoryBarrier();
+        }
+        
+        return pl_RingQueue_GetSlot (p, position);
+    }
+
+    position = pl_AtomicL_Get (&p->head);
+    
+    for (;;)
+    {
+        sequence = pl_RingQueue_GetSequence (p, position);
+        diff = pl_AtomicL_Get (sequence) - (position + 1);
+        
+        if (diff == 0)
+        {
+            if (pl_AtomicL_CompareAndSwap (&p->head, position, position + 1))
+                return pl_RingQueue_GetSlot (p, position);
+        }
+        else if (diff < 0)
+        {
+            return PLANK_NULL;
+        }
+        
+        position = pl_AtomicL_Get (&p->head);
+    }
+}
+
+PlankResult pl_RingQueue_EndPop (PlankRingQueueRef p, PlankP slot)
+{
+    PlankAtomicLRef sequence;
+    
+    pl_AtomicMemoryBarrier(); // finish reading the item before the slot is reused
+    
+    if (p->mode == PLANKRINGQUEUE_SPSC)
+    {
+        pl_AtomicL_SetUnchecked (&p->head, pl_AtomicL_GetUnchecked (&p->head) + 1);
+    }
+    else
+    {
+        // mark the slot free for the producer one lap ahead
+        sequence = (PlankAtomicLRef)((PlankUC*)slot - p->itemOffset);
+        pl_AtomicL_SetUnchecked (sequence, pl_AtomicL_GetUnchecked (sequence) + p->mask);
+    }
+    
+    return PlankResult_OK;
+}
+
+PlankResult pl_RingQueue_Push (PlankRingQueueRef p, const void* item)
+{
+    PlankP slot;
+    
+    if ((slot = pl_RingQueue_BeginPush (p)) == PLANK_NULL)
+        return PlankResult_ContainerFull;
+    
+    pl_MemoryCopy (slot, item, p->itemSize);
+    
+    return pl_RingQueue_EndPush (p, slot);
+}
+
+PlankResult pl_RingQueue_Pop (PlankRingQueueRef p, void* item)
+{
+    PlankP slot;
+    
+    if ((slot = pl_RingQueue_BeginPop (p)) == PLANK_NULL)
+        return PlankResult_ContainerEmpty;
+    
+    pl_MemoryCopy (item, slot, p->itemSize);
+    
+    return pl_RingQueue_EndPop (p, slot);
+}
+
+PlankResult pl_RingQueue_PushBulk (PlankRingQueueRef p, const void* items, const PlankL numItems, PlankL* numPushed)
+{
+    const PlankUC* source;
+    PlankL position, count, first;
+    
+    source = (const PlankUC*)items;
+    count = 0;
+    
+    if (p->mode == PLANKRINGQUEUE_SPSC)
+    {
+        position = pl_AtomicL_GetUnchecked (&p->tail);
+        
+        if ((p->capacity - (position - p->headCache)) < numItems)
+        {
+            p->headCache = pl_AtomicL_Get (&p->head);
+            pl_AtomicMemoryBarrier();
+        }
+        
+        count = p->capacity - (position - p->headCache);
+        count = count < numItems ? count : numItems;
+        
+        if (count > 0)
+        {
+            // copy up to the end of the buffer then wrap around
+            first = p->capacity - (position & p->mask);
+            first = first < count ? first : count;
+            
+            pl_MemoryCopy (pl_RingQueue_GetSlot (p, position), source, first * p->itemSize);
+            
+            if (count > first)
+                pl_MemoryCopy (p->buffer, source + first * p->itemSize, (count - first) * p->itemSize);
+            
+            pl_AtomicMemoryBarrier();
+            pl_AtomicL_SetUnchecked (&p->tail, position + count);
+        }
+    }
+    else
+    {
+        while ((count < numItems) && (pl_RingQueue_Push (p, source) == PlankResult_OK))
+        {
+            source += p->itemSize;
+            ++count;
+        }
+    }
+    
+    if (numPushed != PLANK_NULL)
+        *numPushed = count;
+    
+    return count < numItems ? PlankResult_ContainerFull : PlankResult_OK;
+}
+
+PlankResult pl_RingQueue_PopBulk (PlankRingQueueRef p, void* items, const PlankL numItems, PlankL* numPopped)
+{
+    PlankUC* dest;
+    PlankL position, count, first;
+    
+    dest = (PlankUC*)items;
+    count = 0;
+    
+    if (p->mode == PLANKRINGQUEUE_SPSC)
+    {
+        position = pl_AtomicL_GetUnchecked (&p->head);
+        
+        if ((p->tailCache - position) < numItems)
+        {
+            p->tailCache = pl_AtomicL_Get (&p->tail);
+            pl_AtomicMemoryBarrier();
+        }
+        
+        count = p->tailCache - position;
+        count = count < numItems ? count : numItems;
+        
+        if (count > 0)
+        {
+            first = p->capacity - (position & p->mask);
+            first = first < count ? first : count;
+            
+            pl_MemoryCopy (dest, pl_RingQueue_GetSlot (p, position), first * p->itemSize);
+            
+            if (count > first)
+                pl_MemoryCopy (dest + first * p->itemSize, p->buffer, (count - first) * p->itemSize);
+            
+            pl_AtomicMemoryBarrier();
+            pl_AtomicL_SetUnchecked (&p->head, position + count);
+        }
+    }
+    else
+    {
+        while ((count < numItems) && (pl_RingQueue_Pop (p, dest) == PlankResult_OK))
+        {
+            dest += p->itemSize;
+            ++count;
+        }
+    }
+    
+    if (numPopped != PLANK_NULL)
+        *numPopped = count;
+    
+    return count < numItems ? PlankResult_ContainerEmpty : PlankResult_OK;
+}
+
+PlankL pl_RingQueue_GetCapacity (PlankRingQueueRef p)
+{
+    return p->capacity;
+}
+
+PlankL pl_RingQueue_GetItemSize (PlankRingQueueRef p)
+{
+    return p->itemSize;
+}
+
+int pl_RingQueue_GetMode (PlankRingQueueRef p)
+{
+    return p->mode;
+}
+
+PlankL pl_RingQueue_GetSize (PlankRingQueueRef p)
+{
+    const PlankL size = pl_AtomicL_Get (&p->tail) - pl_AtomicL_Get (&p->head);
+    return size < 0 ? 0 : (size > p->capacity ? p->capacity : size);
+}
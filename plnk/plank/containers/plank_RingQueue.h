@@ -0,0 +1,142 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_RINGQUEUE_H
+#define PLANK_RINGQUEUE_H
+
+#include "atomic/plank_Atomic.h"
+
+#define PLANKRINGQUEUE_MPMC             0
+#define PLANKRINGQUEUE_SPSC             1
+#define PLANKRINGQUEUE_CACHELINESIZE    64
+#define PLANKRINGQUEUE_ITEMALIGN        16
+
+PLANK_BEGIN_C_LINKAGE
+
+/** A bounded lock-free ring queue (FIFO).
+ 
+ Unlike the PlankLockFreeQueue this stores copies of fixed-size items inline in a 
+ single preallocated buffer so pushing and popping never allocate memory. The capacity
+ is rounded up to a power of 2 and a push fails with PlankResult_ContainerFull when
+ the queue is full.
+ 
+ The mode is chosen at initialisation: PLANKRINGQUEUE_SPSC is a wait-free queue for
+ exactly one producer thread and one consumer thread. PLANKRINGQUEUE_MPMC allows any 
+ number of producers and consumers using per-slot sequence numbers (after Dmitry Vyukov's
+ bounded MPMC queue).
+ 
+ The Begin/End functions give direct access to a slot so items can be constructed in 
+ place (e.g., by C++ code that needs to run copy constructors). A slot obtained with 
+ BeginPush or BeginPop must be passed to the matching End function before the same 
+ thread begins another operation on the queue.
+ 
+ @defgroup PlankRingQueueClass Plank RingQueue class
+ @ingroup PlankClasses
+ @{
+ */
+
+typedef struct PlankRingQueue* PlankRingQueueRef; 
+
+PlankRingQueueRef pl_RingQueue_CreateAndInit (const PlankL itemSize, const PlankL capacity, const int mode);
+PlankRingQueueRef pl_RingQueue_Create();
+PlankResult pl_RingQueue_Init (PlankRingQueueRef p, const PlankL itemSize, const PlankL capacity, const int mode);
+PlankResult pl_RingQueue_DeInit (PlankRingQueueRef p);
+PlankResult pl_RingQueue_Destroy (PlankRingQueueRef p);
+
+/** Copy an item into the queue. 
+ @return PlankResult_ContainerFull if there was no space. */
+PlankResult pl_RingQueue_Push (PlankRingQueueRef p, const void* item);
+
+/** Copy an item out of the queue. 
+ @return PlankResult_ContainerEmpty if there was nothing to pop. */
+PlankResult pl_RingQueue_Pop (PlankRingQueueRef p, void* item);
+
+/** Copy up to numItems consecutive items into the queue. 
+ The SPSC mode copies these in at most two blocks and publishes them all at once. */
+PlankResult pl_RingQueue_PushBulk (PlankRingQueueRef p, const void* items, const PlankL numItems, PlankL* numPushed);
+
+/** Copy up to numItems items out of the queue into consecutive memory. */
+PlankResult pl_RingQueue_PopBulk (PlankRingQueueRef p, void* items, const PlankL numItems, PlankL* numPopped);
+
+/** Reserve a slot to write into, this returns PLANK_NULL if the queue is full. */
+PlankP pl_RingQueue_BeginPush (PlankRingQueueRef p);
+
+/** Publish a slot reserved with pl_RingQueue_BeginPush(). */
+PlankResult pl_RingQueue_EndPush (PlankRingQueueRef p, PlankP slot);
+
+/** Get the next slot to read from, this returns PLANK_NULL if the queue is empty. */
+PlankP pl_RingQueue_BeginPop (PlankRingQueueRef p);
+
+/** Release a slot obtained with pl_RingQueue_BeginPop() so it can be reused. */
+PlankResult pl_RingQueue_EndPop (PlankRingQueueRef p, PlankP slot);
+
+PlankL pl_RingQueue_GetCapacity (PlankRingQueueRef p);
+PlankL pl_RingQueue_GetItemSize (PlankRingQueueRef p);
+int pl_RingQueue_GetMode (PlankRingQueueRef p);
+
+/** NB the result of this could be invalid by the time it is returned in a multithreaded context. */
+PlankL pl_RingQueue_GetSize (PlankRingQueueRef p);
+
+/** @} */
+
+PLANK_END_C_LINKAGE
+
+#if !DOXYGEN
+typedef struct PLANK_ALIGN(PLANKRINGQUEUE_CACHELINESIZE) PlankRingQueue
+{
+    // consumer side
+    PLANK_ALIGN(PLANKRINGQUEUE_CACHELINESIZE) PlankAtomicL  head;
+    PlankL                                                  tailCache;
+    
+    // producer side
+    PLANK_ALIGN(PLANKRINGQUEUE_CACHELINESIZE) PlankAtomicL  tail;
+    PlankL                                                  headCache;
+    
+    // shared, read only after initialisation
+    PLANK_ALIGN(PLANKRINGQUEUE_CACHELINESIZE) PlankUC*      buffer;
+    PlankUC*                                                allocation;
+    PlankL                                                  itemSize;
+    PlankL                                                  stride;
+    PlankL                                                  itemOffset;
+    PlankL                                                  capacity;
+    PlankL                                                  mask;
+    int                                                     mode;
+} PlankRingQueue;
+#endif
+
+#endif // PLANK_RINGQUEUE_H
@@ -194,14 +194,14 @@ void pl_Lock_WaitTimeout (PlankLockRef p, double time)
         pthread_mutex_lock (&p->mutex);
         pl_TimeToTimeSpec (&timeout, pl_TimeNow() + time);
         
-        do
+        while (! p->flag)
         {
             if (pthread_cond_timedwait (&p->condition, &p->mutex, &timeout) == ETIMEDOUT)
             {
                 pthread_mutex_unlock (&p->mutex);
                 return;
             }
-        } while (! p->flag);
+        }
 
         p->flag = PLANK_FALSE;
         
@@ -92,11 +92,14 @@ const char* pl_ResultString (PlankResult result)
         "An index for a list, array etc was out of range",                                      //PlankResult_IndexOutOfRange
         "An item count was invalid (e.g., 0 or too small for the context)",                     //PlankResult_ItemCountInvalid
         "A container (e.g., list, queue, stack) is being de-initialised but is non-empty",      //PlankResult_ContainerNotEmptyOnDeInit
+        "A bounded container (e.g., a ring queue) had no space for an item",                    //PlankResult_ContainerFull
+        "A container had no items to remove",                                                   //PlankResult_ContainerEmpty
 
         "The maximum number of identifiers for thread-local storage has been reached",          //PlankResult_ThreadLocalStorageMaximumIdentifiersReached
         "A generic JSON error occurred",                                                        //PlankResult_JSONError
         "A JSON error occurred with a file",                                                    //PlankResult_JSONFileError
         "A generic Zip error occurred",                                                         //PlankResult_ZipError
+        "Invalid characters or padding were found in Base64 encoded text",                      //PlankResult_Base64Error
         "An error with mismatching types for share pointers occurred",                          //PlankResult_SharedPtrTypeError,
 
         ""
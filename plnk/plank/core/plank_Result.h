@@ -92,11 +92,14 @@ enum PlankResultIdentifiers
     PlankResult_IndexOutOfRange,            ///< An index for a list, array etc was out of range.
     PlankResult_ItemCountInvalid,           ///< An item count was invalid (e.g., 0 or too small for the context).
     PlankResult_ContainerNotEmptyOnDeInit,  ///< A container (list, queue, stack) is being de-initialised but is non-empty.
+    PlankResult_ContainerFull,              ///< A bounded container (e.g., a ring queue) had no space for an item.
+    PlankResult_ContainerEmpty,             ///< A container had no items to remove.
     
     PlankResult_ThreadLocalStorageMaximumIdentifiersReached, ///< The maximum number of identifiers for thread-local storage has been reached.
     PlankResult_JSONError,                  ///< A generic JSON error occurred.
     PlankResult_JSONFileError,              ///< A JSON error occurred with a file.
     PlankResult_ZipError,                   ///< A generic Zip error occurred.
+    PlankResult_Base64Error,                ///< Invalid characters or padding were found in Base64 encoded text.
     PlankResult_SharedPtrTypeError,         ///< An error with mismatching types for share pointers.
 
     PlankNumResults
@@ -56,7 +56,10 @@
  config - define these in preprocessor macros to enable special options
  PLANK_FFT_VDSP=1           -   use vDSP on Mac OS X for FFT routines
  PLANK_FFT_VDSP_FLIPIMAG=1  -   flip the imag part of the FFT to match FFTReal data closely
+ PLANK_FFT_OOURA=1          -   use Ooura as the default FFT engine instead of pffft
+ PLANK_FFT_FFTREAL=1        -   use FFTReal as the default FFT engine instead of pffft
  PLANK_VEC_VDSP 1           -   use vDSP on Mac OS X for vector ops
+ PLANK_VEC_SIMD 1           -   use SSE2/AVX/NEON intrinsics for vector ops (e.g., on Linux)
 */
 
 #ifndef PLANK_API
@@ -443,7 +446,7 @@ static PLANK_INLINE_LOW double pl_TimeNow()
 static PLANK_INLINE_LOW void pl_TimeToTimeSpec (struct timespec* time, double seconds)
 {
     time->tv_sec = (long)seconds;
-    time->tv_nsec = (long)((seconds - time->tv_sec) * 0.000000001);
+    time->tv_nsec = (long)((seconds - time->tv_sec) * 1000000000.0);
 }
 #endif
 
@@ -100,6 +100,23 @@ PlankThreadID pl_ThreadCurrentID()
 #endif
 }
 
+PlankI pl_ThreadNumCores()
+{
+    PlankI numCores;
+    
+#if PLANK_APPLE || PLANK_LINUX || PLANK_ANDROID
+    numCores = (PlankI)sysconf (_SC_NPROCESSORS_ONLN);
+#elif PLANK_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo (&info);
+    numCores = (PlankI)info.dwNumberOfProcessors;
+#else
+    #error No platform defined to implement threads.
+#endif
+    
+    return numCores > 0 ? numCores : 1;
+}
+
 #if PLANK_WIN
 struct THREADNAME_INFO
 {
@@ -172,7 +189,11 @@ PlankThreadNativeReturn PLANK_THREADCALL pl_ThreadNativeFunction (PlankP argumen
   
 exit:
     if (result != PlankResult_ThreadWasDeleted)
-        pl_Thread_Reset (p);
+    {
+        // the handle is kept so pl_Thread_Wait() can still join the thread
+        pl_AtomicI_Set (&p->shouldExitAtom, PLANK_FALSE);
+        pl_AtomicI_Set (&p->isRunningAtom, PLANK_FALSE);
+    }
     
     return ((result == PlankResult_OK) || (result == PlankResult_ThreadWasDeleted)) ? 0 : (PlankThreadNativeReturn)(-1);
 }
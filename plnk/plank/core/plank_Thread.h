@@ -112,6 +112,10 @@ PlankResult pl_ThreadYield();
  @return The thread's ID. */
 PlankThreadID pl_ThreadCurrentID();
 
+/** Get the number of processor cores currently available.
+ @return The number of online cores (always at least 1). */
+PlankI pl_ThreadNumCores();
+
 /** Create and initialise a <i>Plank %Thread</i> object and return an oqaque reference to it.
  @return A <i>Plank %Thread</i> object as an opaque reference or PLANK_NULL. */
 PlankThreadRef pl_Thread_CreateAndInit();
@@ -62,4 +62,28 @@ void pl_FFTRealF_Inverse (void* peer, float* output, const float* input)
 {
     ffft::FFTReal<float>* const fft = static_cast<ffft::FFTReal<float>*> (peer);
     fft->do_ifft (input, output);
+}
+
+void* pl_FFTRealD_CreateAndInitWithLength (const long length)
+{
+    ffft::FFTReal<double>* fft = new ffft::FFTReal<double> (length);
+    return fft;
+}
+
+void pl_FFTRealD_Destroy (void* peer)
+{
+    ffft::FFTReal<double>* const fft = static_cast<ffft::FFTReal<double>*> (peer);
+    delete fft;
+}
+
+void pl_FFTRealD_Forward (void* peer, double* output, const double* input)
+{
+    ffft::FFTReal<double>* const fft = static_cast<ffft::FFTReal<double>*> (peer);
+    fft->do_fft (output, input);
+}
+
+void pl_FFTRealD_Inverse (void* peer, double* output, const double* input)
+{
+    ffft::FFTReal<double>* const fft = static_cast<ffft::FFTReal<double>*> (peer);
+    fft->do_ifft (input, output);
 }
\ No newline at end of file
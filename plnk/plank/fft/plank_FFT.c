@@ -48,18 +48,6 @@
 #endif
 
 #ifdef PLANK_FFT_VDSP
-    #ifdef PLANK_FFT_CUSTOM
-    #undef PLANK_FFT_CUSTOM
-    #endif
-
-    #ifdef PLANK_FFT_OOURA
-    #undef PLANK_FFT_OOURA
-    #endif
-
-    #ifdef PLANK_FFT_PFFFT
-    #undef PLANK_FFT_PFFFT
-    #endif
-
     typedef struct PLANK_FFT_VDSP_Point
     {
         int evil;
@@ -70,22 +58,16 @@
     #include <Accelerate/Accelerate.h>
     #undef Point
     #undef Component
-    #else
-    #include "fftreal/plank_FFTRealInternal.h"
 #endif
 
+#include "fftreal/plank_FFTRealInternal.h"
 
-#ifdef PLANK_FFT_PFFFT
-    #ifdef PLANK_FFT_OOURA
-    #undef PLANK_FFT_OOURA
-    #endif
-
-    #include "../../ext/pffft/pffft.c"
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
 #endif
 
-#ifdef PLANK_FFT_OOURA
-    #include "../../ext/ooura/ooura.c"
-#endif
+#include "../../ext/pffft/pffft.c"
+#include "../../ext/ooura/ooura.c"
 
 #if !DOXYGEN
 typedef struct PlankFFTF
@@ -97,25 +79,183 @@ typedef struct PlankFFTF
     float fftScale;
     float ifftScale;
     float* buffer;
+    float* work;
+    int engine;
 #ifdef PLANK_FFT_VDSP
     DSPSplitComplex bufferComplex;
 #endif
 } PlankFFTF;
+
+typedef struct PlankFFTD
+{
+    void* peer;
+    PlankL length;
+    PlankL halfLength;
+    PlankL lengthLog2;
+    double fftScale;
+    double ifftScale;
+    double* buffer;
+    int engine;
+#ifdef PLANK_FFT_VDSP
+    DSPDoubleSplitComplex bufferComplex;
 #endif
+} PlankFFTD;
+#endif
+
+static int pl_FFTDefaultEngine = PLANKFFT_ENGINE_DEFAULT;
+
+PlankResult pl_FFT_SetDefaultEngine (const int engine)
+{
+    if ((engine < PLANKFFT_ENGINE_DEFAULT) || (engine >= PLANKFFT_ENGINE_NUM))
+        return PlankResult_UnknownError;
+    
+    pl_FFTDefaultEngine = engine;
+    return PlankResult_OK;
+}
+
+int pl_FFT_GetDefaultEngine()
+{
+    return pl_FFTDefaultEngine;
+}
 
-const char* pl_FFTF_GetInternalEngineName()
+const char* pl_FFT_GetEngineName (const int engine)
 {
+    switch (engine)
+    {
+        case PLANKFFT_ENGINE_FFTREAL:   return "FFTReal";
+        case PLANKFFT_ENGINE_PFFFT:     return "PFFFT";
+        case PLANKFFT_ENGINE_OOURA:     return "Ooura";
+        case PLANKFFT_ENGINE_VDSP:      return "vDSP";
+#if defined(PLANK_FFT_CUSTOM)
+        case PLANKFFT_ENGINE_CUSTOM:    return pl_FFTCustomF_GetName();
+#else
+        case PLANKFFT_ENGINE_CUSTOM:    return "Custom";
+#endif
+        default:                        return "Default";
+    }
+}
+
+static PlankL pl_FFT_LengthLog2 (const PlankL length)
+{
+    PlankL lengthLog2 = 4;
+    
+    while (((PlankL)1 << lengthLog2) < length)
+        PLANK_INC (lengthLog2);
+    
+    return lengthLog2;
+}
+
+/* Choose the engine for a particular length, falling back to one that can handle it.
+   pffft, Ooura and custom engines are single precision only. */
+static int pl_FFT_ChooseEngine (int engine, const PlankL length, const PlankB isDouble)
+{
+    if (engine == PLANKFFT_ENGINE_DEFAULT)
+        engine = pl_FFTDefaultEngine;
+    
+    if (engine == PLANKFFT_ENGINE_DEFAULT)
+    {
 #if defined(PLANK_FFT_VDSP)
-    return "vDSP";
-#elif defined(PLANK_FFT_PFFFT)
-    return "PFFFT";
-#elif defined(PLANK_FFT_OOURA)
-    return "OURA";
+        engine = PLANKFFT_ENGINE_VDSP;
 #elif defined(PLANK_FFT_CUSTOM)
-    return pl_FFTCustomF_GetName();
+        engine = PLANKFFT_ENGINE_CUSTOM;
+#elif defined(PLANK_FFT_OOURA)
+        engine = PLANKFFT_ENGINE_OOURA;
+#elif defined(PLANK_FFT_FFTREAL)
+        engine = PLANKFFT_ENGINE_FFTREAL;
 #else
-    return "FFTReal";
+        engine = PLANKFFT_ENGINE_PFFFT;
 #endif
+    }
+    
+    switch (engine)
+    {
+        case PLANKFFT_ENGINE_PFFFT:
+            // real transforms need a multiple of 2 * SIMD size squared
+            if (!isDouble && ((length % (2 * pffft_simd_size() * pffft_simd_size())) == 0))
+                return engine;
+            break;
+        case PLANKFFT_ENGINE_OOURA:
+            if (!isDouble && (length >= 4))
+                return engine;
+            break;
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            return engine;
+#endif
+#if defined(PLANK_FFT_CUSTOM)
+        case PLANKFFT_ENGINE_CUSTOM:
+            if (!isDouble)
+                return engine;
+            break;
+#endif
+        default:
+            break;
+    }
+    
+#if defined(PLANK_FFT_VDSP)
+    return PLANKFFT_ENGINE_VDSP;
+#else
+    return PLANKFFT_ENGINE_FFTREAL;
+#endif
+}
+
+static PlankB pl_FFT_IsAligned (const void* ptr)
+{
+    return ((PlankUL)ptr & 15) == 0;
+}
+
+static void pl_FFT_Pack (int halfLength, float* packedOutput, const float* interleavedInput)
+{
+    const float* input;
+    float* real;
+    float* imag;
+    
+    input = interleavedInput;
+    real = packedOutput;
+    imag = packedOutput + halfLength;
+    
+    while (halfLength--)
+    {
+        *real++ = *input++;
+        *imag++ = *input++;
+    }
+}
+
+static void pl_FFT_Unpack (int halfLength, float* interleavedOutput, const float* packedInput)
+{
+    float* output;
+    const float* real;
+    const float* imag;
+    
+    output = interleavedOutput;
+    real = packedInput;
+    imag = packedInput + halfLength;
+    
+    while (halfLength--)
+    {
+        *output++ = *real++;
+        *output++ = *imag++;
+    }
+}
+
+/* pffft uses the opposite sign to FFTReal for the imaginary parts, the Nyquist
+   bin is real and stored at the start of the imaginary half so is left alone. */
+static void pl_FFT_FlipImag (const int halfLength, float* packed)
+{
+    float* flip = packed + halfLength;
+    pl_VectorNegF_NN (flip + 1, flip + 1, halfLength - 1);
+}
+
+//------------------------------------------------------------------------------
+
+const char* pl_FFTF_GetInternalEngineName (PlankFFTFRef p)
+{
+    return pl_FFT_GetEngineName (p->engine);
+}
+
+int pl_FFTF_GetEngine (PlankFFTFRef p)
+{
+    return p->engine;
 }
 
 PlankFFTFRef pl_FFTF_CreateAndInit()
@@ -154,6 +294,11 @@ PlankResult pl_FFTF_Init (PlankFFTFRef p)
 }
 
 PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length)
+{
+    return pl_FFTF_InitWithLengthAndEngine (p, length, PLANKFFT_ENGINE_DEFAULT);
+}
+
+PlankResult pl_FFTF_InitWithLengthAndEngine (PlankFFTFRef p, const PlankL length, const int engine)
 {
     PlankResult result = PlankResult_OK;
     PlankMemoryRef m;
@@ -166,6 +311,7 @@ PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length)
     }
     
     p->buffer = PLANK_NULL;
+    p->work = PLANK_NULL;
     p->length = length;
     
     if (p->length <= 0)
@@ -174,30 +320,35 @@ PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length)
         p->length = (PlankL)1 << p->length; // less than 16 use it as a power of 2
     
     p->halfLength = p->length / 2;
-    
-    p->lengthLog2 = 4;
-    while (((PlankL)1 << p->lengthLog2) < p->length)
-        PLANK_INC (p->lengthLog2);
-    
-#if defined(PLANK_FFT_VDSP)
-    p->peer = vDSP_create_fftsetup (p->lengthLog2, 0);
-    p->ifftScale = 1.0f / p->length;
-    p->fftScale = 0.5f;
-#elif defined(PLANK_FFT_PFFFT)
-    p->peer = pffft_new_setup ((int)p->length, PFFFT_REAL);
-    p->ifftScale = 1.0f / (int)p->length;
+    p->lengthLog2 = pl_FFT_LengthLog2 (p->length);
+    p->engine = pl_FFT_ChooseEngine (engine, p->length, PLANK_FALSE);
     p->fftScale = 1.0f;
-#elif defined(PLANK_FFT_OOURA)
-    p->ifftScale = 2.0f / (int)p->length;
-    p->fftScale = 1.0f;
-    p->peer = ooura_create (p->length);
-#elif defined(PLANK_FFT_CUSTOM)
-    p->peer = pl_FFTCustomF_CreateAndInitWithLength ((int)p->length, &p->fftScale, &p->ifftScale);
-#else
-    p->peer = pl_FFTRealF_CreateAndInitWithLength (p->length);
     p->ifftScale = 1.0f / (int)p->length;
-    p->fftScale = 1.0f;
+    
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            p->peer = vDSP_create_fftsetup (p->lengthLog2, 0);
+            p->fftScale = 0.5f;
+            break;
+#endif
+        case PLANKFFT_ENGINE_PFFFT:
+            p->peer = pffft_new_setup ((int)p->length, PFFFT_REAL);
+            break;
+        case PLANKFFT_ENGINE_OOURA:
+            p->peer = ooura_create ((int)p->length);
+            p->ifftScale = 2.0f / (int)p->length;
+            break;
+#if defined(PLANK_FFT_CUSTOM)
+        case PLANKFFT_ENGINE_CUSTOM:
+            p->peer = pl_FFTCustomF_CreateAndInitWithLength ((int)p->length, &p->fftScale, &p->ifftScale);
+            break;
 #endif
+        default:
+            p->peer = pl_FFTRealF_CreateAndInitWithLength (p->length);
+            break;
+    }
     
     if (p->peer == PLANK_NULL)
     {
@@ -205,7 +356,22 @@ PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length)
         goto exit;
     }
     
-    p->buffer = (float*)pl_Memory_AllocateBytes (m, sizeof (float) * p->length);
+    if (p->engine == PLANKFFT_ENGINE_PFFFT)
+    {
+        // pffft needs SIMD aligned buffers for its input, output and work space
+        p->buffer = (float*)pffft_aligned_malloc (sizeof (float) * p->length);
+        p->work = (float*)pffft_aligned_malloc (sizeof (float) * p->length);
+        
+        if (p->work == PLANK_NULL)
+        {
+            result = PlankResult_MemoryError;
+            goto exit;
+        }
+    }
+    else
+    {
+        p->buffer = (float*)pl_Memory_AllocateBytes (m, sizeof (float) * p->length);
+    }
     
     if (p->buffer == PLANK_NULL)
     {
@@ -234,20 +400,40 @@ PlankResult pl_FFTF_DeInit (PlankFFTFRef p)
         goto exit;
     }
     
+    switch (p->engine)
+    {
 #if defined(PLANK_FFT_VDSP)
-    vDSP_destroy_fftsetup ((FFTSetup)p->peer);
-#elif defined(PLANK_FFT_PFFFT)
-    pffft_destroy_setup ((PFFFT_Setup*)p->peer);
-#elif defined(PLANK_FFT_OOURA)
-    ooura_destroy((OouraFFT*)p->peer);
-#elif defined(PLANK_FFT_CUSTOM)
-    pl_FFTCustomF_Destroy (p->peer);
-#else
-    pl_FFTRealF_Destroy (p->peer);
+        case PLANKFFT_ENGINE_VDSP:
+            vDSP_destroy_fftsetup ((FFTSetup)p->peer);
+            break;
+#endif
+        case PLANKFFT_ENGINE_PFFFT:
+            pffft_destroy_setup ((PFFFT_Setup*)p->peer);
+            break;
+        case PLANKFFT_ENGINE_OOURA:
+            ooura_destroy ((OouraFFT*)p->peer);
+            break;
+#if defined(PLANK_FFT_CUSTOM)
+        case PLANKFFT_ENGINE_CUSTOM:
+            pl_FFTCustomF_Destroy (p->peer);
+            break;
 #endif
+        default:
+            pl_FFTRealF_Destroy (p->peer);
+            break;
+    }
     
     p->peer = PLANK_NULL;
-    result = pl_Memory_Free (m, p->buffer);
+    
+    if (p->engine == PLANKFFT_ENGINE_PFFFT)
+    {
+        pffft_aligned_free (p->buffer);
+        pffft_aligned_free (p->work);
+    }
+    else
+    {
+        result = pl_Memory_Free (m, p->buffer);
+    }
     
     pl_MemoryZero (p, sizeof (PlankFFTF));
     
@@ -272,45 +458,9 @@ exit:
     return result;
 }
 
-#if defined (PLANK_FFT_OOURA) || defined (PLANK_FFT_PFFFT)
-static void pl_FFT_Pack (int halfLength, float* packedOutput, const float* interleavedInput)
-{
-    const float* input;
-    float* real;
-    float* imag;
-    
-    input = interleavedInput;
-    real = packedOutput;
-    imag = packedOutput + halfLength;
-    
-    while (halfLength--)
-    {
-        *real++ = *input++;
-        *imag++ = *input++;
-    }
-}
-
-static void pl_FFT_Unpack (int halfLength, float* interleavedOutput, const float* packedInput)
-{
-    float* output;
-    const float* real;
-    const float* imag;
-    
-    output = interleavedOutput;
-    real = packedInput;
-    imag = packedInput + halfLength;
-    
-    while (halfLength--)
-    {
-        *output++ = *real++;
-        *output++ = *imag++;
-    }
-}
-#endif // defined (PLANK_FFT_OOURA) || defined (PLANK_FFT_PFFFT)
-
-void pl_FFTF_Forward (PlankFFTFRef p, float* output, const float* input)
-{
 #if defined(PLANK_FFT_VDSP)
+static void pl_FFTF_ForwardVDSP (PlankFFTFRef p, float* output, const float* input)
+{
     const PlankL N = p->length;
     const float scale = p->fftScale;
 
@@ -337,34 +487,11 @@ void pl_FFTF_Forward (PlankFFTFRef p, float* output, const float* input)
     
     flip[0] = nyquist;
    #endif
-#elif defined(PLANK_FFT_PFFFT)
-    pffft_transform ((PFFFT_Setup*)p->peer, input, output, p->buffer, PFFFT_FORWARD);
-    pffft_zreorder ((PFFFT_Setup*)p->peer, output, p->buffer, PFFFT_FORWARD);
-    pl_FFT_Pack (p->halfLength, output, p->buffer);
-#elif defined(PLANK_FFT_OOURA)
-    pl_MemoryCopy (p->buffer, input, sizeof(float) * p->length);
-    ooura_forward ((OouraFFT*)p->peer, p->buffer);
-    pl_FFT_Pack (p->halfLength, output, p->buffer);
-#elif defined(PLANK_FFT_CUSTOM)
-    const PlankL N = p->length;
-    const float scale = p->fftScale;
-
-    pl_FFTCustomF_Forward (p->peer, output, input, p->buffer);
-
-    if (scale != 1.0f)
-        pl_VectorMulF_NN1 (output, output, scale, N);
-
-#else
-    pl_FFTRealF_Forward (p->peer, output, input);
-#endif
 }
 
-void pl_FFTF_Inverse (PlankFFTFRef p, float* output, const float* input)
+static void pl_FFTF_InverseVDSP (PlankFFTFRef p, float* output, const float* input)
 {
     const PlankL N = p->length;
-    const float scale = p->ifftScale;
-    
-#if defined(PLANK_FFT_VDSP)
     FFTSetup fftvDSP = (FFTSetup)p->peer;
     float* buffer = p->buffer;
     DSPSplitComplex* bufferComplex = &p->bufferComplex;
@@ -384,22 +511,152 @@ void pl_FFTF_Inverse (PlankFFTFRef p, float* output, const float* input)
     
     vDSP_fft_zrip (fftvDSP, bufferComplex, 1, Nlog2, FFT_INVERSE);
     vDSP_ztoc (bufferComplex, 1, (DSPComplex*)output, 2, N2);
-#elif defined(PLANK_FFT_PFFFT)
-    pl_FFT_Unpack (p->halfLength, p->buffer, input);
-    pffft_zreorder ((PFFFT_Setup*)p->peer, p->buffer, output, PFFFT_BACKWARD);
-    pffft_transform ((PFFFT_Setup*)p->peer, output, output, p->buffer, PFFFT_BACKWARD);
-#elif defined(PLANK_FFT_OOURA)
-    pl_FFT_Unpack (p->halfLength, output, input);
-    ooura_inverse ((OouraFFT*)p->peer, output);
-#elif defined(PLANK_FFT_CUSTOM)
-    pl_FFTCustomF_Inverse (p->peer, output, input, p->buffer);
-#else
-    pl_MemoryCopy (p->buffer, input, sizeof (float) * N);
-    pl_FFTRealF_Inverse (p->peer, output, p->buffer);
+    pl_VectorMulF_NN1 (output, output, p->ifftScale, N);
+}
 #endif
+
+static void pl_FFTF_ForwardPFFFT (PlankFFTFRef p, float* output, const float* input)
+{
+    PFFFT_Setup* setup = (PFFFT_Setup*)p->peer;
     
-    if (scale != 1.0f)
-        pl_VectorMulF_NN1 (output, output, scale, N);
+    if (!pl_FFT_IsAligned (input))
+    {
+        pl_MemoryCopy (p->work, input, sizeof (float) * p->length);
+        input = p->work;
+    }
+    
+    pffft_transform (setup, input, p->work, p->buffer, PFFFT_FORWARD);
+    pffft_zreorder (setup, p->work, p->buffer, PFFFT_FORWARD);
+    pl_FFT_Pack ((int)p->halfLength, output, p->buffer);
+    pl_FFT_FlipImag ((int)p->halfLength, output);
+}
+
+static void pl_FFTF_InversePFFFT (PlankFFTFRef p, float* output, const float* input)
+{
+    PFFFT_Setup* setup = (PFFFT_Setup*)p->peer;
+    float* imag;
+    PlankL i;
+    
+    pl_FFT_Unpack ((int)p->halfLength, p->buffer, input);
+    
+    // flip the interleaved imaginary parts, the first pair holds DC and Nyquist
+    imag = p->buffer + 3;
+    
+    for (i = 1; i < p->halfLength; ++i, imag += 2)
+        *imag = -*imag;
+    
+    pffft_zreorder (setup, p->buffer, p->work, PFFFT_BACKWARD);
+    
+    if (pl_FFT_IsAligned (output))
+    {
+        pffft_transform (setup, p->work, output, p->buffer, PFFFT_BACKWARD);
+        pl_VectorMulF_NN1 (output, output, p->ifftScale, p->length);
+    }
+    else
+    {
+        pffft_transform (setup, p->work, p->work, p->buffer, PFFFT_BACKWARD);
+        pl_VectorMulF_NN1 (output, p->work, p->ifftScale, p->length);
+    }
+}
+
+static void pl_FFTF_ForwardOoura (PlankFFTFRef p, float* output, const float* input)
+{
+    pl_MemoryCopy (p->buffer, input, sizeof (float) * p->length);
+    ooura_forward ((OouraFFT*)p->peer, p->buffer);
+    pl_FFT_Pack ((int)p->halfLength, output, p->buffer);
+}
+
+static void pl_FFTF_InverseOoura (PlankFFTFRef p, float* output, const float* input)
+{
+    pl_FFT_Unpack ((int)p->halfLength, p->buffer, input);
+    ooura_inverse ((OouraFFT*)p->peer, p->buffer);
+    pl_VectorMulF_NN1 (output, p->buffer, p->ifftScale, p->length);
+}
+
+void pl_FFTF_Forward (PlankFFTFRef p, float* output, const float* input)
+{
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            pl_FFTF_ForwardVDSP (p, output, input);
+            break;
+#endif
+        case PLANKFFT_ENGINE_PFFFT:
+            pl_FFTF_ForwardPFFFT (p, output, input);
+            break;
+        case PLANKFFT_ENGINE_OOURA:
+            pl_FFTF_ForwardOoura (p, output, input);
+            break;
+#if defined(PLANK_FFT_CUSTOM)
+        case PLANKFFT_ENGINE_CUSTOM:
+            pl_FFTCustomF_Forward (p->peer, output, input, p->buffer);
+            
+            if (p->fftScale != 1.0f)
+                pl_VectorMulF_NN1 (output, output, p->fftScale, p->length);
+            
+            break;
+#endif
+        default:
+            if (output == input)
+            {
+                pl_MemoryCopy (p->buffer, input, sizeof (float) * p->length);
+                input = p->buffer;
+            }
+            
+            pl_FFTRealF_Forward (p->peer, output, input);
+            break;
+    }
+}
+
+void pl_FFTF_Inverse (PlankFFTFRef p, float* output, const float* input)
+{
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            pl_FFTF_InverseVDSP (p, output, input);
+            break;
+#endif
+        case PLANKFFT_ENGINE_PFFFT:
+            pl_FFTF_InversePFFFT (p, output, input);
+            break;
+        case PLANKFFT_ENGINE_OOURA:
+            pl_FFTF_InverseOoura (p, output, input);
+            break;
+#if defined(PLANK_FFT_CUSTOM)
+        case PLANKFFT_ENGINE_CUSTOM:
+            pl_FFTCustomF_Inverse (p->peer, output, input, p->buffer);
+            
+            if (p->ifftScale != 1.0f)
+                pl_VectorMulF_NN1 (output, output, p->ifftScale, p->length);
+            
+            break;
+#endif
+        default:
+            pl_MemoryCopy (p->buffer, input, sizeof (float) * p->length);
+            pl_FFTRealF_Inverse (p->peer, output, p->buffer);
+            pl_VectorMulF_NN1 (output, output, p->ifftScale, p->length);
+            break;
+    }
+}
+
+void pl_FFTF_ForwardBatch (PlankFFTFRef p, float* output, const float* input, const int numTransforms)
+{
+    const PlankL N = p->length;
+    int i;
+    
+    for (i = 0; i < numTransforms; ++i, output += N, input += N)
+        pl_FFTF_Forward (p, output, input);
+}
+
+void pl_FFTF_InverseBatch (PlankFFTFRef p, float* output, const float* input, const int numTransforms)
+{
+    const PlankL N = p->length;
+    int i;
+    
+    for (i = 0; i < numTransforms; ++i, output += N, input += N)
+        pl_FFTF_Inverse (p, output, input);
 }
 
 PlankL pl_FFTF_Length (PlankFFTFRef p)
@@ -422,3 +679,300 @@ float* pl_FFTF_Temp (PlankFFTFRef p)
     return p->buffer;
 }
 
+//------------------------------------------------------------------------------
+
+const char* pl_FFTD_GetInternalEngineName (PlankFFTDRef p)
+{
+    return pl_FFT_GetEngineName (p->engine);
+}
+
+int pl_FFTD_GetEngine (PlankFFTDRef p)
+{
+    return p->engine;
+}
+
+PlankFFTDRef pl_FFTD_CreateAndInit()
+{
+    PlankFFTDRef p;
+    p = pl_FFTD_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_FFTD_Init (p) != PlankResult_OK)
+            pl_FFTD_Destroy (p);
+        else
+            return p;
+    }
+    
+    return (PlankFFTDRef)PLANK_NULL;
+}
+
+PlankFFTDRef pl_FFTD_Create()
+{
+    PlankMemoryRef m;
+    PlankFFTDRef p;
+    
+    m = pl_MemoryGlobal();
+    p = (PlankFFTDRef)pl_Memory_AllocateBytes (m, sizeof (PlankFFTD));
+    
+    if (p != NULL)
+        pl_MemoryZero (p, sizeof (PlankFFTD));
+    
+    return p;
+}
+
+PlankResult pl_FFTD_Init (PlankFFTDRef p)
+{
+    return pl_FFTD_InitWithLength (p, 0);
+}
+
+PlankResult pl_FFTD_InitWithLength (PlankFFTDRef p, const PlankL length)
+{
+    return pl_FFTD_InitWithLengthAndEngine (p, length, PLANKFFT_ENGINE_DEFAULT);
+}
+
+PlankResult pl_FFTD_InitWithLengthAndEngine (PlankFFTDRef p, const PlankL length, const int engine)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    p->buffer = PLANK_NULL;
+    p->length = length;
+    
+    if (p->length <= 0)
+        p->length = PLANKFFTD_DEFAULTLENGTH;
+    else if (p->length < 16)
+        p->length = (PlankL)1 << p->length; // less than 16 use it as a power of 2
+    
+    p->halfLength = p->length / 2;
+    p->lengthLog2 = pl_FFT_LengthLog2 (p->length);
+    p->engine = pl_FFT_ChooseEngine (engine, p->length, PLANK_TRUE);
+    p->fftScale = 1.0;
+    p->ifftScale = 1.0 / (double)p->length;
+    
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            p->peer = vDSP_create_fftsetupD (p->lengthLog2, 0);
+            p->fftScale = 0.5;
+            break;
+#endif
+        default:
+            p->peer = pl_FFTRealD_CreateAndInitWithLength (p->length);
+            break;
+    }
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    p->buffer = (double*)pl_Memory_AllocateBytes (m, sizeof (double) * p->length);
+    
+    if (p->buffer == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+#if defined(PLANK_FFT_VDSP)
+    p->bufferComplex.realp = p->buffer;
+    p->bufferComplex.imagp = p->buffer + p->halfLength;
+#endif
+    
+exit:
+    return result;
+}
+
+PlankResult pl_FFTD_DeInit (PlankFFTDRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    m = pl_MemoryGlobal();
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            vDSP_destroy_fftsetupD ((FFTSetupD)p->peer);
+            break;
+#endif
+        default:
+            pl_FFTRealD_Destroy (p->peer);
+            break;
+    }
+    
+    p->peer = PLANK_NULL;
+    result = pl_Memory_Free (m, p->buffer);
+    
+    pl_MemoryZero (p, sizeof (PlankFFTD));
+    
+exit:
+    return result;
+}
+
+PlankResult pl_FFTD_Destroy (PlankFFTDRef p)
+{
+    PlankResult result;
+    PlankMemoryRef m;
+    
+    result = PlankResult_OK;
+    m = pl_MemoryGlobal();
+    
+    if ((result = pl_FFTD_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);
+    
+exit:
+    return result;
+}
+
+#if defined(PLANK_FFT_VDSP)
+static void pl_FFTD_ForwardVDSP (PlankFFTDRef p, double* output, const double* input)
+{
+    const PlankL N = p->length;
+    const double scale = p->fftScale;
+    
+    FFTSetupD fftvDSP = (FFTSetupD)p->peer;
+    const PlankL N2 = p->halfLength;
+    const PlankL Nlog2 = p->lengthLog2;
+    double* buffer = p->buffer;
+    
+    DSPDoubleSplitComplex outputComplex;
+    outputComplex.realp = output;
+    outputComplex.imagp = output + N2;
+    
+    if (scale != 1.0)
+        pl_VectorMulD_NN1 (buffer, input, scale, N);
+    
+    vDSP_ctozD ((DSPDoubleComplex*)buffer, 2, &outputComplex, 1, N2);
+    vDSP_fft_zripD (fftvDSP, &outputComplex, 1, Nlog2, FFT_FORWARD);
+    
+   #ifdef PLANK_FFT_VDSP_FLIPIMAG
+    double* flip = output + N2;
+    double nyquist = flip[0];
+    
+    pl_VectorNegD_NN (flip, flip, N2);
+    
+    flip[0] = nyquist;
+   #endif
+}
+
+static void pl_FFTD_InverseVDSP (PlankFFTDRef p, double* output, const double* input)
+{
+    const PlankL N = p->length;
+    FFTSetupD fftvDSP = (FFTSetupD)p->peer;
+    double* buffer = p->buffer;
+    DSPDoubleSplitComplex* bufferComplex = &p->bufferComplex;
+    const PlankL N2 = p->halfLength;
+    const PlankL Nlog2 = p->lengthLog2;
+    
+    pl_MemoryCopy (buffer, input, sizeof (double) * N);
+    
+   #ifdef PLANK_FFT_VDSP_FLIPIMAG
+    double* flip = buffer + N2;
+    double nyquist = flip[0];
+    
+    pl_VectorNegD_NN (flip, flip, N2);
+    
+    flip[0] = nyquist;
+   #endif
+    
+    vDSP_fft_zripD (fftvDSP, bufferComplex, 1, Nlog2, FFT_INVERSE);
+    vDSP_ztocD (bufferComplex, 1, (DSPDoubleComplex*)output, 2, N2);
+    pl_VectorMulD_NN1 (output, output, p->ifftScale, N);
+}
+#endif
+
+void pl_FFTD_Forward (PlankFFTDRef p, double* output, const double* input)
+{
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            pl_FFTD_ForwardVDSP (p, output, input);
+            break;
+#endif
+        default:
+            if (output == input)
+            {
+                pl_MemoryCopy (p->buffer, input, sizeof (double) * p->length);
+                input = p->buffer;
+            }
+            
+            pl_FFTRealD_Forward (p->peer, output, input);
+            break;
+    }
+}
+
+void pl_FFTD_Inverse (PlankFFTDRef p, double* output, const double* input)
+{
+    switch (p->engine)
+    {
+#if defined(PLANK_FFT_VDSP)
+        case PLANKFFT_ENGINE_VDSP:
+            pl_FFTD_InverseVDSP (p, output, input);
+            break;
+#endif
+        default:
+            pl_MemoryCopy (p->buffer, input, sizeof (double) * p->length);
+            pl_FFTRealD_Inverse (p->peer, output, p->buffer);
+            pl_VectorMulD_NN1 (output, output, p->ifftScale, p->length);
+            break;
+    }
+}
+
+void pl_FFTD_ForwardBatch (PlankFFTDRef p, double* output, const double* input, const int numTransforms)
+{
+    const PlankL N = p->length;
+    int i;
+    
+    for (i = 0; i < numTransforms; ++i, output += N, input += N)
+        pl_FFTD_Forward (p, output, input);
+}
+
+void pl_FFTD_InverseBatch (PlankFFTDRef p, double* output, const double* input, const int numTransforms)
+{
+    const PlankL N = p->length;
+    int i;
+    
+    for (i = 0; i < numTransforms; ++i, output += N, input += N)
+        pl_FFTD_Inverse (p, output, input);
+}
+
+PlankL pl_FFTD_Length (PlankFFTDRef p)
+{
+    return p->length;
+}
+
+PlankL pl_FFTD_HalfLength (PlankFFTDRef p)
+{
+    return p->halfLength;
+}
+
+PlankL pl_FFTD_LengthLog2 (PlankFFTDRef p)
+{
+    return p->lengthLog2;
+}
+
+double* pl_FFTD_Temp (PlankFFTDRef p)
+{
+    return p->buffer;
+}
+
@@ -40,16 +40,50 @@
 #define PLANK_FFT_H
 
 #define PLANKFFTF_DEFAULTLENGTH 4096
+#define PLANKFFTD_DEFAULTLENGTH 4096
+
+/** FFT engine identifiers.
+ These can be passed to pl_FFTF_InitWithLengthAndEngine(), pl_FFTD_InitWithLengthAndEngine()
+ or pl_FFT_SetDefaultEngine(). */
+#define PLANKFFT_ENGINE_DEFAULT     0
+#define PLANKFFT_ENGINE_FFTREAL     1
+#define PLANKFFT_ENGINE_PFFFT       2
+#define PLANKFFT_ENGINE_OOURA       3
+#define PLANKFFT_ENGINE_VDSP        4
+#define PLANKFFT_ENGINE_CUSTOM      5
+#define PLANKFFT_ENGINE_NUM         6
 
 PLANK_BEGIN_C_LINKAGE
 
+/** Set the engine used by FFT objects initialised with PLANKFFT_ENGINE_DEFAULT.
+ This only affects FFT objects initialised after the call. Setting this to
+ PLANKFFT_ENGINE_DEFAULT restores the automatic choice (vDSP if PLANK_FFT_VDSP
+ is defined, otherwise pffft for suitable lengths and FFTReal for the rest).
+ @param engine One of the PLANKFFT_ENGINE_ identifiers.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFT_SetDefaultEngine (const int engine);
+
+/** Get the engine used by FFT objects initialised with PLANKFFT_ENGINE_DEFAULT. 
+ @return One of the PLANKFFT_ENGINE_ identifiers. */
+int pl_FFT_GetDefaultEngine();
+
+/** Get the name of an FFT engine.
+ @param engine One of the PLANKFFT_ENGINE_ identifiers.
+ @return The name of the engine e.g., "FFTReal" or "PFFFT". */
+const char* pl_FFT_GetEngineName (const int engine);
+
 /** A simple, cross-platform FFT processor for audio signals.
  This must be allocated/deallocated using pl_FFTF_Create() and pl_FFTF_Destroy(),
  a statically alloacted version is not currently available.
  
- This makes use of other underlying libraries on request. By default it uses
- FFTReal (via the Plank FFTRealInternal class). To use vDSP on Mac OS X or iOS
- define the preprocessor macro PLANK_FFT_VDSP.
+ This makes use of other underlying libraries on request. The engine is chosen
+ when the object is initialised, either explicitly using pl_FFTF_InitWithLengthAndEngine()
+ or from the global default (see pl_FFT_SetDefaultEngine()). Unless the default has
+ been changed this is pffft (SIMD-accelerated, for lengths that are a multiple of 32) falling
+ back to FFTReal (via the Plank FFTRealInternal class) for other lengths. To use vDSP on Mac OS X 
+ or iOS define the preprocessor macro PLANK_FFT_VDSP. Defining PLANK_FFT_OOURA or PLANK_FFT_FFTREAL
+ makes that engine the automatic choice instead. If the requested engine can't handle
+ the length it falls back to FFTReal (or vDSP). All engines produce the same data layout and scaling.
  
  @code
  PlankFFTFRef fft;
@@ -100,7 +134,6 @@ PLANK_BEGIN_C_LINKAGE
 /** An opaque reference to the <i>Plank FFTF</i> object. */
 typedef struct PlankFFTF* PlankFFTFRef;
 
-const char* pl_FFTF_GetInternalEngineName();
 
 /** Create and initialise a <i>Plank FFTF</i> object and return an oqaque reference to it.
  @return A <i>Plank FFTF</i> object as an opaque reference. */
@@ -122,6 +155,14 @@ PlankResult pl_FFTF_Init (PlankFFTFRef p);
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length);
 
+/** Initialise a <i>Plank FFTF</i> object using a particular engine.
+ @param p The <i>Plank FFTF</i> object.
+ @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
+                specify the log2 FFT size e.g., length 8 = pow(2,8) = 256
+ @param engine  One of the PLANKFFT_ENGINE_ identifiers, PLANKFFT_ENGINE_DEFAULT uses the global default.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTF_InitWithLengthAndEngine (PlankFFTFRef p, const PlankL length, const int engine);
+
 /** Deinitialise a <i>Plank FFTF</i> object.
  @param p The <i>Plank FFTF</i> object.
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
@@ -146,6 +187,22 @@ void pl_FFTF_Forward (PlankFFTFRef p, float* output, const float* input);
  @param input A pointer to an array of floats holding the input data. */
 void pl_FFTF_Inverse (PlankFFTFRef p, float* output, const float* input);
 
+/** Apply the FFT to a number of consecutive input frames.
+ The input and output arrays must each hold numTransforms * pl_FFTF_Length(p) floats.
+ @param p The <i>Plank FFTF</i> object.
+ @param output A pointer to an array of floats to store the results.
+ @param input A pointer to an array of floats holding the input data.
+ @param numTransforms The number of FFT frames to process. */
+void pl_FFTF_ForwardBatch (PlankFFTFRef p, float* output, const float* input, const int numTransforms);
+
+/** Apply the inverse-FFT to a number of consecutive input frames.
+ The input and output arrays must each hold numTransforms * pl_FFTF_Length(p) floats.
+ @param p The <i>Plank FFTF</i> object.
+ @param output A pointer to an array of floats to store the results.
+ @param input A pointer to an array of floats holding the input data.
+ @param numTransforms The number of FFT frames to process. */
+void pl_FFTF_InverseBatch (PlankFFTFRef p, float* output, const float* input, const int numTransforms);
+
 /** Get the FFT size.
  @param p The <i>Plank FFTF</i> object.
  @return The FFT size. */
@@ -171,6 +228,128 @@ PlankL pl_FFTF_LengthLog2 (PlankFFTFRef p);
  @return A pointer to the temporary float buffer. */
 float* pl_FFTF_Temp (PlankFFTFRef p);
 
+/** Get the engine being used.
+ @param p The <i>Plank FFTF</i> object.
+ @return One of the PLANKFFT_ENGINE_ identifiers. */
+int pl_FFTF_GetEngine (PlankFFTFRef p);
+
+/** Get the name of the engine being used.
+ @param p The <i>Plank FFTF</i> object.
+ @return The name of the engine e.g., "FFTReal" or "PFFFT". */
+const char* pl_FFTF_GetInternalEngineName (PlankFFTFRef p);
+
+/// @} // End group PlankFFTFClass
+
+/** A double precision version of the <i>Plank FFTF</i> class.
+ This uses the same data layout and scaling as PlankFFTF. pffft, Ooura and custom
+ engines are single precision only so this uses vDSP (if PLANK_FFT_VDSP is defined)
+ or FFTReal.
+ @defgroup PlankFFTDClass Plank FFTD class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** An opaque reference to the <i>Plank FFTD</i> object. */
+typedef struct PlankFFTD* PlankFFTDRef;
+
+/** Create and initialise a <i>Plank FFTD</i> object and return an oqaque reference to it.
+ @return A <i>Plank FFTD</i> object as an opaque reference. */
+PlankFFTDRef pl_FFTD_CreateAndInit();
+
+/** Create a <i>Plank FFTD</i> object and return an oqaque reference to it.
+ @return A <i>Plank FFTD</i> object as an opaque reference. */
+PlankFFTDRef pl_FFTD_Create();
+
+/** Initialise a <i>Plank FFTD</i> object with a default length (PLANKFFTD_DEFAULTLENGTH).
+ @param p The <i>Plank FFTD</i> object.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_Init (PlankFFTDRef p);
+
+/** Initialise a <i>Plank FFTD</i> object.
+ @param p The <i>Plank FFTD</i> object.
+ @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
+                specify the log2 FFT size e.g., length 8 = pow(2,8) = 256
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_InitWithLength (PlankFFTDRef p, const PlankL length);
+
+/** Initialise a <i>Plank FFTD</i> object using a particular engine.
+ @param p The <i>Plank FFTD</i> object.
+ @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
+                specify the log2 FFT size e.g., length 8 = pow(2,8) = 256
+ @param engine  One of the PLANKFFT_ENGINE_ identifiers, PLANKFFT_ENGINE_DEFAULT uses the global default.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_InitWithLengthAndEngine (PlankFFTDRef p, const PlankL length, const int engine);
+
+/** Deinitialise a <i>Plank FFTD</i> object.
+ @param p The <i>Plank FFTD</i> object.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_DeInit (PlankFFTDRef p);
+
+/** Destroy a <i>Plank FFTD</i> object.
+ @param p The <i>Plank FFTD</i> object.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_Destroy (PlankFFTDRef p);
+
+/** Apply the FFT to the input and place the result in output.
+ This may be performed in-place (i.e., input and output can point to the same data).
+ @param p The <i>Plank FFTD</i> object.
+ @param output A pointer to an array of doubles to store the result.
+ @param input A pointer to an array of doubles holding the input data. */
+void pl_FFTD_Forward (PlankFFTDRef p, double* output, const double* input);
+
+/** Apply the inverse-FFT to the input and place the result in output.
+ This may be performed in-place (i.e., input and output can point to the same data).
+ @param p The <i>Plank FFTD</i> object.
+ @param output A pointer to an array of doubles to store the result.
+ @param input A pointer to an array of doubles holding the input data. */
+void pl_FFTD_Inverse (PlankFFTDRef p, double* output, const double* input);
+
+/** Apply the FFT to a number of consecutive input frames.
+ @param p The <i>Plank FFTD</i> object.
+ @param output A pointer to an array of doubles to store the results.
+ @param input A pointer to an array of doubles holding the input data.
+ @param numTransforms The number of FFT frames to process. */
+void pl_FFTD_ForwardBatch (PlankFFTDRef p, double* output, const double* input, const int numTransforms);
+
+/** Apply the inverse-FFT to a number of consecutive input frames.
+ @param p The <i>Plank FFTD</i> object.
+ @param output A pointer to an array of doubles to store the results.
+ @param input A pointer to an array of doubles holding the input data.
+ @param numTransforms The number of FFT frames to process. */
+void pl_FFTD_InverseBatch (PlankFFTDRef p, double* output, const double* input, const int numTransforms);
+
+/** Get the FFT size.
+ @param p The <i>Plank FFTD</i> object.
+ @return The FFT size. */
+PlankL pl_FFTD_Length (PlankFFTDRef p);
+
+/** Get half FFT size.
+ @param p The <i>Plank FFTD</i> object.
+ @return The half FFT size. */
+PlankL pl_FFTD_HalfLength (PlankFFTDRef p);
+
+/** Get log2 of the FFT size.
+ @param p The <i>Plank FFTD</i> object.
+ @return The log2 of the FFT size. */
+PlankL pl_FFTD_LengthLog2 (PlankFFTDRef p);
+
+/** Get a pointer to the internal temporary buffer.
+ @param p The <i>Plank FFTD</i> object.
+ @return A pointer to the temporary double buffer. */
+double* pl_FFTD_Temp (PlankFFTDRef p);
+
+/** Get the engine being used.
+ @param p The <i>Plank FFTD</i> object.
+ @return One of the PLANKFFT_ENGINE_ identifiers. */
+int pl_FFTD_GetEngine (PlankFFTDRef p);
+
+/** Get the name of the engine being used.
+ @param p The <i>Plank FFTD</i> object.
+ @return The name of the engine e.g., "FFTReal" or "vDSP". */
+const char* pl_FFTD_GetInternalEngineName (PlankFFTDRef p);
+
+/// @} // End group PlankFFTDClass
+
 #if defined(PLANK_FFT_CUSTOM) || defined(DOXYGEN)
 /** Custom creation function for external FFT libs.
  @note Implement this somewhere in your code and define PLANK_FFT_CUSTOM in the project.
@@ -204,8 +383,6 @@ const char* pl_FFTCustomF_GetName();
 
 #endif
 
-/// @} // End group PlankFFTFClass
-
 PLANK_END_C_LINKAGE
 
 #endif // PLANK_FFT_H
@@ -488,6 +488,10 @@ typedef PlankUI PlankAudioFileMetaDataIOFlags;
 
 #define PLANKAUDIOFILE_REGIONNAME_SEPARATOR         "#"
 
+#define PLANKAUDIOFILE_SEEKTABLE_EXTENSION          ".seektable"
+#define PLANKAUDIOFILE_SEEKTABLE_ID                 "PkST"
+#define PLANKAUDIOFILE_SEEKTABLE_VERSION            2
+
 
 #if PLANK_OGGVORBIS
     #ifndef OV_EXCLUDE_STATIC_CALLBACKS
@@ -497,6 +497,34 @@ PlankResult pl_AudioFileReader_OpenWithFile (PlankAudioFileReaderRef p, PlankFil
     return pl_AudioFileReader_OpenInternalInternal (p, 0, file, metaDataIOFlags);
 }
 
+PlankResult pl_AudioFileReader_OpenMapped (PlankAudioFileReaderRef p, const char* filepath, const PlankAudioFileMetaDataIOFlags metaDataIOFlags)
+{
+    PlankResult result;
+    PlankFile file;
+    const void* header;
+    PlankLL headerLength;
+    
+    pl_File_Init (&file);
+    
+    if ((result = pl_File_OpenMapped (&file, filepath, PLANKFILE_BINARY | PLANKFILE_READ)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_GetDataPointer (&file, &header, &headerLength)) != PlankResult_OK) goto exit;
+    
+    if ((headerLength >= 4) && (memcmp (header, "OggS", 4) == 0))
+    {
+        // the Ogg decoders do their own buffering so there's nothing to gain
+        pl_File_DeInit (&file);
+        result = pl_AudioFileReader_OpenInternal (p, filepath, metaDataIOFlags);
+        goto exit;
+    }
+    
+    // this takes over the file and zeros ours
+    result = pl_AudioFileReader_OpenWithFile (p, &file, metaDataIOFlags);
+    
+exit:
+    pl_File_DeInit (&file);
+    return result;
+}
+
 PlankResult pl_AudioFileReader_OpenWithAudioFileArray (PlankAudioFileReaderRef p, PlankDynamicArrayRef array, PlankB ownArray, const int multiMode, int* indexRef)
 {
     return pl_AudioFileReader_Array_Open (p, array, ownArray, multiMode, indexRef);
@@ -826,6 +854,95 @@ PlankResult pl_AudioFileReader_ReadFrames (PlankAudioFileReaderRef p, const Plan
     return ((PlankAudioFileReaderReadFramesFunction)p->readFramesFunction)(p, convertByteOrder, numFrames, data, framesRead);
 }
 
+PlankResult pl_AudioFileReader_GetFramesPointer (PlankAudioFileReaderRef p, const int numFrames, const void** data, int* framesRead)
+{
+    PlankResult result = PlankResult_OK;
+    PlankLL startFrame, endFrame, bytesAvailable;
+    int framesToRead, bytesPerSample, numChannels, streamType;
+    PlankB isBigEndian;
+    
+    *framesRead = 0;
+    
+    if ((p->peer == PLANK_NULL) || (p->readFramesFunction != (PlankM)pl_AudioFileReader_Iff_ReadFrames))
+    {
+        result = PlankResult_AudioFileUnsupportedType;
+        goto exit;
+    }
+    
+    if ((p->dataPosition < 0) || (p->formatInfo.bytesPerFrame <= 0))
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+    
+    if ((result = pl_File_GetStreamType ((PlankFileRef)p->peer, &streamType)) != PlankResult_OK) goto exit;
+    
+    if ((streamType != PLANKFILE_STREAMTYPE_MAPPED) && (streamType != PLANKFILE_STREAMTYPE_MEMORY))
+    {
+        result = PlankResult_AudioFileUnsupportedType;
+        goto exit;
+    }
+    
+    numChannels = pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo);
+    bytesPerSample = p->formatInfo.bytesPerFrame / numChannels;
+    isBigEndian = (p->formatInfo.encoding & PLANKAUDIOFILE_ENCODING_BIGENDIAN_FLAG) ? PLANK_TRUE : PLANK_FALSE;
+    
+#if PLANK_BIGENDIAN
+    if (! isBigEndian)
+#else
+    if (isBigEndian)
+#endif
+    {
+        result = PlankResult_AudioFileUnsupportedType;
+        goto exit;
+    }
+    
+    // only the sample formats that are C types can be used in place
+    if (! (((p->formatInfo.encoding & PLANKAUDIOFILE_ENCODING_PCM_FLAG) && ((bytesPerSample == 2) || (bytesPerSample == 4))) ||
+           ((p->formatInfo.encoding & PLANKAUDIOFILE_ENCODING_FLOAT_FLAG) && ((bytesPerSample == 4) || (bytesPerSample == 8)))))
+    {
+        result = PlankResult_AudioFileUnsupportedType;
+        goto exit;
+    }
+    
+    if ((result = pl_AudioFileReader_GetFramePosition (p, &startFrame)) != PlankResult_OK) goto exit;
+    
+    if (startFrame < 0)
+    {
+        result = PlankResult_AudioFileInvalidFilePosition;
+        goto exit;
+    }
+    
+    endFrame = startFrame + numFrames;
+    framesToRead = ((p->numFrames == -1) || (endFrame <= p->numFrames)) ? (numFrames) : (int)(p->numFrames - startFrame);
+    
+    if ((result = pl_File_GetDataPointer ((PlankFileRef)p->peer, data, &bytesAvailable)) != PlankResult_OK) goto exit;
+    
+    // the data chunk can start at any byte (e.g., 58 in many float WAVs) so the 
+    // samples can't be accessed in place unless they happen to be aligned
+    if (((PlankUL)*data % bytesPerSample) != 0)
+    {
+        *data = PLANK_NULL;
+        result = PlankResult_AudioFileUnsupportedType;
+        goto exit;
+    }
+    
+    framesToRead = (int)pl_MinLL (framesToRead, bytesAvailable / p->formatInfo.bytesPerFrame);
+    
+    if (framesToRead <= 0)
+    {
+        result = PlankResult_FileEOF;
+        goto exit;
+    }
+    
+    if ((result = pl_File_OffsetPosition ((PlankFileRef)p->peer, (PlankLL)framesToRead * p->formatInfo.bytesPerFrame)) != PlankResult_OK) goto exit;
+    
+    *framesRead = framesToRead;
+    
+exit:
+    return result;
+}
+
 PlankAudioFileMetaDataRef pl_AudioFileReader_GetMetaData (PlankAudioFileReaderRef p)
 {
     return p->metaData;
@@ -1319,30 +1436,35 @@ exit:
 PlankResult pl_AudioFileReader_WAV_ParseMetaData (PlankAudioFileReaderRef p)
 {
     PlankResult result = PlankResult_OK;
-    PlankLL readChunkLength, readChunkEnd, mainEnd, pos;
+    PlankLL readChunkLength, readChunkEnd;
     PlankIffID readChunkID;
     PlankIffFileReaderRef iff;
+    PlankIffFileReaderChunkInfo chunkInfo;
     PlankDynamicArrayRef block;
     PlankC* data;
-    int bytesRead;
+    int bytesRead, numChunks, chunkIndex;
 
     iff = (PlankIffFileReaderRef)p->peer;
-    pos = iff->common.headerInfo.mainHeaderEnd;
     
     if ((result = pl_AudioFileMetaData_SetSource (p->metaData, PLANKAUDIOFILE_FORMAT_WAV)) != PlankResult_OK) goto exit;
     
-    if ((result = pl_IffFileReader_GetMainEnd (iff, &mainEnd)) != PlankResult_OK) goto exit;
-    if ((result = pl_File_SetPosition ((PlankFileRef)iff, pos)) != PlankResult_OK) goto exit;
+    if ((result = pl_IffFileReader_GetNumChunks (iff, &numChunks)) != PlankResult_OK) goto exit;
     
-    while ((pos < mainEnd) && (pl_File_IsEOF ((PlankFileRef)iff) == PLANK_FALSE))
+    for (chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
     {
-        if ((result = pl_IffFileReader_ParseChunkHeader (iff, 0, &readChunkID, &readChunkLength, &readChunkEnd, &pos)) != PlankResult_OK) goto exit;
+        if ((result = pl_IffFileReader_GetChunkInfo (iff, chunkIndex, &chunkInfo)) != PlankResult_OK) goto exit;
+        
+        readChunkID     = chunkInfo.id;
+        readChunkLength = chunkInfo.length;
+        readChunkEnd    = chunkInfo.dataPos + pl_AlignULL (chunkInfo.length, iff->common.headerInfo.alignment);
+        
+        if ((result = pl_File_SetPosition ((PlankFileRef)iff, chunkInfo.dataPos)) != PlankResult_OK) goto exit;
         
         if ((readChunkID.fcc == pl_FourCharCode ("fmt ")) ||
             (readChunkID.fcc == pl_FourCharCode ("data")))
         {
             // already done...
-            goto next;
+            continue;
         }
         else if ((readChunkID.fcc == pl_FourCharCode ("bext")) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_INFO))
         {
@@ -1351,7 +1473,7 @@ PlankResult pl_AudioFileReader_WAV_ParseMetaData (PlankAudioFileReaderRef p)
         else if ((readChunkID.fcc == pl_FourCharCode ("levl")) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_OVERVIEW))
         {
             // might be large...
-            goto next;
+            continue;
         }
         else if ((readChunkID.fcc == pl_FourCharCode ("smpl")) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_SAMPLER))
         {
@@ -1393,10 +1515,6 @@ PlankResult pl_AudioFileReader_WAV_ParseMetaData (PlankAudioFileReaderRef p)
                 if ((result = pl_AudioFileMetaData_AddFormatSpecificBlock (p->metaData, block)) != PlankResult_OK) goto exit;
             }
         }
-        
-    next:
-        if ((result = pl_File_SetPosition ((PlankFileRef)iff, readChunkEnd)) != PlankResult_OK) goto exit;
-        pos = readChunkEnd;
     }
 
 exit:
@@ -1488,29 +1606,34 @@ static PlankResult pl_AudioFileReader_AIFFAIFC_ParseChunk_INST (PlankAudioFileRe
 static PlankResult pl_AudioFileReader_AIFFAIFC_ParseMetaData (PlankAudioFileReaderRef p)
 {
     PlankResult result = PlankResult_OK;
-    PlankLL readChunkLength, readChunkEnd, mainEnd, pos;
+    PlankLL readChunkLength, readChunkEnd;
     PlankIffID readChunkID;
     PlankIffFileReaderRef iff;
+    PlankIffFileReaderChunkInfo chunkInfo;
     PlankDynamicArrayRef block;
     PlankC* data;
-    int bytesRead;
+    int bytesRead, numChunks, chunkIndex;
     
     iff = (PlankIffFileReaderRef)p->peer;
-    pos = iff->common.headerInfo.mainHeaderEnd;
     
-    if ((result = pl_IffFileReader_GetMainEnd (iff, &mainEnd)) != PlankResult_OK) goto exit;
-    if ((result = pl_File_SetPosition ((PlankFileRef)iff, pos)) != PlankResult_OK) goto exit;
+    if ((result = pl_IffFileReader_GetNumChunks (iff, &numChunks)) != PlankResult_OK) goto exit;
     
-    while ((pos < mainEnd) && (pl_File_IsEOF ((PlankFileRef)iff) == PLANK_FALSE))
+    for (chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
     {
-        if ((result = pl_IffFileReader_ParseChunkHeader (iff, 0, &readChunkID, &readChunkLength, &readChunkEnd, &pos)) != PlankResult_OK) goto exit;
+        if ((result = pl_IffFileReader_GetChunkInfo (iff, chunkIndex, &chunkInfo)) != PlankResult_OK) goto exit;
+        
+        readChunkID     = chunkInfo.id;
+        readChunkLength = chunkInfo.length;
+        readChunkEnd    = chunkInfo.dataPos + pl_AlignULL (chunkInfo.length, iff->common.headerInfo.alignment);
+        
+        if ((result = pl_File_SetPosition ((PlankFileRef)iff, chunkInfo.dataPos)) != PlankResult_OK) goto exit;
         
         if ((readChunkID.fcc == pl_FourCharCode ("COMM")) ||
             (readChunkID.fcc == pl_FourCharCode ("FVER")) ||
             (readChunkID.fcc == pl_FourCharCode ("SSND")))
         {
             // already done...
-            goto next;
+            continue;
         }
         else if ((readChunkID.fcc == pl_FourCharCode ("MARK")) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_CUEPOINTS))
         {
@@ -1541,10 +1664,6 @@ static PlankResult pl_AudioFileReader_AIFFAIFC_ParseMetaData (PlankAudioFileRead
                 if ((result = pl_AudioFileMetaData_AddFormatSpecificBlock (p->metaData, block)) != PlankResult_OK) goto exit;
             }
         }
-        
-    next:
-        if ((result = pl_File_SetPosition ((PlankFileRef)iff, readChunkEnd)) != PlankResult_OK) goto exit;
-        pos = readChunkEnd;
     }
     
 exit:
@@ -2008,8 +2127,9 @@ PlankResult pl_AudioFileReader_CAF_ParseMetaData (PlankAudioFileReaderRef p)
     PlankUI stringsDataSize;
     char* stringsData;
     PlankUI numStrings, i;
+    PlankIffFileReaderChunkInfo chunkInfo;
     PlankC* data;
-    int bytesRead;
+    int bytesRead, numChunks, chunkIndex;
     
     pl_DynamicArray_Init (&stringIndices);
     pl_DynamicArray_Init (&strings);
@@ -2040,19 +2160,24 @@ PlankResult pl_AudioFileReader_CAF_ParseMetaData (PlankAudioFileReaderRef p)
         }
     }
     
-    pos = iff->common.headerInfo.mainHeaderEnd;
-    if ((result = pl_File_SetPosition ((PlankFileRef)iff, pos)) != PlankResult_OK) goto exit;
+    if ((result = pl_IffFileReader_GetNumChunks (iff, &numChunks)) != PlankResult_OK) goto exit;
     
-    while (pl_File_IsEOF ((PlankFileRef)iff) == PLANK_FALSE)
+    for (chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
     {
-        if ((result = pl_IffFileReader_ParseChunkHeader (iff, 0, &readChunkID, &readChunkLength, &readChunkEnd, &pos)) != PlankResult_OK) goto exit;
+        if ((result = pl_IffFileReader_GetChunkInfo (iff, chunkIndex, &chunkInfo)) != PlankResult_OK) goto exit;
+        
+        readChunkID     = chunkInfo.id;
+        readChunkLength = chunkInfo.length;
+        readChunkEnd    = chunkInfo.dataPos + pl_AlignULL (chunkInfo.length, iff->common.headerInfo.alignment);
+        
+        if ((result = pl_File_SetPosition ((PlankFileRef)iff, chunkInfo.dataPos)) != PlankResult_OK) goto exit;
         
         if ((readChunkID.fcc == pl_FourCharCode ("desc")) ||
             (readChunkID.fcc == pl_FourCharCode ("strg")) ||
             (readChunkID.fcc == pl_FourCharCode ("data")))
         {
             // already done...
-            goto next;
+            continue;
         }
         else if ((readChunkID.fcc == pl_FourCharCode ("mark")) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_CUEPOINTS))
         {
@@ -2060,7 +2185,7 @@ PlankResult pl_AudioFileReader_CAF_ParseMetaData (PlankAudioFileReaderRef p)
         }
         else if ((readChunkID.fcc == pl_FourCharCode ("ovvw")) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_OVERVIEW))
         {
-            goto next;
+            continue;
         }
         else if ((readChunkID.fcc != iff->common.headerInfo.junkID.fcc) && (p->metaDataIOFlags & PLANKAUDIOFILEMETADATA_IOFLAGS_CUSTOM))
         {
@@ -2083,10 +2208,6 @@ PlankResult pl_AudioFileReader_CAF_ParseMetaData (PlankAudioFileReaderRef p)
                 if ((result = pl_AudioFileMetaData_AddFormatSpecificBlock (p->metaData, block)) != PlankResult_OK) goto exit;
             }
         }
-        
-    next:
-        if ((result = pl_File_SetPosition ((PlankFileRef)iff, readChunkEnd)) != PlankResult_OK) goto exit;
-        pos = readChunkEnd;
     }
     
 exit:
@@ -2587,6 +2708,292 @@ static const char* pl_OggTagCompare (const char *source, const char *tag)
     return source + n;
 }
 
+typedef struct PlankOggSeekPoint
+{
+    PlankLL offset;     // the byte offset of the start of the page
+    PlankLL granule;    // the granule position at the end of the page
+} PlankOggSeekPoint;
+
+/* The seek table is only made when it is first needed so opening a file doesn't 
+ read every page of it. */
+typedef struct PlankOggSeekTable
+{
+    PlankDynamicArray points;
+    PlankDynamicArray path;   // the audio file's path, empty if it wasn't opened from one
+    PlankB ready;
+} PlankOggSeekTable;
+
+typedef PlankOggSeekTable* PlankOggSeekTableRef;
+
+/* Reads the header of every page in the file to find the offset and end granule 
+ of each page. Only pages that finish a packet are added. The table is left empty
+ for chained or multiplexed files (i.e., more than one serial number) so these
+ fall back to the seeking in the codec libraries. The file position is restored. */
+static PlankResult pl_OggFile_BuildSeekTable (PlankFileRef p, PlankDynamicArrayRef table)
+{
+    PlankResult result;
+    PlankLL original, offset, granule;
+    PlankOggSeekPoint point;
+    PlankUC header[27];
+    PlankUC lacing[255];
+    PlankUI serial, firstSerial;
+    int bytesRead, numSegments, pageSize, i;
+    
+    result = PlankResult_OK;
+    
+    if (! pl_File_IsPositionable (p))
+        goto exit;
+    
+    if ((result = pl_File_GetPosition (p, &original)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_SetSize (table, 0)) != PlankResult_OK) goto exit;
+    
+    offset = 0;
+    firstSerial = 0;
+    
+    while (PLANK_TRUE)
+    {
+        if ((result = pl_File_SetPosition (p, offset)) != PlankResult_OK) break;
+        
+        result = pl_File_Read (p, header, 27, &bytesRead);
+        
+        if ((bytesRead < 27) || (memcmp (header, "OggS", 4) != 0))
+            break;
+        
+        numSegments = header[26];
+        result = pl_File_Read (p, lacing, numSegments, &bytesRead);
+        
+        if (bytesRead < numSegments)
+            break;
+        
+        serial = (PlankUI)header[14] | ((PlankUI)header[15] << 8) | ((PlankUI)header[16] << 16) | ((PlankUI)header[17] << 24);
+        
+        if (offset == 0)
+        {
+            firstSerial = serial;
+        }
+        else if (serial != firstSerial)
+        {
+            pl_DynamicArray_SetSize (table, 0);
+            break;
+        }
+        
+        granule = 0;
+        
+        for (i = 7; i >= 0; --i)
+            granule = (granule << 8) | (PlankLL)header[6 + i];
+        
+        if (granule > 0) // -1 for pages that don't finish a packet, 0 for the header pages
+        {
+            point.offset  = offset;
+            point.granule = granule;
+            
+            if ((result = pl_DynamicArray_AddItem (table, &point)) != PlankResult_OK) goto exit;
+        }
+        
+        pageSize = 27 + numSegments;
+        
+        for (i = 0; i < numSegments; ++i)
+            pageSize += lacing[i];
+        
+        offset += pageSize;
+    }
+    
+    result = pl_File_SetPosition (p, original);
+    
+exit:
+    return result;
+}
+
+static void pl_OggFile_GetSeekTablePath (PlankDynamicArrayRef path, const char* filepath)
+{
+    pl_DynamicArray_SetAsText (path, filepath);
+    pl_DynamicArray_AppendText (path, PLANKAUDIOFILE_SEEKTABLE_EXTENSION);
+}
+
+/* Loads a seek table that was written next to the file with pl_AudioFileReader_WriteSeekTable().
+ The table is only used if the size and modification time of the audio file still match. */
+static PlankResult pl_OggFile_LoadSeekTable (PlankDynamicArrayRef table, const char* filepath)
+{
+    PlankResult result;
+    PlankDynamicArray path;
+    PlankFile file;
+    PlankFourCharCode fcc;
+    PlankOggSeekPoint* points;
+    PlankLL fileSize, modificationTime, storedSize, storedTime;
+    int version, numPoints, i;
+    
+    pl_DynamicArray_Init (&path);
+    pl_File_Init (&file);
+    
+    if ((result = pl_FileGetInfo (filepath, &fileSize, &modificationTime)) != PlankResult_OK) goto exit;
+    
+    pl_OggFile_GetSeekTablePath (&path, filepath);
+    
+    if (! pl_FileExists ((const char*)pl_DynamicArray_GetArray (&path), PLANK_FALSE))
+    {
+        result = PlankResult_FileReadError;
+        goto exit;
+    }
+    
+    if ((result = pl_File_OpenBinaryRead (&file, (const char*)pl_DynamicArray_GetArray (&path), PLANK_FALSE, PLANK_FALSE)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_ReadFourCharCode (&file, &fcc)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_ReadI (&file, &version)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_ReadLL (&file, &storedSize)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_ReadLL (&file, &storedTime)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_ReadI (&file, &numPoints)) != PlankResult_OK) goto exit;
+    
+    if ((fcc != pl_FourCharCode (PLANKAUDIOFILE_SEEKTABLE_ID)) || 
+        (version != PLANKAUDIOFILE_SEEKTABLE_VERSION) ||
+        (storedSize != fileSize) || (storedTime != modificationTime) || 
+        (numPoints < 0))
+    {
+        result = PlankResult_FileReadError;
+        goto exit;
+    }
+    
+    if ((result = pl_DynamicArray_SetSize (table, numPoints)) != PlankResult_OK) goto exit;
+    
+    points = (PlankOggSeekPoint*)pl_DynamicArray_GetArray (table);
+    
+    for (i = 0; i < numPoints; ++i)
+    {
+        if ((result = pl_File_ReadLL (&file, &points[i].offset)) != PlankResult_OK) goto exit;
+        if ((result = pl_File_ReadLL (&file, &points[i].granule)) != PlankResult_OK) goto exit;
+    }
+    
+    result = PlankResult_OK;
+    
+exit:
+    if (result != PlankResult_OK)
+        pl_DynamicArray_SetSize (table, 0);
+    
+    pl_File_DeInit (&file);
+    pl_DynamicArray_DeInit (&path);
+    return result;
+}
+
+static PlankResult pl_OggFile_InitSeekTable (PlankOggSeekTableRef table, const char* filepath)
+{
+    PlankResult result;
+    
+    table->ready = PLANK_FALSE;
+    
+    if ((result = pl_DynamicArray_InitWithItemSizeAndCapacity (&table->points, sizeof (PlankOggSeekPoint), 64)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_Init (&table->path)) != PlankResult_OK) goto exit;
+    
+    if (filepath)
+        result = pl_DynamicArray_SetAsText (&table->path, filepath);
+    
+exit:
+    return result;
+}
+
+static PlankResult pl_OggFile_DeInitSeekTable (PlankOggSeekTableRef table)
+{
+    PlankResult result;
+    
+    if ((result = pl_DynamicArray_DeInit (&table->points)) != PlankResult_OK) goto exit;
+    result = pl_DynamicArray_DeInit (&table->path);
+    
+exit:
+    return result;
+}
+
+/* Makes the seek table the first time it is needed, from the table written next
+ to the file if it is still up to date, otherwise by reading every page header. 
+ This is only tried once, if it fails the table stays empty and seeks fall back 
+ to the codec libraries. */
+static PlankResult pl_OggFile_PrepareSeekTable (PlankOggSeekTableRef table, PlankFileRef file)
+{
+    PlankResult result;
+    
+    result = PlankResult_OK;
+    
+    if (table->ready)
+        goto exit;
+    
+    table->ready = PLANK_TRUE;
+    
+    if ((pl_DynamicArray_GetSize (&table->path) > 0) &&
+        (pl_OggFile_LoadSeekTable (&table->points, (const char*)pl_DynamicArray_GetArray (&table->path)) == PlankResult_OK))
+        goto exit;
+    
+    if ((result = pl_OggFile_BuildSeekTable (file, &table->points)) != PlankResult_OK)
+        pl_DynamicArray_SetSize (&table->points, 0);
+    
+exit:
+    return result;
+}
+
+static PlankResult pl_OggFile_WriteSeekTable (PlankOggSeekTableRef seekTable, PlankFileRef audioFile, const char* filepath)
+{
+    PlankResult result;
+    PlankDynamicArray path;
+    PlankFile file;
+    PlankOggSeekPoint* points;
+    PlankDynamicArrayRef table;
+    PlankLL fileSize, modificationTime;
+    int numPoints, i;
+    
+    pl_DynamicArray_Init (&path);
+    pl_File_Init (&file);
+    
+    table = &seekTable->points;
+    
+    if ((result = pl_OggFile_PrepareSeekTable (seekTable, audioFile)) != PlankResult_OK) goto exit;
+    if ((result = pl_FileGetInfo (filepath, &fileSize, &modificationTime)) != PlankResult_OK) goto exit;
+    
+    pl_OggFile_GetSeekTablePath (&path, filepath);
+    numPoints = (int)pl_DynamicArray_GetSize (table);
+    points = (PlankOggSeekPoint*)pl_DynamicArray_GetArray (table);
+    
+    if ((result = pl_File_OpenBinaryWrite (&file, (const char*)pl_DynamicArray_GetArray (&path), PLANK_FALSE, PLANK_TRUE, PLANK_FALSE)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteFourCharCode (&file, pl_FourCharCode (PLANKAUDIOFILE_SEEKTABLE_ID))) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteI (&file, PLANKAUDIOFILE_SEEKTABLE_VERSION)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteLL (&file, fileSize)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteLL (&file, modificationTime)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteI (&file, numPoints)) != PlankResult_OK) goto exit;
+    
+    for (i = 0; i < numPoints; ++i)
+    {
+        if ((result = pl_File_WriteLL (&file, points[i].offset)) != PlankResult_OK) goto exit;
+        if ((result = pl_File_WriteLL (&file, points[i].granule)) != PlankResult_OK) goto exit;
+    }
+    
+exit:
+    pl_File_DeInit (&file);
+    pl_DynamicArray_DeInit (&path);
+    return result;
+}
+
+/* Finds the last page that starts at or before a granule position. 
+ @return The index of the page or -1 if the table is empty. */
+static int pl_OggFile_FindSeekPoint (PlankDynamicArrayRef table, const PlankLL granule)
+{
+    PlankOggSeekPoint* points;
+    int low, high, mid;
+    
+    points = (PlankOggSeekPoint*)pl_DynamicArray_GetArray (table);
+    high = (int)pl_DynamicArray_GetSize (table);
+    low = 0;
+    
+    if (high == 0)
+        return -1;
+    
+    // find the first page that ends after the granule, it starts where the previous one ended
+    while (low < high)
+    {
+        mid = (low + high) / 2;
+        
+        if (points[mid].granule <= granule)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    
+    return pl_MinI (low, (int)pl_DynamicArray_GetSize (table) - 1);
+}
+
 static PlankResult pl_AudioFileReader_OggFile_ParseComment (PlankAudioFileReaderRef p, const char* comment)
 {
     PlankAudioFileCuePointRef newCuePoint;
@@ -2733,6 +3140,11 @@ typedef struct PlankOggVorbisFileReader
     int bufferFrames;
     PlankLL totalFramesRead;
     int bitStream;
+    PlankLL framePosition;
+    PlankOggSeekTable seekTable;
+    PlankDynamicArray lap;
+    int lapFrames;
+    int lapPosition;
 } PlankOggVorbisFileReader;
 
 typedef PlankOggVorbisFileReader* PlankOggVorbisFileReaderRef;
@@ -2742,6 +3154,8 @@ int pl_OggVorbisFileReader_SeekCallback (PlankP ref, PlankLL offset, int code);
 int pl_OggVorbisFileReader_CloseCallback (PlankP ref);
 long pl_OggVorbisFileReader_TellCallback (PlankP ref);
 
+static PlankResult pl_AudioFileReader_OggVorbis_InitSeeking (PlankAudioFileReaderRef p, const char* filepath);
+
 
 PlankResult pl_AudioFileReader_OggVorbis_Open  (PlankAudioFileReaderRef p, const char* filepath)
 {
@@ -2827,6 +3241,8 @@ PlankResult pl_AudioFileReader_OggVorbis_Open  (PlankAudioFileReaderRef p, const
     p->setFramePositionFunction = (PlankM)pl_AudioFileReader_OggVorbis_SetFramePosition;
     p->getFramePositionFunction = (PlankM)pl_AudioFileReader_OggVorbis_GetFramePosition;
     
+    if ((result = pl_AudioFileReader_OggVorbis_InitSeeking (p, filepath)) != PlankResult_OK) goto exit;
+    
     if (p->metaData)
     {
         if ((result = pl_AudioFileReader_OggVorbis_ParseMetaData (p)) != PlankResult_OK) goto exit;
@@ -2938,6 +3354,8 @@ PlankResult pl_AudioFileReader_OggVorbis_OpenWithFile  (PlankAudioFileReaderRef
     p->setFramePositionFunction = (PlankM)pl_AudioFileReader_OggVorbis_SetFramePosition;
     p->getFramePositionFunction = (PlankM)pl_AudioFileReader_OggVorbis_GetFramePosition;
     
+    if ((result = pl_AudioFileReader_OggVorbis_InitSeeking (p, PLANK_NULL)) != PlankResult_OK) goto exit;
+    
     if (p->metaData)
     {
         if ((result = pl_AudioFileReader_OggVorbis_ParseMetaData (p)) != PlankResult_OK) goto exit;
@@ -2971,6 +3389,8 @@ PlankResult pl_AudioFileReader_OggVorbis_Close (PlankAudioFileReaderRef p)
     }
     
     if ((result = pl_DynamicArray_DeInit (&ogg->buffer)) != PlankResult_OK) goto exit;
+    if ((result = pl_OggFile_DeInitSeekTable (&ogg->seekTable)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_DeInit (&ogg->lap)) != PlankResult_OK) goto exit;
 
     pl_Memory_Free (m, ogg);
     p->peer = PLANK_NULL;
@@ -2979,6 +3399,30 @@ exit:
     return result;
 }
 
+/* Crossfade the frames from before the last seek into the new frames, this uses
+ the same window and length as ov_pcm_seek_lap(). */
+static void pl_OggVorbisFileReader_Splice (PlankOggVorbisFileReaderRef ogg, float* data, const int numFrames, const int numChannels)
+{
+    const float* lap;
+    float w, wd;
+    int i, j, n;
+    
+    lap = (const float*)pl_DynamicArray_GetArray (&ogg->lap) + ogg->lapPosition * numChannels;
+    n = pl_MinI (numFrames, ogg->lapFrames - ogg->lapPosition);
+    
+    for (i = 0; i < n; ++i)
+    {
+        w = pl_SinF (0.5f * PLANK_PI_F * (ogg->lapPosition + i + 0.5f) / ogg->lapFrames);
+        w = pl_SinF (0.5f * PLANK_PI_F * w * w);
+        wd = w * w;
+        
+        for (j = 0; j < numChannels; ++j, ++data, ++lap)
+            *data = *data * wd + *lap * (1.0f - wd);
+    }
+    
+    ogg->lapPosition += n;
+}
+
 PlankResult pl_AudioFileReader_OggVorbis_ReadFrames (PlankAudioFileReaderRef p, const PlankB convertByteOrder, const int numFrames, void* data, int *framesReadOut)
 {    
     PlankResult result;
@@ -3089,6 +3533,10 @@ exit:
     
     ogg->bufferFrames   = bufferFramesRemaining;
     ogg->bufferPosition = bufferFramePosition;
+    ogg->framePosition += framesRead;
+    
+    if (ogg->lapPosition < ogg->lapFrames)
+        pl_OggVorbisFileReader_Splice (ogg, (float*)data, framesRead, numChannels);
 
     *framesReadOut = framesRead;
     
@@ -3096,35 +3544,189 @@ exit:
 }
 
 
+static PlankResult pl_AudioFileReader_OggVorbis_InitSeeking (PlankAudioFileReaderRef p, const char* filepath)
+{
+    PlankResult result;
+    PlankOggVorbisFileReaderRef ogg;
+    int lapLength, numChannels;
+    
+    ogg = (PlankOggVorbisFileReaderRef)p->peer;
+    numChannels = (int)pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo);
+    
+    ogg->framePosition = 0;
+    ogg->lapFrames     = 0;
+    ogg->lapPosition   = 0;
+    
+    // half a short block as in ov_pcm_seek_lap(), with room for the frames being captured
+    lapLength = vorbis_info_blocksize (ov_info (&ogg->oggVorbisFile, -1), 0) / 2;
+    
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&ogg->lap, sizeof (float), lapLength * 2 * numChannels, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    
+    result = pl_OggFile_InitSeekTable (&ogg->seekTable, filepath);
+    
+exit:
+    return result;
+}
+
+/* Skip the packets queued after a seek that aren't needed to decode the target,
+ this is the same as the loop in ov_pcm_seek() but only for the page already read.
+ @return true if the target is within the page, otherwise the skipped packets leave the
+ decoder unprimed and the page must be decoded normally. */
+static PlankB pl_OggVorbisFileReader_SkipPackets (OggVorbis_File* file, const PlankLL frameIndex)
+{
+    ogg_packet op;
+    vorbis_info* info;
+    long thisBlock, lastBlock;
+    int ret;
+    
+    info = file->vi + file->current_link;
+    lastBlock = 0;
+    
+    while ((ret = ogg_stream_packetpeek (&file->os, &op)) != 0)
+    {
+        if (ret < 0)
+            continue; // a hole, the partial packet is already dropped
+        
+        thisBlock = vorbis_packet_blocksize (info, &op);
+        
+        if (thisBlock < 0)
+        {
+            ogg_stream_packetout (&file->os, PLANK_NULL); // not an audio packet
+            continue;
+        }
+        
+        if (lastBlock)
+            file->pcm_offset += (lastBlock + thisBlock) >> 2;
+        
+        if ((file->pcm_offset + ((thisBlock + vorbis_info_blocksize (info, 1)) >> 2)) >= frameIndex)
+            return PLANK_TRUE;
+        
+        // track the packet without decoding it
+        ogg_stream_packetout (&file->os, PLANK_NULL);
+        vorbis_synthesis_trackonly (&file->vb, &op);
+        vorbis_synthesis_blockin (&file->vd, &file->vb);
+        
+        if (op.granulepos > -1)
+            file->pcm_offset = pl_MaxLL (op.granulepos - file->pcmlengths[file->current_link * 2], 0);
+        
+        lastBlock = thisBlock;
+    }
+    
+    return PLANK_FALSE;
+}
+
+/* Jump straight to the page before the target using the seek table and decode up to it.
+ @return 0 on success, otherwise the caller should use the (slower) seek in vorbisfile. */
+static int pl_OggVorbisFileReader_SeekWithTable (PlankOggVorbisFileReaderRef ogg, const PlankLL frameIndex)
+{
+    OggVorbis_File* file;
+    PlankOggSeekPoint* points;
+    float** pcm;
+    PlankLL position;
+    int index, attempts, framesThisTime, bitStream;
+    
+    file = &ogg->oggVorbisFile;
+    
+    if (pl_OggFile_PrepareSeekTable (&ogg->seekTable, (PlankFileRef)ogg) != PlankResult_OK)
+        return -1;
+    
+    points = (PlankOggSeekPoint*)pl_DynamicArray_GetArray (&ogg->seekTable.points);
+    index = pl_OggFile_FindSeekPoint (&ogg->seekTable.points, frameIndex);
+    
+    for (attempts = 0; (index >= 0) && (attempts < 4); ++attempts, --index)
+    {
+        if (ov_raw_seek (file, points[index].offset) != 0)
+            return -1;
+        
+        position = ov_pcm_tell (file);
+        
+        if ((position >= 0) && (position <= frameIndex))
+        {
+            if (file->ready_state >= INITSET)
+            {
+                if (! pl_OggVorbisFileReader_SkipPackets (file, frameIndex) &&
+                    (ov_raw_seek (file, points[index].offset) != 0))
+                    return -1;
+                
+                position = ov_pcm_tell (file);
+            }
+            
+            while (position < frameIndex)
+            {
+                framesThisTime = (int)ov_read_float (file, &pcm, (int)pl_MinLL (frameIndex - position, (PlankLL)4096), &bitStream);
+                
+                if (framesThisTime <= 0)
+                    return -1;
+                
+                position += framesThisTime;
+            }
+            
+            return 0;
+        }
+    }
+    
+    return -1;
+}
+
 PlankResult pl_AudioFileReader_OggVorbis_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex)
 {
+    PlankResult result;
     PlankOggVorbisFileReaderRef ogg;
-    int err;
+    PlankLL position;
+    float* lap;
+    int lapLength, numChannels, framesRead;
     
+    result = PlankResult_OK;
     ogg = (PlankOggVorbisFileReaderRef)p->peer;
-    err = ov_pcm_seek_lap (&ogg->oggVorbisFile, frameIndex); // should probably eventually do my own lapping in readframes?
     
-    if (err != 0)
-        return PlankResult_FileSeekFailed;
+    // regions set the position before every read so don't seek if we're already there
+    if (frameIndex == ogg->framePosition)
+        goto exit;
+    
+    if ((frameIndex < 0) || (frameIndex > p->numFrames))
+    {
+        result = PlankResult_FileSeekFailed;
+        goto exit;
+    }
+    
+    numChannels = (int)pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo);
+    lapLength   = (int)pl_DynamicArray_GetSize (&ogg->lap) / (2 * numChannels);
+    lap         = (float*)pl_DynamicArray_GetArray (&ogg->lap);
+    
+    // keep the frames that would have been read next to splice into the new position, fewer near the end
+    framesRead = 0;
+    pl_AudioFileReader_OggVorbis_ReadFrames (p, PLANK_FALSE, lapLength, lap + lapLength * numChannels, &framesRead);
+    pl_MemoryCopy (lap, lap + lapLength * numChannels, framesRead * p->formatInfo.bytesPerFrame);
     
     ogg->bufferFrames   = 0;
     ogg->bufferPosition = 0;
+    ogg->lapFrames      = 0;
+    ogg->lapPosition    = 0;
+
+    if (pl_OggVorbisFileReader_SeekWithTable (ogg, frameIndex) != 0)
+    {
+        if (ov_pcm_seek (&ogg->oggVorbisFile, frameIndex) != 0)
+        {
+            position = ov_pcm_tell (&ogg->oggVorbisFile);
+            ogg->framePosition = position < 0 ? 0 : position;
+            result = PlankResult_FileSeekFailed;
+            goto exit;
+        }
+    }
     
-    return PlankResult_OK;
+    ogg->framePosition = frameIndex;
+    ogg->lapFrames     = framesRead;
+    
+exit:
+    return result;
 }
 
 PlankResult pl_AudioFileReader_OggVorbis_GetFramePosition (PlankAudioFileReaderRef p, PlankLL *frameIndex)
 {
     PlankOggVorbisFileReaderRef ogg;
-    PlankLL pos;
     
     ogg = (PlankOggVorbisFileReaderRef)p->peer;
-    pos = ov_pcm_tell (&ogg->oggVorbisFile);
-    
-    if (pos < 0)
-        return PlankResult_FileSeekFailed;
-    
-    *frameIndex = pos;
+    *frameIndex = ogg->framePosition; // the decoder is ahead by the frames in the buffer
     
     return PlankResult_OK;
 }
@@ -3248,6 +3850,8 @@ typedef struct PlankOpusFileReader
     int bufferFrames;    
     PlankLL totalFramesRead;
     int link;
+    PlankLL framePosition;
+    PlankOggSeekTable seekTable;
 } PlankOpusFileReader;
 
 typedef PlankOpusFileReader* PlankOpusFileReaderRef;
@@ -3348,6 +3952,9 @@ PlankResult pl_AudioFileReader_Opus_Open  (PlankAudioFileReaderRef p, const char
     p->setFramePositionFunction = (PlankM)pl_AudioFileReader_Opus_SetFramePosition;
     p->getFramePositionFunction = (PlankM)pl_AudioFileReader_Opus_GetFramePosition;
     
+    opus->framePosition = 0;
+    if ((result = pl_OggFile_InitSeekTable (&opus->seekTable, filepath)) != PlankResult_OK) goto exit;
+    
     if (p->metaData)
     {
         if ((result = pl_AudioFileReader_Opus_ParseMetaData (p)) != PlankResult_OK) goto exit;
@@ -3466,6 +4073,9 @@ PlankResult pl_AudioFileReader_Opus_OpenWithFile  (PlankAudioFileReaderRef p, Pl
     p->setFramePositionFunction = (PlankM)pl_AudioFileReader_Opus_SetFramePosition;
     p->getFramePositionFunction = (PlankM)pl_AudioFileReader_Opus_GetFramePosition;
     
+    opus->framePosition = 0;
+    if ((result = pl_OggFile_InitSeekTable (&opus->seekTable, PLANK_NULL)) != PlankResult_OK) goto exit;
+    
     if (p->metaData)
     {
         if ((result = pl_AudioFileReader_Opus_ParseMetaData (p)) != PlankResult_OK) goto exit;
@@ -3492,6 +4102,7 @@ PlankResult pl_AudioFileReader_Opus_Close (PlankAudioFileReaderRef p)
     opus->oggOpusFile = PLANK_NULL;
     
     if ((result = pl_DynamicArray_DeInit (&opus->buffer)) != PlankResult_OK) goto exit;
+    if ((result = pl_OggFile_DeInitSeekTable (&opus->seekTable)) != PlankResult_OK) goto exit;
     
     pl_Memory_Free (m, opus);
     p->peer = PLANK_NULL;
@@ -3587,41 +4198,103 @@ exit:
     
     opus->bufferFrames   = bufferFramesRemaining;
     opus->bufferPosition = bufferFramePosition;
+    opus->framePosition += framesRead;
     
     *framesReadOut = framesRead;
     
     return result;
 }
 
+/* Jump straight to a page at least the pre-roll before the target using the seek 
+ table and decode up to the target.
+ @return 0 on success, otherwise the caller should use the (slower) seek in opusfile. */
+static int pl_OpusFileReader_SeekWithTable (PlankOpusFileReaderRef opus, const PlankLL frameIndex, const int numChannels)
+{
+    OggOpusFile* file;
+    PlankOggSeekPoint* points;
+    float* buffer;
+    PlankLL position, preRoll;
+    int index, attempts, framesThisTime, bufferSize;
+    
+    file     = opus->oggOpusFile;
+    
+    if (pl_OggFile_PrepareSeekTable (&opus->seekTable, (PlankFileRef)opus) != PlankResult_OK)
+        return -1;
+    
+    points   = (PlankOggSeekPoint*)pl_DynamicArray_GetArray (&opus->seekTable.points);
+    buffer   = (float*)pl_DynamicArray_GetArray (&opus->buffer);
+    bufferSize = (int)(pl_DynamicArray_GetSize (&opus->buffer) / sizeof (float));
+    preRoll  = PLANKAUDIOFILE_OPUS_PREROLL_MS * (PLANKAUDIOFILE_OPUS_DEFAULTSAMPLERATE / 1000);
+    
+    // granules include the pre-skip, op_raw_seek() discards the pre-roll itself so the page
+    // needs to start that far before the target
+    index = pl_OggFile_FindSeekPoint (&opus->seekTable.points, frameIndex + op_head (file, -1)->pre_skip - preRoll);
+    
+    for (attempts = 0; (index >= 0) && (attempts < 4); ++attempts, --index)
+    {
+        if (op_raw_seek (file, points[index].offset) != 0)
+            return -1;
+        
+        position = op_pcm_tell (file);
+        
+        if ((position >= 0) && (position <= frameIndex))
+        {
+            while (position < frameIndex)
+            {
+                framesThisTime = op_read_float (file, buffer, (int)pl_MinLL ((frameIndex - position) * numChannels, (PlankLL)bufferSize), PLANK_NULL);
+                
+                if (framesThisTime <= 0)
+                    return -1;
+                
+                position += framesThisTime;
+            }
+            
+            return 0;
+        }
+    }
+    
+    return -1;
+}
+
 PlankResult pl_AudioFileReader_Opus_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex)
 {
+    PlankResult result;
     PlankOpusFileReaderRef opus;
-    int err;
+    PlankLL position;
     
+    result = PlankResult_OK;
     opus = (PlankOpusFileReaderRef)p->peer;
-    err = op_pcm_seek (opus->oggOpusFile, frameIndex);
     
-    if (err != 0)
-        return PlankResult_FileSeekFailed;
+    // regions set the position before every read so don't seek if we're already there
+    if (frameIndex == opus->framePosition)
+        goto exit;
     
     opus->bufferFrames   = 0;
     opus->bufferPosition = 0;
     
-    return PlankResult_OK;
+    if (pl_OpusFileReader_SeekWithTable (opus, frameIndex, (int)pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo)) != 0)
+    {
+        if (op_pcm_seek (opus->oggOpusFile, frameIndex) != 0)
+        {
+            position = op_pcm_tell (opus->oggOpusFile);
+            opus->framePosition = position < 0 ? 0 : position;
+            result = PlankResult_FileSeekFailed;
+            goto exit;
+        }
+    }
+    
+    opus->framePosition = frameIndex;
+    
+exit:
+    return result;
 }
 
 PlankResult pl_AudioFileReader_Opus_GetFramePosition (PlankAudioFileReaderRef p, PlankLL *frameIndex)
 {
     PlankOpusFileReaderRef opus;
-    PlankLL pos;
     
     opus = (PlankOpusFileReaderRef)p->peer;
-    pos = op_pcm_tell (opus->oggOpusFile);
-    
-    if (pos < 0)
-        return PlankResult_FileSeekFailed;
-    
-    *frameIndex = pos;
+    *frameIndex = opus->framePosition; // the decoder is ahead by the frames in the buffer
     
     return PlankResult_OK;
 }
@@ -3740,6 +4413,23 @@ PlankLL pl_OpusFileReader_TellCallback (PlankP datasource)
 
 #endif // PLANK_OPUS
 
+PlankResult pl_AudioFileReader_WriteSeekTable (PlankAudioFileReaderRef p, const char* filepath)
+{
+    switch (p->format)
+    {
+#if PLANK_OGGVORBIS
+        case PLANKAUDIOFILE_FORMAT_OGGVORBIS:
+            return pl_OggFile_WriteSeekTable (&((PlankOggVorbisFileReaderRef)p->peer)->seekTable, (PlankFileRef)p->peer, filepath);
+#endif
+#if PLANK_OPUS
+        case PLANKAUDIOFILE_FORMAT_OPUS:
+            return pl_OggFile_WriteSeekTable (&((PlankOpusFileReaderRef)p->peer)->seekTable, (PlankFileRef)p->peer, filepath);
+#endif
+        default:
+            return PlankResult_AudioFileUnsupportedType;
+    }
+}
+
 // -- MultiFile Functions -- //////////////////////////////////////////////////
 
 #if PLANK_APPLE
@@ -95,6 +95,11 @@ PlankResult pl_AudioFileReader_OpenInternal (PlankAudioFileReaderRef p, const ch
  The AudioFileReader takes ownership of the file and zeros the incomming file object. */
 PlankResult pl_AudioFileReader_OpenWithFile (PlankAudioFileReaderRef p, PlankFileRef file, const PlankAudioFileMetaDataIOFlags metaDataIOFlags);
 
+/** Open a WAV, AIFF, AIFC, W64 or CAF file by mapping it into memory.
+ Readers opening the same path share one mapping. Frames can then be accessed 
+ in place using pl_AudioFileReader_GetFramesPointer(). */
+PlankResult pl_AudioFileReader_OpenMapped (PlankAudioFileReaderRef p, const char* filepath, const PlankAudioFileMetaDataIOFlags metaDataIOFlags);
+
 PlankResult pl_AudioFileReader_OpenWithAudioFileArray (PlankAudioFileReaderRef p, PlankDynamicArrayRef array, PlankB ownArray, const int multiMode, int* indexRef);
 
 typedef PlankResult (*PlankAudioFileReaderCustomNextFunction)(PlankP, PlankAudioFileReaderRef, PlankAudioFileReaderRef*);
@@ -184,6 +189,29 @@ PlankResult pl_AudioFileReader_GetFramePosition (PlankAudioFileReaderRef p, Plan
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_AudioFileReader_ReadFrames (PlankAudioFileReaderRef p, const PlankB convertByteOrder, const int numFrames, void* data, int* framesRead);
 
+/** Get a pointer to frames in place rather than copying them.
+ This only succeeds if the file was opened with pl_AudioFileReader_OpenMapped() (or from memory),
+ the samples are in the native byte order, they are 16 or 32-bit integers or 32 or 64-bit
+ floats and the data starts at an address aligned to the sample size. Otherwise it returns 
+ PlankResult_AudioFileUnsupportedType and pl_AudioFileReader_ReadFrames() should be used instead. The frame position is advanced past the frames returned.
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @param numFrames The maximum number of frames required.
+ @param data On return points to the first frame.
+ @param framesRead On return contains the number of frames available at that pointer.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileReader_GetFramesPointer (PlankAudioFileReaderRef p, const int numFrames, const void** data, int* framesRead);
+
+/** Write the seek table of an Ogg Vorbis or Opus file next to the file.
+ Ogg files are indexed on their first seek (or here) by reading the header of every 
+ page, this allows seeks to go straight to the right page rather than searching the file.
+ The table is written to the file's path with PLANKAUDIOFILE_SEEKTABLE_EXTENSION
+ appended and is loaded instead of indexing the file on later opens as long as 
+ the file's size and modification time haven't changed.
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @param filepath The path the audio file was opened from.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileReader_WriteSeekTable (PlankAudioFileReaderRef p, const char* filepath);
+
 PlankAudioFileMetaDataRef pl_AudioFileReader_GetMetaData (PlankAudioFileReaderRef p);
 
 PlankResult pl_AudioFileReader_SetName (PlankAudioFileReaderRef p, const char* text);
@@ -41,6 +41,12 @@
 #include "plank_File.h"
 #include "../maths/plank_Maths.h"
 #include "plank_MultiFileReader.h"
+#include "../core/plank_SpinLock.h"
+
+#if !PLANK_WIN
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
 
 // file callbacks
 
@@ -645,6 +651,277 @@ static PlankResult pl_FileMultiGetPositionCallback (PlankFileRef p, PlankLL* pos
 }
 
 
+// mapped callbacks, the views are shared between all files opened with the same path
+
+typedef struct PlankFileMapping
+{
+    struct PlankFileMapping* next;
+    PlankUC* data;
+    PlankLL size;
+    int refCount;
+#if PLANK_WIN
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+    char path[PLANKPATH_MAXLENGTH];
+} PlankFileMapping;
+
+static PlankFileMapping* pl_FileMappingList = PLANK_NULL;
+static PlankSpinLock pl_FileMappingLock; // zeroed so it starts unlocked
+
+static PlankFileMapping* pl_FileMappingMap (const char* filepath)
+{
+    PlankFileMapping* mapping;
+    void* data;
+    PlankLL size;
+#if PLANK_WIN
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+    LARGE_INTEGER fileSize;
+    
+    fileHandle = CreateFileA (filepath, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return PLANK_NULL;
+    
+    if (! GetFileSizeEx (fileHandle, &fileSize) || (fileSize.QuadPart <= 0))
+    {
+        CloseHandle (fileHandle);
+        return PLANK_NULL;
+    }
+    
+    size = (PlankLL)fileSize.QuadPart;
+    mappingHandle = CreateFileMappingA (fileHandle, 0, PAGE_READONLY, 0, 0, 0);
+    
+    if (mappingHandle == PLANK_NULL)
+    {
+        CloseHandle (fileHandle);
+        return PLANK_NULL;
+    }
+    
+    data = MapViewOfFile (mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    
+    if (data == PLANK_NULL)
+    {
+        CloseHandle (mappingHandle);
+        CloseHandle (fileHandle);
+        return PLANK_NULL;
+    }
+#else
+    int fd;
+    struct stat st;
+    
+    fd = open (filepath, O_RDONLY);
+    
+    if (fd < 0)
+        return PLANK_NULL;
+    
+    if ((fstat (fd, &st) != 0) || (st.st_size <= 0))
+    {
+        close (fd);
+        return PLANK_NULL;
+    }
+    
+    size = (PlankLL)st.st_size;
+    data = mmap (0, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd); // the mapping keeps its own reference to the file
+    
+    if (data == MAP_FAILED)
+        return PLANK_NULL;
+#endif
+    
+    mapping = (PlankFileMapping*)pl_Memory_AllocateBytes (pl_MemoryGlobal(), sizeof (PlankFileMapping));
+    
+    if (mapping != PLANK_NULL)
+    {
+        pl_MemoryZero (mapping, sizeof (PlankFileMapping));
+        mapping->data = (PlankUC*)data;
+        mapping->size = size;
+        strncpy (mapping->path, filepath, PLANKPATH_MAXLENGTH - 1);
+#if PLANK_WIN
+        mapping->fileHandle = fileHandle;
+        mapping->mappingHandle = mappingHandle;
+#endif
+    }
+    else
+    {
+#if PLANK_WIN
+        UnmapViewOfFile (data);
+        CloseHandle (mappingHandle);
+        CloseHandle (fileHandle);
+#else
+        munmap (data, (size_t)size);
+#endif
+    }
+    
+    return mapping;
+}
+
+static void pl_FileMappingUnmap (PlankFileMapping* mapping)
+{
+#if PLANK_WIN
+    UnmapViewOfFile (mapping->data);
+    CloseHandle (mapping->mappingHandle);
+    CloseHandle (mapping->fileHandle);
+#else
+    munmap (mapping->data, (size_t)mapping->size);
+#endif
+    
+    pl_Memory_Free (pl_MemoryGlobal(), mapping);
+}
+
+// mappings are keyed by the absolute path with any links resolved so different 
+// spellings of the same path share one mapping
+static PlankB pl_FileMappingCanonicalPath (const char* filepath, char* canonicalPath)
+{
+#if PLANK_WIN
+    DWORD length;
+    
+    length = GetFullPathNameA (filepath, PLANKPATH_MAXLENGTH, canonicalPath, 0);
+    return ((length > 0) && (length < PLANKPATH_MAXLENGTH)) ? PLANK_TRUE : PLANK_FALSE;
+#else
+    char* resolved;
+    PlankB success;
+    
+    if ((resolved = realpath (filepath, PLANK_NULL)) == PLANK_NULL)
+        return PLANK_FALSE;
+    
+    success = (strlen (resolved) < PLANKPATH_MAXLENGTH) ? PLANK_TRUE : PLANK_FALSE;
+    
+    if (success)
+        strcpy (canonicalPath, resolved);
+    
+    free (resolved);
+    return success;
+#endif
+}
+
+// call with the lock held
+static PlankFileMapping* pl_FileMappingFind (const char* canonicalPath)
+{
+    PlankFileMapping* mapping;
+    
+    mapping = pl_FileMappingList;
+    
+    while ((mapping != PLANK_NULL) && (strcmp (mapping->path, canonicalPath) != 0))
+        mapping = mapping->next;
+    
+    return mapping;
+}
+
+static PlankFileMapping* pl_FileMappingAcquire (const char* filepath)
+{
+    char canonicalPath[PLANKPATH_MAXLENGTH];
+    PlankFileMapping* mapping;
+    PlankFileMapping* newMapping;
+    
+    if (! pl_FileMappingCanonicalPath (filepath, canonicalPath))
+        return PLANK_NULL;
+    
+    pl_SpinLock_Lock (&pl_FileMappingLock);
+    
+    if ((mapping = pl_FileMappingFind (canonicalPath)) != PLANK_NULL)
+        mapping->refCount++;
+    
+    pl_SpinLock_Unlock (&pl_FileMappingLock);
+    
+    if (mapping != PLANK_NULL)
+        return mapping;
+    
+    // map outside the lock as this can block on I/O, then publish it unless 
+    // another thread mapped the same file in the meantime
+    if ((newMapping = pl_FileMappingMap (canonicalPath)) == PLANK_NULL)
+        return PLANK_NULL;
+    
+    pl_SpinLock_Lock (&pl_FileMappingLock);
+    
+    if ((mapping = pl_FileMappingFind (canonicalPath)) == PLANK_NULL)
+    {
+        mapping = newMapping;
+        mapping->next = pl_FileMappingList;
+        pl_FileMappingList = mapping;
+        newMapping = PLANK_NULL;
+    }
+    
+    mapping->refCount++;
+    
+    pl_SpinLock_Unlock (&pl_FileMappingLock);
+    
+    if (newMapping != PLANK_NULL)
+        pl_FileMappingUnmap (newMapping);
+    
+    return mapping;
+}
+
+static PlankResult pl_FileMappingRelease (const void* data)
+{
+    PlankFileMapping** link;
+    PlankFileMapping* mapping;
+    PlankFileMapping* unusedMapping;
+    PlankResult result;
+    
+    result = PlankResult_FileCloseFailed;
+    unusedMapping = PLANK_NULL;
+    
+    pl_SpinLock_Lock (&pl_FileMappingLock);
+    
+    for (link = &pl_FileMappingList; *link != PLANK_NULL; link = &(*link)->next)
+    {
+        mapping = *link;
+        
+        if (mapping->data == data)
+        {
+            if (--mapping->refCount == 0)
+            {
+                *link = mapping->next;
+                unusedMapping = mapping;
+            }
+            
+            result = PlankResult_OK;
+            break;
+        }
+    }
+    
+    pl_SpinLock_Unlock (&pl_FileMappingLock);
+    
+    // unmap outside the lock too
+    if (unusedMapping != PLANK_NULL)
+        pl_FileMappingUnmap (unusedMapping);
+    
+    return result;
+}
+
+static PlankResult pl_FileMappedOpenCallback (PlankFileRef p)
+{
+    if (p->mode & (PLANKFILE_WRITE | PLANKFILE_APPEND | PLANKFILE_NEW))
+        return PlankResult_FileModeInvalid;
+    
+    return PlankResult_OK;
+}
+
+static PlankResult pl_FileMappedCloseCallback (PlankFileRef p)
+{
+    PlankResult result;
+    
+    result = pl_FileMappingRelease (p->stream);
+    pl_File_Init (p);
+    
+    return result;
+}
+
+static PlankResult pl_FileMappedClearCallback (PlankFileRef p)
+{
+    (void)p;
+    return PlankResult_FileWriteError;
+}
+
+static PlankResult pl_FileMappedWriteCallback (PlankFileRef p, const void* data, const int maximumBytes)
+{
+    (void)p;
+    (void)data;
+    (void)maximumBytes;
+    return PlankResult_FileWriteError;
+}
 
 // global
 
@@ -668,6 +945,30 @@ PlankB pl_FileExists (const char* filepath, const PlankB isDirectory)
     return isDirectory ? (st.st_mode & S_IFDIR ? PLANK_TRUE : PLANK_FALSE) : (st.st_mode & S_IFREG ? PLANK_TRUE : PLANK_FALSE);
 }
 
+PlankResult pl_FileGetInfo (const char* filepath, PlankLL* size, PlankLL* modificationTime)
+{
+    struct stat st;
+    
+    if ((stat (filepath, &st) != 0) || ! (st.st_mode & S_IFREG))
+        return PlankResult_FilePathInvalid;
+    
+    if (size != PLANK_NULL)
+        *size = (PlankLL)st.st_size;
+    
+    if (modificationTime != PLANK_NULL)
+    {
+#if PLANK_APPLE
+        *modificationTime = (PlankLL)st.st_mtimespec.tv_sec * 1000000000LL + (PlankLL)st.st_mtimespec.tv_nsec;
+#elif PLANK_LINUX || PLANK_ANDROID
+        *modificationTime = (PlankLL)st.st_mtim.tv_sec * 1000000000LL + (PlankLL)st.st_mtim.tv_nsec;
+#else
+        *modificationTime = (PlankLL)st.st_mtime * 1000000000LL; // whole seconds only
+#endif
+    }
+    
+    return PlankResult_OK;
+}
+
 static int pl_mkdir (const char* filepath)
 {
 #if (defined (_WIN32) || defined (_WIN64) || defined (WIN64))
@@ -1118,6 +1419,86 @@ exit:
     return result;    
 }
 
+PlankResult pl_File_OpenMapped (PlankFileRef p, const char* filepath, const int mode)
+{
+    PlankResult result;
+    PlankFileMapping* mapping;
+    
+    result = PlankResult_OK;
+    
+    if (p->stream != 0)
+    {
+        if ((result = pl_File_Close (p)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    if ((filepath == 0) || (filepath[0] == 0))
+    {
+        result = PlankResult_FilePathInvalid;
+        goto exit;
+    }
+    
+    if (strlen (filepath) >= PLANKPATH_MAXLENGTH)
+    {
+        result = PlankResult_FilePathInvalid; // the path wouldn't fit with its terminator
+        goto exit;
+    }
+    
+    if (mode & (PLANKFILE_WRITE | PLANKFILE_APPEND | PLANKFILE_NEW))
+    {
+        result = PlankResult_FileModeInvalid; // mappings are read only
+        goto exit;
+    }
+    
+    if ((mapping = pl_FileMappingAcquire (filepath)) == PLANK_NULL)
+    {
+        result = PlankResult_FileOpenFailed;
+        goto exit;
+    }
+    
+    strncpy (p->path, filepath, PLANKPATH_MAXLENGTH - 1);
+    p->path[PLANKPATH_MAXLENGTH - 1] = '\0';
+    p->stream = mapping->data;
+    p->size = mapping->size;
+    p->position = 0;
+    p->mode = mode;
+    p->type = PLANKFILE_STREAMTYPE_MAPPED;
+    
+    result = pl_File_SetFunction (p,
+                                  pl_FileMappedOpenCallback,
+                                  pl_FileMappedCloseCallback,
+                                  pl_FileMappedClearCallback,
+                                  pl_FileMemoryGetStatusCallback,
+                                  pl_FileMemoryReadCallback,
+                                  pl_FileMappedWriteCallback,
+                                  pl_FileMemorySetPositionCallback,
+                                  pl_FileMemoryGetPositionCallback);
+    
+    if (result != PlankResult_OK) goto exit;
+    
+    result = (p->openFunction) (p);
+    if (result != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_File_GetDataPointer (PlankFileRef p, const void** data, PlankLL* bytesAvailable)
+{
+    if ((p->type != PLANKFILE_STREAMTYPE_MAPPED) && (p->type != PLANKFILE_STREAMTYPE_MEMORY))
+        return PlankResult_FileReadError;
+    
+    if (p->stream == PLANK_NULL)
+        return PlankResult_FileReadError;
+    
+    *data = (const PlankUC*)p->stream + p->position;
+    
+    if (bytesAvailable != PLANK_NULL)
+        *bytesAvailable = p->size - p->position;
+    
+    return PlankResult_OK;
+}
+
 #define PLANKFILE_COPYCHUNKSIZE 512
 
 PlankResult pl_File_Copy (PlankFileRef p, PlankFileRef source, const PlankLL size)
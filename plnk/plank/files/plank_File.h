@@ -105,6 +105,7 @@ typedef struct PlankFile* PlankFileRef;
 #define PLANKFILE_STREAMTYPE_DYNAMICARRAY   3
 #define PLANKFILE_STREAMTYPE_NETWORK        4
 #define PLANKFILE_STREAMTYPE_MULTI          5
+#define PLANKFILE_STREAMTYPE_MAPPED         6
 #define PLANKFILE_STREAMTYPE_OTHER          999
 
 #define PLANKFILE_SETPOSITION_ABSOLUTE       SEEK_SET
@@ -115,6 +116,14 @@ typedef struct PlankFile* PlankFileRef;
 PlankResult pl_FileErase (const char* filepath);
 
 PlankB pl_FileExists (const char* filepath, const PlankB isDirectory);
+
+/** Get the size and modification time of a file without opening it. 
+ @param filepath The path to the file.
+ @param size The size of the file in bytes is returned here, use 0 to ignore.
+ @param modificationTime The time of the last modification in nanoseconds since 1970 is returned here, use 0 to ignore.
+                         This is as precise as the filesystem allows so a file rewritten within a second still differs.
+ @return PlankResult_FilePathInvalid if the file doesn't exist, otherwise PlankResult_OK. */
+PlankResult pl_FileGetInfo (const char* filepath, PlankLL* size, PlankLL* modificationTime);
 PlankResult pl_FileMakeDirectory (const char* filepath);
 
 
@@ -231,6 +240,23 @@ PlankResult pl_File_OpenDynamicArray (PlankFileRef p, PlankDynamicArrayRef memor
 
 PlankResult pl_File_OpenMulti (PlankFileRef p, PlankMulitFileReaderRef multi, const int mode);
 
+/** Open a file read-only by mapping it into memory.
+ Mappings are shared so any number of file objects opening the same path use 
+ a single view of the file which is unmapped when the last of them is closed.
+ @param p The <i>Plank %File</i> object. 
+ @param filepath The filepath of the file to open.
+ @param mode A bit mask code to identify the mode in which to open the file, this must not include PLANKFILE_WRITE.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_File_OpenMapped (PlankFileRef p, const char* filepath, const int mode);
+
+/** Get a pointer to the data at the current position of a mapped or memory file.
+ This does not move the read/write pointer.
+ @param p The <i>Plank %File</i> object. 
+ @param data On return points to the data at the current position.
+ @param bytesAvailable On return contains the number of bytes from there to the end of the file (pass PLANK_NULL to ignore this).
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_File_GetDataPointer (PlankFileRef p, const void** data, PlankLL* bytesAvailable);
+
 PlankResult pl_File_Copy (PlankFileRef p, PlankFileRef source, const PlankLL size);
 
 PlankResult pl_File_Clear (PlankFileRef p);
@@ -130,6 +130,9 @@ PlankResult pl_IffFileReader_DeInit (PlankIffFileReaderRef p)
     
     if ((result = pl_File_DeInit ((PlankFileRef)p)) != PlankResult_OK)
         goto exit;
+    
+    if ((result = pl_DynamicArray_DeInit (&p->chunkInfos)) != PlankResult_OK)
+        goto exit;
 
     pl_MemoryZero (p, sizeof (PlankIffFileReader));
 
@@ -165,6 +168,14 @@ PlankFileRef pl_IffFileReader_GetFile (PlankIffFileReaderRef p)
     return (PlankFileRef)p;
 }
 
+static void pl_IffFileReader_ClearChunkInfos (PlankIffFileReaderRef p)
+{
+    p->chunkInfosValid = PLANK_FALSE;
+    
+    if (pl_DynamicArray_GetItemSize (&p->chunkInfos) > 0)
+        pl_DynamicArray_SetSize (&p->chunkInfos, 0);
+}
+
 static PlankResult pl_IffFileReader_ParseMain (PlankIffFileReaderRef p)
 {
     PlankResult result = PlankResult_OK;
@@ -247,6 +258,8 @@ exit:
 PlankResult pl_IffFileReader_Open (PlankIffFileReaderRef p, const char* filepath)
 {
     PlankResult result = PlankResult_OK;
+    
+    pl_IffFileReader_ClearChunkInfos (p);
         
     result = pl_File_OpenBinaryRead ((PlankFileRef)p, 
                                      filepath, 
@@ -281,6 +294,7 @@ PlankResult pl_IffFileReader_OpenWithFile (PlankIffFileReaderRef p, PlankFileRef
         goto exit;
     }
     
+    pl_IffFileReader_ClearChunkInfos (p);
     pl_MemoryCopy ((PlankFileRef)p, file, sizeof (PlankFile));
     pl_MemoryZero (file, sizeof (PlankFile));
 
@@ -295,6 +309,8 @@ PlankResult pl_IffFileReader_Close (PlankIffFileReaderRef p)
     if (p == PLANK_NULL)
         return PlankResult_FileCloseFailed;
     
+    pl_IffFileReader_ClearChunkInfos (p);
+    
     return pl_File_Close ((PlankFileRef)p);
 }
 
@@ -335,6 +351,7 @@ PlankResult pl_IffFileReader_SetEndian (PlankIffFileReaderRef p, const PlankB is
     if (pl_File_IsBigEndian ((PlankFileRef)p) != (PlankB)(!!isBigEndian))
     {
         pl_File_SetEndian ((PlankFileRef)p, isBigEndian);
+        pl_IffFileReader_ClearChunkInfos (p); // the lengths would be read differently
         
         if (p->common.headerInfo.lengthSize == 4)
         {
@@ -352,12 +369,145 @@ PlankResult pl_IffFileReader_SetEndian (PlankIffFileReaderRef p, const PlankB is
     return PlankResult_OK;
 }
 
+PlankResult pl_IffFileReader_IndexChunks (PlankIffFileReaderRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankIffFileReaderChunkInfo info;
+    PlankLL mainEnd, chunkEnd, pos;
+    
+    if (p->chunkInfosValid)
+        goto exit;
+    
+    if (pl_DynamicArray_GetItemSize (&p->chunkInfos) == 0)
+    {
+        if ((result = pl_DynamicArray_InitWithItemSizeAndCapacity (&p->chunkInfos, sizeof (PlankIffFileReaderChunkInfo), 16)) != PlankResult_OK) goto exit;
+    }
+    else
+    {
+        if ((result = pl_DynamicArray_SetSize (&p->chunkInfos, 0)) != PlankResult_OK) goto exit;
+    }
+    
+    pos = p->common.headerInfo.mainHeaderEnd;
+    
+    if ((result = pl_IffFileReader_GetMainEnd (p, &mainEnd)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_SetPosition ((PlankFileRef)p, pos)) != PlankResult_OK) goto exit;
+    
+    while (((mainEnd < 0) || (pos < mainEnd)) &&
+           (pl_File_IsEOF ((PlankFileRef)p) == PLANK_FALSE))
+    {
+        info.headerPos = pos;
+        result = pl_IffFileReader_ParseChunkHeader (p, 0, &info.id, &info.length, &chunkEnd, &info.dataPos);
+        
+        if (result == PlankResult_FileEOF)
+        {
+            result = PlankResult_OK;
+            break;
+        }
+        
+        if (result != PlankResult_OK) goto exit;
+        if ((result = pl_DynamicArray_AddItem (&p->chunkInfos, &info)) != PlankResult_OK) goto exit;
+        
+        // e.g., a CAF data chunk that runs to the end of the file
+        if (info.length < 0)
+            break;
+        
+        pos = chunkEnd;
+        if ((result = pl_File_SetPosition ((PlankFileRef)p, pos)) != PlankResult_OK) goto exit;
+    }
+    
+    p->chunkInfosValid = PLANK_TRUE;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_IffFileReader_GetNumChunks (PlankIffFileReaderRef p, int* numChunks)
+{
+    PlankResult result = PlankResult_OK;
+    
+    *numChunks = 0;
+    
+    if ((result = pl_IffFileReader_IndexChunks (p)) != PlankResult_OK) goto exit;
+    
+    *numChunks = (int)pl_DynamicArray_GetSize (&p->chunkInfos);
+    
+exit:
+    return result;
+}
+
+PlankResult pl_IffFileReader_GetChunkInfo (PlankIffFileReaderRef p, const int index, PlankIffFileReaderChunkInfo* info)
+{
+    if (! p->chunkInfosValid)
+        return PlankResult_UnknownError;
+    
+    return pl_DynamicArray_GetItem (&p->chunkInfos, index, info);
+}
+
+/* Search the index from a chunk header position, sets indexed to false if the
+ index couldn't be built or the start position isn't at the start of a chunk. */
+static PlankResult pl_IffFileReader_SeekChunkIndexed (PlankIffFileReaderRef p, const PlankLL startPosition, const PlankIffID* chunkID, PlankLL* chunkLength, PlankLL* chunkDataPos, PlankB* indexed)
+{
+    PlankResult result = PlankResult_OK;
+    const PlankIffFileReaderChunkInfo* infos;
+    int numChunks, first, i;
+    
+    *indexed = PLANK_FALSE;
+    
+    if (pl_IffFileReader_GetNumChunks (p, &numChunks) != PlankResult_OK)
+        goto exit;
+    
+    infos = (const PlankIffFileReaderChunkInfo*)pl_DynamicArray_GetArray (&p->chunkInfos);
+    first = -1;
+    
+    if (startPosition == p->common.headerInfo.mainHeaderEnd)
+    {
+        first = 0;
+    }
+    else
+    {
+        for (i = 0; i < numChunks; ++i)
+        {
+            if (infos[i].headerPos == startPosition)
+            {
+                first = i;
+                break;
+            }
+        }
+    }
+    
+    if (first < 0)
+        goto exit;
+    
+    *indexed = PLANK_TRUE;
+    
+    for (i = first; i < numChunks; ++i)
+    {
+        if (pl_IffFile_EqualIDs ((PlankIffFileRef)p, chunkID, &infos[i].id))
+        {
+            if (chunkLength)
+                *chunkLength = infos[i].length;
+            
+            if (chunkDataPos)
+                *chunkDataPos = infos[i].dataPos;
+            
+            result = pl_File_SetPosition ((PlankFileRef)p, infos[i].dataPos);
+            goto exit;
+        }
+    }
+    
+    result = PlankResult_IffFileReaderChunkNotFound;
+    
+exit:
+    return result;
+}
+
 PlankResult pl_IffFileReader_SeekChunk (PlankIffFileReaderRef p, const PlankLL startPosition, const char* chunkIDstr, PlankLL* chunkLength, PlankLL* chunkDataPos)
 {
     PlankResult result = PlankResult_OK;
     PlankLL readChunkEnd, mainEnd, pos;
     PlankLL readChunkLength;
     PlankIffID chunkID, readChunkID;
+    PlankB indexed;
 
     if ((result = pl_IffFile_InitID ((PlankIffFileRef)p, chunkIDstr, &chunkID)) != PlankResult_OK) goto exit;
     
@@ -373,6 +523,11 @@ PlankResult pl_IffFileReader_SeekChunk (PlankIffFileReaderRef p, const PlankLL s
             pos = startPosition;
     }
     
+    result = pl_IffFileReader_SeekChunkIndexed (p, pos, &chunkID, chunkLength, chunkDataPos, &indexed);
+    
+    if (indexed)
+        goto exit;
+    
     if ((result = pl_IffFileReader_GetMainEnd (p, &mainEnd)) != PlankResult_OK) goto exit;
     if ((result = pl_File_SetPosition ((PlankFileRef)p, pos)) != PlankResult_OK) goto exit;
     
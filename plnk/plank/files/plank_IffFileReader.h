@@ -54,6 +54,15 @@ PLANK_BEGIN_C_LINKAGE
 /** An opaque reference to the <i>Plank IffFileReader</i> object. */
 typedef struct PlankIffFileReader* PlankIffFileReaderRef; 
 
+/** The position and length of a chunk found by pl_IffFileReader_IndexChunks(). */
+typedef struct PlankIffFileReaderChunkInfo
+{
+    PlankIffID id;
+    PlankLL headerPos;
+    PlankLL length;
+    PlankLL dataPos;
+} PlankIffFileReaderChunkInfo;
+
 /** Create and initialise a <i>Plank IffFileReader</i> object and return an oqaque reference to it.
  @return A <i>Plank IffFileReader</i> object as an opaque reference or PLANK_NULL. */
 PlankIffFileReaderRef pl_IffFileReader_CreateAndInit();
@@ -128,6 +137,9 @@ PlankResult pl_IffFileReader_IsBigEndian (PlankIffFileReaderRef p, PlankB* isBig
 PlankResult pl_IffFileReader_SetEndian (PlankIffFileReaderRef p, const PlankB isBigEndian);
 
 /** Seek to the data of a particular chunk.
+ The first call reads all of the chunk headers into an index (see pl_IffFileReader_IndexChunks()),
+ later calls search the index and only need to set the file position. If the start position is 
+ not the start of an indexed chunk the headers are read from the file as before.
  @param p             The <i>Plank IffFileReader</i> object.
  @param startPosition Where to start searching within the file, in bytes. There are two special values:
                       -  0 : Specifies the start of the file (although this will be offset to the first chunk).
@@ -135,6 +147,27 @@ PlankResult pl_IffFileReader_SetEndian (PlankIffFileReaderRef p, const PlankB is
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_IffFileReader_SeekChunk (PlankIffFileReaderRef p, const PlankLL startPosition, const char* chunkID, PlankLL* chunkLength, PlankLL* chunkDataPos);
 
+/** Read the header of every chunk in the file in a single pass.
+ This is done once per file, the index is cleared when the file is closed. The pass stops at
+ the end of the main chunk, the end of the file or at a chunk with an unknown length (e.g., 
+ the data chunk in a CAF file that was not finalised).
+ @param p The <i>Plank IffFileReader</i> object.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_IffFileReader_IndexChunks (PlankIffFileReaderRef p);
+
+/** Get the number of chunks in the index, this builds the index if needed.
+ @param p The <i>Plank IffFileReader</i> object.
+ @param numChunks The number of chunks is returned here.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_IffFileReader_GetNumChunks (PlankIffFileReaderRef p, int* numChunks);
+
+/** Get the position and length of a chunk in the index.
+ @param p The <i>Plank IffFileReader</i> object.
+ @param index The index of the chunk in file order.
+ @param info The chunk information is returned here.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_IffFileReader_GetChunkInfo (PlankIffFileReaderRef p, const int index, PlankIffFileReaderChunkInfo* info);
+
 /**
  @param p The <i>Plank IffFileReader</i> object.
  @param chunkIDstr The chunk ID as a string can be returned here. This should point to a string capable of holding at least 37 characters. Use 0 to ignore.
@@ -153,6 +186,8 @@ PLANK_END_C_LINKAGE
 typedef struct PlankIffFileReader
 {
     PlankIffFile common;
+    PlankDynamicArray chunkInfos;
+    PlankB chunkInfosValid;
 } PlankIffFileReader;
 #endif
 
@@ -488,6 +488,8 @@
         #include "plank_vDSP.h"
     #elif defined(PLANK_VEC_IPP)
         #include "plank_vIPP.h"
+    #elif defined(PLANK_VEC_SIMD)
+        #include "plank_vSIMD.h"
     #elif defined(PLANK_VEC_OTHERLIB)
         #include "some other vector lib" // must define PLANK_VEC_CUSTOM
     #endif
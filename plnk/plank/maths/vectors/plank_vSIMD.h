@@ -0,0 +1,1089 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_VSIMD_H
+#define PLANK_VSIMD_H
+
+#if !DOXYGEN
+
+#ifdef PLANK_VEC_CUSTOM
+    #error only one custom vectorised libary may be specified
+#endif
+
+#define PLANK_VEC_CUSTOM
+
+/* Native SIMD backend using compiler intrinsics rather than a vendor library.
+ The instruction set is selected at compile time from the target flags:
+ AVX (-mavx or -mavx2), SSE2 (the x86-64 baseline) or NEON
+ on AArch64. Define PLANK_VEC_SIMD_NOAVX=1 to force the 128-bit SSE path on
+ an AVX build. Operations without a SIMD implementation here fall back to the
+ scalar loops from plank_Vectors.h. */
+
+#if (defined(__AVX__) && !PLANK_VEC_SIMD_NOAVX)
+    #define PLANK_VSIMD_AVX 1
+    #define PLANK_VSIMD_X86 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define PLANK_VSIMD_SSE 1
+    #define PLANK_VSIMD_X86 1
+    #include <emmintrin.h>
+    #if defined(__SSE4_1__)
+        #include <smmintrin.h>
+    #endif
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define PLANK_VSIMD_NEON 1
+    #include <arm_neon.h>
+#else
+    #error PLANK_VEC_SIMD requires SSE2, AVX or AArch64 NEON
+#endif
+
+//------------------------------- AVX ------------------------------------------
+
+#if PLANK_VSIMD_AVX
+
+#define PLANK_SIMDF_LENGTH  8   // vector 8 floats
+#define PLANK_SIMDF_SIZE   32
+#define PLANK_SIMDF_SHIFT   3   // divide by 8 for length
+#define PLANK_SIMDF_MASK    7   // remainder mask for non-multiples of 8
+typedef __m256 PlankVF;
+
+#define PLANK_SIMDD_LENGTH  4   // vector 4 doubles
+#define PLANK_SIMDD_SIZE   32
+#define PLANK_SIMDD_SHIFT   2   // divide by 4 for length
+#define PLANK_SIMDD_MASK    3   // remainder mask for non-multiples of 4
+typedef __m256d PlankVD;
+
+#define PLANK_VSIMDF_LOAD(P)        _mm256_loadu_ps(P)
+#define PLANK_VSIMDF_STORE(P,A)     _mm256_storeu_ps(P,A)
+#define PLANK_VSIMDF_SET1(A)        _mm256_set1_ps(A)
+#define PLANK_VSIMDF_ADD(A,B)       _mm256_add_ps(A,B)
+#define PLANK_VSIMDF_SUB(A,B)       _mm256_sub_ps(A,B)
+#define PLANK_VSIMDF_MUL(A,B)       _mm256_mul_ps(A,B)
+#define PLANK_VSIMDF_DIV(A,B)       _mm256_div_ps(A,B)
+#define PLANK_VSIMDF_MIN(A,B)       _mm256_min_ps(A,B)
+#define PLANK_VSIMDF_MAX(A,B)       _mm256_max_ps(A,B)
+#define PLANK_VSIMDF_SQRT(A)        _mm256_sqrt_ps(A)
+#define PLANK_VSIMDF_AND(A,B)       _mm256_and_ps(A,B)
+#define PLANK_VSIMDF_ANDNOT(A,B)    _mm256_andnot_ps(A,B)
+#define PLANK_VSIMDF_XOR(A,B)       _mm256_xor_ps(A,B)
+#define PLANK_VSIMDF_CMPEQ(A,B)     _mm256_cmp_ps(A,B,_CMP_EQ_OQ)
+#define PLANK_VSIMDF_CMPNE(A,B)     _mm256_cmp_ps(A,B,_CMP_NEQ_UQ)
+#define PLANK_VSIMDF_CMPGT(A,B)     _mm256_cmp_ps(A,B,_CMP_GT_OQ)
+#define PLANK_VSIMDF_CMPGE(A,B)     _mm256_cmp_ps(A,B,_CMP_GE_OQ)
+#define PLANK_VSIMDF_CMPLT(A,B)     _mm256_cmp_ps(A,B,_CMP_LT_OQ)
+#define PLANK_VSIMDF_CMPLE(A,B)     _mm256_cmp_ps(A,B,_CMP_LE_OQ)
+#define PLANK_VSIMDF_TRUNC(A)       _mm256_round_ps(A,_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+#define PLANK_VSIMDF_FLOOR(A)       _mm256_floor_ps(A)
+#define PLANK_VSIMDF_CEIL(A)        _mm256_ceil_ps(A)
+
+#define PLANK_VSIMDD_LOAD(P)        _mm256_loadu_pd(P)
+#define PLANK_VSIMDD_STORE(P,A)     _mm256_storeu_pd(P,A)
+#define PLANK_VSIMDD_SET1(A)        _mm256_set1_pd(A)
+#define PLANK_VSIMDD_ADD(A,B)       _mm256_add_pd(A,B)
+#define PLANK_VSIMDD_SUB(A,B)       _mm256_sub_pd(A,B)
+#define PLANK_VSIMDD_MUL(A,B)       _mm256_mul_pd(A,B)
+#define PLANK_VSIMDD_DIV(A,B)       _mm256_div_pd(A,B)
+#define PLANK_VSIMDD_MIN(A,B)       _mm256_min_pd(A,B)
+#define PLANK_VSIMDD_MAX(A,B)       _mm256_max_pd(A,B)
+#define PLANK_VSIMDD_SQRT(A)        _mm256_sqrt_pd(A)
+#define PLANK_VSIMDD_AND(A,B)       _mm256_and_pd(A,B)
+#define PLANK_VSIMDD_ANDNOT(A,B)    _mm256_andnot_pd(A,B)
+#define PLANK_VSIMDD_XOR(A,B)       _mm256_xor_pd(A,B)
+#define PLANK_VSIMDD_CMPEQ(A,B)     _mm256_cmp_pd(A,B,_CMP_EQ_OQ)
+#define PLANK_VSIMDD_CMPNE(A,B)     _mm256_cmp_pd(A,B,_CMP_NEQ_UQ)
+#define PLANK_VSIMDD_CMPGT(A,B)     _mm256_cmp_pd(A,B,_CMP_GT_OQ)
+#define PLANK_VSIMDD_CMPGE(A,B)     _mm256_cmp_pd(A,B,_CMP_GE_OQ)
+#define PLANK_VSIMDD_CMPLT(A,B)     _mm256_cmp_pd(A,B,_CMP_LT_OQ)
+#define PLANK_VSIMDD_CMPLE(A,B)     _mm256_cmp_pd(A,B,_CMP_LE_OQ)
+#define PLANK_VSIMDD_TRUNC(A)       _mm256_round_pd(A,_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+#define PLANK_VSIMDD_FLOOR(A)       _mm256_floor_pd(A)
+#define PLANK_VSIMDD_CEIL(A)        _mm256_ceil_pd(A)
+
+#define PLANK_VSIMD_HASROUND 1
+
+// gathers need AVX2, PlankVFI is an int vector with one lane per float lane
+#if defined(__AVX2__)
+    typedef __m256i PlankVFI;
+    #define PLANK_VSIMDFI_LOAD(P)       _mm256_loadu_si256((const __m256i*)(P))
+    #define PLANK_VSIMDFI_ADD(A,B)      _mm256_add_epi32(A,B)
+    #define PLANK_VSIMDF_TOINT(A)       _mm256_cvttps_epi32(A)
+    #define PLANK_VSIMDF_FROMINT(A)     _mm256_cvtepi32_ps(A)
+    #define PLANK_VSIMDF_GATHER(P,I)    _mm256_i32gather_ps(P,I,4)
+    #define PLANK_VSIMD_HASGATHER 1
+#endif
+
+//------------------------------- SSE ------------------------------------------
+
+#elif PLANK_VSIMD_SSE
+
+#define PLANK_SIMDF_LENGTH  4   // vector 4 floats
+#define PLANK_SIMDF_SIZE   16
+#define PLANK_SIMDF_SHIFT   2   // divide by 4 for length
+#define PLANK_SIMDF_MASK    3   // remainder mask for non-multiples of 4
+typedef __m128 PlankVF;
+
+#define PLANK_SIMDD_LENGTH  2   // vector 2 doubles
+#define PLANK_SIMDD_SIZE   16
+#define PLANK_SIMDD_SHIFT   1   // divide by 2 for length
+#define PLANK_SIMDD_MASK    1   // remainder mask for non-even lengths
+typedef __m128d PlankVD;
+
+#define PLANK_VSIMDF_LOAD(P)        _mm_loadu_ps(P)
+#define PLANK_VSIMDF_STORE(P,A)     _mm_storeu_ps(P,A)
+#define PLANK_VSIMDF_SET1(A)        _mm_set1_ps(A)
+#define PLANK_VSIMDF_ADD(A,B)       _mm_add_ps(A,B)
+#define PLANK_VSIMDF_SUB(A,B)       _mm_sub_ps(A,B)
+#define PLANK_VSIMDF_MUL(A,B)       _mm_mul_ps(A,B)
+#define PLANK_VSIMDF_DIV(A,B)       _mm_div_ps(A,B)
+#define PLANK_VSIMDF_MIN(A,B)       _mm_min_ps(A,B)
+#define PLANK_VSIMDF_MAX(A,B)       _mm_max_ps(A,B)
+#define PLANK_VSIMDF_SQRT(A)        _mm_sqrt_ps(A)
+#define PLANK_VSIMDF_AND(A,B)       _mm_and_ps(A,B)
+#define PLANK_VSIMDF_ANDNOT(A,B)    _mm_andnot_ps(A,B)
+#define PLANK_VSIMDF_XOR(A,B)       _mm_xor_ps(A,B)
+#define PLANK_VSIMDF_CMPEQ(A,B)     _mm_cmpeq_ps(A,B)
+#define PLANK_VSIMDF_CMPNE(A,B)     _mm_cmpneq_ps(A,B)
+#define PLANK_VSIMDF_CMPGT(A,B)     _mm_cmpgt_ps(A,B)
+#define PLANK_VSIMDF_CMPGE(A,B)     _mm_cmpge_ps(A,B)
+#define PLANK_VSIMDF_CMPLT(A,B)     _mm_cmplt_ps(A,B)
+#define PLANK_VSIMDF_CMPLE(A,B)     _mm_cmple_ps(A,B)
+#define PLANK_VSIMDF_TRUNC(A)       _mm_cvtepi32_ps(_mm_cvttps_epi32(A))
+
+#define PLANK_VSIMDD_LOAD(P)        _mm_loadu_pd(P)
+#define PLANK_VSIMDD_STORE(P,A)     _mm_storeu_pd(P,A)
+#define PLANK_VSIMDD_SET1(A)        _mm_set1_pd(A)
+#define PLANK_VSIMDD_ADD(A,B)       _mm_add_pd(A,B)
+#define PLANK_VSIMDD_SUB(A,B)       _mm_sub_pd(A,B)
+#define PLANK_VSIMDD_MUL(A,B)       _mm_mul_pd(A,B)
+#define PLANK_VSIMDD_DIV(A,B)       _mm_div_pd(A,B)
+#define PLANK_VSIMDD_MIN(A,B)       _mm_min_pd(A,B)
+#define PLANK_VSIMDD_MAX(A,B)       _mm_max_pd(A,B)
+#define PLANK_VSIMDD_SQRT(A)        _mm_sqrt_pd(A)
+#define PLANK_VSIMDD_AND(A,B)       _mm_and_pd(A,B)
+#define PLANK_VSIMDD_ANDNOT(A,B)    _mm_andnot_pd(A,B)
+#define PLANK_VSIMDD_XOR(A,B)       _mm_xor_pd(A,B)
+#define PLANK_VSIMDD_CMPEQ(A,B)     _mm_cmpeq_pd(A,B)
+#define PLANK_VSIMDD_CMPNE(A,B)     _mm_cmpneq_pd(A,B)
+#define PLANK_VSIMDD_CMPGT(A,B)     _mm_cmpgt_pd(A,B)
+#define PLANK_VSIMDD_CMPGE(A,B)     _mm_cmpge_pd(A,B)
+#define PLANK_VSIMDD_CMPLT(A,B)     _mm_cmplt_pd(A,B)
+#define PLANK_VSIMDD_CMPLE(A,B)     _mm_cmple_pd(A,B)
+#define PLANK_VSIMDD_TRUNC(A)       _mm_cvtepi32_pd(_mm_cvttpd_epi32(A))
+
+#if defined(__SSE4_1__)
+    #define PLANK_VSIMDF_FLOOR(A)   _mm_floor_ps(A)
+    #define PLANK_VSIMDF_CEIL(A)    _mm_ceil_ps(A)
+    #define PLANK_VSIMDD_FLOOR(A)   _mm_floor_pd(A)
+    #define PLANK_VSIMDD_CEIL(A)    _mm_ceil_pd(A)
+    #define PLANK_VSIMD_HASROUND 1
+#endif
+
+//------------------------------- NEON -----------------------------------------
+
+#elif PLANK_VSIMD_NEON
+
+#define PLANK_SIMDF_LENGTH  4   // vector 4 floats
+#define PLANK_SIMDF_SIZE   16
+#define PLANK_SIMDF_SHIFT   2   // divide by 4 for length
+#define PLANK_SIMDF_MASK    3   // remainder mask for non-multiples of 4
+typedef float32x4_t PlankVF;
+
+#define PLANK_SIMDD_LENGTH  2   // vector 2 doubles
+#define PLANK_SIMDD_SIZE   16
+#define PLANK_SIMDD_SHIFT   1   // divide by 2 for length
+#define PLANK_SIMDD_MASK    1   // remainder mask for non-even lengths
+typedef float64x2_t PlankVD;
+
+// masks are kept in the float registers so the generic code below is the same as for x86
+#define PLANK_VSIMDF_U(A)           vreinterpretq_u32_f32(A)
+#define PLANK_VSIMDF_F(A)           vreinterpretq_f32_u32(A)
+#define PLANK_VSIMDF_LOAD(P)        vld1q_f32(P)
+#define PLANK_VSIMDF_STORE(P,A)     vst1q_f32(P,A)
+#define PLANK_VSIMDF_SET1(A)        vdupq_n_f32(A)
+#define PLANK_VSIMDF_ADD(A,B)       vaddq_f32(A,B)
+#define PLANK_VSIMDF_SUB(A,B)       vsubq_f32(A,B)
+#define PLANK_VSIMDF_MUL(A,B)       vmulq_f32(A,B)
+#define PLANK_VSIMDF_DIV(A,B)       vdivq_f32(A,B)
+#define PLANK_VSIMDF_MIN(A,B)       vminq_f32(A,B)
+#define PLANK_VSIMDF_MAX(A,B)       vmaxq_f32(A,B)
+#define PLANK_VSIMDF_SQRT(A)        vsqrtq_f32(A)
+#define PLANK_VSIMDF_AND(A,B)       PLANK_VSIMDF_F(vandq_u32(PLANK_VSIMDF_U(A),PLANK_VSIMDF_U(B)))
+#define PLANK_VSIMDF_ANDNOT(A,B)    PLANK_VSIMDF_F(vbicq_u32(PLANK_VSIMDF_U(B),PLANK_VSIMDF_U(A)))
+#define PLANK_VSIMDF_XOR(A,B)       PLANK_VSIMDF_F(veorq_u32(PLANK_VSIMDF_U(A),PLANK_VSIMDF_U(B)))
+#define PLANK_VSIMDF_CMPEQ(A,B)     PLANK_VSIMDF_F(vceqq_f32(A,B))
+#define PLANK_VSIMDF_CMPNE(A,B)     PLANK_VSIMDF_F(vmvnq_u32(vceqq_f32(A,B)))
+#define PLANK_VSIMDF_CMPGT(A,B)     PLANK_VSIMDF_F(vcgtq_f32(A,B))
+#define PLANK_VSIMDF_CMPGE(A,B)     PLANK_VSIMDF_F(vcgeq_f32(A,B))
+#define PLANK_VSIMDF_CMPLT(A,B)     PLANK_VSIMDF_F(vcltq_f32(A,B))
+#define PLANK_VSIMDF_CMPLE(A,B)     PLANK_VSIMDF_F(vcleq_f32(A,B))
+#define PLANK_VSIMDF_TRUNC(A)       vrndq_f32(A)
+#define PLANK_VSIMDF_FLOOR(A)       vrndmq_f32(A)
+#define PLANK_VSIMDF_CEIL(A)        vrndpq_f32(A)
+
+#define PLANK_VSIMDD_U(A)           vreinterpretq_u64_f64(A)
+#define PLANK_VSIMDD_F(A)           vreinterpretq_f64_u64(A)
+#define PLANK_VSIMDD_LOAD(P)        vld1q_f64(P)
+#define PLANK_VSIMDD_STORE(P,A)     vst1q_f64(P,A)
+#define PLANK_VSIMDD_SET1(A)        vdupq_n_f64(A)
+#define PLANK_VSIMDD_ADD(A,B)       vaddq_f64(A,B)
+#define PLANK_VSIMDD_SUB(A,B)       vsubq_f64(A,B)
+#define PLANK_VSIMDD_MUL(A,B)       vmulq_f64(A,B)
+#define PLANK_VSIMDD_DIV(A,B)       vdivq_f64(A,B)
+#define PLANK_VSIMDD_MIN(A,B)       vminq_f64(A,B)
+#define PLANK_VSIMDD_MAX(A,B)       vmaxq_f64(A,B)
+#define PLANK_VSIMDD_SQRT(A)        vsqrtq_f64(A)
+#define PLANK_VSIMDD_AND(A,B)       PLANK_VSIMDD_F(vandq_u64(PLANK_VSIMDD_U(A),PLANK_VSIMDD_U(B)))
+#define PLANK_VSIMDD_ANDNOT(A,B)    PLANK_VSIMDD_F(vbicq_u64(PLANK_VSIMDD_U(B),PLANK_VSIMDD_U(A)))
+#define PLANK_VSIMDD_XOR(A,B)       PLANK_VSIMDD_F(veorq_u64(PLANK_VSIMDD_U(A),PLANK_VSIMDD_U(B)))
+#define PLANK_VSIMDD_CMPEQ(A,B)     PLANK_VSIMDD_F(vceqq_f64(A,B))
+#define PLANK_VSIMDD_CMPNE(A,B)     PLANK_VSIMDD_F(vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(vceqq_f64(A,B)))))
+#define PLANK_VSIMDD_CMPGT(A,B)     PLANK_VSIMDD_F(vcgtq_f64(A,B))
+#define PLANK_VSIMDD_CMPGE(A,B)     PLANK_VSIMDD_F(vcgeq_f64(A,B))
+#define PLANK_VSIMDD_CMPLT(A,B)     PLANK_VSIMDD_F(vcltq_f64(A,B))
+#define PLANK_VSIMDD_CMPLE(A,B)     PLANK_VSIMDD_F(vcleq_f64(A,B))
+#define PLANK_VSIMDD_TRUNC(A)       vrndq_f64(A)
+#define PLANK_VSIMDD_FLOOR(A)       vrndmq_f64(A)
+#define PLANK_VSIMDD_CEIL(A)        vrndpq_f64(A)
+
+#define PLANK_VSIMD_HASROUND 1
+
+#endif
+
+// integer vectors are always 128-bit (AVX without AVX2 has no 256-bit integer ops)
+#if PLANK_VSIMD_X86
+    #define PLANK_SIMDI_LENGTH  4   // vector 4 ints
+    #define PLANK_SIMDI_SIZE   16
+    #define PLANK_SIMDI_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDI_MASK    3   // remainder mask for non-multiples of 4
+    typedef __m128i PlankVI;
+
+    #define PLANK_SIMDS_LENGTH  8   // vector 8 shorts
+    #define PLANK_SIMDS_SIZE   16
+    #define PLANK_SIMDS_SHIFT   3   // divide by 8 for length
+    #define PLANK_SIMDS_MASK    7   // remainder mask for non-multiples of 8
+    typedef __m128i PlankVS;
+
+    #define PLANK_VSIMDI_LOAD(P)        _mm_loadu_si128((const __m128i*)(P))
+    #define PLANK_VSIMDI_STORE(P,A)     _mm_storeu_si128((__m128i*)(P),A)
+    #define PLANK_VSIMDI_SET1(A)        _mm_set1_epi32(A)
+    #define PLANK_VSIMDI_ADD(A,B)       _mm_add_epi32(A,B)
+    #define PLANK_VSIMDI_SUB(A,B)       _mm_sub_epi32(A,B)
+
+    #define PLANK_VSIMDS_LOAD(P)        _mm_loadu_si128((const __m128i*)(P))
+    #define PLANK_VSIMDS_STORE(P,A)     _mm_storeu_si128((__m128i*)(P),A)
+    #define PLANK_VSIMDS_SET1(A)        _mm_set1_epi16(A)
+    #define PLANK_VSIMDS_ADD(A,B)       _mm_add_epi16(A,B)
+    #define PLANK_VSIMDS_SUB(A,B)       _mm_sub_epi16(A,B)
+#else
+    #define PLANK_SIMDI_LENGTH  4   // vector 4 ints
+    #define PLANK_SIMDI_SIZE   16
+    #define PLANK_SIMDI_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDI_MASK    3   // remainder mask for non-multiples of 4
+    typedef int32x4_t PlankVI;
+
+    #define PLANK_SIMDS_LENGTH  8   // vector 8 shorts
+    #define PLANK_SIMDS_SIZE   16
+    #define PLANK_SIMDS_SHIFT   3   // divide by 8 for length
+    #define PLANK_SIMDS_MASK    7   // remainder mask for non-multiples of 8
+    typedef int16x8_t PlankVS;
+
+    #define PLANK_VSIMDI_LOAD(P)        vld1q_s32(P)
+    #define PLANK_VSIMDI_STORE(P,A)     vst1q_s32(P,A)
+    #define PLANK_VSIMDI_SET1(A)        vdupq_n_s32(A)
+    #define PLANK_VSIMDI_ADD(A,B)       vaddq_s32(A,B)
+    #define PLANK_VSIMDI_SUB(A,B)       vsubq_s32(A,B)
+
+    #define PLANK_VSIMDS_LOAD(P)        vld1q_s16(P)
+    #define PLANK_VSIMDS_STORE(P,A)     vst1q_s16(P,A)
+    #define PLANK_VSIMDS_SET1(A)        vdupq_n_s16(A)
+    #define PLANK_VSIMDS_ADD(A,B)       vaddq_s16(A,B)
+    #define PLANK_VSIMDS_SUB(A,B)       vsubq_s16(A,B)
+#endif
+
+#define PLANK_SIMDLL_LENGTH  1   // vector 1 LongLong
+#define PLANK_SIMDLL_SIZE    8
+#define PLANK_SIMDLL_SHIFT   0   // no shift
+#define PLANK_SIMDLL_MASK    0   // no remainder
+typedef PlankLL PlankVLL;
+
+//-------------------------- generic macros ------------------------------------
+
+#define PLANK_VSIMD(TYPECODE,OP)            PLANK_VSIMD##TYPECODE##_##OP
+#define PLANK_VSIMD_ONE(TYPECODE)           PLANK_VSIMD(TYPECODE,SET1)((Plank##TYPECODE)1)
+#define PLANK_VSIMD_SIGNBIT(TYPECODE)       PLANK_VSIMD(TYPECODE,SET1)((Plank##TYPECODE)-0.0)
+#define PLANK_VSIMD_BOOL(TYPECODE,MASK)     PLANK_VSIMD(TYPECODE,AND)(MASK, PLANK_VSIMD_ONE(TYPECODE))
+
+#define PLANK_VSIMD_UNARYOP_DEFINE(OP,TYPECODE,VEXPR) \
+    static PLANK_INLINE_MID void PLANK_VECTORUNARYOP_NAME(OP,TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE va; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, a += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            va = PLANK_VSIMD(TYPECODE,LOAD)(a); PLANK_VSIMD(TYPECODE,STORE)(result, VEXPR);\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = pl_##OP##TYPECODE (*a++); }\
+    }
+
+#define PLANK_VSIMD_BINARYOPVECTOR_DEFINE(OP,TYPECODE,VEXPR) \
+    static PLANK_INLINE_MID void PLANK_VECTORBINARYOPVECTOR_NAME(OP,TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, const Plank##TYPECODE* b, PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE va, vb; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, a += PLANK_SIMD##TYPECODE##_LENGTH, b += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            va = PLANK_VSIMD(TYPECODE,LOAD)(a); vb = PLANK_VSIMD(TYPECODE,LOAD)(b); PLANK_VSIMD(TYPECODE,STORE)(result, VEXPR);\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = pl_##OP##TYPECODE (*a++, *b++); }\
+    }
+
+#define PLANK_VSIMD_BINARYOPSCALAR_DEFINE(OP,TYPECODE,VEXPR) \
+    static PLANK_INLINE_MID void PLANK_VECTORBINARYOPSCALAR_NAME(OP,TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, Plank##TYPECODE b, PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE va; const PlankV##TYPECODE vb = PLANK_VSIMD(TYPECODE,SET1)(b); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, a += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            va = PLANK_VSIMD(TYPECODE,LOAD)(a); PLANK_VSIMD(TYPECODE,STORE)(result, VEXPR);\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = pl_##OP##TYPECODE (*a++, b); }\
+    }
+
+#define PLANK_VSIMD_SCALARBINARYOPVECTOR_DEFINE(OP,TYPECODE,VEXPR) \
+    static PLANK_INLINE_MID void PLANK_SCALARBINARYOPVECTOR_NAME(OP,TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE a, const Plank##TYPECODE* b, PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE vb; const PlankV##TYPECODE va = PLANK_VSIMD(TYPECODE,SET1)(a); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, b += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vb = PLANK_VSIMD(TYPECODE,LOAD)(b); PLANK_VSIMD(TYPECODE,STORE)(result, VEXPR);\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = pl_##OP##TYPECODE (a, *b++); }\
+    }
+
+#define PLANK_VSIMD_BINARYOP_DEFINE(OP,TYPECODE,VEXPR) \
+    PLANK_VSIMD_BINARYOPVECTOR_DEFINE(OP,TYPECODE,VEXPR)\
+    PLANK_VSIMD_BINARYOPSCALAR_DEFINE(OP,TYPECODE,VEXPR)\
+    PLANK_VSIMD_SCALARBINARYOPVECTOR_DEFINE(OP,TYPECODE,VEXPR)
+
+#define PLANK_VSIMD_FILL_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORFILL_NAME(TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE value, PlankUL N) {\
+        PlankUL i; const PlankV##TYPECODE v = PLANK_VSIMD(TYPECODE,SET1)(value); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH) { PLANK_VSIMD(TYPECODE,STORE)(result, v); }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = value; }\
+    }
+
+#define PLANK_VSIMD_CLEAR_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORCLEAR_NAME(TYPECODE) (Plank##TYPECODE *result, PlankUL N) {\
+        PLANK_VECTORFILL_NAME(TYPECODE) (result, (Plank##TYPECODE)0, N);\
+    }
+
+#define PLANK_VSIMD_RAMP_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORRAMP_NAME(TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE a, Plank##TYPECODE b, PlankUL N) {\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE start[PLANK_SIMD##TYPECODE##_LENGTH];\
+        PlankUL i; PlankV##TYPECODE va, vstep; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < PLANK_SIMD##TYPECODE##_LENGTH; ++i) { start[i] = a + b * (Plank##TYPECODE)i; }\
+        va = PLANK_VSIMD(TYPECODE,LOAD)(start); vstep = PLANK_VSIMD(TYPECODE,SET1)(b * (Plank##TYPECODE)PLANK_SIMD##TYPECODE##_LENGTH);\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH) { PLANK_VSIMD(TYPECODE,STORE)(result, va); va = PLANK_VSIMD(TYPECODE,ADD)(va, vstep); }\
+        if (numSIMD > 0) { a = a + b * (Plank##TYPECODE)(numSIMD << PLANK_SIMD##TYPECODE##_SHIFT); }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = a; a = a + b; }\
+    }
+
+#define PLANK_VSIMD_RAMPMUL_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORRAMPMUL_NAME(TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE a, Plank##TYPECODE b, PlankUL N) {\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE start[PLANK_SIMD##TYPECODE##_LENGTH];\
+        PlankUL i; PlankV##TYPECODE va, vstep; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < PLANK_SIMD##TYPECODE##_LENGTH; ++i) { start[i] = a + b * (Plank##TYPECODE)i; }\
+        va = PLANK_VSIMD(TYPECODE,LOAD)(start); vstep = PLANK_VSIMD(TYPECODE,SET1)(b * (Plank##TYPECODE)PLANK_SIMD##TYPECODE##_LENGTH);\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_VSIMD(TYPECODE,STORE)(result, PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,LOAD)(result), va)); va = PLANK_VSIMD(TYPECODE,ADD)(va, vstep);\
+        }\
+        if (numSIMD > 0) { a = a + b * (Plank##TYPECODE)(numSIMD << PLANK_SIMD##TYPECODE##_SHIFT); }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ *= a; a = a + b; }\
+    }
+
+#define PLANK_VSIMD_MULADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORMULADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PlankUL i; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, input += PLANK_SIMD##TYPECODE##_LENGTH, mul += PLANK_SIMD##TYPECODE##_LENGTH, add += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_VSIMD(TYPECODE,STORE)(result, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,LOAD)(input), PLANK_VSIMD(TYPECODE,LOAD)(mul)), PLANK_VSIMD(TYPECODE,LOAD)(add)));\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = *input++ * *mul++ + *add++; }\
+    }
+
+#define PLANK_VSIMD_MULADDINPLACE_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORMULADDINPLACE_NAME(TYPECODE) (Plank##TYPECODE *io, const Plank##TYPECODE* mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PLANK_VECTORMULADD_NAME(TYPECODE) (io, io, mul, add, N);\
+    }
+
+#define PLANK_VSIMD_MULSCALARADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORMULSCALARADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, Plank##TYPECODE add, PlankUL N) {\
+        PlankUL i; const PlankV##TYPECODE vadd = PLANK_VSIMD(TYPECODE,SET1)(add); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, input += PLANK_SIMD##TYPECODE##_LENGTH, mul += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_VSIMD(TYPECODE,STORE)(result, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,LOAD)(input), PLANK_VSIMD(TYPECODE,LOAD)(mul)), vadd));\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = *input++ * *mul++ + add; }\
+    }
+
+#define PLANK_VSIMD_SCALARMULSCALARADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORSCALARMULSCALARADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, Plank##TYPECODE add, PlankUL N) {\
+        PlankUL i; const PlankV##TYPECODE vmul = PLANK_VSIMD(TYPECODE,SET1)(mul), vadd = PLANK_VSIMD(TYPECODE,SET1)(add); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, input += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_VSIMD(TYPECODE,STORE)(result, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,LOAD)(input), vmul), vadd));\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = *input++ * mul + add; }\
+    }
+
+#define PLANK_VSIMD_SCALARMULADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORSCALARMULADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PlankUL i; const PlankV##TYPECODE vmul = PLANK_VSIMD(TYPECODE,SET1)(mul); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, input += PLANK_SIMD##TYPECODE##_LENGTH, add += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_VSIMD(TYPECODE,STORE)(result, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,LOAD)(input), vmul), PLANK_VSIMD(TYPECODE,LOAD)(add)));\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = *input++ * mul + *add++; }\
+    }
+
+#define PLANK_VSIMD_HSUM_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID Plank##TYPECODE pl_VectorSIMDHSum##TYPECODE (PlankV##TYPECODE v) {\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE lanes[PLANK_SIMD##TYPECODE##_LENGTH];\
+        Plank##TYPECODE sum = (Plank##TYPECODE)0; int i;\
+        PLANK_VSIMD(TYPECODE,STORE)(lanes, v);\
+        for (i = 0; i < PLANK_SIMD##TYPECODE##_LENGTH; ++i) { sum += lanes[i]; }\
+        return sum;\
+    }
+
+#define PLANK_VSIMD_ADDVECTORMUL_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORADDVECTORMUL_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, const Plank##TYPECODE* b, PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE vsum = PLANK_VSIMD(TYPECODE,SET1)((Plank##TYPECODE)0); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, a += PLANK_SIMD##TYPECODE##_LENGTH, b += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vsum = PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,LOAD)(a), PLANK_VSIMD(TYPECODE,LOAD)(b)), vsum);\
+        }\
+        *result = pl_VectorSIMDHSum##TYPECODE (vsum);\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result = *a++ * *b++ + *result; }\
+    }
+
+#define PLANK_VSIMD_MEAN_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID Plank##TYPECODE PLANK_VECTORMEAN_NAME(TYPECODE) (const Plank##TYPECODE* a, PlankUL N) {\
+        PlankUL i; Plank##TYPECODE sum; PlankV##TYPECODE vsum = PLANK_VSIMD(TYPECODE,SET1)((Plank##TYPECODE)0); const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i, a += PLANK_SIMD##TYPECODE##_LENGTH) { vsum = PLANK_VSIMD(TYPECODE,ADD)(vsum, PLANK_VSIMD(TYPECODE,LOAD)(a)); }\
+        sum = pl_VectorSIMDHSum##TYPECODE (vsum);\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { sum += *a++; }\
+        return sum / N;\
+    }
+
+// the index is truncated and split in the vector unit, the table reads themselves are scalar
+#define PLANK_VSIMD_LOOKUP_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORLOOKUP_NAME(TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE *table, PlankUL n, Plank##TYPECODE *index, PlankUL N) {\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE whole[PLANK_SIMD##TYPECODE##_LENGTH];\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE lo[PLANK_SIMD##TYPECODE##_LENGTH];\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE hi[PLANK_SIMD##TYPECODE##_LENGTH];\
+        PlankUL i; int j, k; PlankV##TYPECODE vindex, vwhole, vfrac, vlo, vhi; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        PLANK_UNUSED(n);\
+        for (i = 0; i < numSIMD; ++i, result += PLANK_SIMD##TYPECODE##_LENGTH, index += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vindex = PLANK_VSIMD(TYPECODE,LOAD)(index);\
+            vwhole = PLANK_VSIMD(TYPECODE,TRUNC)(vindex);\
+            vfrac = PLANK_VSIMD(TYPECODE,SUB)(vindex, vwhole);\
+            PLANK_VSIMD(TYPECODE,STORE)(whole, vwhole);\
+            for (j = 0; j < PLANK_SIMD##TYPECODE##_LENGTH; ++j) { k = (int)whole[j]; lo[j] = table[k]; hi[j] = table[k + 1]; }\
+            vlo = PLANK_VSIMD(TYPECODE,LOAD)(lo); vhi = PLANK_VSIMD(TYPECODE,LOAD)(hi);\
+            PLANK_VSIMD(TYPECODE,STORE)(result, PLANK_VSIMD(TYPECODE,ADD)(vlo, PLANK_VSIMD(TYPECODE,MUL)(vfrac, PLANK_VSIMD(TYPECODE,SUB)(vhi, vlo))));\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) { *result++ = pl_Lookup##TYPECODE (table, *index++); }\
+    }
+
+#define PLANK_VSIMD_ZMUL_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORZMUL_NAME(TYPECODE) (Plank##TYPECODE *resultReal, Plank##TYPECODE *resultImag,\
+                                                                  const Plank##TYPECODE* leftReal, const Plank##TYPECODE* leftImag,\
+                                                                  const Plank##TYPECODE* rightReal, const Plank##TYPECODE* rightImag,\
+                                                                  PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE lr, li, rr, ri; Plank##TYPECODE re; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i) {\
+            lr = PLANK_VSIMD(TYPECODE,LOAD)(leftReal); li = PLANK_VSIMD(TYPECODE,LOAD)(leftImag);\
+            rr = PLANK_VSIMD(TYPECODE,LOAD)(rightReal); ri = PLANK_VSIMD(TYPECODE,LOAD)(rightImag);\
+            PLANK_VSIMD(TYPECODE,STORE)(resultReal, PLANK_VSIMD(TYPECODE,SUB)(PLANK_VSIMD(TYPECODE,MUL)(lr, rr), PLANK_VSIMD(TYPECODE,MUL)(li, ri)));\
+            PLANK_VSIMD(TYPECODE,STORE)(resultImag, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(lr, ri), PLANK_VSIMD(TYPECODE,MUL)(li, rr)));\
+            resultReal += PLANK_SIMD##TYPECODE##_LENGTH; resultImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+            leftReal += PLANK_SIMD##TYPECODE##_LENGTH; leftImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+            rightReal += PLANK_SIMD##TYPECODE##_LENGTH; rightImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) {\
+            re = *leftReal * *rightReal - *leftImag * *rightImag;\
+            *resultImag++ = *leftReal++ * *rightImag++ + *leftImag++ * *rightReal++;\
+            *resultReal++ = re;\
+        }\
+    }
+
+#define PLANK_VSIMD_ZMULADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORZMULADD_NAME(TYPECODE) (Plank##TYPECODE *resultReal, Plank##TYPECODE *resultImag,\
+                                                                     const Plank##TYPECODE* inputReal, const Plank##TYPECODE* inputImag,\
+                                                                     const Plank##TYPECODE* mulReal, const Plank##TYPECODE* mulImag,\
+                                                                     const Plank##TYPECODE* addReal, const Plank##TYPECODE* addImag,\
+                                                                     PlankUL N) {\
+        PlankUL i; PlankV##TYPECODE ir, ii, mr, mi; Plank##TYPECODE re; const PlankUL numSIMD = N >> PLANK_SIMD##TYPECODE##_SHIFT;\
+        for (i = 0; i < numSIMD; ++i) {\
+            ir = PLANK_VSIMD(TYPECODE,LOAD)(inputReal); ii = PLANK_VSIMD(TYPECODE,LOAD)(inputImag);\
+            mr = PLANK_VSIMD(TYPECODE,LOAD)(mulReal); mi = PLANK_VSIMD(TYPECODE,LOAD)(mulImag);\
+            PLANK_VSIMD(TYPECODE,STORE)(resultReal, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,SUB)(PLANK_VSIMD(TYPECODE,MUL)(ir, mr), PLANK_VSIMD(TYPECODE,MUL)(ii, mi)), PLANK_VSIMD(TYPECODE,LOAD)(addReal)));\
+            PLANK_VSIMD(TYPECODE,STORE)(resultImag, PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(ir, mi), PLANK_VSIMD(TYPECODE,MUL)(ii, mr)), PLANK_VSIMD(TYPECODE,LOAD)(addImag)));\
+            resultReal += PLANK_SIMD##TYPECODE##_LENGTH; resultImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+            inputReal += PLANK_SIMD##TYPECODE##_LENGTH; inputImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+            mulReal += PLANK_SIMD##TYPECODE##_LENGTH; mulImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+            addReal += PLANK_SIMD##TYPECODE##_LENGTH; addImag += PLANK_SIMD##TYPECODE##_LENGTH;\
+        }\
+        for (i = N & PLANK_SIMD##TYPECODE##_MASK; i > 0; --i) {\
+            re = *inputReal * *mulReal - *inputImag * *mulImag + *addReal++;\
+            *resultImag++ = *inputReal++ * *mulImag++ + *inputImag++ * *mulReal++ + *addImag++;\
+            *resultReal++ = re;\
+        }\
+    }
+
+// float and double share the same set of accelerated operations
+#define PLANK_VSIMD_OPS_FLOATING(TYPECODE)\
+    PLANK_VSIMD_FILL_DEFINE(TYPECODE)\
+    PLANK_VSIMD_CLEAR_DEFINE(TYPECODE)\
+    PLANK_VSIMD_RAMP_DEFINE(TYPECODE)\
+    PLANK_VSIMD_RAMPMUL_DEFINE(TYPECODE)\
+    PLANK_VECTORLINE_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_UNARYOP_DEFINE(Move,TYPECODE,va)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Inc,TYPECODE,PLANK_VSIMD(TYPECODE,ADD)(va, PLANK_VSIMD_ONE(TYPECODE)))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Dec,TYPECODE,PLANK_VSIMD(TYPECODE,SUB)(va, PLANK_VSIMD_ONE(TYPECODE)))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Neg,TYPECODE,PLANK_VSIMD(TYPECODE,XOR)(va, PLANK_VSIMD_SIGNBIT(TYPECODE)))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Abs,TYPECODE,PLANK_VSIMD(TYPECODE,ANDNOT)(PLANK_VSIMD_SIGNBIT(TYPECODE), va))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Squared,TYPECODE,PLANK_VSIMD(TYPECODE,MUL)(va, va))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Cubed,TYPECODE,PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,MUL)(va, va), va))\
+    PLANK_VECTORUNARYOP_DEFINE(Sign,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Reciprocal,TYPECODE,PLANK_VSIMD(TYPECODE,DIV)(PLANK_VSIMD_ONE(TYPECODE), va))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Sqrt,TYPECODE,PLANK_VSIMD(TYPECODE,SQRT)(va))\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(Add,TYPECODE,PLANK_VSIMD(TYPECODE,ADD)(va, vb))\
+    PLANK_VSIMD_BINARYOP_DEFINE(Sub,TYPECODE,PLANK_VSIMD(TYPECODE,SUB)(va, vb))\
+    PLANK_VSIMD_BINARYOP_DEFINE(Mul,TYPECODE,PLANK_VSIMD(TYPECODE,MUL)(va, vb))\
+    PLANK_VSIMD_BINARYOP_DEFINE(Div,TYPECODE,PLANK_VSIMD(TYPECODE,DIV)(va, vb))\
+    PLANK_VECTORBINARYOP_DEFINE(Mod,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Min,TYPECODE,PLANK_VSIMD(TYPECODE,MIN)(va, vb))\
+    PLANK_VSIMD_BINARYOP_DEFINE(Max,TYPECODE,PLANK_VSIMD(TYPECODE,MAX)(va, vb))\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(IsEqualTo,TYPECODE,PLANK_VSIMD_BOOL(TYPECODE, PLANK_VSIMD(TYPECODE,CMPEQ)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsNotEqualTo,TYPECODE,PLANK_VSIMD_BOOL(TYPECODE, PLANK_VSIMD(TYPECODE,CMPNE)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsGreaterThan,TYPECODE,PLANK_VSIMD_BOOL(TYPECODE, PLANK_VSIMD(TYPECODE,CMPGT)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsGreaterThanOrEqualTo,TYPECODE,PLANK_VSIMD_BOOL(TYPECODE, PLANK_VSIMD(TYPECODE,CMPGE)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsLessThan,TYPECODE,PLANK_VSIMD_BOOL(TYPECODE, PLANK_VSIMD(TYPECODE,CMPLT)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsLessThanOrEqualTo,TYPECODE,PLANK_VSIMD_BOOL(TYPECODE, PLANK_VSIMD(TYPECODE,CMPLE)(va, vb)))\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(SumSqr,TYPECODE,PLANK_VSIMD(TYPECODE,ADD)(PLANK_VSIMD(TYPECODE,MUL)(va, va), PLANK_VSIMD(TYPECODE,MUL)(vb, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(DifSqr,TYPECODE,PLANK_VSIMD(TYPECODE,SUB)(PLANK_VSIMD(TYPECODE,MUL)(va, va), PLANK_VSIMD(TYPECODE,MUL)(vb, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(SqrSum,TYPECODE,PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,ADD)(va, vb), PLANK_VSIMD(TYPECODE,ADD)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(SqrDif,TYPECODE,PLANK_VSIMD(TYPECODE,MUL)(PLANK_VSIMD(TYPECODE,SUB)(va, vb), PLANK_VSIMD(TYPECODE,SUB)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(AbsDif,TYPECODE,PLANK_VSIMD(TYPECODE,ANDNOT)(PLANK_VSIMD_SIGNBIT(TYPECODE), PLANK_VSIMD(TYPECODE,SUB)(va, vb)))\
+    PLANK_VSIMD_BINARYOP_DEFINE(Thresh,TYPECODE,PLANK_VSIMD(TYPECODE,ANDNOT)(PLANK_VSIMD(TYPECODE,CMPLT)(va, vb), va))\
+    \
+    PLANK_VSIMD_MULADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_MULADDINPLACE_DEFINE(TYPECODE)\
+    PLANK_VSIMD_MULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_SCALARMULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_SCALARMULADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_HSUM_DEFINE(TYPECODE)\
+    PLANK_VSIMD_ADDVECTORMUL_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_LOOKUP_DEFINE(TYPECODE)\
+    PLANK_VSIMD_MEAN_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORUNARYOP_DEFINE(Log2,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sin,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Cos,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Tan,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Asin,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Acos,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Atan,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sinh,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Cosh,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Tanh,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Log,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Log10,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Exp,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(M2F,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(F2M,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(A2dB,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(dB2A,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(D2R,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(R2D,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Distort,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Zap,TYPECODE)\
+    \
+    PLANK_VECTORBINARYOP_DEFINE(Pow,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Hypot,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Atan2,TYPECODE)\
+    \
+    PLANK_VSIMD_ZMUL_DEFINE(TYPECODE)\
+    PLANK_VSIMD_ZMULADD_DEFINE(TYPECODE)
+
+#if PLANK_VSIMD_HASROUND
+    #define PLANK_VSIMD_OPS_ROUND(TYPECODE)\
+        PLANK_VSIMD_UNARYOP_DEFINE(Ceil,TYPECODE,PLANK_VSIMD(TYPECODE,CEIL)(va))\
+        PLANK_VSIMD_UNARYOP_DEFINE(Floor,TYPECODE,PLANK_VSIMD(TYPECODE,FLOOR)(va))\
+        PLANK_VSIMD_UNARYOP_DEFINE(Frac,TYPECODE,PLANK_VSIMD(TYPECODE,SUB)(va, PLANK_VSIMD(TYPECODE,FLOOR)(va)))
+#else
+    #define PLANK_VSIMD_OPS_ROUND(TYPECODE)\
+        PLANK_VECTORUNARYOP_DEFINE(Ceil,TYPECODE)\
+        PLANK_VECTORUNARYOP_DEFINE(Floor,TYPECODE)\
+        PLANK_VECTORUNARYOP_DEFINE(Frac,TYPECODE)
+#endif
+
+// short and int only get the simple arithmetic in the vector unit, the rest matches plank_Vectors.h
+#define PLANK_VSIMD_OPS_INTEGER(TYPECODE)\
+    PLANK_VSIMD_FILL_DEFINE(TYPECODE)\
+    PLANK_VSIMD_CLEAR_DEFINE(TYPECODE)\
+    PLANK_VECTORRAMP_DEFINE(TYPECODE)\
+    PLANK_VECTORRAMPMUL_DEFINE(TYPECODE)\
+    PLANK_VECTORLINE_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_UNARYOP_DEFINE(Move,TYPECODE,va)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Inc,TYPECODE,PLANK_VSIMD(TYPECODE,ADD)(va, PLANK_VSIMD_ONE(TYPECODE)))\
+    PLANK_VSIMD_UNARYOP_DEFINE(Dec,TYPECODE,PLANK_VSIMD(TYPECODE,SUB)(va, PLANK_VSIMD_ONE(TYPECODE)))\
+    PLANK_VECTORUNARYOP_DEFINE(Neg,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Abs,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Squared,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Cubed,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sign,TYPECODE)\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(Add,TYPECODE,PLANK_VSIMD(TYPECODE,ADD)(va, vb))\
+    PLANK_VSIMD_BINARYOP_DEFINE(Sub,TYPECODE,PLANK_VSIMD(TYPECODE,SUB)(va, vb))\
+    PLANK_VECTORBINARYOP_DEFINE(Mul,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Div,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Mod,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Min,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Max,TYPECODE)\
+    \
+    PLANK_VECTORBINARYOP_DEFINE(IsEqualTo,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsNotEqualTo,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsGreaterThan,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsGreaterThanOrEqualTo,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsLessThan,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsLessThanOrEqualTo,TYPECODE)\
+    \
+    PLANK_VECTORBINARYOP_DEFINE(SumSqr,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(DifSqr,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(SqrSum,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(SqrDif,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(AbsDif,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Thresh,TYPECODE)\
+    \
+    PLANK_VECTORMULADD_DEFINE(TYPECODE)\
+    PLANK_VECTORMULADDINPLACE_DEFINE(TYPECODE)\
+    PLANK_VECTORMULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VECTORSCALARMULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VECTORSCALARMULADD_DEFINE(TYPECODE)\
+    PLANK_VECTORADDVECTORMUL_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORLOOKUP_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORMEAN_DEFINE(TYPECODE)
+
+//------------------------------- ops ------------------------------------------
+
+PLANK_VSIMD_OPS_FLOATING(F)
+PLANK_VSIMD_OPS_ROUND(F)
+PLANK_VSIMD_OPS_FLOATING(D)
+PLANK_VSIMD_OPS_ROUND(D)
+PLANK_VSIMD_OPS_INTEGER(S)
+PLANK_VSIMD_OPS_INTEGER(I)
+PLANK_VECTOR_OPS_COMMON(LL)
+
+//---------------------------- interleave --------------------------------------
+
+static PLANK_INLINE_MID void pl_VectorInterleave2F_Nnn (float *result, const float *splitA, const float *splitB, PlankUL n)
+{
+    PlankUL i;
+    const PlankUL numSIMD = n >> 2;
+    
+    for (i = 0; i < numSIMD; ++i, result += 8, splitA += 4, splitB += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 a = _mm_loadu_ps (splitA);
+        const __m128 b = _mm_loadu_ps (splitB);
+        _mm_storeu_ps (result,     _mm_unpacklo_ps (a, b));
+        _mm_storeu_ps (result + 4, _mm_unpackhi_ps (a, b));
+#else
+        float32x4x2_t ab;
+        ab.val[0] = vld1q_f32 (splitA);
+        ab.val[1] = vld1q_f32 (splitB);
+        vst2q_f32 (result, ab);
+#endif
+    }
+    
+    for (i = n & 3; i > 0; --i)
+    {
+        *result++ = *splitA++;
+        *result++ = *splitB++;
+    }
+}
+
+static PLANK_INLINE_MID void pl_VectorDeinterleave2F_nnN (float *resultA, float *resultB, const float *input, PlankUL n)
+{
+    PlankUL i;
+    const PlankUL numSIMD = n >> 2;
+    
+    for (i = 0; i < numSIMD; ++i, resultA += 4, resultB += 4, input += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 x = _mm_loadu_ps (input);
+        const __m128 y = _mm_loadu_ps (input + 4);
+        _mm_storeu_ps (resultA, _mm_shuffle_ps (x, y, _MM_SHUFFLE (2, 0, 2, 0)));
+        _mm_storeu_ps (resultB, _mm_shuffle_ps (x, y, _MM_SHUFFLE (3, 1, 3, 1)));
+#else
+        const float32x4x2_t ab = vld2q_f32 (input);
+        vst1q_f32 (resultA, ab.val[0]);
+        vst1q_f32 (resultB, ab.val[1]);
+#endif
+    }
+    
+    for (i = n & 3; i > 0; --i)
+    {
+        *resultA++ = *input++;
+        *resultB++ = *input++;
+    }
+}
+
+static PLANK_INLINE_MID void pl_VectorInterleave2D_Nnn (double *result, const double *splitA, const double *splitB, PlankUL n)
+{
+    PlankUL i;
+    const PlankUL numSIMD = n >> 1;
+    
+    for (i = 0; i < numSIMD; ++i, result += 4, splitA += 2, splitB += 2)
+    {
+#if PLANK_VSIMD_X86
+        const __m128d a = _mm_loadu_pd (splitA);
+        const __m128d b = _mm_loadu_pd (splitB);
+        _mm_storeu_pd (result,     _mm_unpacklo_pd (a, b));
+        _mm_storeu_pd (result + 2, _mm_unpackhi_pd (a, b));
+#else
+        float64x2x2_t ab;
+        ab.val[0] = vld1q_f64 (splitA);
+        ab.val[1] = vld1q_f64 (splitB);
+        vst2q_f64 (result, ab);
+#endif
+    }
+    
+    if (n & 1)
+    {
+        *result++ = *splitA;
+        *result   = *splitB;
+    }
+}
+
+static PLANK_INLINE_MID void pl_VectorDeinterleave2D_nnN (double *resultA, double *resultB, const double *input, PlankUL n)
+{
+    PlankUL i;
+    const PlankUL numSIMD = n >> 1;
+    
+    for (i = 0; i < numSIMD; ++i, resultA += 2, resultB += 2, input += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128d x = _mm_loadu_pd (input);
+        const __m128d y = _mm_loadu_pd (input + 2);
+        _mm_storeu_pd (resultA, _mm_unpacklo_pd (x, y));
+        _mm_storeu_pd (resultB, _mm_unpackhi_pd (x, y));
+#else
+        const float64x2x2_t ab = vld2q_f64 (input);
+        vst1q_f64 (resultA, ab.val[0]);
+        vst1q_f64 (resultB, ab.val[1]);
+#endif
+    }
+    
+    if (n & 1)
+    {
+        *resultA = *input++;
+        *resultB = *input;
+    }
+}
+
+//---------------------------- converters --------------------------------------
+
+// direct conversions to and from int, the other pairs go via an int buffer
+// conversions narrowing to short or char wrap rather than saturate to match the C casts
+
+static PLANK_INLINE_MID void pl_VectorConvertI2F_NN (float *result, const int* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 2;
+    
+    for (i = 0; i < numSIMD; ++i, result += 4, a += 4)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storeu_ps (result, _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*)a)));
+#else
+        vst1q_f32 (result, vcvtq_f32_s32 (vld1q_s32 (a)));
+#endif
+    }
+    
+    for (i = N & 3; i > 0; --i)
+        *result++ = (float)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertF2I_NN (int *result, const float* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 2;
+    
+    for (i = 0; i < numSIMD; ++i, result += 4, a += 4)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storeu_si128 ((__m128i*)result, _mm_cvttps_epi32 (_mm_loadu_ps (a)));
+#else
+        vst1q_s32 (result, vcvtq_s32_f32 (vld1q_f32 (a)));
+#endif
+    }
+    
+    for (i = N & 3; i > 0; --i)
+        *result++ = (int)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertI2D_NN (double *result, const int* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 1;
+    
+    for (i = 0; i < numSIMD; ++i, result += 2, a += 2)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storeu_pd (result, _mm_cvtepi32_pd (_mm_loadl_epi64 ((const __m128i*)a)));
+#else
+        vst1q_f64 (result, vcvtq_f64_s64 (vmovl_s32 (vld1_s32 (a))));
+#endif
+    }
+    
+    if (N & 1)
+        *result = (double)*a;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertD2I_NN (int *result, const double* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 1;
+    
+    for (i = 0; i < numSIMD; ++i, result += 2, a += 2)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storel_epi64 ((__m128i*)result, _mm_cvttpd_epi32 (_mm_loadu_pd (a)));
+#else
+        vst1_s32 (result, vmovn_s64 (vcvtq_s64_f64 (vld1q_f64 (a))));
+#endif
+    }
+    
+    if (N & 1)
+        *result = (int)*a;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertF2D_NN (double *result, const float* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 2;
+    
+    for (i = 0; i < numSIMD; ++i, result += 4, a += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 x = _mm_loadu_ps (a);
+        _mm_storeu_pd (result,     _mm_cvtps_pd (x));
+        _mm_storeu_pd (result + 2, _mm_cvtps_pd (_mm_movehl_ps (x, x)));
+#else
+        const float32x4_t x = vld1q_f32 (a);
+        vst1q_f64 (result,     vcvt_f64_f32 (vget_low_f32 (x)));
+        vst1q_f64 (result + 2, vcvt_high_f64_f32 (x));
+#endif
+    }
+    
+    for (i = N & 3; i > 0; --i)
+        *result++ = (double)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertD2F_NN (float *result, const double* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 2;
+    
+    for (i = 0; i < numSIMD; ++i, result += 4, a += 4)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storeu_ps (result, _mm_movelh_ps (_mm_cvtpd_ps (_mm_loadu_pd (a)), _mm_cvtpd_ps (_mm_loadu_pd (a + 2))));
+#else
+        vst1q_f32 (result, vcvt_high_f32_f64 (vcvt_f32_f64 (vld1q_f64 (a)), vld1q_f64 (a + 2)));
+#endif
+    }
+    
+    for (i = N & 3; i > 0; --i)
+        *result++ = (float)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertS2I_NN (int *result, const short* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 3;
+    
+    for (i = 0; i < numSIMD; ++i, result += 8, a += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i x = _mm_loadu_si128 ((const __m128i*)a);
+        _mm_storeu_si128 ((__m128i*)result,       _mm_srai_epi32 (_mm_unpacklo_epi16 (x, x), 16));
+        _mm_storeu_si128 ((__m128i*)(result + 4), _mm_srai_epi32 (_mm_unpackhi_epi16 (x, x), 16));
+#else
+        const int16x8_t x = vld1q_s16 (a);
+        vst1q_s32 (result,     vmovl_s16 (vget_low_s16 (x)));
+        vst1q_s32 (result + 4, vmovl_high_s16 (x));
+#endif
+    }
+    
+    for (i = N & 7; i > 0; --i)
+        *result++ = (int)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertI2S_NN (short *result, const int* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 3;
+    
+    for (i = 0; i < numSIMD; ++i, result += 8, a += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i lo = _mm_srai_epi32 (_mm_slli_epi32 (_mm_loadu_si128 ((const __m128i*)a), 16), 16);
+        const __m128i hi = _mm_srai_epi32 (_mm_slli_epi32 (_mm_loadu_si128 ((const __m128i*)(a + 4)), 16), 16);
+        _mm_storeu_si128 ((__m128i*)result, _mm_packs_epi32 (lo, hi));
+#else
+        vst1q_s16 (result, vmovn_high_s32 (vmovn_s32 (vld1q_s32 (a)), vld1q_s32 (a + 4)));
+#endif
+    }
+    
+    for (i = N & 7; i > 0; --i)
+        *result++ = (short)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertC2I_NN (int *result, const char* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 3;
+    
+    for (i = 0; i < numSIMD; ++i, result += 8, a += 8)
+    {
+#if PLANK_VSIMD_X86
+        __m128i x = _mm_loadl_epi64 ((const __m128i*)a);
+    #if CHAR_MIN < 0
+        x = _mm_srai_epi16 (_mm_unpacklo_epi8 (x, x), 8);
+    #else
+        x = _mm_unpacklo_epi8 (x, _mm_setzero_si128());
+    #endif
+        _mm_storeu_si128 ((__m128i*)result,       _mm_srai_epi32 (_mm_unpacklo_epi16 (x, x), 16));
+        _mm_storeu_si128 ((__m128i*)(result + 4), _mm_srai_epi32 (_mm_unpackhi_epi16 (x, x), 16));
+#else
+    #if CHAR_MIN < 0
+        const int16x8_t x = vmovl_s8 (vld1_s8 ((const int8_t*)a));
+    #else
+        const int16x8_t x = vreinterpretq_s16_u16 (vmovl_u8 (vld1_u8 ((const uint8_t*)a)));
+    #endif
+        vst1q_s32 (result,     vmovl_s16 (vget_low_s16 (x)));
+        vst1q_s32 (result + 4, vmovl_high_s16 (x));
+#endif
+    }
+    
+    for (i = N & 7; i > 0; --i)
+        *result++ = (int)*a++;
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertI2C_NN (char *result, const int* a, PlankUL N)
+{
+    PlankUL i;
+    const PlankUL numSIMD = N >> 3;
+    
+    for (i = 0; i < numSIMD; ++i, result += 8, a += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i lo = _mm_srai_epi32 (_mm_slli_epi32 (_mm_loadu_si128 ((const __m128i*)a), 24), 24);
+        const __m128i hi = _mm_srai_epi32 (_mm_slli_epi32 (_mm_loadu_si128 ((const __m128i*)(a + 4)), 24), 24);
+        const __m128i s  = _mm_packs_epi32 (lo, hi);
+        _mm_storel_epi64 ((__m128i*)result, _mm_packs_epi16 (s, s));
+#else
+        const int16x8_t s = vmovn_high_s32 (vmovn_s32 (vld1q_s32 (a)), vld1q_s32 (a + 4));
+        vst1_s8 ((int8_t*)result, vmovn_s16 (s));
+#endif
+    }
+    
+    for (i = N & 7; i > 0; --i)
+        *result++ = (char)*a++;
+}
+
+#define PLANK_VSIMD_CONVERTCHUNK 256
+
+#define PLANK_VSIMD_CONVERTVIA_DEFINE(DSTTYPECODE,SRCTYPECODE,VIATYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORCONVERT_NAME(DSTTYPECODE,SRCTYPECODE) (Plank##DSTTYPECODE *result, const Plank##SRCTYPECODE* a, PlankUL N) {\
+        PLANK_ALIGN(16) Plank##VIATYPECODE temp[PLANK_VSIMD_CONVERTCHUNK];\
+        PlankUL n;\
+        while (N > 0) {\
+            n = N < PLANK_VSIMD_CONVERTCHUNK ? N : PLANK_VSIMD_CONVERTCHUNK;\
+            PLANK_VECTORCONVERT_NAME(VIATYPECODE,SRCTYPECODE) (temp, a, n);\
+            PLANK_VECTORCONVERT_NAME(DSTTYPECODE,VIATYPECODE) (result, temp, n);\
+            result += n; a += n; N -= n;\
+        }\
+    }
+
+#define PLANK_VSIMD_CONVERTROUND_DEFINE(DSTTYPECODE,SRCTYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORCONVERTROUND_NAME(DSTTYPECODE,SRCTYPECODE) (Plank##DSTTYPECODE *result, const Plank##SRCTYPECODE* a, PlankUL N) {\
+        PLANK_VECTORCONVERT_NAME(DSTTYPECODE,SRCTYPECODE) (result, a, N);\
+        PLANK_VECTORBINARYOPSCALAR_NAME(Add,DSTTYPECODE) (result, result, (Plank##DSTTYPECODE)0.5, N);\
+    }
+
+PLANK_VSIMD_CONVERTVIA_DEFINE(S,C,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(F,C,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(D,C,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(C,S,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(F,S,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(D,S,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(C,F,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(S,F,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(C,D,I)
+PLANK_VSIMD_CONVERTVIA_DEFINE(S,D,I)
+
+// there are no 64-bit int conversions before AVX-512 so these remain scalar
+PLANK_VECTORCONVERT_DEFINE(LL,C)
+PLANK_VECTORCONVERT_DEFINE(LL,I)
+PLANK_VECTORCONVERT_DEFINE(LL,S)
+PLANK_VECTORCONVERT_DEFINE(LL,F)
+PLANK_VECTORCONVERT_DEFINE(LL,D)
+PLANK_VECTORCONVERT_DEFINE(C,LL)
+PLANK_VECTORCONVERT_DEFINE(I,LL)
+PLANK_VECTORCONVERT_DEFINE(S,LL)
+PLANK_VECTORCONVERT_DEFINE(F,LL)
+PLANK_VECTORCONVERT_DEFINE(D,LL)
+
+PLANK_VSIMD_CONVERTROUND_DEFINE(F,C)
+PLANK_VSIMD_CONVERTROUND_DEFINE(F,I)
+PLANK_VSIMD_CONVERTROUND_DEFINE(F,S)
+PLANK_VECTORCONVERTROUNDF_DEFINE(LL)
+PLANK_VSIMD_CONVERTROUND_DEFINE(D,C)
+PLANK_VSIMD_CONVERTROUND_DEFINE(D,I)
+PLANK_VSIMD_CONVERTROUND_DEFINE(D,S)
+PLANK_VECTORCONVERTROUNDD_DEFINE(LL)
+
+#endif // !DOXYGEN
+#endif // PLANK_VSIMD_H
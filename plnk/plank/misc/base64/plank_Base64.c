@@ -43,14 +43,44 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#if defined(__SSSE3__)
+    #include <tmmintrin.h>
+    #define PLANK_BASE64_SSSE3 1
+#endif
+
+#define PLANK_BASE64_FILECHUNKSIZE 768 // binary bytes per chunk when encoding or decoding files, a multiple of 3
+
 typedef struct PlankBase64Tables
 {
-    const char decoding[256];
+    const PlankUC decoding[256];    // 0xFF marks characters that are not in the alphabet
     const char encoding[64 + 16];
 } PlankBase64Tables;
 
+static const PlankBase64Tables pl_Base64TablesData =
+{
+    {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+        0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+    },
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+};
+
 PlankL pl_Base64EncodedLength (const PlankL inputLength)
-{    
+{
     return (inputLength % 3) ? (4 * (inputLength / 3 + 1)) : (4 * (inputLength / 3));
 }
 
@@ -59,36 +89,229 @@ PlankL pl_Base64DecodedLength (const PlankL inputLength)
     return inputLength / 4 * 3;
 }
 
-static void pl_Base64TablesInit (PlankBase64Tables* tables)
+static const PlankBase64Tables* pl_Base64Tables()
+{
+    return &pl_Base64TablesData;
+}
+
+#if PLANK_BASE64_SSSE3
+// 12 bytes (the low 12 bytes of the input) to 16 characters
+static PLANK_INLINE_LOW __m128i pl_Base64EncodeSSSE3 (__m128i input)
 {
-    int i;
-    
-    // overflow by 1 on the null is OK as long as mod is after it and done last
-    strcpy ((char*)tables->encoding, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+    __m128i t0, t1, t2, t3, indices, offsets, less;
 
-    for (i = 0; i < 64; ++i)
-        ((char*)(tables->decoding))[tables->encoding[i]] = i;
+    // spread each 3 byte group over 4 bytes then move each sextet into its own byte
+    input = _mm_shuffle_epi8 (input, _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    t0 = _mm_and_si128 (input, _mm_set1_epi32 (0x0fc0fc00));
+    t1 = _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+    t2 = _mm_and_si128 (input, _mm_set1_epi32 (0x003f03f0));
+    t3 = _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+    indices = _mm_or_si128 (t1, t3);
+
+    // 0-25 -> 13, 26-51 -> 0, 52-63 -> 1-12 then look up the offset to the character
+    offsets = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+    less = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices);
+    offsets = _mm_or_si128 (offsets, _mm_and_si128 (less, _mm_set1_epi8 (13)));
+    offsets = _mm_shuffle_epi8 (_mm_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                               '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                               '/' - 63, 'A', 0, 0),
+                                offsets);
+
+    return _mm_add_epi8 (indices, offsets);
 }
 
-static const PlankBase64Tables* pl_Base64Tables()
+// 16 characters to 12 bytes (the low 12 bytes of the result), invalid is non-zero if any character is not in the alphabet
+static PLANK_INLINE_LOW __m128i pl_Base64DecodeSSSE3 (__m128i input, int* invalid)
+{
+    __m128i isUpper, isLower, isDigit, isPlus, isSlash, valid, shift, merged;
+
+    // characters >= 0x80 are negative here so fall outside every range
+    isUpper = _mm_and_si128 (_mm_cmpgt_epi8 (input, _mm_set1_epi8 ('A' - 1)), _mm_cmplt_epi8 (input, _mm_set1_epi8 ('Z' + 1)));
+    isLower = _mm_and_si128 (_mm_cmpgt_epi8 (input, _mm_set1_epi8 ('a' - 1)), _mm_cmplt_epi8 (input, _mm_set1_epi8 ('z' + 1)));
+    isDigit = _mm_and_si128 (_mm_cmpgt_epi8 (input, _mm_set1_epi8 ('0' - 1)), _mm_cmplt_epi8 (input, _mm_set1_epi8 ('9' + 1)));
+    isPlus  = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('+'));
+    isSlash = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('/'));
+
+    valid = _mm_or_si128 (_mm_or_si128 (isUpper, isLower), _mm_or_si128 (_mm_or_si128 (isDigit, isPlus), isSlash));
+    *invalid = _mm_movemask_epi8 (valid) ^ 0xFFFF;
+
+    shift = _mm_and_si128 (isUpper, _mm_set1_epi8 (-'A'));
+    shift = _mm_or_si128 (shift, _mm_and_si128 (isLower, _mm_set1_epi8 (26 - 'a')));
+    shift = _mm_or_si128 (shift, _mm_and_si128 (isDigit, _mm_set1_epi8 (52 - '0')));
+    shift = _mm_or_si128 (shift, _mm_and_si128 (isPlus, _mm_set1_epi8 (62 - '+')));
+    shift = _mm_or_si128 (shift, _mm_and_si128 (isSlash, _mm_set1_epi8 (63 - '/')));
+
+    // pack the four sextets in each 32 bits into 24 bits then into big endian byte order
+    merged = _mm_maddubs_epi16 (_mm_add_epi8 (input, shift), _mm_set1_epi32 (0x01400140));
+    merged = _mm_madd_epi16 (merged, _mm_set1_epi32 (0x00011000));
+
+    return _mm_shuffle_epi8 (merged, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+#endif
+
+PlankL pl_Base64_EncodeData (char* text, const void* binary, const PlankL binaryLength)
+{
+    const PlankUC* src;
+    const char* table;
+    char* dst;
+    PlankL remaining;
+    PlankUI triple;
+
+    src = (const PlankUC*)binary;
+    dst = text;
+    remaining = binaryLength;
+    table = pl_Base64Tables()->encoding;
+
+#if PLANK_BASE64_SSSE3
+    // each load reads 16 bytes but only uses 12
+    while (remaining >= 16)
+    {
+        _mm_storeu_si128 ((__m128i*)dst, pl_Base64EncodeSSSE3 (_mm_loadu_si128 ((const __m128i*)src)));
+        src += 12;
+        dst += 16;
+        remaining -= 12;
+    }
+#endif
+
+    while (remaining >= 3)
+    {
+        triple = ((PlankUI)src[0] << 0x10) | ((PlankUI)src[1] << 0x08) | (PlankUI)src[2];
+
+        dst[0] = table[(triple >> 3 * 6) & 0x3F];
+        dst[1] = table[(triple >> 2 * 6) & 0x3F];
+        dst[2] = table[(triple >> 1 * 6) & 0x3F];
+        dst[3] = table[(triple >> 0 * 6) & 0x3F];
+
+        src += 3;
+        dst += 4;
+        remaining -= 3;
+    }
+
+    if (remaining > 0)
+    {
+        triple = ((PlankUI)src[0] << 0x10) | ((remaining > 1) ? ((PlankUI)src[1] << 0x08) : 0);
+
+        dst[0] = table[(triple >> 3 * 6) & 0x3F];
+        dst[1] = table[(triple >> 2 * 6) & 0x3F];
+        dst[2] = (remaining > 1) ? table[(triple >> 1 * 6) & 0x3F] : '=';
+        dst[3] = '=';
+
+        dst += 4;
+    }
+
+    return (PlankL)(dst - text);
+}
+
+PlankResult pl_Base64_DecodeData (void* binary, const char* text, const PlankL textLength, PlankL* binaryLengthOut)
 {
-    static PlankB firstTime = PLANK_TRUE;
-    static PlankBase64Tables tables;
-    
-    if (firstTime)
+    PlankResult result;
+    const PlankUC* table;
+    const PlankUC* src;
+    const PlankUC* last;
+    PlankUC* dst;
+    PlankUI sextetA, sextetB, sextetC, sextetD, triple;
+    int code, binaryBytes;
+#if PLANK_BASE64_SSSE3
+    int invalid;
+#endif
+
+    result = PlankResult_OK;
+    *binaryLengthOut = 0;
+
+    if ((textLength % 4) != 0)
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+
+    if (textLength == 0)
+        goto exit;
+
+    table = pl_Base64Tables()->decoding;
+    src = (const PlankUC*)text;
+    dst = (PlankUC*)binary;
+    last = src + textLength - 4; // only the last quad may be padded
+
+#if PLANK_BASE64_SSSE3
+    // each store writes 16 bytes but only 12 are used, stop while there is enough text left that this stays inside the output
+    while ((last - src) >= 20)
+    {
+        _mm_storeu_si128 ((__m128i*)dst, pl_Base64DecodeSSSE3 (_mm_loadu_si128 ((const __m128i*)src), &invalid));
+
+        if (invalid)
+        {
+            result = PlankResult_Base64Error;
+            goto exit;
+        }
+
+        src += 16;
+        dst += 12;
+    }
+#endif
+
+    while (src < last)
+    {
+        sextetA = table[src[0]];
+        sextetB = table[src[1]];
+        sextetC = table[src[2]];
+        sextetD = table[src[3]];
+
+        if ((sextetA | sextetB | sextetC | sextetD) & 0x80)
+        {
+            result = PlankResult_Base64Error;
+            goto exit;
+        }
+
+        triple = (sextetA << 3 * 6) | (sextetB << 2 * 6) | (sextetC << 1 * 6) | sextetD;
+
+        dst[0] = (PlankUC)(triple >> 2 * 8);
+        dst[1] = (PlankUC)(triple >> 1 * 8);
+        dst[2] = (PlankUC)(triple >> 0 * 8);
+
+        src += 4;
+        dst += 3;
+    }
+
+    code = (src[2] == '=' ? 0x02 : 0x00) | (src[3] == '=' ? 0x01 : 0x00);
+
+    switch (code)
+    {
+        case 0x00: binaryBytes = 3; break;
+        case 0x01: binaryBytes = 2; break;
+        case 0x03: binaryBytes = 1; break;
+        default:
+            result = PlankResult_Base64Error;
+            goto exit;
+    }
+
+    sextetA = table[src[0]];
+    sextetB = table[src[1]];
+    sextetC = (binaryBytes > 1) ? table[src[2]] : 0;
+    sextetD = (binaryBytes > 2) ? table[src[3]] : 0;
+
+    if ((sextetA | sextetB | sextetC | sextetD) & 0x80)
     {
-        pl_Base64TablesInit (&tables);
-        firstTime = PLANK_FALSE;
+        result = PlankResult_Base64Error;
+        goto exit;
     }
-    
-    return &tables;
+
+    triple = (sextetA << 3 * 6) | (sextetB << 2 * 6) | (sextetC << 1 * 6) | sextetD;
+
+    dst[0] = (PlankUC)(triple >> 2 * 8);
+    if (binaryBytes > 1) dst[1] = (PlankUC)(triple >> 1 * 8);
+    if (binaryBytes > 2) dst[2] = (PlankUC)(triple >> 0 * 8);
+
+    *binaryLengthOut = (PlankL)(dst - (PlankUC*)binary) + binaryBytes;
+
+exit:
+    return result;
 }
 
 PlankResult pl_Base64_Init (PlankBase64Ref p)
 {
     if (p == PLANK_NULL)
         return PlankResult_MemoryError;
-        
+
     return pl_DynamicArray_InitWithItemSize (&p->buffer, 1);
 }
 
@@ -96,88 +319,83 @@ PlankResult pl_Base64_DeInit (PlankBase64Ref p)
 {
     if (p == PLANK_NULL)
         return PlankResult_MemoryError;
-    
+
     return pl_DynamicArray_DeInit (&p->buffer);
 }
 
+// reads until the buffer is full or the file ends so only the final chunk can be short
+static PlankResult pl_Base64FileReadChunk (PlankFileRef f, void* data, const int maximumBytes, int* bytesReadOut)
+{
+    PlankResult result;
+    int bytesRead, total;
+
+    result = PlankResult_OK;
+    total = 0;
+
+    while (total < maximumBytes)
+    {
+        bytesRead = 0;
+        result = pl_File_Read (f, (PlankUC*)data + total, maximumBytes - total, &bytesRead);
+        total += bytesRead;
+
+        if (result == PlankResult_FileEOF)
+        {
+            result = PlankResult_OK;
+            break;
+        }
+        else if (result != PlankResult_OK)
+        {
+            break;
+        }
+        else if (bytesRead == 0)
+        {
+            break;
+        }
+    }
+
+    *bytesReadOut = total;
+
+    return result;
+}
+
 PlankResult pl_Base64_EncodeFile (PlankBase64Ref p, PlankFileRef outputTextFile, PlankFileRef inputBinaryFile)
 {
     PlankResult result;
-    PlankUI octetA, octetB, octetC, triple;
-    const char* table;
-    int outputMode, inputMode, pad;
-    PlankUC data;
-    PlankC char0, char1, char2, char3;
-    
+    PlankUC binary[PLANK_BASE64_FILECHUNKSIZE];
+    char text[PLANK_BASE64_FILECHUNKSIZE / 3 * 4];
+    int outputMode, inputMode, bytesRead;
+    PlankL textLength;
+
 	(void)p;
 
     result = PlankResult_OK;
     if ((result = pl_File_GetMode (outputTextFile, &outputMode)) != PlankResult_OK) goto exit;
     if ((result = pl_File_GetMode (inputBinaryFile, &inputMode)) != PlankResult_OK) goto exit;
-    
+
     if (! ((outputMode & PLANKFILE_WRITE) && (outputMode & ~PLANKFILE_BINARY)))
     {
         result = PlankResult_FileWriteError;
         goto exit;
     }
-    
+
     if (! ((inputMode & PLANKFILE_READ) && (inputMode & PLANKFILE_BINARY)))
     {
         result = PlankResult_FileReadError;
         goto exit;
     }
-    
-    table = pl_Base64Tables()->encoding;
-    
-    while (! pl_File_IsEOF (inputBinaryFile))
+
+    // whole chunks are a multiple of 3 bytes so only the final chunk can be padded
+    do
     {
-        pad = 0;
-                
-        if ((result = pl_File_ReadUC (inputBinaryFile, &data)) == PlankResult_OK)
-        {
-            octetA = data;
-        }
-        else goto exit;
+        if ((result = pl_Base64FileReadChunk (inputBinaryFile, binary, sizeof (binary), &bytesRead)) != PlankResult_OK) goto exit;
 
-        if ((result = pl_File_ReadUC (inputBinaryFile, &data)) == PlankResult_OK)
-        {
-            octetB = data;
-        }
-        else if (result == PlankResult_FileEOF)
-        {
-            octetB = 0;
-            octetC = 0;
-            pad = 2;
-            goto encode;
-        }
-        else goto exit;
-        
-        if ((result = pl_File_ReadUC (inputBinaryFile, &data)) == PlankResult_OK)
+        if (bytesRead > 0)
         {
-            octetC = data;
+            textLength = pl_Base64_EncodeData (text, binary, bytesRead);
+            if ((result = pl_File_Write (outputTextFile, text, (int)textLength)) != PlankResult_OK) goto exit;
         }
-        else if (result == PlankResult_FileEOF)
-        {
-            octetC = 0;
-            pad = 1;
-            goto encode;
-        }
-        else goto exit;
-        
-    encode:
-        triple = (octetA << 0x10) + (octetB << 0x08) + octetC;
-
-        char0 = table[(triple >> 3 * 6) & 0x3F];
-        char1 = table[(triple >> 2 * 6) & 0x3F];
-        char2 = (pad == 2) ? '=' : table[(triple >> 1 * 6) & 0x3F];
-        char3 = (pad >  0) ? '=' : table[(triple >> 0 * 6) & 0x3F];
-        
-        if ((result = pl_File_WriteC (outputTextFile, char0)) != PlankResult_OK) goto exit;
-        if ((result = pl_File_WriteC (outputTextFile, char1)) != PlankResult_OK) goto exit;
-        if ((result = pl_File_WriteC (outputTextFile, char2)) != PlankResult_OK) goto exit;
-        if ((result = pl_File_WriteC (outputTextFile, char3)) != PlankResult_OK) goto exit;
-    }
-    
+    } while (bytesRead == (int)sizeof (binary));
+
 exit:
     return result;
 }
@@ -185,92 +403,40 @@ exit:
 PlankResult pl_Base64_DecodeFile (PlankBase64Ref p, PlankFileRef outputBinaryFile, PlankFileRef inputTextFile)
 {
     PlankResult result;
-    PlankUI sextetA, sextetB, sextetC, sextetD, triple, code;
-    const char* table;
-    int outputMode, inputMode, bytesRead, binaryBytes;
-    PlankC quad[4];
-    
+    char text[PLANK_BASE64_FILECHUNKSIZE / 3 * 4];
+    PlankUC binary[PLANK_BASE64_FILECHUNKSIZE];
+    int outputMode, inputMode, bytesRead;
+    PlankL binaryLength;
+
 	(void)p;
 
     result = PlankResult_OK;
     if ((result = pl_File_GetMode (inputTextFile, &inputMode)) != PlankResult_OK) goto exit;
     if ((result = pl_File_GetMode (outputBinaryFile, &outputMode)) != PlankResult_OK) goto exit;
-    
+
     if (! ((outputMode & PLANKFILE_WRITE) && (outputMode & PLANKFILE_BINARY)))
     {
         result = PlankResult_FileWriteError;
         goto exit;
     }
-    
+
     if (! ((inputMode & PLANKFILE_READ) && (inputMode & ~PLANKFILE_BINARY)))
     {
         result = PlankResult_FileReadError;
         goto exit;
     }
-    
-    table = pl_Base64Tables()->decoding;
-    
-    while (! pl_File_IsEOF (inputTextFile))
-    {
-        result = pl_File_Read (inputTextFile, quad, 4, &bytesRead);
-        
-        if ((result == PlankResult_FileEOF) || (bytesRead != 4))
-        {
-            result = PlankResult_ItemCountInvalid;
-            goto exit;
-        }
-        else if (bytesRead == 0)
-        {
-            continue;
-        }
 
-        sextetA = table[quad[0]];
-        sextetB = table[quad[1]];
-        code = (quad[2] == '=' ? 0x02 : 0x00) | (quad[3] == '=' ? 0x01 : 0x00);
-        
-        switch (code)
-        {
-            case 0x00:
-                sextetC = table[quad[2]];
-                sextetD = table[quad[3]];
-                binaryBytes = 3;
-                break;
-            case 0x01:
-                sextetC = table[quad[2]];
-                sextetD = 0;
-                binaryBytes = 2;
-                break;
-            case 0x03:
-                sextetC = 0;
-                sextetD = 0;
-                binaryBytes = 1;
-                break;
-            default:
-                result = PlankResult_UnknownError;
-                goto exit;
-        }
-            
-        triple = (sextetA << 3 * 6) + (sextetB << 2 * 6) + (sextetC << 1 * 6) + (sextetD << 0 * 6);
+    do
+    {
+        if ((result = pl_Base64FileReadChunk (inputTextFile, text, sizeof (text), &bytesRead)) != PlankResult_OK) goto exit;
 
-        if (binaryBytes-- > 0)
+        if (bytesRead > 0)
         {
-            result = pl_File_WriteUC (outputBinaryFile, (triple >> 2 * 8) & 0xFF);
-            if ((result != PlankResult_OK) && (result != PlankResult_FileEOF)) goto exit;
-        }
-        
-        if (binaryBytes-- > 0)
-        {
-            result = pl_File_WriteUC (outputBinaryFile, (triple >> 1 * 8) & 0xFF);
-            if ((result != PlankResult_OK) && (result != PlankResult_FileEOF)) goto exit;
+            if ((result = pl_Base64_DecodeData (binary, text, bytesRead, &binaryLength)) != PlankResult_OK) goto exit;
+            if ((result = pl_File_Write (outputBinaryFile, binary, (int)binaryLength)) != PlankResult_OK) goto exit;
         }
+    } while (bytesRead == (int)sizeof (text));
 
-        if (binaryBytes-- > 0)
-        {
-            result = pl_File_WriteUC (outputBinaryFile, (triple >> 0 * 8) & 0xFF);
-            if ((result != PlankResult_OK) && (result != PlankResult_FileEOF)) goto exit;
-        }
-    }
-    
 exit:
     return result;
 }
@@ -278,72 +444,41 @@ exit:
 const char* pl_Base64_Encode (PlankBase64Ref p, const void* binary, const PlankL binaryLength)
 {
     PlankResult result;
-    PlankFile binaryInputStream;
-    PlankFile textOutputStream;
     PlankL stringLength;
     char* string;
-    void* data;
-    int mode;
-    
+
     result = PlankResult_OK;
     string = (char*)PLANK_NULL;
     stringLength = pl_Base64EncodedLength (binaryLength);
-    
-    if ((result = pl_DynamicArray_SetSize (&p->buffer, stringLength + 1)) != PlankResult_OK) goto exit;    
-    if ((result = pl_File_Init (&binaryInputStream)) != PlankResult_OK) goto exit;
-    if ((result = pl_File_Init (&textOutputStream)) != PlankResult_OK) goto exit;
-    
-    mode = PLANKFILE_BINARY | PLANKFILE_READ | PLANKFILE_NATIVEENDIAN;
-    if ((result = pl_File_OpenMemory (&binaryInputStream, (void*)binary, (PlankLL)binaryLength, mode)) != PlankResult_OK) goto exit;
-
-    data = (void*)pl_DynamicArray_GetArray (&p->buffer);
-    
-    mode = PLANKFILE_WRITE;
-    if ((result = pl_File_OpenMemory (&textOutputStream, data, (PlankLL)stringLength, mode)) != PlankResult_OK) goto exit;
-    if ((result = pl_Base64_EncodeFile (p, &textOutputStream, &binaryInputStream)) != PlankResult_OK) goto exit;
-    
-    string = (char*)data;
-    string[stringLength] = '\0';
-    
-exit:    
-    pl_File_DeInit (&binaryInputStream);
-    pl_File_DeInit (&textOutputStream);
 
+    if ((result = pl_DynamicArray_SetSize (&p->buffer, stringLength + 1)) != PlankResult_OK) goto exit;
+
+    string = (char*)pl_DynamicArray_GetArray (&p->buffer);
+    string[pl_Base64_EncodeData (string, binary, binaryLength)] = '\0';
+
+exit:
     return string;
 }
 
 const void* pl_Base64_Decode (PlankBase64Ref p, const char* text, PlankL* binaryLengthOut)
 {
     PlankResult result;
-    PlankFile textInputStream;
-    PlankFile binaryOutputStream;
-    PlankLL stringLength;//, binaryLength;
+    PlankL stringLength, binaryLength;
     const void* data;
-    int mode;
-    
+
     result = PlankResult_OK;
     data = (const void*)PLANK_NULL;
     stringLength = strlen (text);
     *binaryLengthOut = 0;
-        
-    if ((result = pl_DynamicArray_SetSize (&p->buffer, 0)) != PlankResult_OK) goto exit;
-    if ((result = pl_File_Init (&textInputStream)) != PlankResult_OK) goto exit;
-    if ((result = pl_File_Init (&binaryOutputStream)) != PlankResult_OK) goto exit;
-    
-    mode = PLANKFILE_READ;
-    if ((result = pl_File_OpenMemory (&textInputStream, (void*)text, stringLength, mode)) != PlankResult_OK) goto exit;
-        
-    mode = PLANKFILE_BINARY | PLANKFILE_WRITE | PLANKFILE_NATIVEENDIAN;
-    if ((result = pl_File_OpenDynamicArray (&binaryOutputStream, &p->buffer, mode)) != PlankResult_OK) goto exit;
-    if ((result = pl_Base64_DecodeFile (p, &binaryOutputStream, &textInputStream)) != PlankResult_OK) goto exit;
-    
+
+    if ((result = pl_DynamicArray_SetSize (&p->buffer, pl_Base64DecodedLength (stringLength))) != PlankResult_OK) goto exit;
+    if ((result = pl_Base64_DecodeData (pl_DynamicArray_GetArray (&p->buffer), text, stringLength, &binaryLength)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_SetSize (&p->buffer, binaryLength)) != PlankResult_OK) goto exit;
+
     data = (const void*)pl_DynamicArray_GetArray (&p->buffer);
-    *binaryLengthOut = pl_DynamicArray_GetSize (&p->buffer);
-    
+    *binaryLengthOut = binaryLength;
+
 exit:
-    pl_File_DeInit (&textInputStream);
-    pl_File_DeInit (&binaryOutputStream);
-    
     return data;
 }
 
@@ -356,4 +491,3 @@ PlankResult pl_Base64_PurgeBuffer (PlankBase64Ref p)
 {
     return pl_DynamicArray_Purge (&p->buffer);
 }
-
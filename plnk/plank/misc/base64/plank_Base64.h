@@ -53,6 +53,25 @@ PlankResult pl_Base64_Init (PlankBase64Ref p);
 PlankResult pl_Base64_DeInit (PlankBase64Ref p);
 PlankResult pl_Base64_EncodeFile (PlankBase64Ref p, PlankFileRef outputTextFile, PlankFileRef inputBinaryFile);
 PlankResult pl_Base64_DecodeFile (PlankBase64Ref p, PlankFileRef outputBinaryFile, PlankFileRef inputTextFile);
+
+/** Encode binary data to Base64 text in memory.
+ This uses SSSE3 where available, otherwise it encodes three bytes at a time.
+ @param text The output, this must have space for pl_Base64EncodedLength (binaryLength) characters. This is not null terminated.
+ @param binary The data to encode.
+ @param binaryLength The number of bytes to encode.
+ @return The number of characters written to @e text. */
+PlankL pl_Base64_EncodeData (char* text, const void* binary, const PlankL binaryLength);
+
+/** Decode Base64 text to binary data in memory.
+ This uses SSSE3 where available, otherwise it decodes four characters at a time.
+ @param binary The output, this must have space for pl_Base64DecodedLength (textLength) bytes.
+ @param text The text to decode, this need not be null terminated.
+ @param textLength The number of characters to decode, this must be a multiple of 4.
+ @param binaryLength On return contains the number of bytes written to @e binary.
+ @return PlankResult_OK, PlankResult_ItemCountInvalid if @e textLength is not a multiple of 4 
+         or PlankResult_Base64Error if the text contains invalid characters or padding. */
+PlankResult pl_Base64_DecodeData (void* binary, const char* text, const PlankL textLength, PlankL* binaryLength);
+
 const char* pl_Base64_Encode (PlankBase64Ref p, const void* binary, const PlankL binaryLength);
 const void* pl_Base64_Decode (PlankBase64Ref p, const char* text, PlankL* binaryLength);
 PlankResult pl_Base64_SetBufferSize (PlankBase64Ref p, const PlankL size);
@@ -359,32 +359,74 @@ double pl_JSON_DoubleEncodedGet (PlankJSONRef p)
     return value;
 }
 
+// decodes a Base64 JSON string, or an array of them, straight into the array's memory
+static PlankResult pl_JSON_Base64DecodeStrings (PlankJSONRef p, PlankDynamicArrayRef array)
+{
+    PlankResult result;
+    PlankJSONRef j;
+    PlankUC* data;
+    const char* string;
+    PlankL numStrings, i, textLength, binaryLength, totalLength, itemSize;
+    
+    result = PlankResult_OK;
+    itemSize = pl_DynamicArray_GetItemSize (array);
+    numStrings = pl_JSON_IsArray (p) ? pl_JSON_ArrayGetSize (p) : 1;
+    totalLength = 0;
+    
+    for (i = 0; i < numStrings; ++i)
+    {
+        j = pl_JSON_IsArray (p) ? pl_JSON_ArrayAt (p, i) : p;
+        
+        if (! pl_JSON_IsString (j))
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+        
+        totalLength += pl_Base64DecodedLength (strlen (pl_JSON_StringGet (j)));
+    }
+    
+    if ((result = pl_DynamicArray_SetSize (array, (totalLength + itemSize - 1) / itemSize)) != PlankResult_OK) goto exit;
+    
+    data = (PlankUC*)pl_DynamicArray_GetArray (array);
+    totalLength = 0;
+    
+    // each string is a whole number of quads so they decode independently, items may span strings
+    for (i = 0; i < numStrings; ++i)
+    {
+        string = pl_JSON_StringGet (pl_JSON_IsArray (p) ? pl_JSON_ArrayAt (p, i) : p);
+        textLength = strlen (string);
+
+        if ((result = pl_Base64_DecodeData (data + totalLength, string, textLength, &binaryLength)) != PlankResult_OK) goto exit;
+        
+        totalLength += binaryLength;
+    }
+    
+    if ((totalLength % itemSize) != 0)
+    {
+        result = PlankResult_JSONError;
+        goto exit;
+    }
+    
+    result = pl_DynamicArray_SetSize (array, totalLength / itemSize);
+    
+exit:
+    return result;
+}
+
 static PlankResult pl_JSON_EncodedArrayGet (PlankJSONRef p, PlankDynamicArrayRef array, const char* binaryKey, const char* compressedKey, const PlankUL sz)
 {
     PlankResult result;
-    PlankBase64 b64;
     PlankZip z;
     PlankFile decodedStream;
-    PlankFile encodedStream;
     PlankFile zStream;
     PlankDynamicArray zArray;
-    PlankJSONRef j;
-    PlankL binaryLength, zlength;
     const char* key;
-    const char* string;
-    const void* data;
-    const void* zdata;
     PlankUL itemSize;
-    PlankL numStrings, i;
     
     result = PlankResult_OK;
     key = json_object_iter_key (json_object_iter ((json_t*)p));
     
-    pl_Base64_Init (&b64);
-    pl_Zip_Init (&z);
-    pl_File_Init (&decodedStream);
-    pl_File_OpenDynamicArray (&decodedStream, array, PLANKFILE_NATIVEENDIAN | PLANKFILE_WRITE | PLANKFILE_BINARY);
-    
     itemSize = pl_DynamicArray_GetItemSize (array);
     
     if (itemSize == 0)
@@ -393,101 +435,34 @@ static PlankResult pl_JSON_EncodedArrayGet (PlankJSONRef p, PlankDynamicArrayRef
     
     if (key)
     {
-        data = 0;
-        binaryLength = 0;
-        
         if (strcmp (key, compressedKey) == 0)
         {
             p = pl_JSON_ObjectAtKey (p, key);
-
-            if (pl_JSON_IsString (p))
-            {
-                string = pl_JSON_StringGet (p);
-                zdata = pl_Base64_Decode (&b64, string, &zlength);
-                
-                pl_File_Init (&encodedStream);
-                pl_File_OpenMemory (&encodedStream, (void*)zdata, zlength, PLANKFILE_NATIVEENDIAN | PLANKFILE_READ | PLANKFILE_BINARY);
-                pl_Zip_InflateStream (&z, &decodedStream, &encodedStream);
-                pl_File_DeInit (&encodedStream);
-            }
-            else if (pl_JSON_IsArray (p))
+            
+            pl_DynamicArray_InitWithItemSize (&zArray, 1);
+            
+            if ((result = pl_JSON_Base64DecodeStrings (p, &zArray)) == PlankResult_OK)
             {
-                numStrings = pl_JSON_ArrayGetSize (p);
-                
-                pl_DynamicArray_InitWithItemSize (&zArray, 1);
+                pl_Zip_Init (&z);
                 pl_File_Init (&zStream);
-                pl_File_OpenDynamicArray (&zStream, &zArray, PLANKFILE_NATIVEENDIAN | PLANKFILE_WRITE | PLANKFILE_READ | PLANKFILE_BINARY);
-                
-                for (i = 0; i < numStrings; ++i)
-                {
-                    j = pl_JSON_ArrayAt (p, i);
-                    
-                    if (! pl_JSON_IsString (j))
-                    {
-                        result = PlankResult_JSONError;
-                        pl_File_DeInit (&zStream);
-                        pl_DynamicArray_DeInit (&zArray);
-                        goto exit;
-                    }
-                    
-                    string = pl_JSON_StringGet (j);
-                    
-                    pl_File_Init (&encodedStream);
-                    pl_File_OpenMemory (&encodedStream, (void*)string, strlen (string), PLANKFILE_NATIVEENDIAN | PLANKFILE_READ | PLANKFILE_BINARY);                    
-                    pl_Base64_DecodeFile (&b64, &zStream, &encodedStream);
-                    pl_File_DeInit (&encodedStream);
-                }
-                
-                pl_File_ResetPosition (&zStream);
+                pl_File_Init (&decodedStream);
+                pl_File_OpenMemory (&zStream, pl_DynamicArray_GetArray (&zArray), pl_DynamicArray_GetSize (&zArray), PLANKFILE_NATIVEENDIAN | PLANKFILE_READ | PLANKFILE_BINARY);
+                pl_File_OpenDynamicArray (&decodedStream, array, PLANKFILE_NATIVEENDIAN | PLANKFILE_WRITE | PLANKFILE_BINARY);
                 pl_Zip_InflateStream (&z, &decodedStream, &zStream);
+                pl_File_DeInit (&decodedStream);
                 pl_File_DeInit (&zStream);
-                pl_DynamicArray_DeInit (&zArray);
+                pl_Zip_DeInit (&z);
             }
+            
+            pl_DynamicArray_DeInit (&zArray);
         }
         else if (strcmp (key, binaryKey) == 0)
         {
-            p = pl_JSON_ObjectAtKey (p, key);
-            
-            if (pl_JSON_IsString (p))
-            {
-                string = pl_JSON_StringGet (p);
-                
-                pl_File_Init (&encodedStream);
-                pl_File_OpenMemory (&encodedStream, (void*)string, strlen (string), PLANKFILE_NATIVEENDIAN | PLANKFILE_READ | PLANKFILE_BINARY);
-                pl_Base64_DecodeFile (&b64, &decodedStream, &encodedStream);
-                pl_File_DeInit (&encodedStream);
-
-            }
-            else if (pl_JSON_IsArray (p))
-            {
-                numStrings = pl_JSON_ArrayGetSize (p);
-                
-                for (i = 0; i < numStrings; ++i)
-                {
-                    j = pl_JSON_ArrayAt (p, i);
-                    
-                    if (! pl_JSON_IsString (j))
-                    {
-                        result = PlankResult_JSONError;
-                        goto exit;
-                    }
-                    
-                    string = pl_JSON_StringGet (j);
-
-                    pl_File_Init (&encodedStream);
-                    pl_File_OpenMemory (&encodedStream, (void*)string, strlen (string), PLANKFILE_NATIVEENDIAN | PLANKFILE_READ | PLANKFILE_BINARY);
-                    pl_Base64_DecodeFile (&b64, &decodedStream, &encodedStream);
-                    pl_File_DeInit (&encodedStream);
-                }
-            }
+            result = pl_JSON_Base64DecodeStrings (pl_JSON_ObjectAtKey (p, key), array);
         }
     }
     
 exit:
-    pl_File_DeInit (&decodedStream);
-    pl_Zip_DeInit (&z);
-    pl_Base64_DeInit (&b64);
-
     return result;
 }
 
@@ -688,6 +663,21 @@ PlankB pl_JSON_IsDoubleArrayEncoded (PlankJSONRef p)
     return pl_JSON_IsEncoded (p, PLANK_JSON_DOUBLEARRAYBINARY, PLANK_JSON_DOUBLEARRAYCOMPRESSED);
 }
 
+PlankB pl_JSON_IsIntArraySidecar (PlankJSONRef p)
+{
+    return pl_JSON_IsEncoded (p, PLANK_JSON_INTARRAYSIDECAR, 0);
+}
+
+PlankB pl_JSON_IsFloatArraySidecar (PlankJSONRef p)
+{
+    return pl_JSON_IsEncoded (p, PLANK_JSON_FLOATARRAYSIDECAR, 0);
+}
+
+PlankB pl_JSON_IsDoubleArraySidecar (PlankJSONRef p)
+{
+    return pl_JSON_IsEncoded (p, PLANK_JSON_DOUBLEARRAYSIDECAR, 0);
+}
+
 PlankB pl_JSON_IsError (PlankJSONRef p)
 {
     return pl_JSON_IsObject (p) && (pl_JSON_ObjectGetSize (p) == 1) && (pl_JSON_ObjectAtKey (p, "error") != 0);
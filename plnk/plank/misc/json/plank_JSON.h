@@ -52,6 +52,9 @@
 #define PLANK_JSON_FLOATARRAYCOMPRESSED     "Zf[]"  ///< Plank's custom JSON compressed float array, - deflated, then Base64 encoded
 #define PLANK_JSON_INTARRAYCOMPRESSED       "Zi[]"  ///< Plank's custom JSON compressed int array, - deflated, then Base64 encoded
 #define PLANK_JSON_DOUBLEARRAYCOMPRESSED    "Zd[]"  ///< Plank's custom JSON compressed double array, - deflated, then Base64 encoded
+#define PLANK_JSON_INTARRAYSIDECAR          "Si[]"  ///< Plank's custom JSON int array, - raw in a PlankJSONSidecar file, stored as [offset, count]
+#define PLANK_JSON_FLOATARRAYSIDECAR        "Sf[]"  ///< Plank's custom JSON float array, - raw in a PlankJSONSidecar file, stored as [offset, count]
+#define PLANK_JSON_DOUBLEARRAYSIDECAR       "Sd[]"  ///< Plank's custom JSON double array, - raw in a PlankJSONSidecar file, stored as [offset, count]
 
 #define PLANK_JSON_COMPRESSIONLEVEL         9
 
@@ -134,6 +137,9 @@ PlankB pl_JSON_IsDoubleEncoded (PlankJSONRef p);
 PlankB pl_JSON_IsIntArrayEncoded (PlankJSONRef p);
 PlankB pl_JSON_IsFloatArrayEncoded (PlankJSONRef p);
 PlankB pl_JSON_IsDoubleArrayEncoded (PlankJSONRef p);
+PlankB pl_JSON_IsIntArraySidecar (PlankJSONRef p);
+PlankB pl_JSON_IsFloatArraySidecar (PlankJSONRef p);
+PlankB pl_JSON_IsDoubleArraySidecar (PlankJSONRef p);
 PlankB pl_JSON_IsError (PlankJSONRef p);
 
 
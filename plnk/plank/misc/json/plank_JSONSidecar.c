@@ -0,0 +1,247 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plank_StandardHeader.h"
+#include "plank_JSONSidecar.h"
+#include "../../maths/plank_Maths.h"
+
+#define PLANK_JSONSIDECAR_MAGIC             "PlSc"
+#define PLANK_JSONSIDECAR_BYTEORDERMARK     0x01020304
+#define PLANK_JSONSIDECAR_WRITECHUNKSIZE    (1 << 24)
+
+// the header is padded to the alignment so the first array follows it directly
+// 4 bytes magic, 4 bytes version, 4 bytes byte order mark (all native byte order)
+
+PlankResult pl_JSONSidecar_Init (PlankJSONSidecarRef p)
+{
+    if (p == PLANK_NULL)
+        return PlankResult_MemoryError;
+    
+    pl_MemoryZero (p, sizeof (PlankJSONSidecar));
+    
+    return pl_File_Init (&p->file);
+}
+
+PlankResult pl_JSONSidecar_DeInit (PlankJSONSidecarRef p)
+{
+    PlankResult result;
+    
+    if (p == PLANK_NULL)
+        return PlankResult_MemoryError;
+    
+    result = pl_JSONSidecar_Close (p);
+    pl_File_DeInit (&p->file);
+    pl_MemoryZero (p, sizeof (PlankJSONSidecar));
+    
+    return result;
+}
+
+PlankResult pl_JSONSidecar_OpenWrite (PlankJSONSidecarRef p, const char* filepath)
+{
+    PlankResult result;
+    
+    if ((result = pl_JSONSidecar_Close (p)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_OpenBinaryNativeEndianWrite (&p->file, filepath, PLANK_FALSE, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    
+    if ((result = pl_File_Write (&p->file, PLANK_JSONSIDECAR_MAGIC, 4)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteUI (&p->file, PLANK_JSONSIDECAR_VERSION)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteUI (&p->file, PLANK_JSONSIDECAR_BYTEORDERMARK)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_WriteZeros (&p->file, PLANK_JSONSIDECAR_ALIGNMENT - 12)) != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_JSONSidecar_OpenRead (PlankJSONSidecarRef p, const char* filepath)
+{
+    PlankResult result;
+    const void* data;
+    PlankLL size;
+    PlankUI version, byteOrderMark;
+    
+    if ((result = pl_JSONSidecar_Close (p)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_OpenMapped (&p->file, filepath, PLANKFILE_READ | PLANKFILE_BINARY | PLANKFILE_NATIVEENDIAN)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_GetDataPointer (&p->file, &data, &size)) != PlankResult_OK) goto exit;
+    
+    if (size < PLANK_JSONSIDECAR_ALIGNMENT)
+    {
+        result = PlankResult_JSONFileError;
+        goto exit;
+    }
+    
+    pl_MemoryCopy (&version, (const PlankUC*)data + 4, sizeof (version));
+    pl_MemoryCopy (&byteOrderMark, (const PlankUC*)data + 8, sizeof (byteOrderMark));
+    
+    if ((memcmp (data, PLANK_JSONSIDECAR_MAGIC, 4) != 0) ||
+        (version > PLANK_JSONSIDECAR_VERSION) ||
+        (byteOrderMark != PLANK_JSONSIDECAR_BYTEORDERMARK))
+    {
+        result = PlankResult_JSONFileError;
+        goto exit;
+    }
+    
+    p->data = (const PlankUC*)data;
+    p->size = size;
+    
+exit:
+    if ((result != PlankResult_OK) && (p->data == PLANK_NULL))
+        pl_File_Close (&p->file);
+    
+    return result;
+}
+
+PlankResult pl_JSONSidecar_Close (PlankJSONSidecarRef p)
+{
+    PlankResult result;
+    
+    result = PlankResult_OK;
+    
+    if (p->file.stream != PLANK_NULL)
+        result = pl_File_Close (&p->file);
+    
+    p->data = PLANK_NULL;
+    p->size = 0;
+    
+    return result;
+}
+
+static PlankJSONRef pl_JSONSidecar_Array (PlankJSONSidecarRef p, const char* key, const void* values, const PlankL itemSize, const PlankL count)
+{
+    PlankResult result;
+    PlankJSONRef j;
+    PlankJSONRef jref;
+    const PlankUC* src;
+    PlankLL position, remaining, padding;
+    int chunkSize;
+    
+    j = PLANK_NULL;
+    
+    // must be open for writing
+    if ((p->file.stream == PLANK_NULL) || (p->data != PLANK_NULL) || (count < 0))
+        goto exit;
+    
+    // always aligned after the header and each array
+    if ((result = pl_File_GetPosition (&p->file, &position)) != PlankResult_OK) goto exit;
+    
+    src = (const PlankUC*)values;
+    remaining = (PlankLL)itemSize * count;
+    padding = (PLANK_JSONSIDECAR_ALIGNMENT - (remaining % PLANK_JSONSIDECAR_ALIGNMENT)) % PLANK_JSONSIDECAR_ALIGNMENT;
+    
+    while (remaining > 0)
+    {
+        chunkSize = (int)pl_MinLL (remaining, PLANK_JSONSIDECAR_WRITECHUNKSIZE);
+        if ((result = pl_File_Write (&p->file, src, chunkSize)) != PlankResult_OK) goto exit;
+        src += chunkSize;
+        remaining -= chunkSize;
+    }
+    
+    if ((result = pl_File_WriteZeros (&p->file, (int)padding)) != PlankResult_OK) goto exit;
+    
+    jref = pl_JSON_Array();
+    pl_JSON_ArrayAppend (jref, pl_JSON_Int (position));
+    pl_JSON_ArrayAppend (jref, pl_JSON_Int (count));
+    
+    j = pl_JSON_Object();
+    pl_JSON_ObjectPutKey (j, key, jref);
+    
+exit:
+    return j ? j : pl_JSON_Null();
+}
+
+PlankJSONRef pl_JSONSidecar_IntArray (PlankJSONSidecarRef p, const PlankLL* values, const PlankL count)
+{
+    return pl_JSONSidecar_Array (p, PLANK_JSON_INTARRAYSIDECAR, values, sizeof (values[0]), count);
+}
+
+PlankJSONRef pl_JSONSidecar_FloatArray (PlankJSONSidecarRef p, const float* values, const PlankL count)
+{
+    return pl_JSONSidecar_Array (p, PLANK_JSON_FLOATARRAYSIDECAR, values, sizeof (values[0]), count);
+}
+
+PlankJSONRef pl_JSONSidecar_DoubleArray (PlankJSONSidecarRef p, const double* values, const PlankL count)
+{
+    return pl_JSONSidecar_Array (p, PLANK_JSON_DOUBLEARRAYSIDECAR, values, sizeof (values[0]), count);
+}
+
+static const void* pl_JSONSidecar_ArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, const char* key, const PlankL itemSize, PlankL* countOut)
+{
+    PlankJSONRef jref;
+    PlankLL offset, count;
+    
+    *countOut = 0;
+    
+    // must be open for reading
+    if (p->data == PLANK_NULL)
+        return PLANK_NULL;
+    
+    if (! pl_JSON_IsObject (j))
+        return PLANK_NULL;
+    
+    jref = pl_JSON_ObjectAtKey (j, key);
+    
+    if (! pl_JSON_IsArray (jref) || (pl_JSON_ArrayGetSize (jref) != 2))
+        return PLANK_NULL;
+    
+    offset = pl_JSON_IntGet (pl_JSON_ArrayAt (jref, 0));
+    count = pl_JSON_IntGet (pl_JSON_ArrayAt (jref, 1));
+    
+    // the reference must be to an aligned array after the header that fits in the file
+    if ((offset < PLANK_JSONSIDECAR_ALIGNMENT) || (offset > p->size) ||
+        ((offset % PLANK_JSONSIDECAR_ALIGNMENT) != 0) ||
+        (count < 0) || (count > ((p->size - offset) / itemSize)))
+        return PLANK_NULL;
+    
+    *countOut = (PlankL)count;
+    
+    return p->data + offset;
+}
+
+const PlankLL* pl_JSONSidecar_IntArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, PlankL* count)
+{
+    return (const PlankLL*)pl_JSONSidecar_ArrayGet (p, j, PLANK_JSON_INTARRAYSIDECAR, sizeof (PlankLL), count);
+}
+
+const float* pl_JSONSidecar_FloatArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, PlankL* count)
+{
+    return (const float*)pl_JSONSidecar_ArrayGet (p, j, PLANK_JSON_FLOATARRAYSIDECAR, sizeof (float), count);
+}
+
+const double* pl_JSONSidecar_DoubleArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, PlankL* count)
+{
+    return (const double*)pl_JSONSidecar_ArrayGet (p, j, PLANK_JSON_DOUBLEARRAYSIDECAR, sizeof (double), count);
+}
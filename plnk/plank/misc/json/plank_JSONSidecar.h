@@ -0,0 +1,156 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_JSONSIDECAR_H
+#define PLANK_JSONSIDECAR_H
+
+#include "plank_JSON.h"
+
+#define PLANK_JSONSIDECAR_ALIGNMENT         64      ///< Byte alignment of each array in the file (and so in memory when it is mapped).
+#define PLANK_JSONSIDECAR_VERSION           1
+
+/** A binary file of raw numerical arrays referenced from a JSON document.
+ 
+ Large arrays stored as Base64 text in JSON (see pl_JSON_FloatArrayBinary() etc.) 
+ must be parsed, decoded and copied on every load. A sidecar instead writes each 
+ array's raw bytes to a separate file as it is added and puts a small reference 
+ to it in the JSON document (e.g., {"Sf[]" : [offset, count]}). 
+ 
+ When reading, the sidecar file is mapped into memory and the array getters 
+ return pointers directly into the mapping so the data are never copied. These 
+ pointers are valid until the sidecar is closed. Each array starts on a 
+ PLANK_JSONSIDECAR_ALIGNMENT byte boundary so it is suitably aligned for 
+ vector operations. The data are in native byte order, a file written on a 
+ machine with a different byte order fails to open.
+ 
+ @code
+ PlankJSONSidecar sidecar;
+ pl_JSONSidecar_Init (&sidecar);
+ pl_JSONSidecar_OpenWrite (&sidecar, "weights.bin");
+ pl_JSON_ObjectPutKey (j, "weights", pl_JSONSidecar_FloatArray (&sidecar, weights, numWeights));
+ pl_JSONSidecar_DeInit (&sidecar);
+ ...
+ pl_JSONSidecar_OpenRead (&sidecar, "weights.bin");
+ weights = pl_JSONSidecar_FloatArrayGet (&sidecar, pl_JSON_ObjectAtKey (j, "weights"), &numWeights);
+ @endcode
+ 
+ @defgroup PlankJSONSidecarClass Plank JSONSidecar class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** An opaque reference to the <i>Plank JSONSidecar</i> object. */
+typedef struct PlankJSONSidecar* PlankJSONSidecarRef;
+
+PLANK_BEGIN_C_LINKAGE
+
+/** Initialise a <i>Plank JSONSidecar</i> object. 
+ @param p The <i>Plank JSONSidecar</i> object. 
+ @return PlankResult_OK if the operation was successful. */
+PlankResult pl_JSONSidecar_Init (PlankJSONSidecarRef p);
+
+/** Deinitialise a <i>Plank JSONSidecar</i> object, this closes any open file. 
+ @param p The <i>Plank JSONSidecar</i> object. 
+ @return PlankResult_OK if the operation was successful. */
+PlankResult pl_JSONSidecar_DeInit (PlankJSONSidecarRef p);
+
+/** Create a sidecar file for writing arrays to, any existing file is replaced.
+ @param p The <i>Plank JSONSidecar</i> object. 
+ @param filepath The path of the file to create.
+ @return PlankResult_OK if the operation was successful. */
+PlankResult pl_JSONSidecar_OpenWrite (PlankJSONSidecarRef p, const char* filepath);
+
+/** Open a sidecar file for reading by mapping it into memory.
+ @param p The <i>Plank JSONSidecar</i> object. 
+ @param filepath The path of the file to open.
+ @return PlankResult_OK if the operation was successful. */
+PlankResult pl_JSONSidecar_OpenRead (PlankJSONSidecarRef p, const char* filepath);
+
+/** Close the sidecar file. 
+ Any pointers obtained from the array getters are invalid after this.
+ @param p The <i>Plank JSONSidecar</i> object. 
+ @return PlankResult_OK if the operation was successful. */
+PlankResult pl_JSONSidecar_Close (PlankJSONSidecarRef p);
+
+/** Write an int array to the sidecar file and return a JSON reference to it. 
+ @return The reference or a JSON null if the sidecar is not open for writing or the write failed. */
+PlankJSONRef pl_JSONSidecar_IntArray (PlankJSONSidecarRef p, const PlankLL* values, const PlankL count);
+
+/** Write a float array to the sidecar file and return a JSON reference to it. 
+ @return The reference or a JSON null if the sidecar is not open for writing or the write failed. */
+PlankJSONRef pl_JSONSidecar_FloatArray (PlankJSONSidecarRef p, const float* values, const PlankL count);
+
+/** Write a double array to the sidecar file and return a JSON reference to it. 
+ @return The reference or a JSON null if the sidecar is not open for writing or the write failed. */
+PlankJSONRef pl_JSONSidecar_DoubleArray (PlankJSONSidecarRef p, const double* values, const PlankL count);
+
+/** Get an int array in place from a JSON reference created by pl_JSONSidecar_IntArray().
+ @param p The <i>Plank JSONSidecar</i> object, this must be open for reading. 
+ @param j The JSON reference.
+ @param count On return contains the number of items in the array.
+ @return A pointer into the mapped file or PLANK_NULL if the reference is not valid for this file. */
+const PlankLL* pl_JSONSidecar_IntArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, PlankL* count);
+
+/** Get a float array in place from a JSON reference created by pl_JSONSidecar_FloatArray().
+ @param p The <i>Plank JSONSidecar</i> object, this must be open for reading. 
+ @param j The JSON reference.
+ @param count On return contains the number of items in the array.
+ @return A pointer into the mapped file or PLANK_NULL if the reference is not valid for this file. */
+const float* pl_JSONSidecar_FloatArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, PlankL* count);
+
+/** Get a double array in place from a JSON reference created by pl_JSONSidecar_DoubleArray().
+ @param p The <i>Plank JSONSidecar</i> object, this must be open for reading. 
+ @param j The JSON reference.
+ @param count On return contains the number of items in the array.
+ @return A pointer into the mapped file or PLANK_NULL if the reference is not valid for this file. */
+const double* pl_JSONSidecar_DoubleArrayGet (PlankJSONSidecarRef p, PlankJSONRef j, PlankL* count);
+
+PLANK_END_C_LINKAGE
+
+#if !DOXYGEN
+typedef struct PlankJSONSidecar
+{
+    PlankFile file;
+    const PlankUC* data;
+    PlankLL size;
+} PlankJSONSidecar;
+#endif
+
+/** @} */
+
+#endif // PLANK_JSONSIDECAR_H
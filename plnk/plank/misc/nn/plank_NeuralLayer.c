@@ -42,20 +42,123 @@
 #include "plank_NeuralNode.h"
 #include "plank_NeuralLayer.h"
 #include "../../maths/vectors/plank_Vectors.h"
-//#include "../../random/plank_RNG.h"
+#include "../../random/plank_RNG.h"
 
+// number of weight matrix rows processed together so they stay in the cache
+// while each vector of a batch is applied to them
+#define PLANK_NEURALLAYERF_BLOCKNODES 16
 
+static void pl_NeuralLayerF_PropogateMatrix (PlankNeuralLayerFRef p, const float* inputs, float* outputs, const int numVectors)
+{
+    PlankNeuralNetworkFActFunction actFunc;
+    int numNodes, numInputs, firstNode, lastNode, i, j;
+    const float* weightMatrixPtr;
+    const float* thresholdVectorPtr;
+    const float* inputVectorPtr;
+    float* outputVectorPtr;
+    float input;
+    
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    weightMatrixPtr = (const float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    actFunc = p->network->actFunc;
+    
+    for (firstNode = 0; firstNode < numNodes; firstNode += PLANK_NEURALLAYERF_BLOCKNODES)
+    {
+        lastNode = pl_MinI (firstNode + PLANK_NEURALLAYERF_BLOCKNODES, numNodes);
+        
+        for (i = 0; i < numVectors; ++i)
+        {
+            inputVectorPtr = inputs + i * numInputs;
+            outputVectorPtr = outputs + i * numNodes;
+            
+            for (j = firstNode; j < lastNode; ++j)
+            {
+                pl_VectorAddMulF_1NN (&input, inputVectorPtr, weightMatrixPtr + j * numInputs, numInputs);
+                outputVectorPtr[j] = actFunc (input + thresholdVectorPtr[j]);
+            }
+        }
+    }
+}
+
+static void pl_NeuralLayerF_BackPropMatrix (PlankNeuralLayerFRef p, const float* inputs, const float* outputs, const float* errors, float* deltas, float* adjusts, const int numVectors, const float actFuncOffset, const float learnRate)
+{
+    int numNodes, numInputs, firstNode, lastNode, i, j;
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    float* weightVectorPtr;
+    float output, learn, batchLearnRate;
+    
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    batchLearnRate = learnRate / (float)numVectors; // average the changes over the batch
+    
+    for (i = 0; i < numVectors * numNodes; ++i)
+    {
+        output = outputs[i];
+        deltas[i] = errors[i] * (actFuncOffset + (output * (1.0f - output)));
+    }
+    
+    pl_VectorClearF_N (adjusts, numVectors * numInputs);
+    
+    for (firstNode = 0; firstNode < numNodes; firstNode += PLANK_NEURALLAYERF_BLOCKNODES)
+    {
+        lastNode = pl_MinI (firstNode + PLANK_NEURALLAYERF_BLOCKNODES, numNodes);
+        
+        for (j = firstNode; j < lastNode; ++j)
+        {
+            weightVectorPtr = weightMatrixPtr + j * numInputs;
+            
+            for (i = 0; i < numVectors; ++i)
+            {
+                learn = deltas[i * numNodes + j] * batchLearnRate;
+                pl_VectorMulAddF_NN1N (weightVectorPtr, inputs + i * numInputs, learn, weightVectorPtr, numInputs);
+                thresholdVectorPtr[j] += learn;
+            }
+        }
+        
+        // the adjustments use the updated weights as the node-by-node implementation did
+        for (i = 0; i < numVectors; ++i)
+        {
+            for (j = firstNode; j < lastNode; ++j)
+                pl_VectorMulAddF_NN1N (adjusts + i * numInputs, weightMatrixPtr + j * numInputs, deltas[i * numNodes + j], adjusts + i * numInputs, numInputs);
+        }
+    }
+}
 
 PlankResult pl_NeuralLayerF_InitNumNodesAndPrevious (PlankNeuralLayerFRef p, PlankNeuralNetworkFRef network, const int numNodes, const int numPreviousNodes)
 {
     return pl_NeuralLayerF_InitNumNodesPreviousWithRange (p, network, numNodes, numPreviousNodes, 0.1f);
 }
 
+static PlankResult pl_NeuralLayerF_InitVectors (PlankNeuralLayerFRef p, PlankNeuralNetworkFRef network, const int numNodes, const int numPreviousNodes)
+{
+    PlankResult result = PlankResult_OK;
+    
+    p->network = network;
+    
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->weightMatrix, sizeof (PlankF), numNodes * numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->thresholdVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->deltaVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->inputVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->adjustVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->batchInputs, sizeof (PlankF))) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->batchOutputs, sizeof (PlankF))) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->batchDeltas, sizeof (PlankF))) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->batchAdjusts, sizeof (PlankF))) != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
 PlankResult pl_NeuralLayerF_InitNumNodesPreviousWithRange (PlankNeuralLayerFRef p, PlankNeuralNetworkFRef network, const int numNodes, const int numPreviousNodes, const float range)
 {
     PlankResult result;
-    int numNodesChecked, numPreviousNodesChecked, i;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
     
@@ -67,24 +170,11 @@ PlankResult pl_NeuralLayerF_InitNumNodesPreviousWithRange (PlankNeuralLayerFRef
     
     pl_MemoryZero (p, sizeof (PlankNeuralLayerF));
     
-    numNodesChecked = pl_MaxI (1, numNodes);
-    numPreviousNodesChecked = pl_MaxI (1, numPreviousNodes);
-    
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->nodes, sizeof (PlankNeuralNodeF), numNodesChecked, PLANK_FALSE)) != PlankResult_OK)
+    if ((result = pl_NeuralLayerF_InitVectors (p, network, pl_MaxI (1, numNodes), pl_MaxI (1, numPreviousNodes))) != PlankResult_OK)
         goto exit;
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    result = pl_NeuralLayerF_Randomise (p, range);
     
-    for (i = 0; i < numNodesChecked; ++i)
-    {
-        if ((result = pl_NeuralNodeF_InitWithNumWeightsAndRange (&nodeArray[i], network, numPreviousNodesChecked, range)) != PlankResult_OK)
-            goto exit;
-    }
-
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputVector, sizeof (PlankF), numNodesChecked, PLANK_TRUE)) != PlankResult_OK) goto exit;    
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->inputVector, sizeof (PlankF), numPreviousNodesChecked, PLANK_TRUE)) != PlankResult_OK) goto exit;
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->adjustVector, sizeof (PlankF), numPreviousNodesChecked, PLANK_TRUE)) != PlankResult_OK) goto exit;
-
 exit:
     return result;
 }
@@ -92,8 +182,6 @@ exit:
 PlankResult pl_NeuralLayerF_DeInit (PlankNeuralLayerFRef p)
 {
     PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
 
     result = PlankResult_OK;
 
@@ -103,16 +191,16 @@ PlankResult pl_NeuralLayerF_DeInit (PlankNeuralLayerFRef p)
         goto exit;
     }
     
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-
-    for (i = 0; i < numNodes; ++i)
-        pl_NeuralNodeF_DeInit (&nodeArray[i]);
-    
-    pl_DynamicArray_DeInit (&p->nodes);
+    pl_DynamicArray_DeInit (&p->weightMatrix);
+    pl_DynamicArray_DeInit (&p->thresholdVector);
     pl_DynamicArray_DeInit (&p->outputVector);
+    pl_DynamicArray_DeInit (&p->deltaVector);
     pl_DynamicArray_DeInit (&p->inputVector);
     pl_DynamicArray_DeInit (&p->adjustVector);
+    pl_DynamicArray_DeInit (&p->batchInputs);
+    pl_DynamicArray_DeInit (&p->batchOutputs);
+    pl_DynamicArray_DeInit (&p->batchDeltas);
+    pl_DynamicArray_DeInit (&p->batchAdjusts);
     
     pl_MemoryZero (p, sizeof (PlankNeuralLayerF));
     
@@ -122,52 +210,66 @@ exit:
 
 PlankResult pl_NeuralLayerF_Reset (PlankNeuralLayerFRef p, const float amount)
 {
-    PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
+    PlankRNGRef r;
+    float amount2;
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    int numNodes, numInputs, i, j;
+    
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    r = pl_RNGGlobal();
     
-    result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    amount2 = amount * 2.0f;
     
-    for (i = 0; i < numNodes; ++i)
+    for (j = 0; j < numNodes; ++j)
     {
-        if ((result = pl_NeuralNodeF_Reset (&nodeArray[i], amount)) != PlankResult_OK)
-            goto exit;
+        for (i = 0; i < numInputs; ++i)
+            *weightMatrixPtr++ = pl_RNG_NextFloat (r) * amount2 - amount;
+        
+        thresholdVectorPtr[j] = pl_RNG_NextFloat (r) * amount2 - amount;
     }
     
-exit:
-    return result;
+    return PlankResult_OK;
 }
 
 PlankResult pl_NeuralLayerF_Randomise (PlankNeuralLayerFRef p, const float amount)
 {
-    PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
+    PlankRNGRef r;
+    float amount2;
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    int numNodes, numInputs, i, j;
+    
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    r = pl_RNGGlobal();
     
-    result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-
-    for (i = 0; i < numNodes; ++i)
+    amount2 = amount * 2.0f;
+    
+    for (j = 0; j < numNodes; ++j)
     {
-        if ((result = pl_NeuralNodeF_Randomise (&nodeArray[i], amount)) != PlankResult_OK)
-            goto exit;
+        for (i = 0; i < numInputs; ++i)
+            *weightMatrixPtr++ += pl_RNG_NextFloat (r) * amount2 - amount;
+        
+        thresholdVectorPtr[j] += pl_RNG_NextFloat (r) * amount2 - amount;
     }
     
-exit:
-    return result;
+    return PlankResult_OK;
 }
 
 PlankResult pl_NeuralLayerF_SetNode (PlankNeuralLayerFRef p, const int nodeIndex, const float* weights, const float threshold)
 {
     PlankResult result;
-    int numNodes;
-    PlankNeuralNodeF* nodeArray;
+    int numNodes, numInputs;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
 
     if ((nodeIndex < 0) || (nodeIndex >= numNodes))
     {
@@ -175,8 +277,8 @@ PlankResult pl_NeuralLayerF_SetNode (PlankNeuralLayerFRef p, const int nodeIndex
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_Set (&nodeArray[nodeIndex], weights, threshold);
+    pl_VectorMoveF_NN ((float*)pl_DynamicArray_GetArray (&p->weightMatrix) + nodeIndex * numInputs, weights, numInputs);
+    ((float*)pl_DynamicArray_GetArray (&p->thresholdVector))[nodeIndex] = threshold;
     
 exit:
     return result;
@@ -186,10 +288,9 @@ PlankResult pl_NeuralLayerF_SetThreshold (PlankNeuralLayerFRef p, const int node
 {
     PlankResult result;
     int numNodes;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
     
     if ((nodeIndex < 0) || (nodeIndex >= numNodes))
     {
@@ -197,8 +298,7 @@ PlankResult pl_NeuralLayerF_SetThreshold (PlankNeuralLayerFRef p, const int node
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_SetThreshold (&nodeArray[nodeIndex], threshold);
+    ((float*)pl_DynamicArray_GetArray (&p->thresholdVector))[nodeIndex] = threshold;
     
 exit:
     return result;
@@ -207,20 +307,19 @@ exit:
 PlankResult pl_NeuralLayerF_SetWeight (PlankNeuralLayerFRef p, const int nodeIndex, const int weightIndex, const float weight)
 {
     PlankResult result;
-    int numNodes;
-    PlankNeuralNodeF* nodeArray;
+    int numNodes, numInputs;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
     
-    if ((nodeIndex < 0) || (nodeIndex >= numNodes))
+    if ((nodeIndex < 0) || (nodeIndex >= numNodes) || (weightIndex < 0) || (weightIndex >= numInputs))
     {
         result = PlankResult_IndexOutOfRange;
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_SetWeight (&nodeArray[nodeIndex], weightIndex, weight);
+    ((float*)pl_DynamicArray_GetArray (&p->weightMatrix))[nodeIndex * numInputs + weightIndex] = weight;
     
 exit:
     return result;
@@ -229,11 +328,11 @@ exit:
 PlankResult pl_NeuralLayerF_GetNode (PlankNeuralLayerFRef p, const int nodeIndex, float* weights, float* threshold)
 {
     PlankResult result;
-    int numNodes;
-    PlankNeuralNodeF* nodeArray;
+    int numNodes, numInputs;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
     
     if ((nodeIndex < 0) || (nodeIndex >= numNodes))
     {
@@ -241,8 +340,8 @@ PlankResult pl_NeuralLayerF_GetNode (PlankNeuralLayerFRef p, const int nodeIndex
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_Get (&nodeArray[nodeIndex], weights, threshold);
+    pl_VectorMoveF_NN (weights, (const float*)pl_DynamicArray_GetArray (&p->weightMatrix) + nodeIndex * numInputs, numInputs);
+    *threshold = ((const float*)pl_DynamicArray_GetArray (&p->thresholdVector))[nodeIndex];
     
 exit:
     return result;
@@ -251,48 +350,91 @@ exit:
 PlankResult pl_NeuralLayerF_Propogate (PlankNeuralLayerFRef p, const float* inputs)
 {
     PlankResult result;
-    int numNodes, numInputs, i;
-    PlankNeuralNodeF* nodeArray;
+    int numInputs;
     float* inputVectorPtr;
-    float* outputVectorPtr;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
     numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
-    
     inputVectorPtr = (float*)pl_DynamicArray_GetArray (&p->inputVector);
-    outputVectorPtr = (float*)pl_DynamicArray_GetArray (&p->outputVector);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
 
     pl_VectorMoveF_NN (inputVectorPtr, inputs, numInputs);
-
-    for (i = 0; i < numNodes; ++i)
-        outputVectorPtr[i] = pl_NeuralNodeF_Propogate (&nodeArray[i], inputVectorPtr);
+    pl_NeuralLayerF_PropogateMatrix (p, inputVectorPtr, (float*)pl_DynamicArray_GetArray (&p->outputVector), 1);
         
-//exit:
     return result;
 }
 
 PlankResult pl_NeuralLayerF_BackProp (PlankNeuralLayerFRef p, const float* errors, const float actFuncOffset, const float learnRate)
+{
+    pl_NeuralLayerF_BackPropMatrix (p,
+                                    (const float*)pl_DynamicArray_GetArray (&p->inputVector),
+                                    (const float*)pl_DynamicArray_GetArray (&p->outputVector),
+                                    errors,
+                                    (float*)pl_DynamicArray_GetArray (&p->deltaVector),
+                                    (float*)pl_DynamicArray_GetArray (&p->adjustVector),
+                                    1, actFuncOffset, learnRate);
+    
+    return PlankResult_OK;
+}
+
+PlankResult pl_NeuralLayerF_PropogateBatch (PlankNeuralLayerFRef p, const float* inputs, const int numVectors)
 {
     PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
-    const float* inputVectorPtr;
-    float* adjustVectorPtr;
-   
+    int numNodes, numInputs;
+    float* batchInputsPtr;
+    
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
     
-    pl_DynamicArray_Zero (&p->adjustVector);
+    if (numVectors < 1)
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    
+    if ((result = pl_DynamicArray_SetSize (&p->batchInputs, numVectors * numInputs)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_SetSize (&p->batchOutputs, numVectors * numNodes)) != PlankResult_OK) goto exit;
+    
+    batchInputsPtr = (float*)pl_DynamicArray_GetArray (&p->batchInputs);
+    pl_VectorMoveF_NN (batchInputsPtr, inputs, numVectors * numInputs);
+    
+    pl_NeuralLayerF_PropogateMatrix (p, batchInputsPtr, (float*)pl_DynamicArray_GetArray (&p->batchOutputs), numVectors);
+    p->batchSize = numVectors;
     
-    inputVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->inputVector);
-    adjustVectorPtr = (float*)pl_DynamicArray_GetArray (&p->adjustVector);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+exit:
+    return result;
+}
 
-    for (i = 0; i < numNodes; ++i)
-        pl_NeuralNodeF_BackProp (&nodeArray[i], inputVectorPtr, errors[i], actFuncOffset, learnRate, adjustVectorPtr);
+PlankResult pl_NeuralLayerF_BackPropBatch (PlankNeuralLayerFRef p, const float* errors, const float actFuncOffset, const float learnRate)
+{
+    PlankResult result;
+    int numNodes, numInputs, numVectors;
+    
+    result = PlankResult_OK;
+    numVectors = p->batchSize;
+    
+    if (numVectors < 1)
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+
+    if ((result = pl_DynamicArray_SetSize (&p->batchDeltas, numVectors * numNodes)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_SetSize (&p->batchAdjusts, numVectors * numInputs)) != PlankResult_OK) goto exit;
+    
+    pl_NeuralLayerF_BackPropMatrix (p,
+                                    (const float*)pl_DynamicArray_GetArray (&p->batchInputs),
+                                    (const float*)pl_DynamicArray_GetArray (&p->batchOutputs),
+                                    errors,
+                                    (float*)pl_DynamicArray_GetArray (&p->batchDeltas),
+                                    (float*)pl_DynamicArray_GetArray (&p->batchAdjusts),
+                                    numVectors, actFuncOffset, learnRate);
     
+exit:
     return result;
 }
 
@@ -319,6 +461,21 @@ const float* pl_NeuralLayerF_GetAdjustPtr (PlankNeuralLayerFRef p)
     return (const float*)pl_DynamicArray_GetArray (&p->adjustVector);
 }
 
+const float* pl_NeuralLayerF_GetBatchOutputsPtr (PlankNeuralLayerFRef p)
+{
+    return (const float*)pl_DynamicArray_GetArray (&p->batchOutputs);
+}
+
+const float* pl_NeuralLayerF_GetBatchAdjustPtr (PlankNeuralLayerFRef p)
+{
+    return (const float*)pl_DynamicArray_GetArray (&p->batchAdjusts);
+}
+
+const float* pl_NeuralLayerF_GetWeightMatrixPtr (PlankNeuralLayerFRef p)
+{
+    return (const float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+}
+
 int pl_NeuralLayerF_GetNumInputs (PlankNeuralLayerFRef p)
 {
     return (int)pl_DynamicArray_GetSize (&p->inputVector);
@@ -332,10 +489,12 @@ int pl_NeuralLayerF_GetNumOutputs (PlankNeuralLayerFRef p)
 PlankResult pl_NeuralLayerF_ToJSON (PlankNeuralLayerFRef p, PlankJSONRef j, const PlankB useBinary)
 {
     PlankResult result;
-    int i, numNodes;
-    PlankNeuralNodeF* nodeArray;
+    int i, numNodes, numInputs;
+    const float* weightMatrixPtr;
+    const float* thresholdVectorPtr;
     PlankJSONRef jlayer;
     PlankJSONRef jnodes;
+    PlankJSONRef jnode;
     
     result = PlankResult_OK;
     
@@ -345,19 +504,32 @@ PlankResult pl_NeuralLayerF_ToJSON (PlankNeuralLayerFRef p, PlankJSONRef j, cons
     pl_JSON_ObjectSetType (jlayer, PLANK_NEURALLAYERF_JSON_TYPE);
     pl_JSON_ObjectSetVersionString (jlayer, PLANK_NEURALLAYERF_JSON_VERSION);
 
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->thresholdVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    weightMatrixPtr = (const float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->thresholdVector);
     
+    // nodes are written in the same form as pl_NeuralNodeF_ToJSON()
     for (i = 0; i < numNodes; ++i)
-	{        
-        if ((result = pl_NeuralNodeF_ToJSON (&nodeArray[i], jnodes, useBinary)) != PlankResult_OK)
-            goto exit;
+	{
+        jnode = pl_JSON_Object();
+        pl_JSON_ObjectSetType (jnode, PLANK_NEURALNODEF_JSON_TYPE);
+        pl_JSON_ObjectSetVersionString (jnode, PLANK_NEURALNODEF_JSON_VERSION);
+        
+        pl_JSON_ObjectPutKey (jnode,
+                              PLANK_NEURALNODEF_JSON_THRESHOLD,
+                              useBinary ? pl_JSON_FloatBinary (thresholdVectorPtr[i]) : pl_JSON_Float (thresholdVectorPtr[i]));
+        
+        pl_JSON_ObjectPutKey (jnode,
+                              PLANK_NEURALNODEF_JSON_WEIGHTS,
+                              useBinary ? pl_JSON_FloatArrayBinary (weightMatrixPtr + i * numInputs, numInputs) : pl_JSON_FloatArray (weightMatrixPtr + i * numInputs, numInputs));
+        
+        pl_JSON_ArrayAppend (jnodes, jnode);
     }
     
     pl_JSON_ObjectPutKey (jlayer, PLANK_NEURALLAYERF_JSON_NODES, jnodes);
     pl_JSON_ArrayAppend (j, jlayer);
 
-exit:
     return result;
 }
 
@@ -365,10 +537,13 @@ PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNet
 {
     PlankResult result;
     PlankJSONRef jnodes;
+    PlankJSONRef jnode;
+    PlankJSONRef jweights;
+    PlankDynamicArray weights;
     int numNodes, numPreviousNodes, i;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
+    pl_MemoryZero (&weights, sizeof (PlankDynamicArray));
     
     if (p == PLANK_NULL)
     {
@@ -403,6 +578,7 @@ PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNet
     }
     
     numNodes = (int)pl_JSON_ArrayGetSize (jnodes);
+    numPreviousNodes = 0;
     
     if (numNodes < 1)
     {
@@ -410,23 +586,62 @@ PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNet
         goto exit;
     }
     
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->nodes, sizeof (PlankNeuralNodeF), numNodes, PLANK_FALSE)) != PlankResult_OK) goto exit;
-    
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    
     for (i = 0; i < numNodes; ++i)
     {
-        if ((result = pl_NeuralNodeF_InitFromJSON (&nodeArray[i], network, pl_JSON_ArrayAt (jnodes, i))) != PlankResult_OK)
+        jnode = pl_JSON_ArrayAt (jnodes, i);
+        
+        if (! pl_JSON_IsObjectType (jnode, PLANK_NEURALNODEF_JSON_TYPE))
+        {
+            result = PlankResult_JSONError;
             goto exit;
+        }
+        
+        if (pl_JSON_ObjectGetVersion (jnode) > pl_JSON_VersionCode (PLANK_NEURALNODEF_JSON_VERSION))
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+        
+        if ((jweights = pl_JSON_ObjectAtKey (jnode, PLANK_NEURALNODEF_JSON_WEIGHTS)) == 0)
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+        
+        if (! (pl_JSON_IsFloatArrayEncoded (jweights) || (pl_JSON_IsArray (jweights))))
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+        
+        if ((result = pl_JSON_FloatArrayGet (jweights, &weights)) != PlankResult_OK) goto exit;
+        
+        if (i == 0)
+        {
+            numPreviousNodes = (int)pl_DynamicArray_GetSize (&weights);
+            
+            if (numPreviousNodes < 1)
+            {
+                result = PlankResult_JSONError;
+                goto exit;
+            }
+            
+            if ((result = pl_NeuralLayerF_InitVectors (p, network, numNodes, numPreviousNodes)) != PlankResult_OK)
+                goto exit;
+        }
+        else if ((int)pl_DynamicArray_GetSize (&weights) != numPreviousNodes)
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+        
+        pl_NeuralLayerF_SetNode (p, i,
+                                 (const float*)pl_DynamicArray_GetArray (&weights),
+                                 pl_JSON_FloatGet (pl_JSON_ObjectAtKey (jnode, PLANK_NEURALNODEF_JSON_THRESHOLD)));
     }
-    
-    numPreviousNodes = pl_NeuralNodeF_GetNumWeights (&nodeArray[0]);
-    
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->inputVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->adjustVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
         
 exit:
+    pl_DynamicArray_DeInit (&weights);
     return result;
 }
 
@@ -87,9 +87,28 @@ PlankResult pl_NeuralLayerF_SetWeight (PlankNeuralLayerFRef p, const int nodeInd
 PlankResult pl_NeuralLayerF_GetNode (PlankNeuralLayerFRef p, const int nodeIndex, float* weights, float* threshold);
 PlankResult pl_NeuralLayerF_Propogate (PlankNeuralLayerFRef p, const float* inputs);
 PlankResult pl_NeuralLayerF_BackProp (PlankNeuralLayerFRef p, const float* errors, const float actFuncOffset, const float learnRate);
+
+/** Propogate a batch of input vectors through the layer.
+ The weights are stored as a contiguous matrix with one row per node so the
+ batch is processed as a matrix multiply, a block of rows at a time.
+ @param p The <i>Plank %NeuralLayerF</i> object.
+ @param inputs The input vectors, each with pl_NeuralLayerF_GetNumInputs() values, stored one after another.
+ @param numVectors The number of input vectors.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralLayerF_PropogateBatch (PlankNeuralLayerFRef p, const float* inputs, const int numVectors);
+
+/** Train the layer on the batch passed to the previous pl_NeuralLayerF_PropogateBatch().
+ The weight changes for all the vectors in the batch are averaged and applied together.
+ @param p The <i>Plank %NeuralLayerF</i> object.
+ @param errors The error vectors, each with pl_NeuralLayerF_GetNumOutputs() values, stored one after another.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralLayerF_BackPropBatch (PlankNeuralLayerFRef p, const float* errors, const float actFuncOffset, const float learnRate);
 PlankResult pl_NeuralLayerF_GetOutputs (PlankNeuralLayerFRef p, float* outputs);
 const float* pl_NeuralLayerF_GetOutputsPtr (PlankNeuralLayerFRef p);
 const float* pl_NeuralLayerF_GetAdjustPtr (PlankNeuralLayerFRef p);
+const float* pl_NeuralLayerF_GetBatchOutputsPtr (PlankNeuralLayerFRef p);
+const float* pl_NeuralLayerF_GetBatchAdjustPtr (PlankNeuralLayerFRef p);
+const float* pl_NeuralLayerF_GetWeightMatrixPtr (PlankNeuralLayerFRef p);
 int pl_NeuralLayerF_GetNumInputs (PlankNeuralLayerFRef p);
 int pl_NeuralLayerF_GetNumOutputs (PlankNeuralLayerFRef p);
 PlankResult pl_NeuralLayerF_ToJSON (PlankNeuralLayerFRef p, PlankJSONRef j, const PlankB useBinary);
@@ -103,10 +122,18 @@ PLANK_END_C_LINKAGE
 #if !DOXYGEN
 typedef struct PlankNeuralLayerF
 {
-    PlankDynamicArray nodes;
+    PlankNeuralNetworkFRef network;
+    PlankDynamicArray weightMatrix;
+    PlankDynamicArray thresholdVector;
     PlankDynamicArray outputVector;
+    PlankDynamicArray deltaVector;
     PlankDynamicArray inputVector;
     PlankDynamicArray adjustVector;
+    PlankDynamicArray batchInputs;
+    PlankDynamicArray batchOutputs;
+    PlankDynamicArray batchDeltas;
+    PlankDynamicArray batchAdjusts;
+    int batchSize;
 } PlankNeuralLayerF;
 #endif
 
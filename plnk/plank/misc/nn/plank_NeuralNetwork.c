@@ -84,6 +84,7 @@ PlankResult pl_NeuralNetworkF_InitWithLayersAndRange (PlankNeuralNetworkFRef p,
     }
 
     if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->errorVector, sizeof (PlankF), layers[numLayers - 1], PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->batchErrors, sizeof (PlankF))) != PlankResult_OK) goto exit;
     
     p->learnRate = 0.25f;
     p->actFuncOffset = 0.01f;
@@ -114,6 +115,7 @@ PlankResult pl_NeuralNetworkF_DeInit (PlankNeuralNetworkFRef p)
 
     pl_DynamicArray_DeInit (&p->layers);
     pl_DynamicArray_DeInit (&p->errorVector);
+    pl_DynamicArray_DeInit (&p->batchErrors);
     
     pl_MemoryZero (p, sizeof (PlankNeuralNetworkF));
     
@@ -379,6 +381,73 @@ exit:
 	return result;
 }
 
+PlankResult pl_NeuralNetworkF_PropogateBatch (PlankNeuralNetworkFRef p, const float* inputs, const int numVectors)
+{
+    PlankResult result;
+    int numLayers, i;
+    PlankNeuralLayerF* layerArray;
+    const float* layerInputs;
+    
+    result = PlankResult_OK;
+    numLayers = (int)pl_DynamicArray_GetSize (&p->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->layers);
+    layerInputs = inputs;
+    
+    for (i = 0; i < numLayers; ++i)
+	{
+        if ((result = pl_NeuralLayerF_PropogateBatch (&layerArray[i], layerInputs, numVectors)) != PlankResult_OK) goto exit;
+        layerInputs = pl_NeuralLayerF_GetBatchOutputsPtr (&layerArray[i]);
+	}
+	
+exit:
+	return result;
+}
+
+PlankResult pl_NeuralNetworkF_BackPropBatch (PlankNeuralNetworkFRef p, const float* inputs, const float* targets, const int numVectors)
+{
+    PlankResult result;
+    int numLayers, numOutputs, i;
+    PlankNeuralLayerF* layerArray;
+    const float* actualOutputs;
+    const float* adjusts;
+    float* outputErrors;
+    
+    result = PlankResult_OK;
+    numLayers = (int)pl_DynamicArray_GetSize (&p->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->layers);
+    numOutputs = (int)pl_DynamicArray_GetSize (&p->errorVector);
+    
+    if ((result = pl_NeuralNetworkF_PropogateBatch (p, inputs, numVectors)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_SetSize (&p->batchErrors, numVectors * numOutputs)) != PlankResult_OK) goto exit;
+
+    outputErrors = (float*)pl_DynamicArray_GetArray (&p->batchErrors);
+    actualOutputs = pl_NeuralLayerF_GetBatchOutputsPtr (&layerArray[numLayers - 1]);
+    
+    pl_VectorSubF_NNN (outputErrors, targets, actualOutputs, numVectors * numOutputs);
+    
+    adjusts = outputErrors;
+    
+	for (i = numLayers - 1; i >= 0; --i)
+	{
+        if ((result = pl_NeuralLayerF_BackPropBatch (&layerArray[i], adjusts, p->actFuncOffset, p->learnRate)) != PlankResult_OK) goto exit;
+        adjusts = pl_NeuralLayerF_GetBatchAdjustPtr (&layerArray[i]);
+	}
+    
+exit:
+	return result;
+}
+
+const float* pl_NeuralNetworkF_GetBatchOutputsPtr (PlankNeuralNetworkFRef p)
+{
+    int numLayers;
+    PlankNeuralLayerF* layerArray;
+    
+    numLayers = (int)pl_DynamicArray_GetSize (&p->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->layers);
+    
+    return pl_NeuralLayerF_GetBatchOutputsPtr (&layerArray[numLayers - 1]);
+}
+
 PlankResult pl_NeuralNetworkF_GetOutputs (PlankNeuralNetworkFRef p, float* outputs)
 {
     PlankResult result;
@@ -512,6 +581,7 @@ PlankResult pl_NeuralNetworkF_InitFromJSON (PlankNeuralNetworkFRef p, PlankJSONR
     numOutputs = pl_NeuralLayerF_GetNumOutputs (&layerArray[numLayers - 2]);
         
     if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->errorVector, sizeof (PlankF), numOutputs, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->batchErrors, sizeof (PlankF))) != PlankResult_OK) goto exit;
     
     p->learnRate = pl_JSON_FloatGet (pl_JSON_ObjectAtKey (j, PLANK_NEURALNETWORKF_JSON_LEARNRATE));    
     p->actFuncOffset = pl_JSON_FloatGet (pl_JSON_ObjectAtKey (j, PLANK_NEURALNETWORKF_JSON_ACTFUNCOFFSET));
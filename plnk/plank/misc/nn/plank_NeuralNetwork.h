@@ -104,6 +104,32 @@ PlankResult pl_NeuralNetworkF_Propogate (PlankNeuralNetworkFRef p, const float*
 PlankResult pl_NeuralNetworkF_BackProp (PlankNeuralNetworkFRef p, const float* inputs, const float* targets);
 PlankResult pl_NeuralNetworkF_GetOutputs (PlankNeuralNetworkFRef p, float* outputs);
 const float* pl_NeuralNetworkF_GetOutputsPtr (PlankNeuralNetworkFRef p);
+
+/** Propogate a batch of input vectors through the network.
+ This is equivalent to calling pl_NeuralNetworkF_Propogate() for each vector
+ but processes each layer as a matrix multiply for the whole batch. The results
+ are available from pl_NeuralNetworkF_GetBatchOutputsPtr().
+ @param p The <i>Plank %NeuralNetworkF</i> object.
+ @param inputs The input vectors, each with pl_NeuralNetworkF_GetNumInputs() values, stored one after another.
+ @param numVectors The number of input vectors.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralNetworkF_PropogateBatch (PlankNeuralNetworkFRef p, const float* inputs, const int numVectors);
+
+/** Train the network on a batch of input and target vectors.
+ Unlike calling pl_NeuralNetworkF_BackProp() for each vector in turn the errors
+ for the whole batch are found using the same weights and the average of the
+ weight changes is then applied. With one vector the result is the same as 
+ pl_NeuralNetworkF_BackProp().
+ @param p The <i>Plank %NeuralNetworkF</i> object.
+ @param inputs The input vectors, each with pl_NeuralNetworkF_GetNumInputs() values, stored one after another.
+ @param targets The target vectors, each with pl_NeuralNetworkF_GetNumOutputs() values, stored one after another.
+ @param numVectors The number of input (and target) vectors.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralNetworkF_BackPropBatch (PlankNeuralNetworkFRef p, const float* inputs, const float* targets, const int numVectors);
+
+/** Get the output vectors from the last batch.
+ These are stored one after another, each with pl_NeuralNetworkF_GetNumOutputs() values. */
+const float* pl_NeuralNetworkF_GetBatchOutputsPtr (PlankNeuralNetworkFRef p);
 PlankResult pl_NeuralNetworkF_SetActFunc (PlankNeuralNetworkFRef p, PlankNeuralNetworkFActFunction actFunc);
 
 PlankResult pl_NeuralNetworkF_ToJSON (PlankNeuralNetworkFRef p, PlankJSONRef j, const PlankB useBinary);
@@ -120,6 +146,7 @@ typedef struct PlankNeuralNetworkF
     float learnRate, actFuncOffset;
 	PlankDynamicArray layers;
 	PlankDynamicArray errorVector;
+	PlankDynamicArray batchErrors;
     PlankNeuralNetworkFActFunction actFunc;
 } PlankNeuralNetworkF;
 #endif
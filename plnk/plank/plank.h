@@ -70,6 +70,7 @@
 #include "containers/plank_LockFreeDynamicArray.h"
 #include "containers/plank_LockFreeQueue.h"
 #include "containers/plank_LockFreeStack.h"
+#include "containers/plank_RingQueue.h"
 #include "containers/plank_SimpleQueue.h"
 #include "containers/plank_SimpleStack.h"
 #include "containers/plank_SimpleLinkedList.h"
@@ -85,6 +86,7 @@
 #include "misc/nn/plank_NeuralNetwork.h"
 
 #include "misc/json/plank_JSON.h"
+#include "misc/json/plank_JSONSidecar.h"
 #include "misc/base64/plank_Base64.h"
 #include "misc/zip/plank_Zip.h"
 
@@ -39,14 +39,343 @@
 #include "../core/plank_StandardHeader.h"
 #include "plank_RNG.h"
 #include "../containers/atomic/plank_Atomic.h"
+#include "../core/plank_Thread.h"
+
+/* The lanes are stepped with whichever SIMD the compiler targets, this doesn't 
+ depend on PLANK_VEC_SIMD so fills are vectorised in every build. */
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define PLANK_RNG_V                 __m256i
+    #define PLANK_RNG_VLENGTH           8
+    #define PLANK_RNG_VLOAD(P)          _mm256_loadu_si256 ((const __m256i*)(P))
+    #define PLANK_RNG_VSTORE(P,A)       _mm256_storeu_si256 ((__m256i*)(P), A)
+    #define PLANK_RNG_VADD(A,B)         _mm256_add_epi32 (A, B)
+    #define PLANK_RNG_VXOR(A,B)         _mm256_xor_si256 (A, B)
+    #define PLANK_RNG_VOR(A,B)          _mm256_or_si256 (A, B)
+    #define PLANK_RNG_VSHL(A,N)         _mm256_slli_epi32 (A, N)
+    #define PLANK_RNG_VSHR(A,N)         _mm256_srli_epi32 (A, N)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define PLANK_RNG_V                 __m128i
+    #define PLANK_RNG_VLENGTH           4
+    #define PLANK_RNG_VLOAD(P)          _mm_loadu_si128 ((const __m128i*)(P))
+    #define PLANK_RNG_VSTORE(P,A)       _mm_storeu_si128 ((__m128i*)(P), A)
+    #define PLANK_RNG_VADD(A,B)         _mm_add_epi32 (A, B)
+    #define PLANK_RNG_VXOR(A,B)         _mm_xor_si128 (A, B)
+    #define PLANK_RNG_VOR(A,B)          _mm_or_si128 (A, B)
+    #define PLANK_RNG_VSHL(A,N)         _mm_slli_epi32 (A, N)
+    #define PLANK_RNG_VSHR(A,N)         _mm_srli_epi32 (A, N)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define PLANK_RNG_V                 uint32x4_t
+    #define PLANK_RNG_VLENGTH           4
+    #define PLANK_RNG_VLOAD(P)          vld1q_u32 (P)
+    #define PLANK_RNG_VSTORE(P,A)       vst1q_u32 (P, A)
+    #define PLANK_RNG_VADD(A,B)         vaddq_u32 (A, B)
+    #define PLANK_RNG_VXOR(A,B)         veorq_u32 (A, B)
+    #define PLANK_RNG_VOR(A,B)          vorrq_u32 (A, B)
+    #define PLANK_RNG_VSHL(A,N)         vshlq_n_u32 (A, N)
+    #define PLANK_RNG_VSHR(A,N)         vshrq_n_u32 (A, N)
+#endif
+
+#define PLANK_RNG_ROTL(X,K)             (((X) << (K)) | ((X) >> (32 - (K))))
+#define PLANK_RNG_VROTL(X,K)            PLANK_RNG_VOR (PLANK_RNG_VSHL (X, K), PLANK_RNG_VSHR (X, 32 - (K)))
+
+/* x^(2^k) modulo the characteristic polynomial of xoshiro128, applying entry k 
+ with pl_RNG_Jump() moves a state 2^k steps forward. Entries 64 and 96 are the 
+ generator's usual jump and long jump. */
+static const PlankUI pl_RNG_JumpPolynomials[128][4] = 
+{
+    { 0x00000002, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000004, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000010, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000100, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00010000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000001, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000001, 0x00000000 }, { 0xde18fc01, 0x1b489db6, 0x006254b1, 0x00fc65a2 },
+    { 0x78bd1157, 0xb488a061, 0x77900a22, 0x0e6834fb }, { 0x7b0bf49a, 0x4152f743, 0x44118d9b, 0x38d2b436 },
+    { 0x845a09b1, 0x94b54ba1, 0x503a9ae6, 0x5f7aa4ff }, { 0x0a1f06b6, 0xece7bc8e, 0x9ab5cf0e, 0x780f1aed },
+    { 0x8fcff8d3, 0xd66b4f59, 0x07ee277a, 0xeb3e4975 }, { 0x8a2979a9, 0x60e16970, 0x8b01ce7b, 0xc9d1ce32 },
+    { 0xd4fd7b86, 0x57b8e99a, 0x3853473d, 0xee6262e1 }, { 0x7f0861fd, 0xa1ea4d71, 0xa2327f56, 0x668140b3 },
+    { 0x08a24926, 0x2fb44195, 0x6d916ade, 0x4e271317 }, { 0xd35f6af2, 0x4677800b, 0x7b28f619, 0x83bc62cd },
+    { 0x0dfcd277, 0x46325cc0, 0x73a74986, 0x19b1cec2 }, { 0xb8c5a6a6, 0x97e03957, 0xba0dcd4f, 0xee16f96c },
+    { 0x584b12af, 0x7316a7cd, 0x7a2ba910, 0x53fe0a37 }, { 0x08b50aa9, 0x78f5b997, 0xb6319395, 0x665aaf09 },
+    { 0x2d6021ee, 0x4f64a1a4, 0x0baac402, 0x14dbe352 }, { 0xff5111ed, 0x8cdd10af, 0x9596864e, 0x7584f641 },
+    { 0x2e4b8d20, 0x6c4fa858, 0x60a23f97, 0x6cbdae97 }, { 0x8fd0c1ad, 0x8d6d396c, 0x1b2a88a9, 0x5409d06c },
+    { 0x070bbd82, 0x38dc68d8, 0xe2f8cff2, 0x1a377633 }, { 0xdeef0ad1, 0x306d9b7b, 0x75f46cc6, 0x6ea3c8e6 },
+    { 0x3b11252c, 0x1849dfcf, 0x83608b0c, 0x4271354c }, { 0x7bc67b5d, 0x699cac0a, 0xd888887f, 0x88e6db6e },
+    { 0xdc16b5e8, 0x2514ba92, 0x5de9763f, 0x11534240 }, { 0x19a6c40d, 0xfdd2110d, 0x9499febc, 0x686d0878 },
+    { 0xf7afe108, 0xf3be07b8, 0x730b948d, 0x0f8aed94 }, { 0xf460532d, 0xc59fb123, 0xa69c31b0, 0x5322c76e },
+    { 0x51e478c4, 0xf5e2f2d7, 0xfe9852d5, 0x95e92935 }, { 0xb50d1e24, 0xb42d61cd, 0xbd400cdd, 0x09d372b1 },
+    { 0x6bdfad84, 0xc4c77b39, 0x2c1d0568, 0xe7536e87 }, { 0x1971c861, 0x9b2f7d00, 0x5bfabd1e, 0x4b9d0a59 },
+    { 0xfa529189, 0x29d8e7c8, 0x6e84af09, 0xd61683d9 }, { 0xafa34e18, 0x990b180c, 0x93d1a9a8, 0x2bddc822 },
+    { 0x4690ac90, 0x83f99607, 0x720d8d54, 0x8c913c7b }, { 0x369ee447, 0xb2090283, 0x4e01096b, 0x5bcc6a1a },
+    { 0x5bdef343, 0x1b6400d1, 0xe94b6db2, 0x789925e5 }, { 0x24768a59, 0x298bd3d0, 0x17709585, 0x44b170cf },
+    { 0x5d874f1b, 0x170214ce, 0x0b14099d, 0x97cda294 }, { 0xe0d94af5, 0x53f78198, 0xf13a78ac, 0x48731cb9 },
+    { 0xccca1be5, 0xa64a2fb8, 0xe4558a6e, 0x3f16f673 }, { 0x0683f257, 0x6dd6ee27, 0x99a8d18e, 0xa3ef88df },
+    { 0xcb56667c, 0x87a4583d, 0xdec5bb9a, 0xdeaa4ca2 }, { 0xcfa23a11, 0xf03580b0, 0x76e2536b, 0x8c8fab83 },
+    { 0xb6ff34b1, 0x16f8a8c8, 0x445b421d, 0x6157c701 }, { 0x4ec6d5de, 0x4cf8b920, 0x7e968b3e, 0xc9790225 },
+    { 0x35a81e7c, 0x3b0ce3bf, 0xc4c741e4, 0xdbcbeaae }, { 0x816402f4, 0x1970e372, 0x8b80bd92, 0x479e43a8 },
+    { 0xddeca818, 0xc45c3501, 0x2253cc65, 0x0adcea84 }, { 0x729a959b, 0x880a3b77, 0x4de1459a, 0xb1afc783 },
+    { 0x61fb9420, 0xe6895754, 0x2f656668, 0x5d351d8e }, { 0x09e626b1, 0xed521e9b, 0x48307882, 0x1f945c5f },
+    { 0x7e887a38, 0x6247b9b1, 0xab5076c6, 0x8f5e8e11 }, { 0xc815942d, 0x3bef9fbe, 0x163b81db, 0xdd9db375 },
+    { 0x556b1be1, 0x570b130f, 0xef247f68, 0x81a138ad }, { 0x744853a3, 0x485c1e3e, 0xae1e2311, 0x2ca9fb49 },
+    { 0x1615188d, 0x821fd395, 0xf2c0b4f8, 0x3e3e7fb3 }, { 0xfbb4ea2a, 0x0c437163, 0xeeeeff2f, 0xce994be3 },
+    { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b }, { 0x9b802a8b, 0x794805ed, 0x5eb170f0, 0x7c0f7916 },
+    { 0x1a235895, 0x008078d6, 0x18eca90e, 0x5f292782 }, { 0xf70585fb, 0x4e0c5957, 0xbce250c3, 0x17a896ff },
+    { 0xd2f6556f, 0x4a18286d, 0x3628d30b, 0x55160319 }, { 0x7a7faf9a, 0xa16bbafd, 0x0e0ce4fb, 0x3c7d15de },
+    { 0xf28e46eb, 0x5de8d870, 0x99c73881, 0x138475d2 }, { 0x606a7785, 0x20e6d45f, 0x1b647514, 0x86eb7ca9 },
+    { 0x49666ecc, 0x3789d8a5, 0x6a660a93, 0xd71038c4 }, { 0x5128e049, 0x57728e18, 0x914d8f82, 0x770b4aae },
+    { 0xf4c220b9, 0x204509e7, 0xf72abaa8, 0x87a9ba17 }, { 0xa770745c, 0x6305aeb1, 0x514fb641, 0x53f14381 },
+    { 0xef0c0748, 0x37c6bfd3, 0xce823c5f, 0x614b1be8 }, { 0xa7598b6e, 0x56acc333, 0x7616abeb, 0x444c7482 },
+    { 0x3b8e5872, 0x95b59666, 0x250a934e, 0xe1c8cd14 }, { 0x61af734b, 0xcafb7bef, 0x40320995, 0x52c3fefd },
+    { 0x1e448b65, 0x3d04f456, 0x0065b6c1, 0x03ede698 }, { 0x999c0c61, 0x8f514f34, 0x208ae8a1, 0xa286055d },
+    { 0xfd77b051, 0xdc74937c, 0x87c9caa7, 0x87c3b447 }, { 0x5cb18704, 0x3861888c, 0x421e95f0, 0x84702775 },
+    { 0x796e8f1c, 0x17386578, 0xa950e8b9, 0x5122b999 }, { 0xfd714f38, 0x6a60580c, 0x1de92dc7, 0x0a378a8d },
+    { 0x920394a9, 0x59e5f42e, 0xa82afdb9, 0x29ec5ed3 }, { 0x9d4e636e, 0x91c22db3, 0xf24479f8, 0xb34270ee },
+    { 0xf610cdc8, 0x935a2512, 0xa972efe6, 0x866bc548 }, { 0xf67e06e0, 0x830fc62f, 0x426d33f9, 0x36c311b2 },
+    { 0x82e394f4, 0x8e7ae190, 0x74da71b9, 0x2b8b3ac4 }, { 0x1b17a73e, 0x48ec363c, 0x9f3a8665, 0x1ba09ec7 },
+    { 0x5eee0d0e, 0x8a54b514, 0x268d5b56, 0x7c53cf77 }, { 0xecb31e06, 0x1def52d6, 0x5ec53d4f, 0xcb831ed8 },
+    { 0x196075bf, 0xc31db8fb, 0x2e624b60, 0xba7e0917 }, { 0xf59f8398, 0x7e8f6a86, 0xc9ba6afb, 0xc28a81ed },
+    { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 }, { 0xeeb0e0a4, 0x77133e23, 0xdc596025, 0x97f55fe2 },
+    { 0x9e9b45ac, 0x6d495900, 0x69ac41e5, 0x0356e935 }, { 0x407883f3, 0x547d4854, 0x9065599b, 0x662b6ac9 },
+    { 0x667ee2de, 0x8a954d8b, 0x6551c593, 0x2fcdf7e4 }, { 0xfb5707aa, 0xdaa2886a, 0xb233cd67, 0x0f4183ca },
+    { 0x40dbcd63, 0x8e131a4f, 0x224fc251, 0xc64784ee }, { 0x4f4db4ff, 0x7b6ea15f, 0xb29e13b7, 0x563b1ea7 },
+    { 0xbbd3ae5a, 0xebf544e9, 0xd28ec540, 0x5ce3332f }, { 0xd39c61eb, 0x1f4dd02e, 0x95a4e90f, 0xa9ac90e8 },
+    { 0x790c846c, 0xd428b915, 0xd2660f23, 0x725dcd70 }, { 0x08eff263, 0xf39ff6c1, 0x513d8ba0, 0xca4404ca },
+    { 0x26534b4d, 0xcf8db66b, 0x6102f64b, 0xf84f07e3 }, { 0xa88724c5, 0x0870d7d7, 0x181f9787, 0xdc3d5d45 },
+    { 0xdba73489, 0x0df0ec1f, 0x43005e2e, 0xd543edf1 }, { 0x6d73a1e7, 0xfe43b2a7, 0xf9a46a20, 0x58859a86 },
+    { 0xa683b6d0, 0xafc4a733, 0x1bf94979, 0xf904dd9f }, { 0x2ee03d84, 0x75c74e3d, 0x96efbfd6, 0x7d256f6c },
+    { 0x3ad0ebe7, 0x13f14f31, 0x796d291c, 0xa42bbfdd }, { 0xce04ddb0, 0x1fc44a96, 0xb6a00a91, 0x8a6c4326 },
+    { 0x4e519967, 0x0d7a869e, 0x40012492, 0x6dc7c036 }, { 0x9e4d0a48, 0x6a86db67, 0xae852b9b, 0x6cc51ceb },
+    { 0x5a52e97f, 0x77beacce, 0xb8030b6c, 0x5ead7c39 }, { 0x022cefbe, 0x7d88e3d4, 0x858bbdfe, 0x6b644146 },
+    { 0x90067a45, 0xb7ce03bc, 0xde4ac3e8, 0x99853a2c }, { 0xe3a7ccf3, 0x35c9b163, 0xbb5b8048, 0x31ac55d8 },
+    { 0x8d4a33db, 0x169e96ef, 0x3788b4a3, 0x622cd32e }, { 0x0513f190, 0x06f60339, 0x93608184, 0x4576959d },
+    { 0x1a64167b, 0x05c745c5, 0xe2f50d3a, 0x8abc30fa }, { 0x1741bb62, 0x3afd4ba4, 0xb268faef, 0x18bf57c6 },
+    { 0x39b7b7b9, 0x31bb1001, 0xd95f2dcc, 0x5686c6e7 }, { 0x54d81f7e, 0x0453f0fe, 0x3bef4345, 0x9d5e1791 }
+};
+
+static PLANK_INLINE_LOW void pl_RNG_Step (PlankUI* s)
+{
+    const PlankUI t = s[1] << 9;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = PLANK_RNG_ROTL (s[3], 11);
+}
+
+static void pl_RNG_Jump (PlankUI* s, const PlankUI* polynomial)
+{
+    PlankUI result[4] = { 0, 0, 0, 0 };
+    int i, j;
+    
+    for (i = 0; i < 4; ++i)
+    {
+        for (j = 0; j < 32; ++j)
+        {
+            if (polynomial[i] & (1u << j))
+            {
+                result[0] ^= s[0];
+                result[1] ^= s[1];
+                result[2] ^= s[2];
+                result[3] ^= s[3];
+            }
+            
+            pl_RNG_Step (s);
+        }
+    }
+    
+    s[0] = result[0];
+    s[1] = result[1];
+    s[2] = result[2];
+    s[3] = result[3];
+}
+
+static PlankULL pl_RNG_SplitMix64 (PlankULL* x)
+{
+    PlankULL z;
+    z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Set the lanes to a number of steps from the start of the stream, each lane is
+ 2^64 steps on from the one before. */
+static void pl_RNG_SetLanes (PlankRNGRef p, const PlankULL steps)
+{
+    PlankUI s[4];
+    PlankULL i;
+    int k, lane;
+    
+    s[0] = p->base[0];
+    s[1] = p->base[1];
+    s[2] = p->base[2];
+    s[3] = p->base[3];
+    
+    for (k = 7; k < 64; ++k)
+    {
+        if ((steps >> k) & 1)
+            pl_RNG_Jump (s, pl_RNG_JumpPolynomials[k]);
+    }
+    
+    for (i = steps & 127; i > 0; --i)
+        pl_RNG_Step (s);
+    
+    for (lane = 0; lane < PLANK_RNG_LANES; ++lane)
+    {
+        p->lanes[0][lane] = s[0];
+        p->lanes[1][lane] = s[1];
+        p->lanes[2][lane] = s[2];
+        p->lanes[3][lane] = s[3];
+        
+        pl_RNG_Jump (s, pl_RNG_JumpPolynomials[64]);
+    }
+}
+
+/* Seed the state with SplitMix64 then move it to the start of the stream. */
+static void pl_RNG_Reset (PlankRNGRef p)
+{
+    PlankULL x, a, b;
+    int k;
+    
+    x = p->seed;
+    a = pl_RNG_SplitMix64 (&x);
+    b = pl_RNG_SplitMix64 (&x);
+    
+    p->base[0] = (PlankUI)a;
+    p->base[1] = (PlankUI)(a >> 32);
+    p->base[2] = (PlankUI)b;
+    p->base[3] = (PlankUI)(b >> 32);
+    
+    for (k = 0; k < 32; ++k)
+    {
+        if ((p->stream >> k) & 1)
+            pl_RNG_Jump (p->base, pl_RNG_JumpPolynomials[96 + k]);
+    }
+    
+    p->position = 0;
+    pl_RNG_SetLanes (p, 0);
+}
+
+/* An all zero state (e.g., zeroed memory that was never seeded) only ever gives 
+ zero, seed it again from the seed and stream but keep the position. A seeded 
+ state can't become zero as each step and jump is invertible so checking one 
+ lane is enough. */
+static void pl_RNG_ReseedIfZero (PlankRNGRef p)
+{
+    PlankULL position;
+    
+    if ((p->lanes[0][0] | p->lanes[1][0] | p->lanes[2][0] | p->lanes[3][0]) != 0)
+        return;
+    
+    position = p->position;
+    pl_RNG_Reset (p);
+    p->position = position;
+    pl_RNG_SetLanes (p, (position & ~(PlankULL)(PLANK_RNG_BLOCKLENGTH - 1)) / PLANK_RNG_LANES);
+}
+
+/* Run every lane for a number of steps, each step writes one value from each lane. */
+static PLANK_INLINE_LOW void pl_RNG_Steps (PlankRNGRef p, PlankUI* result, const PlankUL numSteps)
+{
+    PlankUL i;
+    int lane;
+    
+    pl_RNG_ReseedIfZero (p);
+    
+#ifdef PLANK_RNG_V
+    PLANK_RNG_V a0, a1, a2, a3, b0, b1, b2, b3, t, u;
+    PlankUI* output;
+    
+    // two registers of lanes at a time so their steps can overlap
+    for (lane = 0; lane < PLANK_RNG_LANES; lane += PLANK_RNG_VLENGTH * 2)
+    {
+        a0 = PLANK_RNG_VLOAD (p->lanes[0] + lane);
+        a1 = PLANK_RNG_VLOAD (p->lanes[1] + lane);
+        a2 = PLANK_RNG_VLOAD (p->lanes[2] + lane);
+        a3 = PLANK_RNG_VLOAD (p->lanes[3] + lane);
+        b0 = PLANK_RNG_VLOAD (p->lanes[0] + lane + PLANK_RNG_VLENGTH);
+        b1 = PLANK_RNG_VLOAD (p->lanes[1] + lane + PLANK_RNG_VLENGTH);
+        b2 = PLANK_RNG_VLOAD (p->lanes[2] + lane + PLANK_RNG_VLENGTH);
+        b3 = PLANK_RNG_VLOAD (p->lanes[3] + lane + PLANK_RNG_VLENGTH);
+        output = result + lane;
+        
+        for (i = 0; i < numSteps; ++i, output += PLANK_RNG_LANES)
+        {
+            t = PLANK_RNG_VADD (a0, a3);
+            u = PLANK_RNG_VADD (b0, b3);
+            PLANK_RNG_VSTORE (output, PLANK_RNG_VADD (PLANK_RNG_VROTL (t, 7), a0));
+            PLANK_RNG_VSTORE (output + PLANK_RNG_VLENGTH, PLANK_RNG_VADD (PLANK_RNG_VROTL (u, 7), b0));
+            
+            t  = PLANK_RNG_VSHL (a1, 9);
+            u  = PLANK_RNG_VSHL (b1, 9);
+            a2 = PLANK_RNG_VXOR (a2, a0);
+            b2 = PLANK_RNG_VXOR (b2, b0);
+            a3 = PLANK_RNG_VXOR (a3, a1);
+            b3 = PLANK_RNG_VXOR (b3, b1);
+            a1 = PLANK_RNG_VXOR (a1, a2);
+            b1 = PLANK_RNG_VXOR (b1, b2);
+            a0 = PLANK_RNG_VXOR (a0, a3);
+            b0 = PLANK_RNG_VXOR (b0, b3);
+            a2 = PLANK_RNG_VXOR (a2, t);
+            b2 = PLANK_RNG_VXOR (b2, u);
+            a3 = PLANK_RNG_VROTL (a3, 11);
+            b3 = PLANK_RNG_VROTL (b3, 11);
+        }
+        
+        PLANK_RNG_VSTORE (p->lanes[0] + lane, a0);
+        PLANK_RNG_VSTORE (p->lanes[1] + lane, a1);
+        PLANK_RNG_VSTORE (p->lanes[2] + lane, a2);
+        PLANK_RNG_VSTORE (p->lanes[3] + lane, a3);
+        PLANK_RNG_VSTORE (p->lanes[0] + lane + PLANK_RNG_VLENGTH, b0);
+        PLANK_RNG_VSTORE (p->lanes[1] + lane + PLANK_RNG_VLENGTH, b1);
+        PLANK_RNG_VSTORE (p->lanes[2] + lane + PLANK_RNG_VLENGTH, b2);
+        PLANK_RNG_VSTORE (p->lanes[3] + lane + PLANK_RNG_VLENGTH, b3);
+    }
+#else
+    PlankUI s[4], t;
+    
+    for (lane = 0; lane < PLANK_RNG_LANES; ++lane)
+    {
+        s[0] = p->lanes[0][lane];
+        s[1] = p->lanes[1][lane];
+        s[2] = p->lanes[2][lane];
+        s[3] = p->lanes[3][lane];
+        
+        for (i = 0; i < numSteps; ++i)
+        {
+            t = s[0] + s[3];
+            result[i * PLANK_RNG_LANES + lane] = PLANK_RNG_ROTL (t, 7) + s[0];
+            pl_RNG_Step (s);
+        }
+        
+        p->lanes[0][lane] = s[0];
+        p->lanes[1][lane] = s[1];
+        p->lanes[2][lane] = s[2];
+        p->lanes[3][lane] = s[3];
+    }
+#endif
+}
 
 PlankRNGRef pl_RNGGlobal()
 {
-    static PlankAtomicI init = { 0 };
+    static PlankAtomicI init = { 0 }; // 0 not started, 1 initialising, 2 ready
     static PlankRNG rng;
     
-    if (pl_AtomicI_CompareAndSwap (&init, 0, 1))
-        pl_RNG_Init (&rng);
+    if (pl_AtomicI_Get (&init) != 2)
+    {
+        if (pl_AtomicI_CompareAndSwap (&init, 0, 1))
+        {
+            pl_RNG_Init (&rng);
+            pl_AtomicI_Set (&init, 2);
+        }
+        else
+        {
+            // another thread is initialising it, don't hand out the zeroed state
+            while (pl_AtomicI_Get (&init) != 2)
+                pl_ThreadYield();
+        }
+    }
     
     return &rng;
 }
@@ -86,7 +415,9 @@ PlankResult pl_RNG_Init (PlankRNGRef p)
     if (p == PLANK_NULL)
         return PlankResult_MemoryError;
     
-    p->value = (unsigned int)time (NULL);
+    p->seed   = (PlankUI)time (NULL);
+    p->stream = 0;
+    pl_RNG_Reset (p);
     return PlankResult_OK;
 }
 
@@ -123,5 +454,109 @@ exit:
 
 void pl_RNG_Seed (PlankRNGRef p, unsigned int seed)
 {
-    p->value = seed;
+    p->seed = seed;
+    pl_RNG_Reset (p);
+}
+
+void pl_RNG_SetStream (PlankRNGRef p, PlankULL stream)
+{
+    p->stream = stream;
+    pl_RNG_Reset (p);
+}
+
+PlankULL pl_RNG_GetStream (PlankRNGRef p)
+{
+    return p->stream;
+}
+
+void pl_RNG_SetPosition (PlankRNGRef p, PlankULL position)
+{
+    // the lanes are left at the start of the block holding the position
+    pl_RNG_SetLanes (p, (position & ~(PlankULL)(PLANK_RNG_BLOCKLENGTH - 1)) / PLANK_RNG_LANES);
+    p->position = position;
+    
+    // pl_RNG_Next() only generates a block at the start of one
+    if (position & (PLANK_RNG_BLOCKLENGTH - 1))
+        pl_RNG_NextBlock (p);
+}
+
+PlankULL pl_RNG_GetPosition (PlankRNGRef p)
+{
+    return p->position;
+}
+
+void pl_RNG_NextBlock (PlankRNGRef p)
+{
+    pl_RNG_Steps (p, p->block, PLANK_RNG_BLOCKLENGTH / PLANK_RNG_LANES);
+}
+
+void pl_RNG_FillUI (PlankRNGRef p, PlankUI* result, PlankUL N)
+{
+    PlankUL numSteps;
+    
+    // finish the current block so the values match those from pl_RNG_Next()
+    while ((N > 0) && (p->position & (PLANK_RNG_BLOCKLENGTH - 1)))
+    {
+        *result++ = (PlankUI)pl_RNG_Next (p);
+        --N;
+    }
+    
+    numSteps = (N / PLANK_RNG_BLOCKLENGTH) * (PLANK_RNG_BLOCKLENGTH / PLANK_RNG_LANES);
+    
+    if (numSteps > 0)
+    {
+        pl_RNG_Steps (p, result, numSteps);
+        p->position += numSteps * PLANK_RNG_LANES;
+        result      += numSteps * PLANK_RNG_LANES;
+        N           -= numSteps * PLANK_RNG_LANES;
+    }
+    
+    while (N > 0)
+    {
+        *result++ = (PlankUI)pl_RNG_Next (p);
+        --N;
+    }
+}
+
+#define PLANK_RNG_FILLCHUNK 256
+
+void pl_RNG_FillF (PlankRNGRef p, float* result, PlankUL N)
+{
+    union { PlankUI i; float f; } value;
+    PlankUI bits[PLANK_RNG_FILLCHUNK];
+    PlankUL i, chunk;
+    
+    while (N > 0)
+    {
+        chunk = (N < PLANK_RNG_FILLCHUNK) ? N : PLANK_RNG_FILLCHUNK;
+        pl_RNG_FillUI (p, bits, chunk);
+        
+        // as pl_RNG_NextFloat()
+        for (i = 0; i < chunk; ++i)
+        {
+            value.i = PLANK_RNG_FLOAT_ONE | (PLANK_RNG_FLOAT_ONEMASK & bits[i]);
+            result[i] = value.f - 1.0f;
+        }
+        
+        result += chunk;
+        N -= chunk;
+    }
+}
+
+void pl_RNG_FillD (PlankRNGRef p, double* result, PlankUL N)
+{
+    PlankUI bits[PLANK_RNG_FILLCHUNK];
+    PlankUL i, chunk;
+    
+    while (N > 0)
+    {
+        chunk = (N < PLANK_RNG_FILLCHUNK) ? N : PLANK_RNG_FILLCHUNK;
+        pl_RNG_FillUI (p, bits, chunk);
+        
+        for (i = 0; i < chunk; ++i)
+            result[i] = (double)bits[i] * PLANK_RNG_DOUBLE_SCALE;
+        
+        result += chunk;
+        N -= chunk;
+    }
 }
@@ -43,6 +43,15 @@ PLANK_BEGIN_C_LINKAGE
 
 /** A simple, fast, cross-platform random number generator.
  
+ This is xoshiro128++ run as PLANK_RNG_LANES interleaved lanes so consecutive 
+ values come from SIMD steps of every lane. Each value depends only on the seed, 
+ the stream and its position in the stream. Streams with the same seed are 
+ 2^96 values apart so voices or threads can each use their own stream without
+ overlapping, and any position can be jumped to with the generator's jump 
+ polynomials. Filling a block with pl_RNG_FillF() or pl_RNG_FillD() gives the 
+ same values as generating them one at a time, so a render split across threads 
+ at known positions is the same regardless of the thread count.
+ 
  The following code snippet creates a <i>Plank %RNG</i> object, generates a random 
  float, then destroys the <i>Plank %RNG</i> object.
  
@@ -62,6 +71,12 @@ PLANK_BEGIN_C_LINKAGE
 /** An opaque reference to the <i>Plank %RNG</i> object. */
 typedef struct PlankRNG* PlankRNGRef; 
 
+/** The number of lanes, each step of the lanes generates this many 32-bit values. */
+#define PLANK_RNG_LANES 16
+
+/** The number of 32-bit values generated at once for pl_RNG_Next(). */
+#define PLANK_RNG_BLOCKLENGTH (PLANK_RNG_LANES * 4)
+
 PlankRNGRef pl_RNGGlobal();
 
 /** Create and initialise a <i>Plank %RNG</i> object and return an oqaque reference to it.
@@ -92,6 +107,53 @@ PlankResult pl_RNG_Destroy (PlankRNGRef p);
  @param seed The new seed. */
 void pl_RNG_Seed (PlankRNGRef p, unsigned int seed);
 
+/** Select an independent stream for a <i>Plank %RNG</i> object. 
+ This also resets the position to the start of the stream. There are 2^32 streams, 
+ only the low 32 bits of the stream are used to select it.
+ @param p The <i>Plank %RNG</i> object. 
+ @param stream The stream, e.g., a voice or thread index. */
+void pl_RNG_SetStream (PlankRNGRef p, PlankULL stream);
+
+/** Get the stream of a <i>Plank %RNG</i> object. 
+ @param p The <i>Plank %RNG</i> object. 
+ @return The stream. */
+PlankULL pl_RNG_GetStream (PlankRNGRef p);
+
+/** Jump to a position in the current stream. 
+ This takes time proportional to the number of bits set in the position so is
+ best not called for every value.
+ @param p The <i>Plank %RNG</i> object. 
+ @param position The number of 32-bit values since the start of the stream. */
+void pl_RNG_SetPosition (PlankRNGRef p, PlankULL position);
+
+/** Get the position in the current stream. 
+ @param p The <i>Plank %RNG</i> object. 
+ @return The number of 32-bit values generated since the start of the stream. */
+PlankULL pl_RNG_GetPosition (PlankRNGRef p);
+
+/** Step the lanes to generate the next PLANK_RNG_BLOCKLENGTH values. 
+ This is used by pl_RNG_Next() and should not normally be called directly.
+ @param p The <i>Plank %RNG</i> object. */
+void pl_RNG_NextBlock (PlankRNGRef p);
+
+/** Fill an array with random unsigned integers. 
+ @param p The <i>Plank %RNG</i> object. 
+ @param result The array to fill.
+ @param N The number of values to generate. */
+void pl_RNG_FillUI (PlankRNGRef p, PlankUI* result, PlankUL N);
+
+/** Fill an array with random floats between 0 and 1. 
+ @param p The <i>Plank %RNG</i> object. 
+ @param result The array to fill.
+ @param N The number of values to generate. */
+void pl_RNG_FillF (PlankRNGRef p, float* result, PlankUL N);
+
+/** Fill an array with random doubles between 0 and 1. 
+ @param p The <i>Plank %RNG</i> object. 
+ @param result The array to fill.
+ @param N The number of values to generate. */
+void pl_RNG_FillD (PlankRNGRef p, double* result, PlankUL N);
+
 /** Generate a random integer. 
  @param p The <i>Plank %RNG</i> object. 
  @return The random integer. */
@@ -42,21 +42,30 @@
 #if !DOXYGEN
 typedef struct PlankRNG
 {
-    unsigned int value;
+    PlankUI seed;
+    PlankULL stream;
+    PlankULL position;
+    PlankUI base[4];
+    PlankUI lanes[4][PLANK_RNG_LANES];
+    PlankUI block[PLANK_RNG_BLOCKLENGTH];
 } PlankRNG;
 #endif
 
-#define PLANK_RNG_MAGIC1            1664525
-#define PLANK_RNG_MAGIC2            1013904223
 #define PLANK_RNG_FLOAT_ONE         PLANK_FLOAT_ONE
 #define PLANK_RNG_FLOAT_ONEMASK     PLANK_FLOAT_ONEMASK
 #define PLANK_RNG_DOUBLE_ONE        PLANK_DOUBLE_ONE
 #define PLANK_RNG_DOUBLE_ONEMASK    PLANK_DOUBLE_ONEMASK
+#define PLANK_RNG_DOUBLE_SCALE      (1.0 / 4294967296.0)
 
 static PLANK_INLINE_LOW int pl_RNG_Next (PlankRNGRef p)
 {
-    p->value = (unsigned int)PLANK_RNG_MAGIC1 * p->value + (unsigned int)PLANK_RNG_MAGIC2;
-    return p->value;
+    const int index = (int)(p->position & (PLANK_RNG_BLOCKLENGTH - 1));
+    
+    if (index == 0)
+        pl_RNG_NextBlock (p);
+    
+    ++p->position;
+    return (int)p->block[index];
 }
 
 static PLANK_INLINE_LOW unsigned int pl_RNG_NextInt (PlankRNGRef p, unsigned int max)
@@ -76,11 +85,7 @@ static PLANK_INLINE_LOW float pl_RNG_NextFloat (PlankRNGRef p)
 
 static PLANK_INLINE_LOW double pl_RNG_NextDouble (PlankRNGRef p)
 {    
-    unsigned int bits;
-	float value;
-	bits = PLANK_RNG_FLOAT_ONE | (PLANK_RNG_FLOAT_ONEMASK & pl_RNG_Next (p));
-    value = *(float*)(&bits);
-    return (double)value - 1.0;
+    return (double)(PlankUI)pl_RNG_Next (p) * PLANK_RNG_DOUBLE_SCALE;
 }
 
 #endif
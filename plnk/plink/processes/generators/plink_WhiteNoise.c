@@ -43,17 +43,15 @@
 void plink_WhiteNoiseProcessF_N (void* ppv, WhiteNoiseProcessStateF* state)
 {
     PlinkProcessF* pp;
-    int i, N;
+    int N;
     float *output;
-	PlankRNGRef rng;
 
     pp = (PlinkProcessF*)ppv;
     N = pp->buffers[0].bufferSize;
     output = pp->buffers[0].buffer;
-    rng = &state->rng;
 
-    for (i = 0; i < N; ++i) 
-        output[i] = pl_RNG_NextFloat (rng);
+    pl_RNG_FillF (&state->rng, output, N);
+    pl_VectorMulAddF_NN11 (output, output, state->maxValue - state->minValue, state->minValue, N);
 }
 
 void plink_WhiteNoiseProcessF (void* ppv, WhiteNoiseProcessStateF* state)
@@ -272,17 +272,17 @@ public:
     
     PLONK_INLINE_MID bool compareAndSwap (const Type* oldValue, const Type* newValue) throw() 
     {
-        return pl_AtomicP_CompareAndSwap (getAtomicRef(), oldValue, newValue);
+        return pl_AtomicP_CompareAndSwap (getAtomicRef(), const_cast<Type*> (oldValue), const_cast<Type*> (newValue));
     }
     
     PLONK_INLINE_MID bool compareAndSwap (const Type* newValue) throw() 
     {
-        return pl_AtomicP_CompareAndSwap (getAtomicRef(), this->getValueUnchecked(), newValue);
+        return pl_AtomicP_CompareAndSwap (getAtomicRef(), this->getValueUnchecked(), const_cast<Type*> (newValue));
     }
     
     PLONK_INLINE_MID Type* swap (const Type* newValue) throw() 
     {
-        return pl_AtomicP_Swap (getAtomicRef(), newValue);
+        return static_cast<Type*> (pl_AtomicP_Swap (getAtomicRef(), const_cast<Type*> (newValue)));
     }
     
     PLONK_INLINE_MID void swapWith (AtomicValue& other) throw() 
@@ -57,12 +57,14 @@ public:
     typedef Dictionary<ValueType,KeyType> Container;
     
 	DictionaryInternal() throw()
+    :   keyRevision (nextKeyRevision())
 	{
 	}
 	
     DictionaryInternal (const int initialCapacity) throw()
     :   values (ObjectArray<ValueType>::emptyWithAllocatedSize (initialCapacity)),
-        keys (ObjectArray<KeyType>::emptyWithAllocatedSize (initialCapacity))
+        keys (ObjectArray<KeyType>::emptyWithAllocatedSize (initialCapacity)),
+        keyRevision (nextKeyRevision())
 	{
 	}
     
@@ -89,10 +91,33 @@ public:
 	{
 		return keys;
 	}
+    
+    /** Changes whenever a key is added or removed.
+     Replacing the value stored against an existing key leaves the
+     positions of the keys and values as they were so doesn't change this. 
+     Revisions are never reused by any dictionary of this type, so a cached 
+     revision alone identifies both the dictionary and its keys even if a new
+     dictionary is later allocated at the address of an old one. */
+    LongLong getKeyRevision() const throw()
+    {
+        return keyRevision;
+    }
+    
+    void keysChanged() throw()
+    {
+        keyRevision = nextKeyRevision();
+    }
 	
 private:
 	ObjectArray<ValueType> values;
 	ObjectArray<KeyType> keys;
+    LongLong keyRevision;
+    
+    static LongLong nextKeyRevision() throw()
+    {
+        static AtomicLongLong revision;
+        return ++revision;
+    }
 };
 
 
@@ -258,6 +283,7 @@ public:
 		{
 			keys.add (key);
 			values.add (value);
+            this->getInternal()->keysChanged();
 			return ObjectArray<ValueType>::getNullObject();
 		}
 	}
@@ -365,6 +391,7 @@ public:
 			ValueType removed = values[index];
 			keys.remove (index);
 			values.remove (index);
+            this->getInternal()->keysChanged();
 			return removed;
 		}
 		else
@@ -69,6 +69,7 @@ template<class ValueType>                                                   clas
 template<class ValueType>                                                   class LinkedListElement;
 
 template<class ValueType>                                                   class LockFreeQueue;
+template<class ValueType>                                                   class RingQueue;
 template<class ValueType>                                                   class LockFreeStack;
 
 template<class ValueType>                                                   class SimpleQueue;
@@ -81,8 +82,12 @@ template<class SampleType>                                                  clas
 template<class SampleType>                                                  class BreakpointsInternal;
 template<class SampleType>                                                  class BreakpointsBase;
 template<class SampleType>                                                  class WavetableBase;
+template<class SampleType>                                                  class WavetableBankInternal;
+template<class SampleType>                                                  class WavetableBankBase;
 template<class SampleType>                                                  class SignalBase;
 template<class SampleType>                                                  class FFTBuffersBase;
+template<class SampleType>                                                  class STFTEngineInternal;
+template<class SampleType>                                                  class STFTEngineBase;
 
 template<class ReturnType,
          class ArgType1 = void, 
@@ -222,6 +227,10 @@ typedef WavetableBase<Int24>                 Int24Wavetable;
 typedef WavetableBase<Long>                  LongWavetable;
 typedef WavetableBase<PLONK_TYPE_DEFAULT>    Wavetable;
 
+typedef WavetableBankBase<Float>                 FloatWavetableBank;
+typedef WavetableBankBase<Double>                DoubleWavetableBank;
+typedef WavetableBankBase<PLONK_TYPE_DEFAULT>    WavetableBank;
+
 typedef SignalBase<Float>                 FloatSignal;
 typedef SignalBase<Double>                DoubleSignal;
 typedef SignalBase<Short>                 ShortSignal;
@@ -247,6 +256,10 @@ typedef FFTBuffersBase<Int24>                 Int24FFTBuffers;
 typedef FFTBuffersBase<Long>                  LongFFTBuffers;
 typedef FFTBuffersBase<PLONK_TYPE_DEFAULT>    FFTBuffers;
 
+typedef STFTEngineBase<Float>                 FloatSTFTEngine;
+typedef STFTEngineBase<Double>                DoubleSTFTEngine;
+typedef STFTEngineBase<PLONK_TYPE_DEFAULT>    STFTEngine;
+
 // fixed types
 typedef Fix<Char,6,2> FixI6F2;
 typedef Fix<Short,8,8> FixI8F8;
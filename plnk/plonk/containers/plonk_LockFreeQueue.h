@@ -44,38 +44,63 @@
 
 #include "../core/plonk_SmartPointer.h"
 #include "../core/plonk_WeakPointer.h"
+#include "plonk_RingQueue.h"
 
 template<class ValueType>                                               
 class LockFreeQueueInternal : public SmartPointer
 {
 public:
     typedef LockFreeQueue<ValueType>        QueueType;
+    typedef RingQueueSlots<ValueType>       Slots;
     
     LockFreeQueueInternal() throw()
+    :   ring (0)
     {
         initQueue (liveQueue);
         initQueue (deadQueue);
     }
     
+    LockFreeQueueInternal (const int capacity) throw()
+    :   ring (pl_RingQueue_CreateAndInit (sizeof (ValueType), capacity, PLANKRINGQUEUE_MPMC))
+    {
+        plonk_assert (ring != 0);
+        initQueue (liveQueue);
+        initQueue (deadQueue);
+    }
+    
     ~LockFreeQueueInternal()
     {
+        if (ring != 0)
+        {
+            Slots::clear (ring);
+            pl_RingQueue_Destroy (ring);
+        }
+        
         deInitQueue (liveQueue);
         deInitQueue (deadQueue);
     }
     
-    PLONK_INLINE_LOW void push (ValueType const& value) throw()
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
     {
+        if (ring != 0)
+            return Slots::push (ring, value);
+        
         PlankLockFreeQueueElementRef element = createElement (value);
         ResultCode result = pl_LockFreeQueue_Push (&liveQueue, element);
         plonk_assert (result == PlankResult_OK);
 #ifndef PLONK_DEBUG
         (void)result;
 #endif
+        return true;
     }
     
     PLONK_INLINE_LOW ValueType pop() throw()
     {
         ValueType value (getNullValue());
+        
+        if (ring != 0)
+            return Slots::pop (ring, value) ? value : getNullValue();
+        
         ValueType* valuePtr = popInternal (&value);
         return (valuePtr == 0) ? getNullValue() : value;
     }
@@ -83,6 +108,9 @@ public:
     template<class OtherType>
     PLONK_INLINE_LOW bool pop (OtherType& value)
     {
+        if (ring != 0)
+            return Slots::pop (ring, value);
+        
         ValueType tmp (getNullValue());
         ValueType* valuePtr = popInternal (&tmp);
  
@@ -96,6 +124,12 @@ public:
 
     void clear() throw()
     {
+        if (ring != 0)
+        {
+            Slots::clear (ring);
+            return;
+        }
+        
         ValueType* valuePtr;
         do 
         {
@@ -114,6 +148,9 @@ public:
     
     void clearAll() throw()
     {
+        if (ring != 0)
+            Slots::clear (ring);
+        
         ResultCode result = pl_LockFreeQueue_Clear (&liveQueue);
         plonk_assert (result == PlankResult_OK);
         
@@ -126,7 +163,12 @@ public:
     
     PLONK_INLINE_LOW int length() throw()
     {
-        return pl_LockFreeQueue_GetSize (&liveQueue);
+        return (ring != 0) ? (int)pl_RingQueue_GetSize (ring) : pl_LockFreeQueue_GetSize (&liveQueue);
+    }
+    
+    PLONK_INLINE_LOW bool isBounded() const throw()
+    {
+        return ring != 0;
     }
     
     friend class LockFreeQueue<ValueType>;
@@ -134,6 +176,7 @@ public:
 private:
     PLONK_ALIGN(16) PlankLockFreeQueue liveQueue;
     PLONK_ALIGN(16) PlankLockFreeQueue deadQueue;
+    PlankRingQueueRef ring;
     
     static void initQueue (PlankLockFreeQueue& queue) throw()
     {
@@ -232,14 +275,26 @@ class LockFreeQueueInternal<ValueType*> : public SmartPointer
 {
 public:
     typedef LockFreeQueue<ValueType*>        QueueType;
+    typedef RingQueueSlots<ValueType*>       Slots;
     
     LockFreeQueueInternal() throw()
+    :   ring (0)
     {
         pl_LockFreeQueue_Init (&queue);
     }
     
+    LockFreeQueueInternal (const int capacity) throw()
+    :   ring (pl_RingQueue_CreateAndInit (sizeof (ValueType*), capacity, PLANKRINGQUEUE_MPMC))
+    {
+        plonk_assert (ring != 0);
+        pl_LockFreeQueue_Init (&queue);
+    }
+    
     ~LockFreeQueueInternal()
     {
+        if (ring != 0)
+            pl_RingQueue_Destroy (ring);
+        
         pl_LockFreeQueue_DeInit (&queue);
     }
     
@@ -248,8 +303,11 @@ public:
         return 0;
     }
     
-    void push (ValueType* const value) throw()
+    bool push (ValueType* const value) throw()
     {
+        if (ring != 0)
+            return Slots::push (ring, value);
+        
         PlankLockFreeQueueElementRef element = pl_LockFreeQueueElement_CreateAndInit();
         plonk_assert (element != 0);
         pl_LockFreeQueueElement_SetData (element, value);
@@ -258,11 +316,18 @@ public:
 #ifndef PLONK_DEBUG
         (void)result;
 #endif
+        return true;
     }
     
     ValueType* pop() throw()
     {
-        ValueType* returnValue;
+        ValueType* returnValue = 0;
+        
+        if (ring != 0)
+        {
+            Slots::pop (ring, returnValue);
+            return returnValue;
+        }
         
         PlankLockFreeQueueElementRef element;
         ResultCode result = pl_LockFreeQueue_Pop (&queue, &element);
@@ -290,6 +355,9 @@ public:
     
     void clear() throw()
     {
+        if (ring != 0)
+            Slots::clear (ring);
+        
         ResultCode result = pl_LockFreeQueue_Clear (&queue);
         plonk_assert (result == PlankResult_OK);
 #ifndef PLONK_DEBUG
@@ -309,13 +377,19 @@ public:
         
     int length() throw()
     {
-        return pl_LockFreeQueue_GetSize (&queue);
+        return (ring != 0) ? (int)pl_RingQueue_GetSize (ring) : pl_LockFreeQueue_GetSize (&queue);
+    }
+    
+    PLONK_INLINE_LOW bool isBounded() const throw()
+    {
+        return ring != 0;
     }
 
     friend class LockFreeQueue<ValueType*>;
     
 private:
     PLONK_ALIGN(16) PlankLockFreeQueue queue;
+    PlankRingQueueRef ring;
 };
 
 
@@ -337,6 +411,16 @@ public:
     {
     }
     
+    /** Create a bounded queue.
+     This stores the items inline in a preallocated ring (see RingQueue) rather 
+     than allocating an element for every push so it is suitable for handing 
+     items to or from the audio thread. push() returns false if the queue is full.
+     @param capacity The maximum number of items, rounded up to a power of 2. */
+    PLONK_INLINE_LOW explicit LockFreeQueue (const int capacity)
+    :   Base (new Internal (capacity))
+    {
+    }
+    
     PLONK_INLINE_LOW explicit LockFreeQueue (Internal* internalToUse) throw() 
 	:	Base (internalToUse)
 	{
@@ -375,9 +459,11 @@ public:
         return Internal::getNullValue();
     }
     
-    PLONK_INLINE_LOW void push (ValueType const& value) throw()
+    /** Push a value onto the queue.
+     @return @c true unless this is a bounded queue and it was full. */
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
     {
-        this->getInternal()->push (value);
+        return this->getInternal()->push (value);
     }
     
     PLONK_INLINE_LOW ValueType pop() throw()
@@ -412,6 +498,9 @@ public:
         
         plonk_assert (count > 0);
         
+        if (this->getInternal()->isBounded())
+            return; // no cache needed
+        
         for (int i = 0; i < count; ++i)
             push (ValueType());
         
@@ -423,6 +512,12 @@ public:
         return this->getInternal()->length();
     }
     
+    /** Determine whether this queue was created with a fixed capacity. */
+    PLONK_INLINE_LOW bool isBounded() const throw()
+    {
+        return this->getInternal()->isBounded();
+    }
+    
     PLONK_OBJECTARROWOPERATOR(LockFreeQueue);
 
 };
@@ -184,8 +184,7 @@ public:
 	{
         if (size >= 1)
         {                                    
-            for (int i = 0; i < size; ++i)
-                dst[i] = plonk::rand (lower, upper);
+            plonk::rand (dst, (int)size, lower, upper);
 		}
         else plonk_assertfalse;
     }
@@ -211,8 +210,7 @@ public:
 	{
         if (size >= 1)
         {                                    
-            for (int i = 0; i < size; ++i)
-                dst[i] = plonk::exprand (lower, upper);
+            plonk::exprand (dst, (int)size, lower, upper);
 		}
         else plonk_assertfalse;
 	}
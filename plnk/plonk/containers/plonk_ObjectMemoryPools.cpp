@@ -44,12 +44,6 @@ BEGIN_PLONK_NAMESPACE
 
 #define PLONK_OBJECTMEMORYPOOLS_DEBUG 1
 
-#if PLONK_OBJECTMEMORYPOOLS_DEBUG
-//static AtomicLong largestSize;
-//static AtomicInt blockAllocationCounts[ObjectMemoryPools::NumQueues];
-//static AtomicInt blockDeallocationCounts[ObjectMemoryPools::NumQueues];
-#endif
-
 void* ObjectMemoryPools::staticAlloc (void* userData, UnsignedLong size)
 {
     ObjectMemoryPools& om = *static_cast<ObjectMemoryPools*> (userData);
@@ -62,17 +56,21 @@ void ObjectMemoryPools::staticFree (void* userData, void* ptr)
     om.free (ptr);
 }
 
-static PLONK_INLINE_LOW void* staticDoAlloc (void* userData, UnsignedLong requestedSize) throw()
+void* ObjectMemoryPools::staticDirectAlloc (void* userData, UnsignedLong requestedSize)
 {    
-    const UnsignedLong align = PLONK_WORDSIZE * 2;
-    const UnsignedLong size = Bits::nextPowerOf2 (requestedSize + align);
-    UnsignedChar* raw = static_cast<UnsignedChar*> (pl_MemoryDefaultAllocateBytes (userData, size));
-    *reinterpret_cast<UnsignedLong*> (raw) = size;
-        
-    return raw + align;
+    const UnsignedLong size = requestedSize + HeaderSize;
+    Header* const header = static_cast<Header*> (pl_MemoryDefaultAllocateBytes (userData, size));
+    
+    if (header == 0)
+        return 0;
+    
+    header->slab = 0;
+    header->size = size;
+    
+    return reinterpret_cast<UnsignedChar*> (header) + HeaderSize;
 }
 
-static PLONK_INLINE_LOW void staticDoFree (void* userData, void* ptr) throw()
+void ObjectMemoryPools::staticDirectFree (void* userData, void* ptr)
 {
 #if PLONK_OBJECTMEMORYPOOLS_DEBUG
     plonk_assert (!Threading::currentThreadIsAudioThread());
@@ -80,12 +78,40 @@ static PLONK_INLINE_LOW void staticDoFree (void* userData, void* ptr) throw()
     
     if (ptr != 0)
     {
-        const UnsignedLong align = PLONK_WORDSIZE * 2;
-        UnsignedChar* const raw = static_cast<UnsignedChar*> (ptr) - align;
-        pl_MemoryDefaultFree (userData, raw);
+        Header* const header = getHeader (ptr);
+
+        // blocks from slabs only get here if they were still in use when the pools
+        // were destroyed, their slabs were never returned so leave them alone
+        if (header->slab == 0)
+            pl_MemoryDefaultFree (userData, header);
     }
 }
 
+int ObjectMemoryPools::sizeToClass (const UnsignedLong size) throw()
+{
+    if (size <= UnsignedLong (SmallClassStep * NumSmallClasses))
+        return size > 0 ? int ((size - 1) / SmallClassStep) : 0;
+    
+    // 2**log2 < size <= 2**(log2 + 1) split into ClassesPerPowerOf2 steps
+    const UnsignedLong log2 = Bits::numBitsRequired (size - 1) - 1;
+    const UnsignedLong step = UnsignedLong (1) << (log2 - 2);
+    
+    return NumSmallClasses + 
+           int (log2 - SmallClassesLog2) * ClassesPerPowerOf2 + 
+           int ((size - 1 - (UnsignedLong (1) << log2)) / step);
+}
+
+UnsignedLong ObjectMemoryPools::classToSize (const int sizeClass) throw()
+{
+    if (sizeClass < NumSmallClasses)
+        return UnsignedLong (sizeClass + 1) * SmallClassStep;
+    
+    const int index = sizeClass - NumSmallClasses;
+    const int log2 = SmallClassesLog2 + index / ClassesPerPowerOf2;
+    
+    return (UnsignedLong (1) << log2) + UnsignedLong (index % ClassesPerPowerOf2 + 1) * (UnsignedLong (1) << (log2 - 2));
+}
+
 ObjectMemoryPools::ObjectMemoryPools (Memory& m) throw()
 :   ObjectMemoryBase (m),
     Threading::Thread ("Memory Pool Thread")
@@ -93,10 +119,17 @@ ObjectMemoryPools::ObjectMemoryPools (Memory& m) throw()
     setPriority (0);
 
     getMemory().resetUserData();
-    getMemory().setFunctions (staticDoAlloc, staticDoFree); 
+    getMemory().setFunctions (staticDirectAlloc, staticDirectFree); 
+    
+    for (int i = 0; i < NumClasses; ++i)
+    {
+        SizeClass& sizeClass = classes[i];
+        sizeClass.blockSize = classToSize (i);
+        sizeClass.blocksPerSlab = int (plonk::max (UnsignedLong (1), UnsignedLong (SlabSize) / sizeClass.blockSize));
+        sizeClass.cacheLimit = int (plonk::max (UnsignedLong (2), plonk::min (UnsignedLong (ThreadCacheMaxBlocks), 
+                                                                              UnsignedLong (ThreadCacheBytes) / sizeClass.blockSize)));
+    }
     
-    AtomicOps::memoryBarrier();
-    queues = new LockFreeQueue<Element>[NumQueues];
     AtomicOps::memoryBarrier();
     
     getMemory().setUserData (this);
@@ -105,80 +138,490 @@ ObjectMemoryPools::ObjectMemoryPools (Memory& m) throw()
 
 ObjectMemoryPools::~ObjectMemoryPools()
 {
-    setShouldExitAndWait(); // the thread clears the queues
+    setShouldExitAndWait(); // the thread returns the slabs
     //<-- something could happen here on another thread but we should be shut down by now..?
     getMemory().resetUserData();
-    getMemory().setFunctions (staticDoAlloc, staticDoFree); 
-    delete [] queues;
+    getMemory().setFunctions (staticDirectAlloc, staticDirectFree); 
 }
 
 void* ObjectMemoryPools::allocateBytes (UnsignedLong requestedSize)
 {    
-    const UnsignedLong align = PLONK_WORDSIZE * 2;
-    const UnsignedLong size = Bits::nextPowerOf2 (requestedSize + align);
-    const UnsignedLong sizeLog2 = size > 0 ? Bits::countTrailingZeroes (size) : 0;
-    plonk_assert (sizeLog2 >= 0 && sizeLog2 < NumQueues);
+    // a free block must have room for the link to the next free block
+    const int sizeClass = sizeToClass (plonk::max (requestedSize, UnsignedLong (sizeof (Block))) + HeaderSize);
+    
+    if (sizeClass >= NumClasses)
+        return staticDirectAlloc (this, requestedSize);
     
-    void* rtn = 0;
-    Element e = queues[sizeLog2].pop();
+    ThreadCache* const cache = sizeClass < NumCachedClasses ? lockThreadCache() : 0;
+    Block* block;
     
-    if (e.ptr != 0)
+    if (cache != 0)
     {
-        rtn = e.ptr;
-#if PLONK_DEBUG
-        UnsignedChar* raw = static_cast<UnsignedChar*> (rtn) - align;
-        plonk_assert (*reinterpret_cast<UnsignedLong*> (raw) == size);
-#endif
+        ThreadCache::Bin& bin = cache->bins[sizeClass];
+        
+        if (bin.count == 0)
+            refillBin (bin, sizeClass);
+        
+        block = bin.head;
+        
+        if (block != 0)
+        {
+            bin.head = block->next;
+            --bin.count;
+        }
+        
+        unlockThreadCache (cache);
     }
     else
     {
-        rtn = staticDoAlloc (this, size);
+        Block* last;
+        int count;
+        
+        block = popBlocks (classes[sizeClass], 1, last, count);
+        
+        if (block == 0)
+        {
+            block = allocateSlab (sizeClass, last, count);
+            
+            if (count > 1)
+                pushBlocks (classes[sizeClass], block->next, last, count - 1);
+        }
     }
-
-    return rtn;
+    
+#if PLONK_DEBUG
+    if (block != 0)
+        plonk_assert (getHeader (block)->slab->sizeClass == sizeClass);
+#endif
+    
+    return block;
 }
 
 void ObjectMemoryPools::free (void* ptr)
 {
     if (ptr != 0)
     {
-        const UnsignedLong align = PLONK_WORDSIZE * 2;
-        UnsignedChar* const raw = static_cast<UnsignedChar*> (ptr) - align;
-        const UnsignedLong size = *reinterpret_cast<UnsignedLong*> (raw);
-        const UnsignedLong sizeLog2 = size > 0 ? Bits::countTrailingZeroes (size) : 0;
-        plonk_assert (sizeLog2 >= 0 && sizeLog2 < NumQueues);
+        Slab* const slab = getHeader (ptr)->slab;
+        
+        if (slab == 0)
+        {
+            pl_MemoryDefaultFree (this, getHeader (ptr)); // too big for any size class
+        }
+        else
+        {
+            const int sizeClass = slab->sizeClass;
+            Block* const block = static_cast<Block*> (ptr);
+            ThreadCache* const cache = sizeClass < NumCachedClasses ? lockThreadCache() : 0;
+            
+            if (cache != 0)
+            {
+                ThreadCache::Bin& bin = cache->bins[sizeClass];
+                
+                if (bin.count >= classes[sizeClass].cacheLimit)
+                    flushBin (bin, sizeClass, bin.count / 2);
+                
+                block->next = bin.head;
+                bin.head = block;
+                ++bin.count;
+                
+                unlockThreadCache (cache);
+            }
+            else
+            {
+                pushBlocks (classes[sizeClass], block, block, 1);
+            }
+        }
+    }
+}
+
+ObjectMemoryPools::ThreadCache* ObjectMemoryPools::lockThreadCache() throw()
+{
+    const Long threadID = Long (Threading::getCurrentThreadID());
+    
+    if (threadID == 0)
+        return 0;
+    
+    const UnsignedLong hash = UnsignedLong (threadID) ^ (UnsignedLong (threadID) >> 7) ^ (UnsignedLong (threadID) >> 17);
+    
+    for (int i = 0; i < NumThreadCaches; ++i)
+    {
+        ThreadCache& cache = caches[(hash + i) & (NumThreadCaches - 1)];
+        const Long owner = cache.threadID.getValueUnchecked();
+        
+        if ((owner == threadID) || ((owner == 0) && cache.threadID.compareAndSwap (0, threadID)))
+        {
+            // the background thread is flushing the cache, bypass it this time
+            if (! cache.state.compareAndSwap (ThreadCache::Idle, ThreadCache::Busy))
+                return 0;
+            
+            // ..or it flushed the cache and handed it on before we locked it
+            if (cache.threadID.getValueUnchecked() != threadID)
+            {
+                cache.state.setValue (ThreadCache::Idle);
+                return 0;
+            }
+            
+            cache.lastActivePeriod = period.getValueUnchecked();
+            return &cache;
+        }
+    }
+    
+    return 0; // all the caches are in use, use the free lists directly
+}
+
+void ObjectMemoryPools::unlockThreadCache (ThreadCache* const cache) throw()
+{
+    cache->state.setValue (ThreadCache::Idle);
+}
 
-        Element e (ptr);
-        queues[sizeLog2].push (e);
+void ObjectMemoryPools::flushThreadCache (ThreadCache& cache) throw()
+{
+    for (int i = 0; i < NumCachedClasses; ++i)
+        flushBin (cache.bins[i], i, 0);
+}
+
+void ObjectMemoryPools::flushBin (ThreadCache::Bin& bin, const int sizeClass, const int numToKeep) throw()
+{
+    const int count = bin.count - numToKeep;
+    
+    if (count > 0)
+    {
+        Block* const first = bin.head;
+        Block* last = first;
+        
+        for (int i = 1; i < count; ++i)
+            last = last->next;
+        
+        bin.head = last->next;
+        bin.count = numToKeep;
+        
+        pushBlocks (classes[sizeClass], first, last, count);
     }
 }
 
-ResultCode ObjectMemoryPools::run() throw()
+void ObjectMemoryPools::refillBin (ThreadCache::Bin& bin, const int sizeClass) throw()
 {
-    int i;
-    const double duration = 0.5;
+    SizeClass& sc = classes[sizeClass];
+    const int numToFetch = plonk::max (1, sc.cacheLimit / 2);
     
-    while (! getShouldExit())
+    Block* last;
+    int count;
+    Block* first = popBlocks (sc, numToFetch, last, count);
+    
+    if (first == 0)
+    {
+        first = allocateSlab (sizeClass, last, count);
+        
+        if (count > numToFetch)
+        {
+            // keep what we would have fetched and put the rest of the new slab on the free list
+            Block* keepLast = first;
+            
+            for (int i = 1; i < numToFetch; ++i)
+                keepLast = keepLast->next;
+            
+            Block* const rest = keepLast->next;
+            keepLast->next = 0;
+            pushBlocks (sc, rest, last, count - numToFetch);
+            count = numToFetch;
+        }
+    }
+    
+    bin.head = first;
+    bin.count = count;
+}
+
+void ObjectMemoryPools::pushBlocks (SizeClass& sizeClass, Block* const first, Block* const last, const int count) throw()
+{
+    Block* head;
+    UnsignedLong tag;
+    
+    do
+    {
+        tag = sizeClass.freeList.getExtraUnchecked();
+        head = sizeClass.freeList.getPtrUnchecked();
+        last->next = head;
+    } while (! sizeClass.freeList.compareAndSwap (head, tag, first, tag + 1));
+    
+    sizeClass.numFree += count;
+}
+
+ObjectMemoryPools::Block* ObjectMemoryPools::popBlocks (SizeClass& sizeClass, const int maximum, Block*& last, int& count) throw()
+{
+    Block* first = 0;
+    Block* head = 0;
+    UnsignedLong tag;
+    
+    last = 0;
+    count = 0;
+    
+    // the background thread won't return any slabs while we might still read a block from one
+    ++sizeClass.numPopping;
+    ++sizeClass.numPops;
+    
+    while (count < maximum)
     {
-        for (i = 0; i < NumQueues; ++i)
+        do
         {
-            plonk_assert (getMemory().getUserData() == this);
+            tag = sizeClass.freeList.getExtraUnchecked();
+            head = sizeClass.freeList.getPtrUnchecked();
+        } while ((head != 0) && ! sizeClass.freeList.compareAndSwap (head, tag, head->next, tag + 1));
+        
+        if (head == 0)
+            break;
+        
+        if (last == 0)
+            last = head;
+        
+        head->next = first;
+        first = head;
+        ++count;
+    }
+    
+    --sizeClass.numPopping;
+    
+    if (count > 0)
+        sizeClass.numFree -= count;
+    
+    return first;
+}
 
-            for (i = 0; i < NumQueues; ++i)
-                queues[i].clearCache();
+ObjectMemoryPools::Block* ObjectMemoryPools::allocateSlab (const int sizeClass, Block*& last, int& count) throw()
+{
+    SizeClass& sc = classes[sizeClass];
+    const UnsignedLong slabHeaderSize = (sizeof (Slab) + SmallClassStep - 1) & ~UnsignedLong (SmallClassStep - 1);
+    const UnsignedLong numBytes = slabHeaderSize + sc.blockSize * sc.blocksPerSlab;
+    Slab* const slab = static_cast<Slab*> (pl_MemoryDefaultAllocateBytes (this, numBytes));
+    Block* first = 0;
+    
+    last = 0;
+    count = 0;
+    
+    if (slab != 0)
+    {
+        slab->sizeClass = sizeClass;
+        slab->numBlocks = sc.blocksPerSlab;
+        slab->numCollected = 0;
+        slab->numBytes = numBytes;
+        
+        UnsignedChar* const start = reinterpret_cast<UnsignedChar*> (slab) + slabHeaderSize;
+        
+        for (int i = sc.blocksPerSlab; --i >= 0;)
+        {
+            Header* const header = reinterpret_cast<Header*> (start + i * sc.blockSize);
+            header->slab = slab;
+            header->size = sc.blockSize;
+            
+            Block* const block = reinterpret_cast<Block*> (reinterpret_cast<UnsignedChar*> (header) + HeaderSize);
+            block->next = first;
+            first = block;
+            
+            if (last == 0)
+                last = block;
+        }
+        
+        count = sc.blocksPerSlab;
+        
+        Slab* head;
+        
+        do
+        {
+            head = sc.slabs.getValueUnchecked();
+            slab->next = head;
+        } while (! sc.slabs.compareAndSwap (head, slab));
+        
+        numBytesReserved += Long (numBytes);
+    }
+    
+    return first;
+}
+
+void ObjectMemoryPools::flushIdleThreadCaches (const bool all) throw()
+{
+    const int now = period.getValueUnchecked();
+    
+    for (int i = 0; i < NumThreadCaches; ++i)
+    {
+        ThreadCache& cache = caches[i];
+        
+        if ((cache.threadID.getValueUnchecked() != 0) &&
+            (all || ((now - cache.lastActivePeriod) >= ThreadCacheIdlePeriods)))
+        {
+            bool locked = cache.state.compareAndSwap (ThreadCache::Idle, ThreadCache::Flushing);
+            
+            while (all && ! locked)
+            {
+                Threading::yield();
+                locked = cache.state.compareAndSwap (ThreadCache::Idle, ThreadCache::Flushing);
+            }
+            
+            if (locked)
+            {
+                flushThreadCache (cache);
+                
+                // hand the cache back, the thread claims another if it ever returns
+                cache.threadID.setValue (0);
+                cache.state.setValue (ThreadCache::Idle);
+            }
+        }
+    }
+}
+
+ObjectMemoryPools::Slab* ObjectMemoryPools::collectFreeSlabs (SizeClass& sizeClass, Slab* released) throw()
+{
+    Block* blocks;
+    Block* block;
+    UnsignedLong tag;
+    Slab* slab;
+    Slab* previous;
+    int numBlocks = 0;
+    
+    // take the whole free list, it is only empty for the time it takes to sort it
+    do
+    {
+        tag = sizeClass.freeList.getExtraUnchecked();
+        blocks = sizeClass.freeList.getPtrUnchecked();
+    } while (! sizeClass.freeList.compareAndSwap (blocks, tag, 0, tag + 1));
+    
+    for (slab = sizeClass.slabs.getValue(); slab != 0; slab = slab->next)
+        slab->numCollected = 0;
+    
+    for (block = blocks; block != 0; block = block->next)
+    {
+        ++getHeader (block)->slab->numCollected;
+        ++numBlocks;
+    }
+    
+    // unlink the slabs that have all their blocks on the free list, only this thread
+    // unlinks slabs but others may add new slabs at the head of the list at any time
+    previous = 0;
+    slab = sizeClass.slabs.getValue();
+    
+    while (slab != 0)
+    {
+        Slab* const next = slab->next;
+        
+        if (slab->numCollected == slab->numBlocks)
+        {
+            if (previous != 0)
+            {
+                previous->next = next;
+            }
+            else if (! sizeClass.slabs.compareAndSwap (slab, next))
+            {
+                previous = sizeClass.slabs.getValue();
                 
-            Threading::sleep (duration);
+                while (previous->next != slab)
+                    previous = previous->next;
+                
+                previous->next = next;
+            }
+            
+            slab->next = released;
+            released = slab;
+        }
+        else
+        {
+            previous = slab;
+        }
+        
+        slab = next;
+    }
+    
+    // put back the blocks from the slabs we're keeping
+    Block* keepFirst = 0;
+    Block* keepLast = 0;
+    int numKept = 0;
+    
+    block = blocks;
+    
+    while (block != 0)
+    {
+        Block* const next = block->next;
+        slab = getHeader (block)->slab;
+        
+        if (slab->numCollected != slab->numBlocks)
+        {
+            if (keepLast == 0)
+                keepLast = block;
+            
+            block->next = keepFirst;
+            keepFirst = block;
+            ++numKept;
         }
+        
+        block = next;
+    }
+    
+    sizeClass.numFree -= numBlocks;
+    
+    if (keepFirst != 0)
+        pushBlocks (sizeClass, keepFirst, keepLast, numKept);
+    
+    return released;
+}
+
+void ObjectMemoryPools::releaseIdleSlabs (const bool all) throw()
+{
+    Slab* released = 0;
+    int i;
+    
+    for (i = 0; i < NumClasses; ++i)
+    {
+        SizeClass& sizeClass = classes[i];
+        
+        // only look at size classes that haven't needed the free list for a while
+        const int numPops = sizeClass.numPops.getValueUnchecked();
+        sizeClass.numIdlePeriods = (numPops == sizeClass.lastNumPops) ? sizeClass.numIdlePeriods + 1 : 0;
+        sizeClass.lastNumPops = numPops;
+        
+        if ((all || (sizeClass.numIdlePeriods >= SlabIdlePeriods)) &&
+            (sizeClass.numFree.getValueUnchecked() >= sizeClass.blocksPerSlab))
+        {
+            sizeClass.numIdlePeriods = 0;
+            released = collectFreeSlabs (sizeClass, released);
+        }
+    }
+    
+    if (released != 0)
+    {
+        // wait for any popBlocks() that started before the free lists were collected
+        for (i = 0; i < NumClasses; ++i)
+            while (classes[i].numPopping.getValueUnchecked() != 0)
+                Threading::yield();
+        
+        while (released != 0)
+        {
+            Slab* const next = released->next;
+            numBytesReserved -= Long (released->numBytes);
+            pl_MemoryDefaultFree (this, released);
+            released = next;
+        }
+    }
+}
+
+ResultCode ObjectMemoryPools::run() throw()
+{
+    const double duration = 0.5;
+    
+    while (! getShouldExit())
+    {
+        plonk_assert (getMemory().getUserData() == this);
+        
+        Threading::sleep (duration);
+        ++period;
+        
+        flushIdleThreadCaches (false);
+        releaseIdleSlabs (false);
     }
     
     setPriority (100);
     
     // reset functions
-    getMemory().setFunctions (staticDoAlloc, staticDoFree); 
+    getMemory().setFunctions (staticDirectAlloc, staticDirectFree); 
     
-    // clear - deallocate all of the memory
-    for (i = 0; i < NumQueues; ++i)
-        queues[i].clearAll();
+    // return everything that isn't still in use
+    flushIdleThreadCaches (true);
+    releaseIdleSlabs (true);
     
     return 0;
 }
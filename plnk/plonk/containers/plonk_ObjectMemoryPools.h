@@ -43,21 +43,30 @@
  This replaces memory allocation functions for objects in the library
  and raw arrays of simple types.
  
- This maintains a series of queues that contain memory blocks that are 2**N.
- This means that objects will be rounded up to the nearest power of 2. (A more
- efficient algorithm would use smaller blcoks above a certain size and round to
- something like 4K.)
+ This is a slab allocator. Requested sizes are rounded up to a size class: 16 byte
+ steps up to 128 bytes then four classes for each power of 2 above that (so a block
+ is never more than 25% larger than it needs to be, a 1025 sample float buffer uses 
+ a 5K block not 8K). Blocks are carved out of larger slabs of memory obtained from 
+ the operating system, up to 64K of blocks per slab for the smaller classes and one 
+ block per slab for the larger ones.
  
- When memory is allocated it is first requested from the appropriate queue. If a
- free memory block is available in the queue then that is used for the requested
- memory and returned to the caller. When memory is freed, the memory block is simply
- placed back onto the appropriate queue.
+ Each thread that allocates or frees memory gets its own small cache of free blocks 
+ for each of the size classes up to 32K. Only the owning thread touches its cache so 
+ allocation and deallocation on the audio thread doesn't contend with other threads.
+ Blocks move between the thread caches and a lock-free free list for each size class 
+ in batches. Larger blocks go straight to the free list for their size class.
+ 
+ When memory is allocated it is first taken from the calling thread's cache, then
+ from the free list for the size class. Only when both of these are empty is a new
+ slab allocated from the operating system. When memory is freed the block is placed
+ back into the thread's cache (or the free list if the cache is full).
  
  This means that if you preallocate pools that are large enough then both allocation
  and deallocation are thread safe.
  
- @note This algorithm NEVER actaully deallocates the memory from the operating system
- until this object is destroyed (usually as you app is closed down).
+ The background thread periodically flushes the caches of threads that have stopped
+ using memory back to the free lists. Once a size class has been idle for a few 
+ seconds any slabs whose blocks are all free are returned to the operating system.
  
  To use this allocate one in your application set up code making sure that this happens
  before any other Plonk/Plank objects:
@@ -86,18 +95,21 @@ public:
     
     enum Constants
     {
-        NumQueues = 64
+        HeaderSize = PLONK_WORDSIZE * 2,
+        SmallClassStep = 16,
+        NumSmallClasses = 8,
+        SmallClassesLog2 = 7,
+        ClassesPerPowerOf2 = 4,
+        NumClasses = NumSmallClasses + ClassesPerPowerOf2 * (PLONK_WORDSIZE * 8 - SmallClassesLog2 - 1),
+        NumCachedClasses = NumSmallClasses + ClassesPerPowerOf2 * (15 - SmallClassesLog2),
+        SlabSize = 65536,
+        ThreadCacheBytes = 32768,
+        ThreadCacheMaxBlocks = 64,
+        NumThreadCaches = 64,
+        ThreadCacheIdlePeriods = 2,
+        SlabIdlePeriods = 4
     };
     
-    class Element : public PlonkBase
-    {
-    public:
-        Element() : ptr (0) { }
-        Element (void* p) : ptr (p) { }
-
-        void* ptr;
-    };
-            
     ObjectMemoryPools (Memory& memory) throw();
     ~ObjectMemoryPools();
     
@@ -110,8 +122,103 @@ public:
     void* allocateBytes (PlankUL size);
     void free (void* ptr);
     
+    /** Get the number of bytes currently held in slabs from the operating system. */
+    PLONK_INLINE_LOW Long getNumBytesReserved() const throw() { return numBytesReserved.getValueUnchecked(); }
+    
 private:
-    LockFreeQueue<Element>* queues;    
+    class Slab;
+    
+    /** A free block, the link to the next free block overlays the block's memory. */
+    class Block
+    {
+    public:
+        Block* next;
+    };
+    
+    /** Stored immediately before each block, the slab is null for blocks allocated directly. */
+    class Header
+    {
+    public:
+        Slab* slab;
+        UnsignedLong size;
+    };
+    
+    class Slab
+    {
+    public:
+        Slab* next;
+        int sizeClass;
+        int numBlocks;
+        int numCollected;
+        UnsignedLong numBytes;
+    };
+    
+    class SizeClass
+    {
+    public:
+        SizeClass() throw() : blockSize (0), blocksPerSlab (0), cacheLimit (0), lastNumPops (0), numIdlePeriods (0) { }
+        
+        AtomicExtended<Block*> freeList;
+        AtomicValue<Slab*> slabs;
+        AtomicInt numFree;
+        AtomicInt numPops;
+        AtomicInt numPopping;
+        UnsignedLong blockSize;
+        int blocksPerSlab;
+        int cacheLimit;
+        int lastNumPops;
+        int numIdlePeriods;
+    };
+    
+    class ThreadCache
+    {
+    public:
+        enum State { Idle, Busy, Flushing };
+        
+        class Bin
+        {
+        public:
+            Block* head;
+            int count;
+        };
+        
+        ThreadCache() throw() : lastActivePeriod (0) { Memory::zero (bins, sizeof (bins)); }
+        
+        AtomicLong threadID;
+        AtomicInt state;
+        int lastActivePeriod;
+        Bin bins[NumCachedClasses];
+    };
+    
+    SizeClass classes[NumClasses];
+    ThreadCache caches[NumThreadCaches];
+    AtomicInt period;
+    AtomicLong numBytesReserved;
+    
+    static void* staticDirectAlloc (void* userData, PlankUL size);
+    static void staticDirectFree (void* userData, void* ptr);
+    
+    static PLONK_INLINE_LOW Header* getHeader (void* const ptr) throw()
+    {
+        return reinterpret_cast<Header*> (static_cast<UnsignedChar*> (ptr) - HeaderSize);
+    }
+    
+    static int sizeToClass (const UnsignedLong size) throw();
+    static UnsignedLong classToSize (const int sizeClass) throw();
+    
+    ThreadCache* lockThreadCache() throw();
+    void unlockThreadCache (ThreadCache* const cache) throw();
+    void flushThreadCache (ThreadCache& cache) throw();
+    void flushBin (ThreadCache::Bin& bin, const int sizeClass, const int numToKeep) throw();
+    void refillBin (ThreadCache::Bin& bin, const int sizeClass) throw();
+    
+    void pushBlocks (SizeClass& sizeClass, Block* const first, Block* const last, const int count) throw();
+    Block* popBlocks (SizeClass& sizeClass, const int maximum, Block*& last, int& count) throw();
+    Block* allocateSlab (const int sizeClass, Block*& last, int& count) throw();
+    
+    void flushIdleThreadCaches (const bool all) throw();
+    Slab* collectFreeSlabs (SizeClass& sizeClass, Slab* released) throw();
+    void releaseIdleSlabs (const bool all) throw();
 };
 
-#endif // PLONK_OBJECTMEMORYPOOLS_H
\ No newline at end of file
+#endif // PLONK_OBJECTMEMORYPOOLS_H
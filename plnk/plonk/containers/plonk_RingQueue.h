@@ -0,0 +1,299 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_RINGQUEUE_H
+#define PLONK_RINGQUEUE_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+
+#include "../core/plonk_SmartPointer.h"
+#include "../core/plonk_WeakPointer.h"
+
+/** Constructs and destroys typed items in the slots of a Plank ring queue. 
+ Items are copy constructed in place on push and destroyed after being copied 
+ out on pop so any copyable type can be used. */
+template<class ValueType>
+class RingQueueSlots
+{
+public:
+    static PLONK_INLINE_LOW bool push (PlankRingQueueRef queue, ValueType const& value) throw()
+    {
+        void* const slot = pl_RingQueue_BeginPush (queue);
+        
+        if (slot == 0)
+            return false;
+        
+        ::new (slot) ValueType (value);
+        pl_RingQueue_EndPush (queue, slot);
+        return true;
+    }
+    
+    template<class OtherType>
+    static PLONK_INLINE_LOW bool pop (PlankRingQueueRef queue, OtherType& value) throw()
+    {
+        void* const slot = pl_RingQueue_BeginPop (queue);
+        
+        if (slot == 0)
+            return false;
+        
+        ValueType* const item = static_cast<ValueType*> (slot);
+        value = *item;
+        item->~ValueType();
+        pl_RingQueue_EndPop (queue, slot);
+        return true;
+    }
+    
+    static void clear (PlankRingQueueRef queue) throw()
+    {
+        void* slot;
+        
+        while ((slot = pl_RingQueue_BeginPop (queue)) != 0)
+        {
+            static_cast<ValueType*> (slot)->~ValueType();
+            pl_RingQueue_EndPop (queue, slot);
+        }
+    }
+};
+
+template<class ValueType>
+class RingQueueInternal : public SmartPointer
+{
+public:
+    typedef RingQueue<ValueType>        QueueType;
+    typedef RingQueueSlots<ValueType>   Slots;
+    
+    RingQueueInternal (const int capacity, const int mode) throw()
+    {
+        ResultCode result = pl_RingQueue_Init (&queue, sizeof (ValueType), plonk::max (1, capacity), mode);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    ~RingQueueInternal()
+    {
+        clear();
+        pl_RingQueue_DeInit (&queue);
+    }
+    
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        return Slots::push (&queue, value);
+    }
+    
+    PLONK_INLINE_LOW int push (const ValueType* values, const int count) throw()
+    {
+        int i;
+        
+        for (i = 0; i < count; ++i)
+            if (! Slots::push (&queue, values[i]))
+                break;
+        
+        return i;
+    }
+    
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        return Slots::pop (&queue, value);
+    }
+    
+    PLONK_INLINE_LOW int pop (ValueType* values, const int count) throw()
+    {
+        int i;
+        
+        for (i = 0; i < count; ++i)
+            if (! Slots::pop (&queue, values[i]))
+                break;
+        
+        return i;
+    }
+    
+    void clear() throw()
+    {
+        Slots::clear (&queue);
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return (int)pl_RingQueue_GetSize (&queue);
+    }
+    
+    PLONK_INLINE_LOW int capacity() throw()
+    {
+        return (int)pl_RingQueue_GetCapacity (&queue);
+    }
+    
+    PLONK_INLINE_LOW int getMode() throw()
+    {
+        return pl_RingQueue_GetMode (&queue);
+    }
+    
+private:
+    PlankRingQueue queue;
+};
+
+//------------------------------------------------------------------------------
+
+/** A bounded lock-free FIFO queue that stores its items inline.
+ Unlike LockFreeQueue, push() and pop() never allocate memory, the items live in a
+ single buffer allocated when the queue is created. The capacity is rounded up 
+ to a power of 2 and push() returns false if the queue is full.
+ 
+ Use SPSC mode when there is exactly one thread pushing and one thread
+ popping (e.g., handing buffers between a worker and the audio thread), otherwise
+ use the default MPMC mode.
+ @ingroup PlonkContainerClasses */
+template<class ValueType>                                               
+class RingQueue : public SmartPointerContainer<RingQueueInternal<ValueType> >
+{
+public:
+    typedef RingQueueInternal<ValueType>        Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef WeakPointerContainer<RingQueue>     Weak;
+    typedef ValueType                           Value;
+    
+    enum Modes
+    {
+        MPMC = PLANKRINGQUEUE_MPMC,     ///< Any number of producer and consumer threads.
+        SPSC = PLANKRINGQUEUE_SPSC      ///< One producer thread and one consumer thread.
+    };
+    
+    enum Constants
+    {
+        DefaultCapacity = 64
+    };
+    
+    /** Create a queue. 
+     @param capacity The maximum number of items, rounded up to a power of 2.
+     @param mode     MPMC or SPSC. */
+    PLONK_INLINE_LOW RingQueue (const int capacity = DefaultCapacity, const int mode = MPMC) throw()
+    :   Base (new Internal (capacity, mode))
+    {
+    }
+    
+    PLONK_INLINE_LOW explicit RingQueue (Internal* internalToUse) throw() 
+	:	Base (internalToUse)
+	{
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */    
+    static RingQueue fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }    
+    
+    /** Copy constructor. */
+    PLONK_INLINE_LOW RingQueue (RingQueue const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    PLONK_INLINE_LOW RingQueue& operator= (RingQueue const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Push a copy of a value, returns false if the queue was full. */
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        return this->getInternal()->push (value);
+    }
+    
+    /** Push up to count values, returns the number pushed. */
+    PLONK_INLINE_LOW int push (const ValueType* values, const int count) throw()
+    {
+        return this->getInternal()->push (values, count);
+    }
+    
+    /** Pop a value, returns false if the queue was empty. */
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        return this->getInternal()->pop (value);
+    }
+    
+    /** Pop up to count values, returns the number popped. */
+    PLONK_INLINE_LOW int pop (ValueType* values, const int count) throw()
+    {
+        return this->getInternal()->pop (values, count);
+    }
+    
+    /** Pop a value, returns a default constructed value if the queue was empty. */
+    PLONK_INLINE_LOW ValueType pop() throw()
+    {
+        ValueType value = ValueType();
+        this->getInternal()->pop (value);
+        return value;
+    }
+    
+    /** Remove all the items. 
+     This counts as a consumer so must only be called from the consumer thread in SPSC mode. */
+    PLONK_INLINE_LOW void clear() throw()
+    {
+        this->getInternal()->clear();
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return this->getInternal()->length();
+    }
+    
+    PLONK_INLINE_LOW int capacity() throw()
+    {
+        return this->getInternal()->capacity();
+    }
+    
+    PLONK_INLINE_LOW int getMode() throw()
+    {
+        return this->getInternal()->getMode();
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(RingQueue);
+};
+
+
+#endif // PLONK_RINGQUEUE_H
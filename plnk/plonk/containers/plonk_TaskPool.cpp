@@ -0,0 +1,302 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../core/plonk_Headers.h"
+
+TaskPool::Worker::Worker (TaskPool& p, const int i) throw()
+:   Threading::Thread (Text ("TaskPool::Worker[" + Text (i) + Text ("]"))),
+    pool (p),
+    index (i),
+    event (Lock::MutexLock)
+{
+}
+
+void TaskPool::Worker::wake() throw()
+{
+    event.signal();
+}
+
+bool TaskPool::Worker::findJob (TaskJob& job) throw()
+{
+    if (jobs.pop (job))
+        return true;
+    
+    // steal from the other workers, starting with our neighbour
+    for (int i = 1; i < pool.numWorkers; ++i)
+    {
+        Worker* const victim = pool.workers[(index + i) % pool.numWorkers];
+        
+        if (victim->jobs.pop (job))
+            return true;
+    }
+    
+    return false;
+}
+
+ResultCode TaskPool::Worker::run() throw()
+{
+    TaskJob job;
+    
+    while (! getShouldExit())
+    {
+        if (findJob (job))
+        {
+            job.run();
+            job = TaskJob();
+        }
+        else
+        {
+            // the event stays signalled if a job arrived since findJob() so this can't miss it
+            event.wait (0.1);
+        }
+    }
+    
+    jobs.clearAll();
+    
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+
+TaskPool::TaskPool (const int numWorkersToUse, const int priority) throw()
+:   numWorkers (numWorkersToUse > 0 ? numWorkersToUse : Threading::getNumCores()),
+    workers (new Worker*[numWorkers])
+{
+    for (int i = 0; i < numWorkers; ++i)
+        workers[i] = new Worker (*this, i);
+    
+    AtomicOps::memoryBarrier();
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers[i]->start();
+        workers[i]->setPriority (priority);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers[i]->setShouldExit();
+        workers[i]->wake();
+    }
+    
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers[i]->wait();
+        delete workers[i];
+    }
+    
+    delete [] workers;
+}
+
+TaskPool& TaskPool::getDefault() throw()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+TaskPool& TaskPool::getIO() throw()
+{
+    static TaskPool pool (2); // disk bound so more workers won't help much
+    return pool;
+}
+
+int TaskPool::findCurrentWorker() const throw()
+{
+    const Threading::ID currentID = Threading::getCurrentThreadID();
+    
+    for (int i = 0; i < numWorkers; ++i)
+        if (workers[i]->getID() == currentID)
+            return i;
+    
+    return -1;
+}
+
+void TaskPool::schedule (TaskJob const& job) throw()
+{
+    plonk_assert (job.getInternal() != 0);
+    
+    const int current = findCurrentWorker();
+    
+    if (current >= 0)
+    {
+        // we're on a worker so it will pick this up when it next looks for a job
+        // or an idle worker will steal it
+        workers[current]->jobs.push (job);
+        workers[(current + 1) % numWorkers]->wake();
+    }
+    else
+    {
+        const int target = (++nextWorker & 0x7fffffff) % numWorkers;
+        workers[target]->jobs.push (job);
+        workers[target]->wake();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+TaskBatchInternal::Job::Job (TaskBatchInternal* batchToUse) throw()
+:   batch (batchToUse),
+    state (Idle)
+{
+}
+
+void TaskBatchInternal::Job::run() throw()
+{
+    if (! state.compareAndSwap (Queued, Running))
+        return; // the batch has gone
+    
+    // help with whichever generation is current, a closed one has nothing left to claim
+    const int generationToRun = batch->ticket.getValue() >> IndexBits;
+    
+    while (batch->runNextItem (generationToRun))
+    {
+    }
+    
+    state.setValue (Idle);
+}
+
+TaskBatchInternal::TaskBatchInternal (const int numJobsToAllocate) throw()
+:   SmartPointer (false),
+    ticket (IndexMask),
+    numItemsDone (0),
+    numItems (0),
+    generation (0),
+    finished (Lock::MutexLock)
+{
+    addJobs (numJobsToAllocate);
+}
+
+TaskBatchInternal::~TaskBatchInternal()
+{
+    for (int i = 0; i < jobs.length(); ++i)
+    {
+        Job* const job = static_cast<Job*> (jobs.atUnchecked (i).getInternal());
+        int spin = 0;
+        
+        // a running job only has to notice there is nothing left to claim, 
+        // if it takes longer than a short spin block rather than burn the core
+        while (! (job->state.compareAndSwap (Job::Idle,   Job::Finished) ||
+                  job->state.compareAndSwap (Job::Queued, Job::Finished)))
+        {
+            if (spin++ < SpinCount)
+                Threading::yield();
+            else
+                finished.wait (0.001);
+        }
+    }
+}
+
+void TaskBatchInternal::addJobs (const int numJobsNeeded) throw()
+{
+    while (jobs.length() < numJobsNeeded)
+        jobs.add (TaskJob (new Job (this)));
+}
+
+bool TaskBatchInternal::runNextItem (const int generationToRun) throw()
+{
+    for (;;)
+    {
+        const int current = ticket.getValue();
+        const int index = current & IndexMask;
+        
+        if (((current >> IndexBits) != generationToRun) || (index >= numItems))
+            return false;
+        
+        if (ticket.compareAndSwap (current, current + 1))
+        {
+            const int total = numItems;
+            
+            runItem (index);
+            
+            if (++numItemsDone == total)
+                finished.signal(); // wake run() if it has stopped spinning
+            
+            return true;
+        }
+    }
+}
+
+void TaskBatchInternal::run (TaskPool& pool, const int numItemsToRun) throw()
+{
+    plonk_assert (numItemsToRun < IndexMask);
+    
+    if (numItemsToRun <= 0)
+        return;
+    
+    generation = (generation + 1) & GenerationMask;
+    numItems = numItemsToRun;
+    numItemsDone.setValue (0);
+    ticket.setValue (generation << IndexBits); // publishes numItems
+    
+    const int numJobs = plonk::min (numItems - 1, pool.getNumWorkers());
+    
+    addJobs (numJobs); // only allocates if the constructor didn't make enough
+    
+    for (int i = 0; i < numJobs; ++i)
+    {
+        TaskJob& job = jobs.atUnchecked (i);
+        
+        // a job still queued or running from the last run will pick up this one
+        if (static_cast<Job*> (job.getInternal())->state.compareAndSwap (Job::Idle, Job::Queued))
+            pool.schedule (job);
+    }
+    
+    while (runNextItem (generation))
+    {
+    }
+    
+    // the barrier, the other items have been claimed so will usually finish 
+    // within a short spin, after that block until the last one signals
+    for (int spin = 0; (spin < SpinCount) && (numItemsDone.getValue() < numItems); ++spin)
+        Threading::yield();
+    
+    while (numItemsDone.getValue() < numItems)
+        finished.wait (0.001);
+    
+    // close this generation so stale jobs can't claim anything before the next run
+    ticket.setValue ((generation << IndexBits) | IndexMask);
+}
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,193 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_TASKPOOL_H
+#define PLONK_TASKPOOL_H
+
+/** A unit of work that can be scheduled on a TaskPool. 
+ Subclasses implement run() which is called on one of the pool's worker threads.
+ The pool holds a reference to the job while it is queued and running. */
+class TaskJobInternal : public SmartPointer
+{
+public:
+    TaskJobInternal() throw() : SmartPointer (false) { } // no weak ref needed
+    ~TaskJobInternal() { }
+    
+    virtual void run() throw() = 0;
+};
+
+class TaskJob : public SmartPointerContainer<TaskJobInternal>
+{
+public:
+    TaskJob() throw()
+    :   SmartPointerContainer<TaskJobInternal> (static_cast<TaskJobInternal*> (0))
+    {
+    }
+    
+    TaskJob (TaskJobInternal* internalToUse) throw()
+    :   SmartPointerContainer<TaskJobInternal> (internalToUse)
+    {
+    }
+    
+    PLONK_INLINE_LOW void run() throw() { this->getInternal()->run(); }
+};
+
+//------------------------------------------------------------------------------
+
+/** A fixed set of worker threads that run TaskJob objects.
+ Each worker owns a lock-free job queue. Jobs scheduled from a worker thread
+ go onto that worker's own queue, jobs scheduled from any other thread are 
+ distributed round-robin. A worker that runs out of jobs steals from the queues 
+ of the other workers before going to sleep on its event, so no polling is 
+ needed: workers are woken when a job is scheduled.
+ 
+ The default pool (see getDefault()) has one worker per processor core and
+ is shared by all InputTask units.
+ 
+ @see TaskJob, InputTaskUnit */
+class TaskPool
+{
+public:
+    TaskPool (const int numWorkers = 0, const int priority = 50) throw();
+    ~TaskPool();
+    
+    /** Get the shared pool which is sized to the number of processor cores. */
+    static TaskPool& getDefault() throw();
+    
+    /** Get the shared pool for jobs that block on disk I/O. 
+     This is kept apart from the default pool so reads waiting on the disk 
+     never hold up processing jobs. */
+    static TaskPool& getIO() throw();
+    
+    /** Queue a job to be run on one of the worker threads. 
+     This is lock-free apart from signalling the worker's event. */
+    void schedule (TaskJob const& job) throw();
+    
+    PLONK_INLINE_LOW int getNumWorkers() const throw() { return numWorkers; }
+    
+private:
+    class Worker : public Threading::Thread
+    {
+    public:
+        Worker (TaskPool& pool, const int index) throw();
+        ResultCode run() throw();
+        
+        void wake() throw();
+        
+        LockFreeQueue<TaskJob> jobs;
+        
+    private:
+        bool findJob (TaskJob& job) throw();
+        
+        TaskPool& pool;
+        const int index;
+        Lock event;
+    };
+    
+    int findCurrentWorker() const throw();
+    
+    int numWorkers;
+    Worker** workers;
+    AtomicInt nextWorker;
+    
+    TaskPool (TaskPool const&);
+    TaskPool& operator= (TaskPool const&);
+};
+
+//------------------------------------------------------------------------------
+
+/** Runs a batch of numbered work items across a TaskPool.
+ The calling thread works on the batch too and run() only returns once every
+ item has completed so it acts as a barrier. Items are claimed using a counter 
+ that is tagged with a generation, this means jobs left in the pool's queues
+ from an earlier batch can never claim items from a later batch.
+ 
+ The jobs that help with the batch are allocated once and rescheduled on each
+ run so run() doesn't allocate once there are enough of them for the pool.
+ 
+ Subclasses implement runItem(). */
+class TaskBatchInternal : public SmartPointer
+{
+public:
+    /** @param numJobsToAllocate The number of jobs to create up front, this should be
+                                 the number of workers in the pool that will be used
+                                 if run() is called on a real-time thread. */
+    TaskBatchInternal (const int numJobsToAllocate = 0) throw();
+    ~TaskBatchInternal();
+    
+    /** Call runItem() for each index from 0 to numItems-1 and wait for them all. */
+    void run (TaskPool& pool, const int numItems) throw();
+    
+    /** Process one item, this may be called from any thread. */
+    virtual void runItem (const int index) throw() = 0;
+    
+private:
+    enum Constants
+    {
+        IndexBits = 16,
+        IndexMask = (1 << IndexBits) - 1,
+        GenerationMask = 0x7fff,
+        SpinCount = 64
+    };
+    
+    /** A job stays in the pool's queues after its batch is deleted if it was 
+     still queued, the Finished state stops it touching the batch. */
+    class Job : public TaskJobInternal
+    {
+    public:
+        enum States { Idle, Queued, Running, Finished };
+        
+        Job (TaskBatchInternal* batch) throw();
+        void run() throw();
+        
+        TaskBatchInternal* const batch;
+        AtomicInt state;
+    };
+    
+    bool runNextItem (const int generation) throw();
+    void addJobs (const int numJobsNeeded) throw();
+    
+    ObjectArray<TaskJob> jobs;
+    AtomicInt ticket;
+    AtomicInt numItemsDone;
+    int numItems;
+    int generation;
+    Lock finished;
+};
+
+#endif // PLONK_TASKPOOL_H
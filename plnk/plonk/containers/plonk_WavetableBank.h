@@ -0,0 +1,349 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_WAVETABLEBANK_H
+#define PLONK_WAVETABLEBANK_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+#include "plonk_DynamicContainer.h"
+
+#include "../core/plonk_SmartPointer.h"
+#include "../core/plonk_WeakPointer.h"
+#include "plonk_ObjectArray.h"
+#include "plonk_SimpleArray.h"
+
+
+template<class SampleType>
+class WavetableBankInternal : public SmartPointer
+{
+public:
+    typedef WavetableBankBase<SampleType>   Container;
+    typedef NumericalArray<SampleType>      Buffer;
+    typedef NumericalArray<double>          DoubleBuffer;
+    typedef WavetableBase<SampleType>       WavetableType;
+
+    WavetableBankInternal (Buffer const& weights, const int tableLengthToUse) throw()
+    :   tableLength (tableLengthToUse),
+        numHarmonics (weights.length()),
+        numLevels (0)
+    {
+        plonk_assert (Bits::isPowerOf2 (tableLength));
+        plonk_assert (numHarmonics > 0);
+        plonk_assert (numHarmonics <= (tableLength / 2));
+
+        // level k holds the first (numHarmonics >> k) harmonics
+        for (int harmonics = numHarmonics; harmonics > 0; harmonics >>= 1)
+            levelHarmonics.add (harmonics);
+
+        numLevels = levelHarmonics.length();
+        DoubleBuffer sums = DoubleBuffer::newClear (numLevels * tableLength);
+        DoubleBuffer sum = DoubleBuffer::newClear (tableLength);
+        double* const sumSamples = sum.getArray();
+        const double angle = Math<double>::get2Pi() / double (tableLength);
+        double peak = 0.0;
+        int harmonic = 1;
+        int i;
+
+        // build the levels from the top octave down, each level adds harmonics to the one above
+        for (int level = numLevels; --level >= 0;)
+        {
+            for (; harmonic <= levelHarmonics.atUnchecked (level); ++harmonic)
+            {
+                const double weight = double (weights.atUnchecked (harmonic - 1));
+
+                if (weight == 0.0)
+                    continue;
+
+                // sin (n * w) from the Chebyshev recurrence, avoids a sin() call per sample
+                const double w = angle * harmonic;
+                const double k = 2.0 * std::cos (w);
+                double y1 = 0.0;
+                double y0 = std::sin (w);
+
+                for (i = 1; i < tableLength; ++i)
+                {
+                    sumSamples[i] += weight * y0;
+                    const double y = k * y0 - y1;
+                    y1 = y0;
+                    y0 = y;
+                }
+            }
+
+            DoubleBuffer::copyData (sums.getArray() + level * tableLength, sumSamples, tableLength);
+            peak = plonk::max (peak, sum.findMaximumAbs());
+        }
+
+        // the same gain for all levels so the output level doesn't jump between octaves
+        const double gain = (peak > 0.0) ? (double (TypeUtility<SampleType>::getTypePeak()) / peak) : 1.0;
+        const double* sumsSamples = sums.getArray();
+
+        // each level is stored twice in a row, like WavetableBase, so lookups never need to wrap
+        tables = Buffer::newClear (numLevels * tableLength * 2);
+        SampleType* tableSamples = tables.getArray();
+
+        for (int level = 0; level < numLevels; ++level, sumsSamples += tableLength)
+        {
+            for (i = 0; i < tableLength; ++i)
+                *tableSamples++ = SampleType (sumsSamples[i] * gain);
+
+            for (i = 0; i < tableLength; ++i)
+                *tableSamples++ = SampleType (sumsSamples[i] * gain);
+        }
+    }
+
+    friend class WavetableBankBase<SampleType>;
+
+private:
+    Buffer tables;
+    IntArray levelHarmonics;
+    int tableLength;
+    int numHarmonics;
+    int numLevels;
+};
+
+//------------------------------------------------------------------------------
+
+/** A set of band limited wavetables, one per octave.
+ Level 0 contains all the harmonics given, each subsequent level contains
+ half as many as the level before it, down to just the fundamental. All levels
+ are the same (power of 2) length and are scaled by the same gain. An oscillator
+ picks the level with the most harmonics that stay below Nyquist at its
+ current frequency so that high notes don't alias and low notes aren't dull.
+
+ The banks for common waveforms are built once and shared by all users.
+ @see OscillatorBankUnit
+ @ingroup PlonkContainerClasses */
+template<class SampleType>
+class WavetableBankBase : public SmartPointerContainer< WavetableBankInternal<SampleType> >
+{
+public:
+    typedef WavetableBankInternal<SampleType>       Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    typedef WeakPointerContainer<WavetableBankBase> Weak;
+
+    typedef NumericalArray<SampleType>              Buffer;
+    typedef WavetableBase<SampleType>               WavetableType;
+
+    /** Creates a bank containing a single sine wave. */
+    WavetableBankBase() throw()
+    :	Base (new Internal (Buffer (SampleType (1)), 512))
+    {
+    }
+
+    /** Creates a bank from harmonic weights.
+     @param weights     The amplitude of each sine harmonic starting with the fundamental.
+                        The number of weights is the number of harmonics in level 0.
+     @param tableLength The length of each table, this must be a power of 2 and at least
+                        twice the number of harmonics. */
+    WavetableBankBase (Buffer const& weights, const int tableLength = 4096) throw()
+	:	Base (new Internal (weights, tableLength))
+	{
+	}
+
+    explicit WavetableBankBase (Internal* internalToUse) throw()
+	:	Base (internalToUse)
+	{
+	}
+
+    WavetableBankBase (WavetableBankBase const& copy) throw()
+	:	Base (static_cast<Base const&> (copy))
+	{
+	}
+
+    WavetableBankBase (Dynamic const& other) throw()
+    :   Base (other.as<WavetableBankBase>().getInternal())
+    {
+    }
+
+    /** Assignment operator. */
+    WavetableBankBase& operator= (WavetableBankBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+
+        return *this;
+	}
+
+    /** Get a weakly linked copy of this object.
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */
+    static WavetableBankBase fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }
+
+    static const WavetableBankBase& getNull() throw()
+	{
+		static WavetableBankBase null;
+		return null;
+	}
+
+    static WavetableBankBase harmonic (Buffer const& weights, const int tableLength = 4096) throw()
+    {
+        return WavetableBankBase (weights, tableLength);
+    }
+
+    /** Creates a band limited sawtooth bank. */
+    static WavetableBankBase harmonicSaw (const int tableLength, const int numHarmonics) throw()
+    {
+        Buffer weights = Buffer::newClear (numHarmonics);
+
+        for (int i = 0; i < numHarmonics; ++i)
+            weights.put (i, SampleType (1.0 / (i + 1)));
+
+        return WavetableBankBase (weights, tableLength);
+    }
+
+    /** Creates a band limited square wave bank. */
+    static WavetableBankBase harmonicSquare (const int tableLength, const int numHarmonics) throw()
+    {
+        Buffer weights = Buffer::newClear (numHarmonics);
+
+        for (int i = 0; i < numHarmonics; i += 2)
+            weights.put (i, SampleType (1.0 / (i + 1)));
+
+        return WavetableBankBase (weights, tableLength);
+    }
+
+    /** Creates a band limited triangle wave bank. */
+    static WavetableBankBase harmonicTri (const int tableLength, const int numHarmonics) throw()
+    {
+        Buffer weights = Buffer::newClear (numHarmonics);
+
+        for (int i = 0; i < numHarmonics; i += 2)
+            weights.put (i, SampleType ((((i / 2) & 1) ? -1.0 : 1.0) / double ((i + 1) * (i + 1))));
+
+        return WavetableBankBase (weights, tableLength);
+    }
+
+    /** A shared sawtooth bank with 1024 harmonics in 4096 sample tables. */
+    static const WavetableBankBase& harmonicSaw() throw()
+    {
+        static const WavetableBankBase bank (harmonicSaw (4096, 1024));
+        return bank;
+    }
+
+    /** A shared square wave bank with 1024 harmonics in 4096 sample tables. */
+    static const WavetableBankBase& harmonicSquare() throw()
+    {
+        static const WavetableBankBase bank (harmonicSquare (4096, 1024));
+        return bank;
+    }
+
+    /** A shared triangle wave bank with 1024 harmonics in 4096 sample tables. */
+    static const WavetableBankBase& harmonicTri() throw()
+    {
+        static const WavetableBankBase bank (harmonicTri (4096, 1024));
+        return bank;
+    }
+
+    PLONK_OBJECTARROWOPERATOR(WavetableBankBase);
+
+    /** Get the number of octave levels. */
+    PLONK_INLINE_LOW int getNumLevels() const throw()
+    {
+        return this->getInternal()->numLevels;
+    }
+
+    /** Get the length of each table in the bank. */
+    PLONK_INLINE_LOW int getTableLength() const throw()
+    {
+        return this->getInternal()->tableLength;
+    }
+
+    /** Get the number of harmonics in level 0. */
+    PLONK_INLINE_LOW int getNumHarmonics() const throw()
+    {
+        return this->getInternal()->numHarmonics;
+    }
+
+    /** Get the number of harmonics in a particular level. */
+    PLONK_INLINE_LOW int getNumHarmonics (const int level) const throw()
+    {
+        return this->getInternal()->levelHarmonics.atUnchecked (level);
+    }
+
+    /** Get the samples for a particular level.
+     There are twice the table length samples, the table is repeated so that 
+     interpolation can read past the end without wrapping. */
+    PLONK_INLINE_LOW const SampleType* getLevelSamples (const int level) const throw()
+    {
+        return getSamples() + getLevelOffset (level);
+    }
+    
+    /** Get the offset of a particular level from the start of the bank's samples. */
+    PLONK_INLINE_LOW int getLevelOffset (const int level) const throw()
+    {
+        plonk_assert ((level >= 0) && (level < getNumLevels()));
+        return level * getTableLength() * 2;
+    }
+    
+    /** Get the samples for all the levels, one after the other. */
+    PLONK_INLINE_LOW const SampleType* getSamples() const throw()
+    {
+        return this->getInternal()->tables.getArray();
+    }
+    
+    /** Get a copy of a particular level as a Wavetable. */
+    WavetableType getLevel (const int level) const throw()
+    {
+        return WavetableType (Buffer::withArray (getTableLength(), getLevelSamples (level)));
+    }
+
+    /** Get the level to use for a given phase increment.
+     The increment is in table samples per output sample (i.e., frequency * tableLength / sampleRate).
+     This is the first level whose top harmonic is below Nyquist, or the last level
+     if even the fundamental is above it. */
+    template<class IndexType>
+    PLONK_INLINE_LOW int getLevelForIncrement (const IndexType increment) const throw()
+    {
+        const Internal* const internal = this->getInternal();
+        const int* const harmonics = internal->levelHarmonics.getArray();
+        const int lastLevel = internal->numLevels - 1;
+        const double limit = double (internal->tableLength / 2) / plonk::abs (double (increment));
+        int level = 0;
+
+        while ((level < lastLevel) && (double (harmonics[level]) >= limit))
+            ++level;
+
+        return level;
+    }
+};
+
+#endif // PLONK_WAVETABLEBANK_H
@@ -70,14 +70,17 @@
 #include "../containers/plonk_TextArray.h"
 #include "../containers/plonk_BreakPoints.h"
 #include "../containers/plonk_Wavetable.h"
+#include "../containers/plonk_WavetableBank.h"
 #include "../containers/plonk_Signal.h"
 #include "../containers/plonk_Int24.h"
 #include "../containers/plonk_Fix.h"
 #include "../containers/plonk_Function.h"
+#include "../containers/plonk_RingQueue.h"
 #include "../containers/plonk_LockFreeQueue.h"
 #include "../containers/plonk_LockFreeStack.h"
 #include "../containers/plonk_ObjectMemoryDeferFree.h"
 #include "../containers/plonk_ObjectMemoryPools.h"
+#include "../containers/plonk_TaskPool.h"
 
 #include "../containers/variables/plonk_VariableForwardDeclarations.h"
 #include "../containers/variables/plonk_Variable.h"
@@ -93,6 +96,7 @@
 
 #include "../maths/plonk_Constants.h"
 #include "../maths/plonk_Endian.h"
+#include "../maths/plonk_InterpSinc.h"
 
 #include "../random/plonk_RNG.h"
 
@@ -103,6 +107,9 @@
 #include "../files/audio/plonk_AudioFileMetaData.h"
 #include "../files/audio/plonk_AudioFileReader.h"
 #include "../files/audio/plonk_AudioFileWriter.h"
+#include "../files/audio/plonk_AudioFileStream.h"
+#include "../files/audio/plonk_DiskRecorder.h"
+#include "../files/audio/plonk_AudioFileHeaderCache.h"
 
 #include "../misc/plonk_NeuralNetwork.h"
 #include "../misc/plonk_JSON.h"
@@ -112,8 +119,10 @@
 #include "../fft/plonk_FFTEngine.h"
 #include "../fft/plonk_FFTEngineInternal.h"
 #include "../fft/plonk_FFTBuffers.h"
+#include "../fft/plonk_STFTEngine.h"
 
 #include "../graph/plonk_GraphForwardDeclarations.h"
+#include "../graph/utility/plonk_GraphDependencies.h" // before channels, the proxy channel uses it inline
 
 #include "../graph/channel/plonk_Channel.h"
 #include "../graph/channel/plonk_ChannelInternalBase.h"
@@ -127,9 +136,12 @@
 #include "../graph/utility/plonk_BlockSize.h"
 #include "../graph/utility/plonk_SampleRate.h"
 #include "../graph/utility/plonk_Bus.h"
+#include "../graph/utility/plonk_ParamEvents.h"
 #include "../graph/utility/plonk_TimeStamp.h"
 #include "../graph/utility/plonk_ProcessInfo.h"
 #include "../graph/utility/plonk_ProcessInfoInternal.h"
+#include "../graph/utility/plonk_Profiler.h"
+#include "../graph/utility/plonk_PlinkKernel.h"
 
 #include "../graph/info/plonk_InfoHeaders.h"
 
@@ -154,6 +166,8 @@
 #include "../graph/simple/plonk_Mixers.h"
 #include "../graph/simple/plonk_BlockChannel.h"
 #include "../graph/simple/plonk_VariableChannel.h"
+#include "../graph/simple/plonk_ParamEventChannel.h"
+#include "../graph/simple/plonk_DiskRecordChannel.h"
 #include "../graph/simple/plonk_RampChannel.h"
 #include "../graph/simple/plonk_AtomicVariableChannel.h"
 #include "../graph/simple/plonk_PatchChannel.h"
@@ -163,6 +177,7 @@
 #include "../graph/generators/plonk_Saw.h"
 #include "../graph/generators/plonk_WhiteNoise.h"
 #include "../graph/generators/plonk_Table.h"
+#include "../graph/generators/plonk_OscillatorBank.h"
 #include "../graph/generators/plonk_SignalPlay.h"
 #include "../graph/generators/plonk_SignalRead.h"
 #include "../graph/generators/plonk_FilePlay.h"
@@ -207,7 +222,9 @@
 #include "../graph/fft/plonk_IFFTChannel.h"
 #include "../graph/fft/plonk_ZMulChannel.h"
 #include "../graph/fft/plonk_ConvolveChannel.h"
+#include "../graph/fft/plonk_STFTChannel.h"
 
 #include "../hosts/plonk_AudioHostBase.h"
+#include "../hosts/offline/plonk_OfflineAudioHost.h"
 
 #endif // PLONKHEADERS_H
\ No newline at end of file
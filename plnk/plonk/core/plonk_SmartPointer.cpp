@@ -99,21 +99,10 @@ static AtomicLong& getTotalSmartPointersAtom() throw()
     return totalSmartPointers;
 }
 
-static AtomicLong& getTotalSmartPointerCountersAtom() throw()
-{
-    static AtomicLong totalSmartPointerCounters;
-    return totalSmartPointerCounters;
-}
-
 const Long getTotalSmartPointers() throw()
 {
     return getTotalSmartPointersAtom().getValue();
 }
-
-const Long getTotalSmartPointerCounters() throw()
-{
-    return getTotalSmartPointerCountersAtom().getValue();
-}
 #endif
 
 
@@ -151,19 +140,36 @@ void PlonkBase::operator delete[] (void* ptr)
     Memory::global().free (ptr); 
 }
 
-SmartPointer::SmartPointer (const bool allocateWeakPointer) throw()
-:	counter (0), weakPointer (0)
+// The count is only ever incremented by a thread that already holds a 
+// reference so that need not be ordered. The decrement must publish this
+// thread's writes to the object and see all the others before deleting it.
+#if defined(__ATOMIC_RELAXED)
+static PLONK_INLINE_LOW void smartPointerIncrement (AtomicInt& count) throw()
+{
+    __atomic_fetch_add ((volatile PlankI*)count.getAtomicRef(), 1, __ATOMIC_RELAXED);
+}
+
+static PLONK_INLINE_LOW Int smartPointerDecrement (AtomicInt& count) throw()
+{
+    return __atomic_sub_fetch ((volatile PlankI*)count.getAtomicRef(), 1, __ATOMIC_ACQ_REL);
+}
+#else
+static PLONK_INLINE_LOW void smartPointerIncrement (AtomicInt& count) throw()
+{
+    ++count;
+}
+
+static PLONK_INLINE_LOW Int smartPointerDecrement (AtomicInt& count) throw()
+{
+    return --count;
+}
+#endif
+
+SmartPointer::SmartPointer (const bool enableWeakPointer) throw()
+:	refCount (0), 
+    weakPointer (0),
+    weakPointerEnabled (enableWeakPointer)
 {		
-    counter = new SmartPointerCounter (this);
-    
-	if (allocateWeakPointer)
-    {
-        WeakPointer* weak = new WeakPointer (counter);
-        weak->incrementRefCount();  // for the WeakPointer object
-        weak->incrementWeakCount(); // for the weak count for this object
-        this->weakPointer = weak;
-    }
-    
 #if PLONK_SMARTPOINTER_DEBUG
     ++getTotalSmartPointersAtom();
 #if PLONK_SMARTPOINTER_DEBUGLOG
@@ -181,10 +187,6 @@ SmartPointer::~SmartPointer()
 #endif
 #endif
     
-    // actually OK now as the weak ref would be nulled on the when the refcount hit zero
-    // another thread getting the weak ref must have intervened and inc'd it
-	//plonk_assert (counter->getRefCount() == 0); 
-    
     if (weakPointer != 0)
     {
         WeakPointer* weak = static_cast<WeakPointer*> (weakPointer.getPtrUnchecked());
@@ -196,197 +198,70 @@ SmartPointer::~SmartPointer()
 
 void SmartPointer::incrementRefCount()  throw()
 {	
-    counter->incrementRefCount();
+    smartPointerIncrement (refCount);
 }
 
 void SmartPointer::decrementRefCount()  throw()
 { 
-    plonk_assert (counter->getRefCount() > 0);
-    counter->decrementRefCount(); 
-}
-
-void* SmartPointer::getWeak() const throw()               
-{ 
-    return weakPointer.getPtrUnchecked(); 
-}
-
-int SmartPointer::getRefCount() const throw()            
-{ 
-    return counter->getRefCount(); 
-}
-
-///-----------------------------------------------------------------------------
-
-SmartPointerCounter::SmartPointerCounter (SmartPointer* smartPointer) throw()
-:   atom (smartPointer, 0)
-{
-    
-#if PLONK_SMARTPOINTER_DEBUG
-    ++getTotalSmartPointerCountersAtom();
-#if PLONK_SMARTPOINTER_DEBUGLOG
-    printf("++SmartPointerCounter++ %p, %ld\n", this, totalSmartPointerCounters.getValueUnchecked());    
-#endif
-#endif
-}
-
-SmartPointerCounter::~SmartPointerCounter()
-{
-#if PLONK_SMARTPOINTER_DEBUG
-    --getTotalSmartPointerCountersAtom();
-#if PLONK_SMARTPOINTER_DEBUGLOG
-    printf("--SmartPointerCounter-- %p, %ld\n", this, totalSmartPointerCounters.getValueUnchecked());    
-#endif
-#endif
-}
-
-SmartPointer* SmartPointerCounter::getSmartPointer() const throw()
-{
-    return atom.getPtr();
-}
-
-void SmartPointerCounter::incrementRefCount() throw()
-{
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, refCount;
-    bool success;
+    plonk_assert (refCount.getValueUnchecked() > 0);
     
-    do
-    {
-        ptr      = atom.getPtrUnchecked();
-        oldExtra = atom.getExtraUnchecked();
-        refCount = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) + 1;
-        
-        plonk_assert ((refCount & PLANK_ATOMIC_XREFCOUNTMAX) != 0); // overflow occurred
-        
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
-    } while (! success);
-}
-
-void SmartPointerCounter::decrementRefCount() throw()
-{    
-    SmartPointer *oldPtr, *newPtr;
-    UnsignedLong oldExtra, refCount;
-    bool success;
-    
-    do
-    {
-        oldPtr   = atom.getPtrUnchecked();
-        oldExtra = atom.getExtraUnchecked();
-        refCount = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) - 1;
-        newPtr   = refCount == 0 ? static_cast<SmartPointer*> (0) : oldPtr;
-        
-        success = atom.compareAndSwap (oldPtr, oldExtra,
-                                       newPtr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
-    } while (! success);
-    
-    if (refCount == 0)
+    if (smartPointerDecrement (refCount) == 0)
     {
-        delete oldPtr; // might be zero in multithreaded if we inc'd and dec'd again but that's OK
+        WeakPointer* const weak = static_cast<WeakPointer*> (weakPointer.getPtrUnchecked());
         
-        if (PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) == 0)
+        // if another thread is retaining this via its weak pointer that will delete it instead
+        if ((weak == 0) || weak->peerReleased())
             delete this;
     }
 }
 
-int SmartPointerCounter::getRefCount() const throw()
+bool SmartPointer::incrementRefCountIfNotZero() throw()
 {
-    return PLANK_SHAREDPTR_XGETREFCOUNT(atom.getExtraUnchecked());
-}
-
-void SmartPointerCounter::incrementWeakCount() throw()
-{
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, weakCount;
+    Int oldCount;
     bool success;
     
     do
     {
-        ptr       = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) + 1;
+        oldCount = refCount.getValueUnchecked();
         
-        plonk_assert ((weakCount & PLANK_ATOMIC_XWEAKCOUNTMAX) != 0); // overflow occurred
+        if (oldCount == 0)
+            return false;
         
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
+        success = refCount.compareAndSwap (oldCount, oldCount + 1);
     } while (! success);
+    
+    return true;
 }
 
-void SmartPointerCounter::decrementWeakCount() throw()
-{    
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, weakCount;
-    bool success;
+void* SmartPointer::getWeak() const throw()               
+{ 
+    void* weak = weakPointer.getPtr();
     
-    do
+    if ((weak == 0) && weakPointerEnabled)
     {
-        ptr       = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) - 1;
+        WeakPointer* const newWeak = new WeakPointer (const_cast<SmartPointer*> (this));
+        newWeak->incrementRefCount();  // for the WeakPointer object
+        newWeak->incrementWeakCount(); // for the weak count for this object
         
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
-    } while (! success);
-    
-    if ((weakCount == 0) && (PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) == 0))
-        delete this;
-}
-
-int SmartPointerCounter::getWeakCount() const throw()
-{
-    return PLANK_SHAREDPTR_XGETWEAKCOUNT(atom.getExtraUnchecked());
-}
-
-void SmartPointerCounter::incrementCounts() throw()
-{
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, refCount, weakCount;
-    bool success;
+        if (weakPointer.compareAndSwap (0, newWeak))
+        {
+            weak = newWeak;
+        }
+        else
+        {
+            // another thread got there first
+            newWeak->decrementWeakCount();
+            newWeak->decrementRefCount(); 
+            weak = weakPointer.getPtr();
+        }
+    }
     
-    do
-    {
-        ptr       = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-
-        refCount  = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) + 1;
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) + 1;
-
-        plonk_assert ((refCount & PLANK_ATOMIC_XREFCOUNTMAX) != 0); // overflow occurred
-        plonk_assert ((weakCount & PLANK_ATOMIC_XWEAKCOUNTMAX) != 0); // overflow occurred
-
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
-    } while (! success);
+    return weak;
 }
 
-void SmartPointerCounter::decrementCounts() throw()
-{    
-    SmartPointer *oldPtr, *newPtr;
-    UnsignedLong oldExtra, refCount, weakCount;
-    bool success;
-    
-    do
-    {
-        oldPtr    = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-
-        refCount  = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) - 1;
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) - 1;
-        
-        newPtr    = refCount == 0 ? static_cast<SmartPointer*> (0) : oldPtr;
-        
-        success = atom.compareAndSwap (oldPtr, oldExtra,
-                                       newPtr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
-    } while (! success);
-    
-    if (refCount == 0)
-    {
-        delete oldPtr; // might be zero in multithreaded if we inc'd and dec'd again but that's OK
-        
-        if (weakCount == 0)
-            delete this;
-    }
+int SmartPointer::getRefCount() const throw()            
+{ 
+    return refCount.getValue();
 }
 
 
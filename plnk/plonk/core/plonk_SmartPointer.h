@@ -64,7 +64,7 @@
 
 #if PLONK_SMARTPOINTER_DEBUG
 const Long getTotalSmartPointers() throw();
-const Long getTotalSmartPointerCounters() throw();
+const Long getTotalWeakPointers() throw();
 #endif
 
 class PlonkBase
@@ -87,6 +87,9 @@ public:
  especially with dynamically allocated audio components. A 'weak' version
  of this pointer can also be obtained which will not affect the reference
  count but will get set to 0 when its SmartPointer peer is deleted.
+ 
+ The reference count is stored in the object itself so no other allocation is
+ needed. The WeakPointer is only allocated the first time one is requested.
  @see WeakPointer, SmartPointerContainer
  */
 class SmartPointer : public PlonkBase
@@ -96,7 +99,7 @@ public:
 	/// @name Construction and destruction
 	/// @{
 	
-	SmartPointer (const bool allocateWeakPointer = true) throw();
+	SmartPointer (const bool enableWeakPointer = true) throw();
     virtual ~SmartPointer(); // MUST be virtual unless PlonkBase gains the need to be virtual    
     
 	void incrementRefCount() throw();    
@@ -108,6 +111,9 @@ public:
 	/// @{
 	
 //    PLONK_INLINE_LOW void update (Text const& message, Dynamic const& payload) throw() { (void)message; (void)payload; } // needed as a dummy in place of Sender::update?
+    
+    /** Gets the WeakPointer peer of this object, allocating it if necessary.
+     Returns 0 if weak pointers were not enabled for this object. */
     void* getWeak() const throw();
     int getRefCount() const throw();
     
@@ -118,64 +124,17 @@ public:
     friend class WeakPointer;
     
 protected:    
-    SmartPointerCounter* counter;
-    AtomicValue<void*> weakPointer;
+    AtomicInt refCount;
+    mutable AtomicValue<void*> weakPointer;
+    const bool weakPointerEnabled;
 	
 private:
+    bool incrementRefCountIfNotZero() throw();
+    
 	SmartPointer (const SmartPointer&);
     SmartPointer& operator= (const SmartPointer&);
 };
 
-//------------------------------------------------------------------------------
-
-class SmartPointerCounter : public PlonkBase
-{
-public:
-    SmartPointerCounter (SmartPointer* smartPointer) throw();    
-    ~SmartPointerCounter();    
-    
-    SmartPointer* getSmartPointer() const throw();
-    
-    void incrementRefCount() throw();    
-    void decrementRefCount() throw();
-    int getRefCount() const throw();   
-    
-    void incrementWeakCount() throw();    
-    void decrementWeakCount() throw();
-    int getWeakCount() const throw();    
-
-    void incrementCounts() throw();    
-    void decrementCounts() throw();    
-
-private:
-    AtomicExtended<SmartPointer*> atom;
-    
-//    struct Counts
-//    {
-//        unsigned int refCount:PLONK_HALFWORDBITS;
-//        unsigned int weakCount:PLONK_HALFWORDBITS;
-//    };
-//    
-//    struct Parts
-//    {
-//        SmartPointer* smartPointer;
-//        Counts counts;    
-//    };
-//    
-//    struct Halves
-//    {
-//        SmartPointer* ptr;
-//        Long extra;
-//    };
-//    
-//    union Element
-//    {
-//        Parts parts;
-//        Halves halves;
-//    };        
-};
-
-
 //------------------------------------------------------------------------------
 
 
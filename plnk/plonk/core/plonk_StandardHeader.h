@@ -166,6 +166,7 @@
 #include <cmath>
 #include <cwchar>
 #include <typeinfo>
+#include <new>
 #include <cstring>
 #include <cstdio>
 
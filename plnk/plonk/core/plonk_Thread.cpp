@@ -106,6 +106,11 @@ bool Threading::currentThreadIsAudioThread() throw()
     return audioThreadID == 0 ? false : audioThreadID == getCurrentThreadID();
 }
 
+int Threading::getNumCores() throw()
+{
+    return pl_ThreadNumCores();
+}
+
 Threading::Thread::Thread (const char* name) throw()
 {
     ResultCode result;
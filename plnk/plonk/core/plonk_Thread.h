@@ -60,6 +60,9 @@ public:
     static bool setAudioThreadID (const Threading::ID theID) throw();
     static bool currentThreadIsAudioThread() throw();
     
+    /** Get the number of processor cores available. */
+    static int getNumCores() throw();
+    
     /** The Thread class itself.
      You must inherit form this and implement the run() function. Then
      call start().
@@ -120,6 +120,10 @@ public:
         FloatUnitQueue, DoubleUnitQueue, ShortUnitQueue, CharUnitQueue, IntUnitQueue, Int24UnitQueue, LongUnitQueue,
         FloatBufferQueue, DoubleBufferQueue, ShortBufferQueue, CharBufferQueue, IntBufferQueue, Int24BufferQueue, LongBufferQueue,
         FloatFFTBuffersVariable, //DoubleFFTBuffers, ShortFFTBuffers, CharFFTBuffers, IntFFTBuffers, Int24FFTBuffers, LongFFTBuffers,
+        FloatParamEvents, DoubleParamEvents,
+        FloatDiskRecorder, DoubleDiskRecorder,
+        FloatWavetableBank, DoubleWavetableBank,
+        FloatSTFTEngine, DoubleSTFTEngine,
         
     // count (??)
         NumTypeCodes
@@ -189,6 +193,10 @@ public:
             "FloatUnitQueue", "DoubleUnitQueue", "ShortUnitQueue", "CharUnitQueue", "IntUnitQueue", "Int24UnitQueue", "LongUnitQueue",
             "FloatBufferQueue", "DoublBufferQueue", "ShortBufferQueue", "CharBufferQueue", "IntBufferQueue", "Int24BufferQueue", "LongBufferQueue",
             "FloatFFTBuffersVariable", //"DoubleFFTBuffers", "ShortFFTBuffers", "CharFFTBuffers", "IntFFTBuffers", "Int24FFTBuffers", "LongFFTBuffers"
+            "FloatParamEvents", "DoubleParamEvents",
+            "FloatDiskRecorder", "DoubleDiskRecorder",
+            "FloatWavetableBank", "DoubleWavetableBank",
+            "FloatSTFTEngine", "DoubleSTFTEngine",
         };
         
         if ((code >= 0) && (code < TypeCode::NumTypeCodes))
@@ -255,6 +263,10 @@ public:
     static PLONK_INLINE_LOW bool isBufferQueue (const int code) throw()       { return (code >= TypeCode::FloatBufferQueue) && (code <= TypeCode::LongBufferQueue); }
 //    static PLONK_INLINE_LOW bool isFFTBuffers (const int code) throw()        { return (code >= TypeCode::FloatFFTBuffers) && (code <= TypeCode::LongFFTBuffers); }
     static PLONK_INLINE_LOW bool isFFTBuffers (const int code) throw()        { return (code == TypeCode::FloatFFTBuffersVariable); }
+    static PLONK_INLINE_LOW bool isParamEvents (const int code) throw()       { return (code >= TypeCode::FloatParamEvents) && (code <= TypeCode::DoubleParamEvents); }
+    static PLONK_INLINE_LOW bool isDiskRecorder (const int code) throw()      { return (code >= TypeCode::FloatDiskRecorder) && (code <= TypeCode::DoubleDiskRecorder); }
+    static PLONK_INLINE_LOW bool isWavetableBank (const int code) throw()     { return (code >= TypeCode::FloatWavetableBank) && (code <= TypeCode::DoubleWavetableBank); }
+    static PLONK_INLINE_LOW bool isSTFTEngine (const int code) throw()        { return (code >= TypeCode::FloatSTFTEngine) && (code <= TypeCode::DoubleSTFTEngine); }
 
     // could replace these later by designing the enum to be bit-mask based
     
@@ -4903,6 +4915,230 @@ public:
     typedef double ScaleType;
 };
 
+template<>
+class TypeUtilityBase<FloatParamEvents>
+{
+public:
+    typedef FloatParamEvents                  TypeName;
+    typedef FloatParamEvents                  OriginalType;
+    typedef FloatParamEvents const&           PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatParamEvents; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const FloatParamEvents>
+{
+public:
+    typedef const FloatParamEvents            TypeName;
+    typedef FloatParamEvents                  OriginalType;
+    typedef FloatParamEvents const&           PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatParamEvents; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<DoubleParamEvents>
+{
+public:
+    typedef DoubleParamEvents                  TypeName;
+    typedef DoubleParamEvents                  OriginalType;
+    typedef DoubleParamEvents const&           PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleParamEvents; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const DoubleParamEvents>
+{
+public:
+    typedef const DoubleParamEvents            TypeName;
+    typedef DoubleParamEvents                  OriginalType;
+    typedef DoubleParamEvents const&           PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleParamEvents; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<FloatDiskRecorder>
+{
+public:
+    typedef FloatDiskRecorder                  TypeName;
+    typedef FloatDiskRecorder                  OriginalType;
+    typedef FloatDiskRecorder const&           PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatDiskRecorder; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const FloatDiskRecorder>
+{
+public:
+    typedef const FloatDiskRecorder            TypeName;
+    typedef FloatDiskRecorder                  OriginalType;
+    typedef FloatDiskRecorder const&           PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatDiskRecorder; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<DoubleDiskRecorder>
+{
+public:
+    typedef DoubleDiskRecorder                  TypeName;
+    typedef DoubleDiskRecorder                  OriginalType;
+    typedef DoubleDiskRecorder const&           PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleDiskRecorder; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const DoubleDiskRecorder>
+{
+public:
+    typedef const DoubleDiskRecorder            TypeName;
+    typedef DoubleDiskRecorder                  OriginalType;
+    typedef DoubleDiskRecorder const&           PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleDiskRecorder; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<FloatWavetableBank>
+{
+public:
+    typedef FloatWavetableBank                  TypeName;
+    typedef FloatWavetableBank                  OriginalType;
+    typedef FloatWavetableBank const&           PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatWavetableBank; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const FloatWavetableBank>
+{
+public:
+    typedef const FloatWavetableBank            TypeName;
+    typedef FloatWavetableBank                  OriginalType;
+    typedef FloatWavetableBank const&           PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatWavetableBank; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<DoubleWavetableBank>
+{
+public:
+    typedef DoubleWavetableBank                  TypeName;
+    typedef DoubleWavetableBank                  OriginalType;
+    typedef DoubleWavetableBank const&           PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleWavetableBank; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const DoubleWavetableBank>
+{
+public:
+    typedef const DoubleWavetableBank            TypeName;
+    typedef DoubleWavetableBank                  OriginalType;
+    typedef DoubleWavetableBank const&           PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleWavetableBank; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<FloatSTFTEngine>
+{
+public:
+    typedef FloatSTFTEngine                     TypeName;
+    typedef FloatSTFTEngine                     OriginalType;
+    typedef FloatSTFTEngine const&              PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatSTFTEngine; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const FloatSTFTEngine>
+{
+public:
+    typedef const FloatSTFTEngine               TypeName;
+    typedef FloatSTFTEngine                     OriginalType;
+    typedef FloatSTFTEngine const&              PassType;
+    typedef float                          IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::FloatSTFTEngine; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<DoubleSTFTEngine>
+{
+public:
+    typedef DoubleSTFTEngine                     TypeName;
+    typedef DoubleSTFTEngine                     OriginalType;
+    typedef DoubleSTFTEngine const&             PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleSTFTEngine; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
+template<>
+class TypeUtilityBase<const DoubleSTFTEngine>
+{
+public:
+    typedef const DoubleSTFTEngine               TypeName;
+    typedef DoubleSTFTEngine                     OriginalType;
+    typedef DoubleSTFTEngine const&             PassType;
+    typedef double                         IndexType;
+    static PLONK_INLINE_LOW int  getTypeCode() { return TypeCode::DoubleSTFTEngine; }
+    static PLONK_INLINE_LOW const OriginalType& getNull() { return TypeUtilityBase<const OriginalType&>::getNull(); }
+    typedef int PeakType;
+    typedef double ScaleType;
+};
+
 
 //template<>
 //class TypeUtilityBase<DoubleFFTBuffers>
@@ -5082,6 +5318,10 @@ public:
     static PLONK_INLINE_LOW bool isUnitQueue() throw()         { return TypeCode::isUnitQueue (TypeUtility<Type>::getTypeCode()); }
     static PLONK_INLINE_LOW bool isBufferQueue() throw()       { return TypeCode::isBufferQueue (TypeUtility<Type>::getTypeCode()); }
     static PLONK_INLINE_LOW bool isFFTBuffers() throw()        { return TypeCode::isFFTBuffers (TypeUtility<Type>::getTypeCode()); }
+    static PLONK_INLINE_LOW bool isParamEvents() throw()       { return TypeCode::isParamEvents (TypeUtility<Type>::getTypeCode()); }
+    static PLONK_INLINE_LOW bool isDiskRecorder() throw()      { return TypeCode::isDiskRecorder (TypeUtility<Type>::getTypeCode()); }
+    static PLONK_INLINE_LOW bool isWavetableBank() throw()     { return TypeCode::isWavetableBank (TypeUtility<Type>::getTypeCode()); }
+    static PLONK_INLINE_LOW bool isSTFTEngine() throw()        { return TypeCode::isSTFTEngine (TypeUtility<Type>::getTypeCode()); }
     
     static PLONK_INLINE_LOW bool isFloatType() throw()         { return TypeCode::isFloatType (TypeUtility<Type>::getTypeCode()); }
     static PLONK_INLINE_LOW bool isDoubleType() throw()        { return TypeCode::isDoubleType (TypeUtility<Type>::getTypeCode()); }
@@ -42,51 +42,97 @@ BEGIN_PLONK_NAMESPACE
 
 #include "plonk_Headers.h"
 
+#if PLONK_SMARTPOINTER_DEBUG
+static AtomicLong& getTotalWeakPointersAtom() throw()
+{
+    static AtomicLong totalWeakPointers;
+    return totalWeakPointers;
+}
+
+const Long getTotalWeakPointers() throw()
+{
+    return getTotalWeakPointersAtom().getValue();
+}
+#endif
 
-WeakPointer::WeakPointer (SmartPointerCounter* counterToUse) throw()
+WeakPointer::WeakPointer (SmartPointer* peerToUse) throw()
 :   SmartPointer (false), // avoid infinite recursion
-    peerCounter (counterToUse)
+    peer (peerToUse),
+    state (0),
+    weakCount (0)
 {
-    plonk_assert (counter != 0);
+    plonk_assert (peer != 0);
+    
+#if PLONK_SMARTPOINTER_DEBUG
+    ++getTotalWeakPointersAtom();
+#endif
 }
 
 WeakPointer::~WeakPointer()
 {
+#if PLONK_SMARTPOINTER_DEBUG
+    --getTotalWeakPointersAtom();
+#endif
 }
 
 SmartPointer* WeakPointer::getWeakPointer() const throw()
 {
-    return peerCounter->getSmartPointer();
+    return (state.getValue() & PeerReleased) ? 0 : peer;
 }    
 
 void WeakPointer::incrementWeakCount() throw()
 {
-    peerCounter->incrementWeakCount();
+    ++weakCount;
 }
 
 void WeakPointer::decrementWeakCount() throw()
 {
-    peerCounter->decrementWeakCount();
+    plonk_assert (weakCount.getValueUnchecked() > 0);
+    --weakCount;
 }
 
 int WeakPointer::getWeakCount() const throw()
 {
-    return peerCounter->getWeakCount();
+    return weakCount.getValue();
 }
 
-void WeakPointer::incrementPeerRefCount() throw()
+SmartPointer* WeakPointer::retainPeer() throw()
 {
-    peerCounter->incrementRefCount();
+    Int oldState;
+    bool success;
+    
+    // pin the peer so it can't be deleted while its count is checked
+    do
+    {
+        oldState = state.getValueUnchecked();
+        
+        if (oldState & PeerReleased)
+            return 0;
+        
+        success = state.compareAndSwap (oldState, oldState + PinIncrement);
+    } while (! success);
+    
+    SmartPointer* const result = peer->incrementRefCountIfNotZero() ? peer : 0;
+    unpin();
+    
+    return result;
 }
 
-void WeakPointer::decrementPeerRefCount() throw()
+void WeakPointer::unpin() throw()
 {
-    peerCounter->decrementRefCount();
+    // the peer was released while pinned and this was the last pin
+    if ((state -= PinIncrement) == PeerReleased)
+        delete peer;
 }
 
 int WeakPointer::getPeerRefCount() const throw()
 {
-    return peerCounter->getRefCount();
+    return (state.getValue() & PeerReleased) ? 0 : peer->getRefCount();
+}
+
+bool WeakPointer::peerReleased() throw()
+{
+    return (state += PeerReleased) == PeerReleased;
 }
 
 END_PLONK_NAMESPACE
@@ -48,11 +48,16 @@
  The main difference is that this copy does not increment the reference 
  count of the SmartPointer and gets set to 0 when the SmartPointer is 
  deleted.
+ 
+ The peer is allocated lazily by SmartPointer::getWeak(). The peer's
+ reference count lives in the SmartPointer itself so while the peer is
+ being retained from here it is pinned to stop it being deleted under us,
+ if its reference count reaches zero during this the last unpin deletes it.
  @see SmartPointer, WeakPointerContainer*/
 class WeakPointer : public SmartPointer
 {
 public:
-    WeakPointer (SmartPointerCounter* counter) throw();
+    WeakPointer (SmartPointer* peer) throw();
     ~WeakPointer();
     
     SmartPointer* getWeakPointer() const throw();
@@ -61,12 +66,29 @@ public:
     void decrementWeakCount() throw();
     int getWeakCount() const throw();   
     
-    void incrementPeerRefCount() throw();    
-    void decrementPeerRefCount() throw();
+    /** Gets the peer with its reference count incremented.
+     Returns 0 if the peer has been (or is being) deleted, otherwise the caller 
+     must call decrementRefCount() on the result. */
+    SmartPointer* retainPeer() throw();
     int getPeerRefCount() const throw();   
     
+    /** Called by the peer when its reference count reaches zero. 
+     Returns true if the peer should delete itself now, false if a thread
+     retaining it will do so instead. */
+    bool peerReleased() throw();
+    
 private:
-    SmartPointerCounter* const peerCounter;
+    enum StateFlags
+    {
+        PeerReleased = 1,
+        PinIncrement = 2
+    };
+    
+    SmartPointer* const peer;
+    AtomicInt state;
+    AtomicInt weakCount;
+    
+    void unpin() throw();
     
     WeakPointer();
     WeakPointer (const WeakPointer&);
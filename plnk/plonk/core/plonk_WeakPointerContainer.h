@@ -114,19 +114,18 @@ public:
         
         if (weakPointer != 0)
         {
-            // retain it, this ensures that if weakPointer->getWeakPointer() returns
-            // a non-null pointer that it will still be valid when passed to 
-            // construct the container object (which retains it again) OR...
-            // the pointer will be null
-            weakPointer->incrementPeerRefCount(); 
+            // retain it, this ensures that if the peer is returned it will still 
+            // be valid when passed to construct the container object (which 
+            // retains it again) OR... the pointer will be null
+            SmartPointer* const peer = weakPointer->retainPeer(); 
             
-            OriginalInternal* smartPointer = static_cast<OriginalInternal*> (weakPointer->getWeakPointer());
-            
-            if (smartPointer != 0)
-                result = OriginalType (smartPointer);
-
-            // release it
-            weakPointer->decrementPeerRefCount();
+            if (peer != 0)
+            {
+                result = OriginalType (static_cast<OriginalInternal*> (peer));
+                
+                // release it
+                peer->decrementRefCount();
+            }
         }
         
         return result;
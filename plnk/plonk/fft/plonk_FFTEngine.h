@@ -59,12 +59,15 @@ class FFTEngineBase<float> : public SmartPointerContainer< FFTEngineInternal<flo
 public:
     typedef FFTEngineInternal<float>            Internal;
     typedef SmartPointerContainer<Internal>     Base;
+    typedef Internal::Buffer                    Buffer;
     
     /** Create a new engine with a particular FFT size.
      @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
-                    specify the log2 FFT size e.g., 8 = pow(2,8) = 256). */
-    FFTEngineBase (const long length = 0) throw()
-    :   Base (new Internal (length))
+                    specify the log2 FFT size e.g., 8 = pow(2,8) = 256). 
+     @param engine  The underlying FFT library to use, one of the PLANKFFT_ENGINE_ identifiers. 
+                    The default uses Plank's global default (see pl_FFT_SetDefaultEngine()). */
+    FFTEngineBase (const long length = 0, const int engine = PLANKFFT_ENGINE_DEFAULT) throw()
+    :   Base (new Internal (length, engine))
     {
     }
     
@@ -129,10 +132,143 @@ public:
         return this->getInternal()->halfLength();
     }
 
+    /** Get log2 of the FFT size. */
     PLONK_INLINE_MID long lengthLog2() const
     {
         return this->getInternal()->lengthLog2();
     }
+    
+    /** Apply the FFT to a number of consecutive frames of length() samples.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void forwardBatch (float* output, const float* input, const int numTransforms) throw()
+    {
+        this->getInternal()->forwardBatch (output, input, numTransforms);
+    }
+    
+    /** Apply the inverse-FFT to a number of consecutive frames of length() samples.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void inverseBatch (float* output, const float* input, const int numTransforms) throw()
+    {
+        this->getInternal()->inverseBatch (output, input, numTransforms);
+    }
+    
+    /** Get the name of the underlying FFT library in use (e.g., "PFFFT" or "FFTReal"). */
+    PLONK_INLINE_MID const char* getEngineName() const
+    {
+        return this->getInternal()->getEngineName();
+    }
+
+private:
+};
+
+/** A double precision platform independent FFT processing engine. 
+ This uses Plank to decide which underlying processing engine to use (e.g., FFTReal
+ or vDSP), the single precision only engines fall back to FFTReal. 
+ @ingroup PlonkOtherUserClasses */
+template<>
+class FFTEngineBase<double> : public SmartPointerContainer< FFTEngineInternal<double> >
+{
+public:
+    typedef FFTEngineInternal<double>            Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef Internal::Buffer                    Buffer;
+    
+    /** Create a new engine with a particular FFT size.
+     @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
+                    specify the log2 FFT size e.g., 8 = pow(2,8) = 256). 
+     @param engine  The underlying FFT library to use, one of the PLANKFFT_ENGINE_ identifiers. 
+                    The default uses Plank's global default (see pl_FFT_SetDefaultEngine()). */
+    FFTEngineBase (const long length = 0, const int engine = PLANKFFT_ENGINE_DEFAULT) throw()
+    :   Base (new Internal (length, engine))
+    {
+    }
+    
+    /** Copy constructor.
+	 Note that a deep copy is not made, the copy will refer to exactly the same data. */
+    FFTEngineBase (FFTEngineBase const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    FFTEngineBase& operator= (FFTEngineBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Apply the FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void forward (double* output, const double* input) throw()
+    {
+        this->getInternal()->forward (output, input);
+    }
+    
+    /** Apply the FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void forward (Buffer& output, Buffer const& input) throw()
+    {
+        plonk_assert (output.length() >= this->length());
+        plonk_assert (input.length() >= this->length());
+        this->getInternal()->forward (output.getArray(), input.getArray());
+    }    
+    
+    /** Apply the inverse-FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void inverse (double* output, const double* input) throw()
+    {
+        this->getInternal()->inverse (output, input);
+    }
+    
+    /** Apply the inverse-FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void inverse (Buffer& output, Buffer const& input) throw()
+    {
+        plonk_assert (output.length() >= this->length());
+        plonk_assert (input.length() >= this->length());
+        this->getInternal()->inverse (output.getArray(), input.getArray());
+    }        
+    
+    /** Get the FFT size. */
+    PLONK_INLINE_MID long length() const
+    {
+        return this->getInternal()->length();
+    }
+    
+    /** Get half FFT size. 
+     This is just as a convenience as it is already cached for efficiency. */
+    PLONK_INLINE_MID long halfLength() const
+    {
+        return this->getInternal()->halfLength();
+    }
+
+    /** Get log2 of the FFT size. */
+    PLONK_INLINE_MID long lengthLog2() const
+    {
+        return this->getInternal()->lengthLog2();
+    }
+    
+    /** Apply the FFT to a number of consecutive frames of length() samples.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void forwardBatch (double* output, const double* input, const int numTransforms) throw()
+    {
+        this->getInternal()->forwardBatch (output, input, numTransforms);
+    }
+    
+    /** Apply the inverse-FFT to a number of consecutive frames of length() samples.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_MID void inverseBatch (double* output, const double* input, const int numTransforms) throw()
+    {
+        this->getInternal()->inverseBatch (output, input, numTransforms);
+    }
+    
+    /** Get the name of the underlying FFT library in use (e.g., "PFFFT" or "FFTReal"). */
+    PLONK_INLINE_MID const char* getEngineName() const
+    {
+        return this->getInternal()->getEngineName();
+    }
 
 private:
 };
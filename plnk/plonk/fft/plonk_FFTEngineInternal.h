@@ -52,10 +52,10 @@ class FFTEngineInternal<float> : public SmartPointer
 public:
     typedef NumericalArray<float>  Buffer;
 
-    FFTEngineInternal (const long length) throw()
+    FFTEngineInternal (const long length, const int engine) throw()
     :   fft (pl_FFTF_Create())
     {
-        pl_FFTF_InitWithLength (this->fft, length);
+        pl_FFTF_InitWithLengthAndEngine (this->fft, length, engine);
     }
     
     ~FFTEngineInternal()
@@ -91,8 +91,91 @@ public:
         return pl_FFTF_LengthLog2 (this->fft);
     }
     
+    PLONK_INLINE_MID void forwardBatch (float* output, const float* input, const int numTransforms) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTF_ForwardBatch (this->fft, output, input, numTransforms);
+    }
+    
+    PLONK_INLINE_MID void inverseBatch (float* output, const float* input, const int numTransforms) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTF_InverseBatch (this->fft, output, input, numTransforms);
+    }
+    
+    PLONK_INLINE_MID const char* getEngineName() const
+    {
+        return pl_FFTF_GetInternalEngineName (this->fft);
+    }
+    
 private:
     PlankFFTFRef fft;
 };
 
+template<>
+class FFTEngineInternal<double> : public SmartPointer
+{
+public:
+    typedef NumericalArray<double>  Buffer;
+    
+    FFTEngineInternal (const long length, const int engine) throw()
+    :   fft (pl_FFTD_Create())
+    {
+        pl_FFTD_InitWithLengthAndEngine (this->fft, length, engine);
+    }
+    
+    ~FFTEngineInternal()
+    {
+        pl_FFTD_Destroy (this->fft);
+        this->fft = 0;
+    }
+    
+    PLONK_INLINE_MID void forward (double* output, const double* input) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTD_Forward (this->fft, output, input);
+    }
+    
+    PLONK_INLINE_MID void inverse (double* output, const double* input) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTD_Inverse (this->fft, output, input);
+    }
+    
+    PLONK_INLINE_MID long length() const
+    {
+        return pl_FFTD_Length (this->fft);
+    }
+    
+    PLONK_INLINE_MID long halfLength() const
+    {
+        return pl_FFTD_HalfLength (this->fft);
+    }
+    
+    PLONK_INLINE_MID long lengthLog2() const
+    {
+        return pl_FFTD_LengthLog2 (this->fft);
+    }
+    
+    PLONK_INLINE_MID void forwardBatch (double* output, const double* input, const int numTransforms) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTD_ForwardBatch (this->fft, output, input, numTransforms);
+    }
+    
+    PLONK_INLINE_MID void inverseBatch (double* output, const double* input, const int numTransforms) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTD_InverseBatch (this->fft, output, input, numTransforms);
+    }
+    
+    PLONK_INLINE_MID const char* getEngineName() const
+    {
+        return pl_FFTD_GetInternalEngineName (this->fft);
+    }
+    
+private:
+    PlankFFTDRef fft;
+};
+
 #endif // PLONK_FFTENGINEINTERNAL_H
@@ -0,0 +1,432 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_STFTENGINE_H
+#define PLONK_STFTENGINE_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "../containers/plonk_ContainerForwardDeclarations.h"
+#include "../containers/plonk_DynamicContainer.h"
+
+#include "../core/plonk_SmartPointer.h"
+#include "../core/plonk_WeakPointer.h"
+#include "../containers/plonk_ObjectArray.h"
+#include "../containers/plonk_SimpleArray.h"
+
+
+template<class SampleType>
+class STFTEngineInternal : public SmartPointer
+{
+public:
+    typedef STFTEngineBase<SampleType>      Container;
+    typedef NumericalArray<SampleType>      Buffer;
+    typedef NumericalArray<SampleType*>     BufferArray;
+    typedef FFTEngineBase<SampleType>       FFTEngineType;
+    
+    typedef void (*SpectralFunction) (SampleType* const* real, SampleType* const* imag,
+                                      const int numChannels, const int numBins,
+                                      void* userData);
+    
+    STFTEngineInternal (const int fftSize, const int hopSize, const int numChannelsToUse, const int engine) throw()
+    :   fft (fftSize, engine),
+        hop (hopSize),
+        numChannels (0),
+        writePos (0),
+        hopCount (0),
+        function (0),
+        userData (0)
+    {
+        const int N = (int) fft.length();
+        
+        plonk_assert (hop > 0 && hop <= N);
+
+        Buffer hann (Buffer::withSize (N));
+        
+        for (int i = 0; i < N; ++i)
+            hann.put (i, SampleType (0.5 - 0.5 * plonk::cos (Math<double>::get2Pi() * i / N)));
+        
+        setWindow (hann);
+        setNumChannels (numChannelsToUse);
+    }
+    
+    void setNumChannels (const int newNumChannels) throw()
+    {
+        plonk_assert (newNumChannels >= 0);
+        
+        if (newNumChannels == numChannels)
+            return;
+        
+        const int N = (int) fft.length();
+        const int halfN = (int) fft.halfLength();
+        
+        numChannels = newNumChannels;
+        inputRing   = Buffer::newClear (numChannels * N);
+        outputRing  = Buffer::newClear (numChannels * N);
+        frames      = Buffer::newClear (numChannels * N);
+        spectra     = Buffer::newClear (numChannels * N);
+        realArrays  = BufferArray::withSize (numChannels);
+        imagArrays  = BufferArray::withSize (numChannels);
+        
+        // the packed FFT layout is already split: real parts then imaginary parts
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            realArrays.put (channel, spectra.getArray() + channel * N);
+            imagArrays.put (channel, spectra.getArray() + channel * N + halfN);
+        }
+        
+        writePos = 0;
+        hopCount = 0;
+    }
+    
+    /* The synthesis window is the analysis window divided by the sum of the
+     squared analysis window over all the frames that overlap each sample. 
+     This makes the overlap-add reconstruct the input exactly for any window
+     whose overlapped squares never sum to zero. */
+    void setWindow (Buffer const& newWindow) throw()
+    {
+        const int N = (int) fft.length();
+        
+        plonk_assert (newWindow.length() == N);
+        
+        analysisWindow  = Buffer::withSize (N);
+        synthesisWindow = Buffer::withSize (N);
+        
+        for (int i = 0; i < N; ++i)
+        {
+            const double w = double (newWindow.atUnchecked (i));
+            double sum = 0.0;
+            
+            for (int j = i % hop; j < N; j += hop)
+                sum += double (newWindow.atUnchecked (j)) * double (newWindow.atUnchecked (j));
+            
+            analysisWindow.put (i, SampleType (w));
+            synthesisWindow.put (i, sum > 1.0e-9 ? SampleType (w / sum) : SampleType (0));
+        }
+    }
+    
+    void reset() throw()
+    {
+        inputRing.zero();
+        outputRing.zero();
+        writePos = 0;
+        hopCount = 0;
+    }
+    
+    void process (SampleType* const* outputs, const SampleType* const* inputs, const int numFrames) throw()
+    {
+        const int N = (int) fft.length();
+        int offset = 0;
+        
+        while (offset < numFrames)
+        {
+            const int numThisTime = plonk::min (plonk::min (numFrames - offset, hop - hopCount), N - writePos);
+            
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                SampleType* const inputRingSamples = inputRing.getArray() + channel * N + writePos;
+                SampleType* const outputRingSamples = outputRing.getArray() + channel * N + writePos;
+                
+                // input first so that inputs and outputs may be the same buffers
+                Buffer::copyData (inputRingSamples, inputs[channel] + offset, numThisTime);
+                Buffer::copyData (outputs[channel] + offset, outputRingSamples, numThisTime);
+                Buffer::zeroData (outputRingSamples, numThisTime);
+            }
+            
+            offset   += numThisTime;
+            hopCount += numThisTime;
+            writePos += numThisTime;
+            
+            if (writePos == N)
+                writePos = 0;
+            
+            if (hopCount == hop)
+            {
+                hopCount = 0;
+                processFrame();
+            }
+        }
+    }
+    
+    friend class STFTEngineBase<SampleType>;
+    
+private:
+    /* The oldest sample is at writePos in the rings so each frame is in two parts. */
+    void processFrame() throw()
+    {
+        const int N = (int) fft.length();
+        const int head = N - writePos;
+        const SampleType* const analysisSamples = analysisWindow.getArray();
+        const SampleType* const synthesisSamples = synthesisWindow.getArray();
+        int channel;
+        
+        for (channel = 0; channel < numChannels; ++channel)
+        {
+            SampleType* const frameSamples = frames.getArray() + channel * N;
+            const SampleType* const inputRingSamples = inputRing.getArray() + channel * N;
+            
+            mul (frameSamples, inputRingSamples + writePos, analysisSamples, head);
+            mul (frameSamples + head, inputRingSamples, analysisSamples + head, writePos);
+        }
+        
+        fft.forwardBatch (spectra.getArray(), frames.getArray(), numChannels);
+        
+        if (function != 0)
+            function (realArrays.getArray(), imagArrays.getArray(), numChannels, (int) fft.halfLength(), userData);
+        
+        fft.inverseBatch (frames.getArray(), spectra.getArray(), numChannels);
+        
+        // overlap-add straight into the output ring
+        for (channel = 0; channel < numChannels; ++channel)
+        {
+            const SampleType* const frameSamples = frames.getArray() + channel * N;
+            SampleType* const outputRingSamples = outputRing.getArray() + channel * N;
+            
+            mulAdd (outputRingSamples + writePos, frameSamples, synthesisSamples, head);
+            mulAdd (outputRingSamples, frameSamples + head, synthesisSamples + head, writePos);
+        }
+    }
+    
+    static PLONK_INLINE_LOW void mul (float* result, const float* a, const float* b, const int N) throw()
+    {
+        pl_VectorMulF_NNN (result, a, b, N);
+    }
+    
+    static PLONK_INLINE_LOW void mul (double* result, const double* a, const double* b, const int N) throw()
+    {
+        pl_VectorMulD_NNN (result, a, b, N);
+    }
+    
+    static PLONK_INLINE_LOW void mulAdd (float* result, const float* a, const float* b, const int N) throw()
+    {
+        pl_VectorMulAddF_NNNN (result, a, b, result, N);
+    }
+    
+    static PLONK_INLINE_LOW void mulAdd (double* result, const double* a, const double* b, const int N) throw()
+    {
+        pl_VectorMulAddD_NNNN (result, a, b, result, N);
+    }
+    
+    FFTEngineType fft;
+    int hop;
+    int numChannels;
+    int writePos;
+    int hopCount;
+    Buffer analysisWindow;
+    Buffer synthesisWindow;
+    Buffer inputRing;
+    Buffer outputRing;
+    Buffer frames;
+    Buffer spectra;
+    BufferArray realArrays;
+    BufferArray imagArrays;
+    SpectralFunction function;
+    void* userData;
+};
+
+//------------------------------------------------------------------------------
+
+/** A multichannel short-time Fourier transform analysis and resynthesis engine.
+ This does the job of an OverlapMake, FFT, IFFT and OverlapMix chain for all 
+ channels at once. Input is buffered until a hop is complete, then each channel's
+ latest frame is windowed and all channels are transformed with one batched FFT. 
+ The spectral function (if any) can then modify the spectra in-place before one 
+ batched inverse FFT, the result of which is windowed and overlap-added directly
+ into the output.
+ 
+ The spectral function receives arrays of real and imaginary pointers, one of
+ each per channel, each pointing to numBins values (half the FFT size). These
+ are in the same packed format as the FFT unit so the first imaginary value
+ holds the real part of the Nyquist bin (the DC and Nyquist bins have no 
+ imaginary part).
+ 
+ The output is delayed by the FFT size. With no spectral function the output
+ is exactly the delayed input for any window and hop where the overlapped
+ windows don't sum to zero (e.g., the default Hann window with a hop of half 
+ the FFT size or less). Only float and double are supported.
+ @see STFTUnit
+ @ingroup PlonkOtherUserClasses */
+template<class SampleType>
+class STFTEngineBase : public SmartPointerContainer< STFTEngineInternal<SampleType> >
+{
+public:
+    typedef STFTEngineInternal<SampleType>          Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    typedef WeakPointerContainer<STFTEngineBase>    Weak;
+    
+    typedef NumericalArray<SampleType>              Buffer;
+    typedef FFTEngineBase<SampleType>               FFTEngineType;
+    typedef typename Internal::SpectralFunction     SpectralFunction;
+    
+    /** Create a new engine.
+     @param fftSize     The FFT size, this must be a power of 2.
+     @param hopSize     The number of samples between frames, 
+                        must be between 1 and the FFT size.
+     @param numChannels The number of channels to process.
+     @param engine      The underlying FFT library to use, one of the PLANKFFT_ENGINE_ identifiers. */
+    STFTEngineBase (const int fftSize = 1024, 
+                    const int hopSize = 256, 
+                    const int numChannels = 1,
+                    const int engine = PLANKFFT_ENGINE_DEFAULT) throw()
+    :   Base (new Internal (fftSize, hopSize, numChannels, engine))
+    {
+    }
+    
+    explicit STFTEngineBase (Internal* internalToUse) throw()
+	:	Base (internalToUse)
+	{
+	} 
+    
+    STFTEngineBase (STFTEngineBase const& copy) throw()
+	:	Base (static_cast<Base const&> (copy))
+	{
+	}    
+    
+    STFTEngineBase (Dynamic const& other) throw()
+    :   Base (other.as<STFTEngineBase>().getInternal())
+    {
+    }    
+    
+    /** Assignment operator. */
+    STFTEngineBase& operator= (STFTEngineBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */    
+    static STFTEngineBase fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }    
+    
+    static const STFTEngineBase& getNull() throw()
+	{
+		static STFTEngineBase null;
+		return null;
+	}	                            
+    
+    PLONK_OBJECTARROWOPERATOR(STFTEngineBase);
+    
+    /** Process a block of samples for all channels.
+     Each pointer in the arrays is the data for one channel. The outputs may be 
+     the same as the inputs. 
+     @param outputs     An array of getNumChannels() output pointers.
+     @param inputs      An array of getNumChannels() input pointers.
+     @param numFrames   The number of samples to process in each channel, this
+                        need not relate to the FFT or hop size. */
+    PLONK_INLINE_LOW void process (SampleType* const* outputs, const SampleType* const* inputs, const int numFrames) throw()
+    {
+        this->getInternal()->process (outputs, inputs, numFrames);
+    }
+    
+    /** Set the function called with the spectra of each frame. 
+     Pass 0 to just analyse and resynthesise the input. */
+    PLONK_INLINE_LOW void setSpectralFunction (SpectralFunction function, void* userData = 0) throw()
+    {
+        this->getInternal()->function = function;
+        this->getInternal()->userData = userData;
+    }
+    
+    /** Set the analysis window, this must be the same length as the FFT size.
+     The synthesis window is derived from this to give unity gain. */
+    PLONK_INLINE_LOW void setWindow (Buffer const& window) throw()
+    {
+        this->getInternal()->setWindow (window);
+    }
+    
+    /** Get the analysis window. */
+    PLONK_INLINE_LOW const Buffer& getWindow() const throw()
+    {
+        return this->getInternal()->analysisWindow;
+    }
+    
+    /** Set the number of channels, this clears the internal buffers if it changes. */
+    PLONK_INLINE_LOW void setNumChannels (const int numChannels) throw()
+    {
+        this->getInternal()->setNumChannels (numChannels);
+    }
+    
+    /** Get the number of channels. */
+    PLONK_INLINE_LOW int getNumChannels() const throw()
+    {
+        return this->getInternal()->numChannels;
+    }
+    
+    /** Clear the internal buffers. */
+    PLONK_INLINE_LOW void reset() throw()
+    {
+        this->getInternal()->reset();
+    }
+    
+    /** Get the FFT size. */
+    PLONK_INLINE_LOW int length() const throw()
+    {
+        return (int) this->getInternal()->fft.length();
+    }
+    
+    /** Get the hop size. */
+    PLONK_INLINE_LOW int getHop() const throw()
+    {
+        return this->getInternal()->hop;
+    }
+    
+    /** Get the number of bins passed to the spectral function (half the FFT size). */
+    PLONK_INLINE_LOW int getNumBins() const throw()
+    {
+        return (int) this->getInternal()->fft.halfLength();
+    }
+    
+    /** Get the delay from input to output in samples. */
+    PLONK_INLINE_LOW int getLatency() const throw()
+    {
+        return (int) this->getInternal()->fft.length();
+    }
+    
+    /** Get the FFTEngine used by this engine. */
+    const FFTEngineType& getFFTEngine() const throw()
+    {
+        return this->getInternal()->fft;
+    }
+};
+
+
+#endif // PLONK_STFTENGINE_H
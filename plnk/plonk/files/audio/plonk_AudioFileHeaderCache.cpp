@@ -0,0 +1,367 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+AudioFileHeader::AudioFileHeader() throw()
+:   fileSize (0),
+    modificationTime (0),
+    format (AudioFile::FormatInvalid),
+    encoding (AudioFile::EncodingInvalid),
+    bitsPerSample (0),
+    bytesPerFrame (0),
+    numChannels (0),
+    sampleRate (0.0),
+    numFrames (0),
+    valid (false)
+{
+}
+
+AudioFileHeader::AudioFileHeader (Text const& pathToUse, const LongLong fileSizeToUse, const LongLong modificationTimeToUse, AudioFileReader const& reader) throw()
+:   path (pathToUse),
+    fileSize (fileSizeToUse),
+    modificationTime (modificationTimeToUse),
+    format (reader.getFormat()),
+    encoding (reader.getEncoding()),
+    bitsPerSample (reader.getBitsPerSample()),
+    bytesPerFrame (reader.getBytesPerFrame()),
+    numChannels (reader.getNumChannels()),
+    sampleRate (reader.getSampleRate()),
+    numFrames (reader.getNumFrames()),
+    valid (reader.isReady())
+{
+}
+
+//------------------------------------------------------------------------------
+
+static PLONK_INLINE_LOW int audioFileHeaderCacheHash (const char* path, const int mask) throw()
+{
+    UnsignedInt hash = 2166136261U;
+    
+    while (*path != '\0')
+        hash = (hash ^ UnsignedChar (*path++)) * 16777619U;
+    
+    return int (hash & UnsignedInt (mask));
+}
+
+class AudioFileHeaderScanBatchInternal : public TaskBatchInternal
+{
+public:
+    AudioFileHeaderScanBatchInternal (AudioFileHeaderArray const& headersToFill, IntArray const& missesToOpen) throw()
+    :   headers (headersToFill),
+        misses (missesToOpen),
+        offset (0)
+    {
+    }
+    
+    void setOffset (const int newOffset) throw()   { offset = newOffset; }
+    
+    void runItem (const int index) throw()
+    {
+        AudioFileHeader& header = headers.atUnchecked (misses.atUnchecked (offset + index));
+        AudioFileReader reader (header.path.getArray(), 0, UnsignedInt (AudioFile::MetaDataIOFlagsNone));
+        
+        if (reader.isReady())
+            header = AudioFileHeader (header.path, header.fileSize, header.modificationTime, reader);
+    }
+    
+private:
+    AudioFileHeaderArray headers;
+    IntArray misses;
+    int offset;
+};
+
+//------------------------------------------------------------------------------
+
+AudioFileHeaderCache::AudioFileHeaderCache() throw()
+{
+}
+
+ResultCode AudioFileHeaderCache::load (FilePath const& path) throw()
+{
+    JSON json = JSON (BinaryFile (path.fullpath()));
+    
+    if (json.isError() || !json.isObject())
+        return PlankResult_JSONError;
+    
+    if (json["version"].getInt() != Version)
+        return PlankResult_JSONError;
+    
+    JSON files = json["files"];
+    
+    if (!files.isArray())
+        return PlankResult_JSONError;
+    
+    const AutoLock l (lock);
+    
+    headers.clear();
+    slots = IntArray();
+    
+    const Long numFiles = files.length();
+    
+    for (Long i = 0; i < numFiles; ++i)
+    {
+        JSON item = files[i];
+        
+        if (!item.isObject() || !item["path"].isString())
+            continue;
+        
+        AudioFileHeader header;
+        header.path             = item["path"].getText();
+        header.fileSize         = item["size"].getInt();
+        header.modificationTime = item["modified"].getInt();
+        header.format           = AudioFile::Format (item["format"].getInt());
+        header.encoding         = AudioFile::Encoding (item["encoding"].getInt());
+        header.bitsPerSample    = int (item["bitsPerSample"].getInt());
+        header.bytesPerFrame    = int (item["bytesPerFrame"].getInt());
+        header.numChannels      = int (item["numChannels"].getInt());
+        header.sampleRate       = item["sampleRate"].getDouble();
+        header.numFrames        = item["numFrames"].getInt();
+        header.valid            = true; // only valid headers are saved
+        
+        storeUnlocked (header);
+    }
+    
+    return PlankResult_OK;
+}
+
+ResultCode AudioFileHeaderCache::save (FilePath const& path) throw()
+{
+    JSON json = JSON::object();
+    JSON files = JSON::array();
+    
+    json.add ("version", JSON (int (Version)));
+    
+    {
+        const AutoLock l (lock);
+        const int numHeaders = headers.length();
+        
+        for (int i = 0; i < numHeaders; ++i)
+        {
+            AudioFileHeader const& header = headers.atUnchecked (i);
+            JSON item = JSON::object();
+            
+            item.add ("path", JSON (header.path));
+            item.add ("size", JSON (header.fileSize));
+            item.add ("modified", JSON (header.modificationTime));
+            item.add ("format", JSON (int (header.format)));
+            item.add ("encoding", JSON (int (header.encoding)));
+            item.add ("bitsPerSample", JSON (header.bitsPerSample));
+            item.add ("bytesPerFrame", JSON (header.bytesPerFrame));
+            item.add ("numChannels", JSON (header.numChannels));
+            item.add ("sampleRate", JSON (header.sampleRate));
+            item.add ("numFrames", JSON (header.numFrames));
+            
+            files.add (item);
+        }
+    }
+    
+    json.add ("files", files);
+    
+    return json.toFile (BinaryFile (path.fullpath(), true, true));
+}
+
+bool AudioFileHeaderCache::find (Text const& path, AudioFileHeader& header) throw()
+{
+    LongLong fileSize, modificationTime;
+    
+    if (pl_FileGetInfo (path.getArray(), &fileSize, &modificationTime) != PlankResult_OK)
+        return false;
+    
+    const AutoLock l (lock);
+    const int slot = findSlot (path);
+    
+    if ((slot < 0) || (slots.atUnchecked (slot) == 0))
+        return false;
+    
+    AudioFileHeader const& cached = headers.atUnchecked (slots.atUnchecked (slot) - 1);
+    
+    if ((cached.fileSize != fileSize) || (cached.modificationTime != modificationTime))
+        return false;
+    
+    header = cached;
+    return true;
+}
+
+void AudioFileHeaderCache::store (AudioFileHeader const& header) throw()
+{
+    const AutoLock l (lock);
+    storeUnlocked (header);
+}
+
+AudioFileHeaderArray AudioFileHeaderCache::scan (FilePathArray const& paths, TaskPool& pool) throw()
+{
+    const int numPaths = paths.length();
+    const int maximumBatchSize = 4096; // a batch has a limited number of items
+    AudioFileHeaderArray result = AudioFileHeaderArray::withSize (numPaths);
+    IntArray misses;
+    
+    {
+        const AutoLock l (lock);
+
+        for (int i = 0; i < numPaths; ++i)
+        {
+            AudioFileHeader& header = result.atUnchecked (i);
+            header.path = paths.atUnchecked (i).fullpath();
+            
+            if (pl_FileGetInfo (header.path.getArray(), &header.fileSize, &header.modificationTime) != PlankResult_OK)
+                continue;
+            
+            const int slot = findSlot (header.path);
+            
+            if ((slot >= 0) && (slots.atUnchecked (slot) != 0))
+            {
+                AudioFileHeader const& cached = headers.atUnchecked (slots.atUnchecked (slot) - 1);
+                
+                if ((cached.fileSize == header.fileSize) && (cached.modificationTime == header.modificationTime))
+                {
+                    header = cached;
+                    continue;
+                }
+            }
+            
+            misses.add (i);
+        }
+    }
+    
+    const int numMisses = misses.length();
+    
+    if (numMisses > 0)
+    {
+        SmartPointerContainer<AudioFileHeaderScanBatchInternal> batch (new AudioFileHeaderScanBatchInternal (result, misses));
+        
+        for (int start = 0; start < numMisses; start += maximumBatchSize)
+        {
+            batch->setOffset (start);
+            batch->run (pool, plonk::min (maximumBatchSize, numMisses - start));
+        }
+        
+        const AutoLock l (lock);
+        
+        for (int i = 0; i < numMisses; ++i)
+        {
+            AudioFileHeader const& header = result.atUnchecked (misses.atUnchecked (i));
+            
+            if (header.isValid())
+                storeUnlocked (header);
+        }
+    }
+    
+    return result;
+}
+
+int AudioFileHeaderCache::length() throw()
+{
+    const AutoLock l (lock);
+    return headers.length();
+}
+
+void AudioFileHeaderCache::clear() throw()
+{
+    const AutoLock l (lock);
+    headers.clear();
+    slots = IntArray();
+}
+
+int AudioFileHeaderCache::findSlot (Text const& path) const throw()
+{
+    const int capacity = slots.length();
+    
+    if (capacity == 0)
+        return -1;
+    
+    const int* const slotArray = slots.getArray();
+    const int mask = capacity - 1;
+    int index = audioFileHeaderCacheHash (path.getArray(), mask);
+    
+    while (slotArray[index] != 0)
+    {
+        if (strcmp (headers.atUnchecked (slotArray[index] - 1).path.getArray(), path.getArray()) == 0)
+            break;
+        
+        index = (index + 1) & mask;
+    }
+    
+    return index;
+}
+
+void AudioFileHeaderCache::storeUnlocked (AudioFileHeader const& header) throw()
+{
+    if ((headers.length() * 2) >= slots.length())
+        growSlots();
+    
+    const int slot = findSlot (header.path);
+    int& entry = slots.atUnchecked (slot);
+    
+    if (entry != 0)
+    {
+        headers.atUnchecked (entry - 1) = header;
+    }
+    else
+    {
+        headers.add (header);
+        entry = headers.length();
+    }
+}
+
+void AudioFileHeaderCache::growSlots() throw()
+{
+    const int minimumSize = 256;
+    const int capacity = plonk::max (minimumSize, slots.length() * 2);
+    const int mask = capacity - 1;
+    const int numHeaders = headers.length();
+    
+    slots = IntArray::newClear (capacity);
+    int* const slotArray = slots.getArray();
+    
+    for (int i = 0; i < numHeaders; ++i)
+    {
+        int index = audioFileHeaderCacheHash (headers.atUnchecked (i).path.getArray(), mask);
+        
+        while (slotArray[index] != 0)
+            index = (index + 1) & mask;
+        
+        slotArray[index] = i + 1;
+    }
+}
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,130 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_AUDIOFILEHEADERCACHE_H
+#define PLONK_AUDIOFILEHEADERCACHE_H
+
+#include "../../core/plonk_CoreForwardDeclarations.h"
+#include "../plonk_FilesForwardDeclarations.h"
+#include "plonk_AudioFileReader.h"
+
+/** The format details of an audio file. 
+ The file's size and modification time are stored so that a cached header can
+ be checked against the file on disk. */
+struct AudioFileHeader
+{
+    AudioFileHeader() throw();
+    
+    /** Fills in the header from a reader that opened successfully. */
+    AudioFileHeader (Text const& path, const LongLong fileSize, const LongLong modificationTime, AudioFileReader const& reader) throw();
+    
+    /** Whether the file opened, headers loaded from a cache file are always valid. */
+    PLONK_INLINE_LOW bool isValid() const throw() { return valid; }
+
+    Text path;
+    LongLong fileSize;
+    LongLong modificationTime; // nanoseconds since 1970
+    AudioFile::Format format;
+    AudioFile::Encoding encoding;
+    int bitsPerSample;
+    int bytesPerFrame;
+    int numChannels;
+    double sampleRate;
+    LongLong numFrames;
+    bool valid;
+};
+
+typedef ObjectArray<AudioFileHeader> AudioFileHeaderArray;
+
+/** Caches the headers of audio files.
+ This is for browsing large sample libraries where only the format and length 
+ of each file is needed. scan() returns headers from the cache where the file's 
+ size and modification time are unchanged, the remaining files are opened in 
+ parallel on a TaskPool. The cache can be saved to and loaded from a JSON file
+ so later sessions only need to open new or modified files.
+ 
+ All functions may be called from any thread except the audio thread. 
+ @see AudioFileReader::openMany() */
+class AudioFileHeaderCache
+{
+public:
+    AudioFileHeaderCache() throw();
+    
+    /** Replaces the contents of the cache with those from a JSON file. */
+    ResultCode load (FilePath const& path) throw();
+    
+    /** Writes the contents of the cache to a JSON file. */
+    ResultCode save (FilePath const& path) throw();
+    
+    /** Gets the header for a path if it is cached and the file hasn't changed. 
+     @return @c true if the header was found. */
+    bool find (Text const& path, AudioFileHeader& header) throw();
+    
+    /** Adds a header to the cache replacing any header with the same path. */
+    void store (AudioFileHeader const& header) throw();
+    
+    /** Gets headers for an array of files. 
+     The result has one header for each path, files that could not be opened
+     (or don't exist) have an invalid header. */
+    AudioFileHeaderArray scan (FilePathArray const& paths, TaskPool& pool = TaskPool::getIO()) throw();
+    
+    /** The number of headers in the cache. */
+    int length() throw();
+    
+    /** Removes all the headers. */
+    void clear() throw();
+    
+private:
+    enum Constants
+    {
+        Version = 2 // 2 stores the modification time in nanoseconds
+    };
+    
+    Lock lock;
+    AudioFileHeaderArray headers;
+    IntArray slots; // index + 1 into headers, 0 is empty
+    
+    int findSlot (Text const& path) const throw();
+    void storeUnlocked (AudioFileHeader const& header) throw();
+    void growSlots() throw();
+    
+    AudioFileHeaderCache (const AudioFileHeaderCache&);
+    const AudioFileHeaderCache& operator= (const AudioFileHeaderCache&);
+};
+
+#endif // PLONK_AUDIOFILEHEADERCACHE_H
@@ -65,12 +65,25 @@ AudioFileReaderInternal::AudioFileReaderInternal (const char* path, const int bu
     init (path, metaDataIOFlags);
 }
 
-ResultCode AudioFileReaderInternal::init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw()
+AudioFileReaderInternal::AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped) throw()
+:   readBuffer (Chars::withSize ((bufferSize > 0) ? bufferSize : AudioFile::DefaultBufferSize)),
+    numFramesPerBuffer (0),
+    newPositionOnNextRead (-1),
+    hitEndOfFile (false),
+    numChannelsChanged (false),
+    audioFileChanged (false),
+    defaultNumChannels (0)
+{
+    init (path, metaDataIOFlags, mapped);
+}
+
+ResultCode AudioFileReaderInternal::init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped) throw()
 {
     plonk_assert (path != 0);
     
     pl_AudioFileReader_Init (getPeerRef());
-    ResultCode result = pl_AudioFileReader_OpenInternal (getPeerRef(), path, metaDataIOFlags.getValue());
+    ResultCode result = mapped ? pl_AudioFileReader_OpenMapped (getPeerRef(), path, metaDataIOFlags.getValue()) :
+                                 pl_AudioFileReader_OpenInternal (getPeerRef(), path, metaDataIOFlags.getValue());
     
     const int bytesPerFrame = getBytesPerFrame();
     
@@ -437,6 +450,8 @@ AudioFile::Format AudioFileReaderInternal::getFormat() const throw()
         case AudioFile::FormatAIFC:         return AudioFile::FormatAIFC;
         case AudioFile::FormatOggVorbis:    return AudioFile::FormatOggVorbis;
         case AudioFile::FormatOpus:         return AudioFile::FormatOpus;
+        case AudioFile::FormatCAF:          return AudioFile::FormatCAF;
+        case AudioFile::FormatW64:          return AudioFile::FormatW64;
         case AudioFile::FormatRegion:       return AudioFile::FormatRegion;
         case AudioFile::FormatMulti:        return AudioFile::FormatMulti;
         case AudioFile::FormatArray:        return AudioFile::FormatArray;
@@ -639,6 +654,16 @@ void AudioFileReaderInternal::setFramePositionOnNextRead (const LongLong positio
     newPositionOnNextRead = position; // atomic!
 }
 
+const void* AudioFileReaderInternal::readFramesInPlace (const int numFrames, int& numFramesRead) throw()
+{
+    const void* frames = 0;
+    
+    if (pl_AudioFileReader_GetFramesPointer (getPeerRef(), numFrames, &frames, &numFramesRead) != PlankResult_OK)
+        return 0;
+    
+    return frames;
+}
+
 void AudioFileReaderInternal::setOwner (void* o) throw()
 {
     plonk_assert ((o == 0) || (owner == 0));
@@ -687,6 +712,11 @@ AudioFileMetaData AudioFileReaderInternal::getMetaData() const throw()
     return AudioFileMetaData (pl_AudioFileReader_GetMetaData (getPeerRef()));
 }
 
+ResultCode AudioFileReaderInternal::writeSeekTable (const char* path) const throw()
+{
+    return pl_AudioFileReader_WriteSeekTable (getPeerRef(), path);
+}
+
 //AudioFileReaderArray AudioFileReader::regionsFromMetaData (const int metaDataOption, const int bufferSize) throw()
 //{
 //    AudioFileReaderArray regionReaderArray;
@@ -787,4 +817,56 @@ AudioFileReaderArray AudioFileReader::regionsFromMetaData (const int metaDataOpt
     return regionReaderArray;
 }
 
+//------------------------------------------------------------------------------
+
+class AudioFileOpenBatchInternal : public TaskBatchInternal
+{
+public:
+    AudioFileOpenBatchInternal (FilePathArray const& pathsToOpen, 
+                                AudioFileReaderArray const& readersToFill,
+                                const int bufferSizeToUse,
+                                AudioFileMetaDataIOFlags const& metaDataIOFlagsToUse) throw()
+    :   paths (pathsToOpen),
+        readers (readersToFill),
+        bufferSize (bufferSizeToUse),
+        metaDataIOFlags (metaDataIOFlagsToUse),
+        offset (0)
+    {
+    }
+    
+    void setOffset (const int newOffset) throw()   { offset = newOffset; }
+    
+    void runItem (const int index) throw()
+    {
+        const int i = offset + index;
+        readers.atUnchecked (i) = AudioFileReader (paths.atUnchecked (i), bufferSize, metaDataIOFlags);
+    }
+    
+private:
+    FilePathArray paths;
+    AudioFileReaderArray readers;
+    const int bufferSize;
+    const AudioFileMetaDataIOFlags metaDataIOFlags;
+    int offset;
+};
+
+AudioFileReaderArray AudioFileReader::openMany (FilePathArray const& paths, 
+                                                const int bufferSize, 
+                                                AudioFileMetaDataIOFlags const& metaDataIOFlags, 
+                                                TaskPool& pool) throw()
+{
+    const int numPaths = paths.length();
+    const int maximumBatchSize = 4096; // a batch has a limited number of items
+    AudioFileReaderArray readers = AudioFileReaderArray::withSize (numPaths);
+    SmartPointerContainer<AudioFileOpenBatchInternal> batch (new AudioFileOpenBatchInternal (paths, readers, bufferSize, metaDataIOFlags));
+    
+    for (int start = 0; start < numPaths; start += maximumBatchSize)
+    {
+        batch->setOffset (start);
+        batch->run (pool, plonk::min (maximumBatchSize, numPaths - start));
+    }
+    
+    return readers;
+}
+
 END_PLONK_NAMESPACE
@@ -57,6 +57,7 @@ public:
 
     AudioFileReaderInternal() throw();
     AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
+    AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped) throw();
     AudioFileReaderInternal (ByteArray const& bytes, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
     AudioFileReaderInternal (FilePathArray const& paths, const AudioFile::MultiFileTypes multiMode, const int bufferSize) throw();
     AudioFileReaderInternal (FilePathArray const& paths, IntVariable const& indexRef, const int bufferSize) throw();
@@ -95,6 +96,8 @@ public:
     void resetFramePosition() throw();
     void setFramePositionOnNextRead (const LongLong position) throw();
     
+    const void* readFramesInPlace (const int numFrames, int& numFramesRead) throw();
+    
     template<class SampleType>
     void readFrames (NumericalArray<SampleType>& data, const bool applyScaling, const bool deinterleave, IntVariable& numLoops) throw();
     
@@ -133,6 +136,8 @@ public:
     
     bool hasMetaData() const throw();
     AudioFileMetaData getMetaData() const throw();
+    
+    ResultCode writeSeekTable (const char* path) const throw();
 //    int getNumCuePoints() const throw();
 //    bool getCuePointAtIndex (const int index, UnsignedInt& cueID, Text& label, LongLong& position) const throw();
     
@@ -140,7 +145,7 @@ public:
     PLONK_INLINE_LOW const PlankAudioFileReaderRef getPeerRef() const { return const_cast<const PlankAudioFileReaderRef> (&peer); }
 
 private:
-    ResultCode init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
+    ResultCode init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped = false) throw();
     ResultCode init (ByteArray const& bytes, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
 
     template<class Type>
@@ -205,6 +210,7 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
     int dataIndex = 0;
     const int numFailsAllowed = 3;
     int numFails = 0;
+    bool inPlace = true; // until we find the file doesn't support it
     
     if (! numFramesPerBuffer)
     {
@@ -235,7 +241,19 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             break; // not enough data left for one frame
 
         int framesRead;
-        result = pl_AudioFileReader_ReadFrames (getPeerRef(), PLANK_FALSE, framesToRead, readBufferArray, &framesRead);
+        const void* frames = 0;
+        
+        if (inPlace)
+        {
+            result = pl_AudioFileReader_GetFramesPointer (getPeerRef(), framesToRead, &frames, &framesRead);
+            inPlace = (result != PlankResult_AudioFileUnsupportedType);
+        }
+        
+        if (! inPlace)
+            result = pl_AudioFileReader_ReadFrames (getPeerRef(), PLANK_FALSE, framesToRead, readBufferArray, &framesRead);
+        
+        // frames in place are always native endian so the swaps below won't write to them
+        void* const sourceArray = inPlace ? const_cast<void*> (frames) : readBufferArray;
         plonk_assert ((result == PlankResult_OK) ||
                       (result == PlankResult_FileEOF) ||
                       (result == PlankResult_AudioFileFrameFormatChanged) ||
@@ -250,25 +268,25 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             {            
                 if (bytesPerSample == 2)
                 {
-                    Short* const convertBuffer = static_cast<Short*> (readBufferArray); 
+                    Short* const convertBuffer = static_cast<Short*> (sourceArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 3)
                 {
-                    Int24* const convertBuffer = static_cast<Int24*> (readBufferArray); 
+                    Int24* const convertBuffer = static_cast<Int24*> (sourceArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 4)
                 {
-                    Int* const convertBuffer = static_cast<Int*> (readBufferArray); 
+                    Int* const convertBuffer = static_cast<Int*> (sourceArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 1)
                 {
-                    Char* const convertBuffer = static_cast<Char*> (readBufferArray); 
+                    Char* const convertBuffer = static_cast<Char*> (sourceArray); 
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else
@@ -281,13 +299,13 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             {
                 if (bytesPerSample == 4)
                 {
-                    Float* const convertBuffer = static_cast<Float*> (readBufferArray); 
+                    Float* const convertBuffer = static_cast<Float*> (sourceArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 8)
                 {
-                    Double* const convertBuffer = static_cast<Double*> (readBufferArray); 
+                    Double* const convertBuffer = static_cast<Double*> (sourceArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
@@ -559,6 +577,27 @@ public:
         return weak.fromWeak();
     }    
     
+    /** Creates an audio file reader that maps the file into memory.
+     This is for WAV, AIFF, AIFC, W64 and CAF files, Ogg files are opened normally. 
+     All readers of the same path share the mapping so this suits large sample
+     sets that are opened many times. Reads skip the file buffer and frames can
+     be accessed without copying using readFramesInPlace().
+     @param path        The path of the file to read. */
+    static AudioFileReader mapped (FilePath const& path, AudioFileMetaDataIOFlags const& metaDataIOFlags = AudioFileMetaDataIOFlags ((UnsignedInt)AudioFile::MetaDataIOFlagsNone)) throw()
+    {
+        return AudioFileReader (new Internal (path.fullpath().getArray(), 0, metaDataIOFlags, true));
+    }
+    
+    /** Opens many audio files in parallel.
+     The headers and any requested metadata are read on the pool's threads (and
+     the calling thread), this returns once all the files have been opened. Use 
+     isReady() to check which files opened successfully. 
+     @see AudioFileHeaderCache */
+    static AudioFileReaderArray openMany (FilePathArray const& paths, 
+                                          const int bufferSize = 0, 
+                                          AudioFileMetaDataIOFlags const& metaDataIOFlags = AudioFileMetaDataIOFlags ((UnsignedInt)AudioFile::MetaDataIOFlagsNone),
+                                          TaskPool& pool = TaskPool::getIO()) throw();
+    
     /** Get the format of the audio file. 
      i.e., WAV, AIFF etc 
      See AudioFile::Format the available types. */
@@ -713,6 +752,20 @@ public:
         getInternal()->readFrames (data, true, false, numLoops);
     }
     
+    /** Get a pointer to frames in the file without copying or converting them.
+     This works for files opened with mapped() (or from a ByteArray) where the 
+     samples are native endian shorts, ints, floats or doubles, use getSampleType()
+     to determine which. The data must also start at an address aligned to the 
+     sample size, which isn't always the case (e.g., some float WAV files). The 
+     position moves past the frames returned. 
+     @param numFrames       The maximum number of frames wanted.
+     @param numFramesRead   On return the number of interleaved frames at the pointer.
+     @return The frames or null if this file can't be read in place, use readFrames() instead. */
+    PLONK_INLINE_LOW const void* readFramesInPlace (const int numFrames, int& numFramesRead) throw()
+    {
+        return getInternal()->readFramesInPlace (numFrames, numFramesRead);
+    }
+    
     /** Read frames into a pre-allocated NumericalArray without scaling. 
      @param data    The NumericalArray object to read interleaved frames into. 
      @param numLoops    How many loops to read, 0 means infinite loops. */
@@ -882,6 +935,13 @@ public:
         return this->getInternal()->getMetaData();
     }
     
+    /** Saves the seek table of an Ogg file next to the file it was opened from.
+     This avoids indexing the file's pages when it is next opened. */
+    ResultCode writeSeekTable (Text const& path) const throw()
+    {
+        return this->getInternal()->writeSeekTable (path.getArray());
+    }
+    
     PLONK_INLINE_LOW ChannelLayout getChannelLayout() const throw()
     {
         return this->getInternal()->getChannelLayout();
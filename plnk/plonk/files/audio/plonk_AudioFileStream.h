@@ -0,0 +1,587 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_AUDIOFILESTREAM_H
+#define PLONK_AUDIOFILESTREAM_H
+
+#include "../../core/plonk_CoreForwardDeclarations.h"
+#include "../plonk_FilesForwardDeclarations.h"
+#include "../../core/plonk_SmartPointer.h"
+#include "../../core/plonk_SmartPointerContainer.h"
+#include "plonk_AudioFileReader.h"
+
+template<class SampleType> class AudioFileStreamBase;
+
+/** Reads an AudioFile ahead into a ring of decoded frames on the TaskPool::getIO() pool.
+ 
+ There is a single consumer (normally the audio thread) and a single I/O job in 
+ flight at any one time so the ring and the marker queue are both single-producer
+ single-consumer. Loop wraps, seeks, file changes and the end of the file are 
+ passed to the consumer as markers tagged with the ring position where they 
+ occurred. As the I/O job reads across loop boundaries the frames after them are 
+ already in the ring by the time the consumer gets there. The loop count is 
+ decremented by the I/O job as it wraps so it runs ahead of what is heard by 
+ up to the read-ahead. */
+template<class SampleType>
+class AudioFileStreamInternal : public SmartPointer
+{
+public:
+    typedef AudioFileStreamBase<SampleType>     Container;
+    typedef NumericalArray<SampleType>          Buffer;
+    
+    enum Events
+    {
+        EventNone               = 0,
+        EventLooped             = 1,
+        EventSeeked             = 2,
+        EventEnded              = 4,
+        EventFileChanged        = 8,
+        EventNumChannelsChanged = 16
+    };
+    
+    enum Constants
+    {
+        DefaultReadAhead    = 16384,
+        MinimumReadAhead    = 256,
+        MaximumChunkFrames  = 4096,
+        NumMarkers          = 64
+    };
+    
+    AudioFileStreamInternal (AudioFileReader const& fileToUse,
+                             IntVariable const& loopCountToUse,
+                             const int readAheadFrames,
+                             const LongLong startPosition) throw()
+    :   SmartPointer (false),
+        file (fileToUse),
+        loopCount (loopCountToUse),
+        oneLoop (1),
+        numChannels (plonk::max (1, fileToUse.getNumChannels())),
+        capacity (Bits::nextPowerOf2 (plonk::max (readAheadFrames > 0 ? readAheadFrames : (int) DefaultReadAhead, (int) MinimumReadAhead))),
+        chunkFrames (plonk::min (capacity / 4, (int) MaximumChunkFrames)),
+        ring (Buffer::newClear (capacity * numChannels)),
+        readFrame (0),
+        writeFrame (0),
+        seekRequest (-1),
+        markerRead (0),
+        markerWrite (0),
+        ended (0),
+        numUnderruns (0),
+        filePosition (0),
+        endedSeen (false),
+        fileNumChannels (numChannels),
+        fileReportsPosition (readerReportsPosition (file)),
+        fillJob (new FillJob (this)),
+        fillJobContainer (fillJob)
+    {
+        if (startPosition > 0)
+        {
+            file.setFramePosition (startPosition);
+            filePosition = fileReportsPosition ? file.getFramePosition() : startPosition;
+        }
+        
+        fill(); // prime the ring on this thread so we start without an underrun
+    }
+    
+    ~AudioFileStreamInternal()
+    {
+    }
+    
+    PLONK_INLINE_LOW int getNumChannels() const throw()     { return numChannels; }
+    PLONK_INLINE_LOW int getFileNumChannels() const throw() { return fileNumChannels; }
+    PLONK_INLINE_LOW int getCapacity() const throw()        { return capacity; }
+    PLONK_INLINE_LOW int getNumUnderruns() const throw()    { return numUnderruns.getValueUnchecked(); }
+    PLONK_INLINE_LOW LongLong getFramePosition() const throw() { return filePosition; }
+    PLONK_INLINE_LOW bool hasEnded() const throw()          { return endedSeen; }
+    
+    /** Request a jump to a new frame position. 
+     This can be called from any thread, the reader is only repositioned on 
+     the I/O thread. The frames queued before the seek are discarded and
+     the consumer gets no frames until the new ones are ready. */
+    void seek (const LongLong position) throw()
+    {
+        seekRequest.setValue (plonk::max (position, LongLong (0)));
+        requestFill();
+    }
+    
+    /** Apply the markers at the read position and return the number of frames 
+     that can be read before the next one. 
+     @param events  Set to a combination of the Events that were applied. */
+    int beginRead (int& events) throw()
+    {
+        events = EventNone;
+        skipToLatestSeek (events);
+        
+        if (seekRequest.getValue() >= 0)
+        {
+            requestFill();
+            return 0; // don't play frames that a pending seek will discard
+        }
+        
+        const LongLong read = readFrame.getValueUnchecked();
+        LongLong end = writeFrame.getValue();
+        
+        while (markerRead.getValueUnchecked() != markerWrite.getValue())
+        {
+            const Marker& marker = markers[markerRead.getValueUnchecked() & (NumMarkers - 1)];
+            
+            if (marker.frame > read)
+            {
+                end = marker.frame;
+                break;
+            }
+            
+            applyMarker (marker, events);
+            ++markerRead;
+        }
+        
+        const int numFrames = endedSeen ? 0 : (int) plonk::min (end - read, LongLong (capacity));
+        
+        if ((numFrames == 0) && ! endedSeen)
+        {
+            ++numUnderruns;
+            requestFill();
+        }
+        
+        return numFrames;
+    }
+    
+    /** Copy one channel of frames from the read position. 
+     Channels beyond the number in the stream wrap around. */
+    void readChannel (SampleType* const output, const int channel, const int numFrames) const throw()
+    {
+        const SampleType* const ringSamples = ring.getArray();
+        const int channelIndex = (unsigned int) channel % (unsigned int) numChannels;
+        int position = (int) (readFrame.getValueUnchecked() & (capacity - 1));
+        
+        for (int i = 0; i < numFrames; ++i)
+        {
+            output[i] = ringSamples[position * numChannels + channelIndex];
+            position = (position + 1) & (capacity - 1);
+        }
+    }
+    
+    /** Release frames that have been read and queue a refill if there is room. */
+    void endRead (const int numFrames) throw()
+    {
+        readFrame.setValue (readFrame.getValueUnchecked() + numFrames);
+        filePosition += numFrames;
+        
+        if (needsFill())
+            requestFill();
+    }
+    
+    friend class AudioFileStreamBase<SampleType>;
+    
+private:
+    struct Marker
+    {
+        LongLong frame;
+        LongLong position;
+        int event;
+        int numChannels;
+    };
+    
+    /** Refills the ring on the I/O pool, one is made for each stream and rescheduled.
+     A request that arrives while it is running sets RunningAgain so it fills 
+     once more rather than the request being lost. Scheduling takes a reference
+     to the stream that is released once the job is idle again so the stream 
+     can't be deleted while it is queued or running. */
+    class FillJob : public TaskJobInternal
+    {
+    public:
+        enum States { Idle, Queued, Running, RunningAgain };
+        
+        FillJob (AudioFileStreamInternal* streamToUse) throw()
+        :   stream (streamToUse),
+            state (Idle)
+        {
+        }
+        
+        void run() throw()
+        {
+            state.setValue (Running);
+            
+            do
+            {
+                stream->fill();
+            } while (! state.compareAndSwap (Running, Idle) && state.compareAndSwap (RunningAgain, Running));
+            
+            stream->decrementRefCount(); // may delete the stream, the pool still holds this job
+        }
+        
+        AudioFileStreamInternal* const stream;
+        AtomicInt state;
+    };
+    
+    void requestFill() throw()
+    {
+        for (;;)
+        {
+            const int current = fillJob->state.getValue();
+            
+            if (current == FillJob::Idle)
+            {
+                if (fillJob->state.compareAndSwap (FillJob::Idle, FillJob::Queued))
+                {
+                    this->incrementRefCount();
+                    TaskPool::getIO().schedule (fillJobContainer);
+                    return;
+                }
+            }
+            else if (current == FillJob::Running)
+            {
+                if (fillJob->state.compareAndSwap (FillJob::Running, FillJob::RunningAgain))
+                    return;
+            }
+            else
+            {
+                return; // already pending
+            }
+        }
+    }
+    
+    bool needsFill() const throw()
+    {
+        if (! hasMarkerSpace())
+            return false;
+        
+        if (seekRequest.getValueUnchecked() >= 0)
+            return true;
+        
+        return (ended.getValueUnchecked() == 0) && (getSpace() >= chunkFrames);
+    }
+    
+    PLONK_INLINE_LOW LongLong getSpace() const throw()
+    {
+        return capacity - (writeFrame.getValueUnchecked() - readFrame.getValueUnchecked());
+    }
+    
+    PLONK_INLINE_LOW bool hasMarkerSpace() const throw()
+    {
+        // leave room for the two markers a single read can produce
+        return (markerWrite.getValueUnchecked() - markerRead.getValueUnchecked()) <= (NumMarkers - 2);
+    }
+    
+    //--------------------------------------------------------------------------
+    // I/O side, only called by the one FillJob running
+    
+    void fill() throw()
+    {
+        while (hasMarkerSpace())
+        {
+            const LongLong target = seekRequest.getValue();
+            
+            if ((target >= 0) && seekRequest.compareAndSwap (target, -1))
+            {
+                file.setFramePosition (target);
+                pushMarker (EventSeeked);
+                ended.setValue (0);
+                continue;
+            }
+            
+            if ((ended.getValueUnchecked() != 0) || (getSpace() < chunkFrames))
+                break;
+            
+            const int fileNumChannels = file.getNumChannels();
+            
+            readBuffer.setSize (chunkFrames * fileNumChannels, false);
+            file.readFrames (readBuffer, oneLoop);
+            
+            const int framesRead = readBuffer.length() / fileNumChannels;
+            writeFrames (readBuffer.getArray(), fileNumChannels, framesRead);
+            
+            if (file.didNumChannelsChange())
+                pushMarker (EventNumChannelsChanged);
+            else if (file.didAudioFileChange())
+                pushMarker (EventFileChanged);
+            
+            if (file.didHitEOF())
+            {
+                const int loops = loopCount.getValue();
+                
+                if ((loops == 0) || (loops > 1))
+                {
+                    file.resetFramePosition();
+                    pushMarker (EventLooped);
+                    
+                    if (loops > 1)
+                        loopCount.setValue (loops - 1);
+                }
+                else
+                {
+                    pushMarker (EventEnded);
+                    ended.setValue (1);
+                }
+            }
+            else if ((framesRead == 0) && ! (file.didNumChannelsChange() || file.didAudioFileChange()))
+            {
+                // a failed read, treat it as the end rather than spin
+                pushMarker (EventEnded);
+                ended.setValue (1);
+            }
+        }
+    }
+    
+    void writeFrames (const SampleType* source, const int sourceNumChannels, const int numFrames) throw()
+    {
+        const LongLong start = writeFrame.getValueUnchecked();
+        SampleType* const ringSamples = ring.getArray();
+        int done = 0;
+        
+        while (done < numFrames)
+        {
+            const int position = (int) ((start + done) & (capacity - 1));
+            const int framesThisTime = plonk::min (numFrames - done, capacity - position);
+            SampleType* const dst = ringSamples + position * numChannels;
+            
+            if (sourceNumChannels == numChannels)
+            {
+                Buffer::copyData (dst, source, framesThisTime * numChannels);
+            }
+            else
+            {
+                for (int frame = 0; frame < framesThisTime; ++frame)
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        dst[frame * numChannels + channel] = source[frame * sourceNumChannels + (channel % sourceNumChannels)];
+            }
+            
+            source += framesThisTime * sourceNumChannels;
+            done   += framesThisTime;
+        }
+        
+        writeFrame.setValue (start + numFrames); // publish the frames
+    }
+    
+    /** Multi, array and custom readers can be positioned but can't report a position. */
+    static bool readerReportsPosition (AudioFileReader& reader) throw()
+    {
+        PlankLL position;
+        return reader.isPositionable() &&
+               (pl_AudioFileReader_GetFramePosition (reader.getInternal()->getPeerRef(), &position) == PlankResult_OK);
+    }
+    
+    void pushMarker (const int event) throw()
+    {
+        const int write = markerWrite.getValueUnchecked();
+        Marker& marker = markers[write & (NumMarkers - 1)];
+        
+        marker.frame       = writeFrame.getValueUnchecked();
+        marker.position    = ((event != EventEnded) && fileReportsPosition) ? file.getFramePosition() : LongLong (-1);
+        marker.event       = event;
+        marker.numChannels = file.getNumChannels();
+        
+        markerWrite.setValue (write + 1); // publish the marker
+    }
+    
+    //--------------------------------------------------------------------------
+    // consumer side
+    
+    void applyMarker (Marker const& marker, int& events) throw()
+    {
+        if (marker.event == EventEnded)
+            endedSeen = true;
+        else if (marker.position >= 0)
+            filePosition = marker.position;
+        
+        if (marker.event == EventSeeked)
+            endedSeen = false;
+        
+        if (marker.event == EventNumChannelsChanged)
+            fileNumChannels = marker.numChannels;
+        
+        events |= marker.event;
+    }
+    
+    /** If a seek has been performed drop everything queued before it.
+     The stale frames are released straight away, even if nothing after the
+     seek has arrived yet, so a full ring has room for the I/O job to refill. */
+    void skipToLatestSeek (int& events) throw()
+    {
+        const int read = markerRead.getValueUnchecked();
+        const int write = markerWrite.getValue();
+        int latestSeek = -1;
+        
+        for (int i = read; i != write; ++i)
+            if (markers[i & (NumMarkers - 1)].event == EventSeeked)
+                latestSeek = i;
+        
+        if (latestSeek < 0)
+            return;
+        
+        const Marker& marker = markers[latestSeek & (NumMarkers - 1)];
+        
+        readFrame.setValue (marker.frame);
+        applyMarker (marker, events);
+        markerRead.setValue (latestSeek + 1);
+        
+        requestFill();
+    }
+    
+    AudioFileReader file;
+    IntVariable loopCount;
+    IntVariable oneLoop;
+    const int numChannels;
+    const int capacity;
+    const int chunkFrames;
+    Buffer ring;
+    Buffer readBuffer;
+    
+    AtomicLongLong readFrame;
+    AtomicLongLong writeFrame;
+    AtomicLongLong seekRequest;
+    
+    Marker markers[NumMarkers];
+    AtomicInt markerRead;
+    AtomicInt markerWrite;
+    AtomicInt ended;
+    AtomicInt numUnderruns;
+    
+    LongLong filePosition;
+    bool endedSeen;
+    int fileNumChannels;
+    const bool fileReportsPosition;
+    
+    FillJob* const fillJob;
+    TaskJob fillJobContainer;
+};
+
+//------------------------------------------------------------------------------
+
+/** Streams an audio file through a ring of frames decoded ahead on a background thread.
+ This is used by FilePlayUnit::arStream() so that the audio thread never 
+ reads the disk or decodes. All the I/O for all streams is done by the jobs 
+ on TaskPool::getIO(). 
+ 
+ The AudioFileReader object passed in must not be used by any other code.
+ @see FilePlayUnit
+ @ingroup PlonkOtherUserClasses */
+template<class SampleType>
+class AudioFileStreamBase : public SmartPointerContainer< AudioFileStreamInternal<SampleType> >
+{
+public:
+    typedef AudioFileStreamInternal<SampleType>     Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    
+    AudioFileStreamBase() throw()
+    :   Base (static_cast<Internal*> (0))
+    {
+    }
+    
+    /** Create a stream and fill it from the start position.
+     @param file            The file to stream, this must not be used elsewhere.
+     @param loopCount       How many times to play the file, 0 loops forever.
+     @param readAheadFrames How many frames to decode ahead, rounded up to a power of 2.
+     @param startPosition   The frame to start streaming from. */
+    AudioFileStreamBase (AudioFileReader const& file,
+                         IntVariable const& loopCount,
+                         const int readAheadFrames = 0,
+                         const LongLong startPosition = 0) throw()
+    :   Base (new Internal (file, loopCount, readAheadFrames, startPosition))
+    {
+    }
+    
+    AudioFileStreamBase (AudioFileStreamBase const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    AudioFileStreamBase& operator= (AudioFileStreamBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Get the number of interleaved channels held in the ring. */
+    PLONK_INLINE_LOW int getNumChannels() const throw()
+    {
+        return this->getInternal()->getNumChannels();
+    }
+    
+    /** Get the number of channels in the file at the read position. 
+     This changes with EventNumChannelsChanged, the ring keeps getNumChannels()
+     channels and the file's channels are wrapped around to fill them. */
+    PLONK_INLINE_LOW int getFileNumChannels() const throw()
+    {
+        return this->getInternal()->getFileNumChannels();
+    }
+    
+    /** Get the frame position in the file of the next frame to be read. */
+    PLONK_INLINE_LOW LongLong getFramePosition() const throw()
+    {
+        return this->getInternal()->getFramePosition();
+    }
+    
+    /** Whether the consumer has reached the end of the file. */
+    PLONK_INLINE_LOW bool hasEnded() const throw()
+    {
+        return this->getInternal()->hasEnded();
+    }
+    
+    /** Get the number of times the consumer found the ring empty. */
+    PLONK_INLINE_LOW int getNumUnderruns() const throw()
+    {
+        return this->getInternal()->getNumUnderruns();
+    }
+    
+    /** Jump to a new frame position without blocking. */
+    PLONK_INLINE_LOW void seek (const LongLong position) throw()
+    {
+        this->getInternal()->seek (position);
+    }
+    
+    /** @see AudioFileStreamInternal::beginRead() */
+    PLONK_INLINE_LOW int beginRead (int& events) throw()
+    {
+        return this->getInternal()->beginRead (events);
+    }
+    
+    PLONK_INLINE_LOW void readChannel (SampleType* const output, const int channel, const int numFrames) const throw()
+    {
+        this->getInternal()->readChannel (output, channel, numFrames);
+    }
+    
+    PLONK_INLINE_LOW void endRead (const int numFrames) throw()
+    {
+        this->getInternal()->endRead (numFrames);
+    }
+};
+
+
+#endif // PLONK_AUDIOFILESTREAM_H
@@ -673,7 +673,9 @@ public:
     /** Get the number of channels in the file. */
     PLONK_INLINE_LOW int getNumChannels() const throw()
     {
-        return pl_AudioFileWriter_GetNumChannels (&this->getInternal()->peer);
+        int numChannels = 0;
+        pl_AudioFileWriter_GetNumChannels (&this->getInternal()->peer, &numChannels);
+        return numChannels;
     }
     
     PLONK_INLINE_LOW ChannelLayout getChannelLayout() const throw()
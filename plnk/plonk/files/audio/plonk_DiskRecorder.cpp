@@ -0,0 +1,113 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+DiskRecorderThread::DiskRecorderThread (const double intervalToUse) throw()
+:   Threading::Thread ("DiskRecorderThread"),
+    interval (intervalToUse),
+    event (Lock::MutexLock),
+    recordersLock (Lock::MutexLock)
+{
+    start();
+}
+
+DiskRecorderThread::~DiskRecorderThread()
+{
+    setShouldExit();
+    wake();
+    
+    while (isRunning())
+        Threading::sleep (0.000001);
+}
+
+DiskRecorderThread& DiskRecorderThread::getDefault() throw()
+{
+    static DiskRecorderThread thread;
+    return thread;
+}
+
+void DiskRecorderThread::add (DiskRecorderInternalBase* recorder) throw()
+{
+    plonk_assert (recorder != 0);
+    
+    recorder->incrementRefCount();
+    
+    const AutoLock lock (recordersLock);
+    recorders.add (recorder);
+}
+
+void DiskRecorderThread::wake() throw()
+{
+    event.signal();
+}
+
+void DiskRecorderThread::drainAll (const bool finish) throw()
+{
+    const AutoLock lock (recordersLock);
+    
+    for (int i = recorders.length(); --i >= 0;)
+    {
+        DiskRecorderInternalBase* const recorder = recorders.atUnchecked (i);
+        
+        if (recorder->drain (finish))
+        {
+            recorders.remove (i);
+            recorder->decrementRefCount();
+        }
+    }
+}
+
+ResultCode DiskRecorderThread::run() throw()
+{
+    while (! getShouldExit())
+    {
+        drainAll (false);
+        event.wait (interval);
+    }
+    
+    drainAll (true);
+    
+    return 0;
+}
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,423 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_DISKRECORDER_H
+#define PLONK_DISKRECORDER_H
+
+#include "../../core/plonk_CoreForwardDeclarations.h"
+#include "../plonk_FilesForwardDeclarations.h"
+#include "../../core/plonk_SmartPointer.h"
+#include "../../core/plonk_SmartPointerContainer.h"
+#include "plonk_AudioFileWriter.h"
+
+/** Base for objects that have their queued frames written out by the DiskRecorderThread. */
+class DiskRecorderInternalBase : public SmartPointer
+{
+public:
+    DiskRecorderInternalBase() throw() { }
+    ~DiskRecorderInternalBase() { }
+    
+    /** Write everything that is queued. 
+     This is only called on the DiskRecorderThread. 
+     @param finish  If @c true the recorder must close its file as the thread is exiting.
+     @return @c true if the recorder has closed its file and can be forgotten. */
+    virtual bool drain (const bool finish) throw() = 0;
+};
+
+//------------------------------------------------------------------------------
+
+/** A shared thread that writes the frames queued by DiskRecorder objects to disk.
+ The thread wakes at a fixed interval and drains every recorder that is 
+ registered with it so the audio thread never needs to signal it. A recorder 
+ is dropped once it has been closed, or once the thread holds the only 
+ reference to it, after its remaining frames have been written and the file 
+ closed. Any recorders still open when the thread exits are closed too. 
+ @see DiskRecorderBase */
+class DiskRecorderThread : public Threading::Thread
+{
+public:
+    enum Constants
+    {
+        DefaultIntervalMillis = 20
+    };
+    
+    DiskRecorderThread (const double interval = DefaultIntervalMillis * 0.001) throw();
+    ~DiskRecorderThread();
+    
+    /** Get the shared thread, this is started the first time it is needed. */
+    static DiskRecorderThread& getDefault() throw();
+    
+    /** Start draining a recorder, the thread holds a reference until it is dropped. 
+     This must not be called from the audio thread. */
+    void add (DiskRecorderInternalBase* recorder) throw();
+    
+    /** Drain the recorders now rather than waiting for the next interval. 
+     This must not be called from the audio thread. */
+    void wake() throw();
+    
+    ResultCode run() throw();
+    
+private:
+    void drainAll (const bool finish) throw();
+    
+    const double interval;
+    Lock event;
+    Lock recordersLock;
+    ObjectArray<DiskRecorderInternalBase*> recorders;
+    
+    DiskRecorderThread (DiskRecorderThread const&);
+    DiskRecorderThread& operator= (DiskRecorderThread const&);
+};
+
+//------------------------------------------------------------------------------
+
+template<class SampleType>
+class DiskRecorderInternal : public DiskRecorderInternalBase
+{
+public:
+    typedef DiskRecorderBase<SampleType>        Container;
+    typedef AudioFileWriter<SampleType>         WriterType;
+    typedef NumericalArray<SampleType>          Buffer;
+    
+    enum Constants
+    {
+        DefaultBufferFrames = 65536,
+        MinimumBufferFrames = 1024,
+        MaximumBatchFrames  = 16384
+    };
+    
+    DiskRecorderInternal (WriterType const& writerToUse, const int bufferFrames) throw()
+    :   writer (writerToUse),
+        numChannels (plonk::max (1, writerToUse.getNumChannels())),
+        capacity (Bits::nextPowerOf2 (plonk::max (bufferFrames > 0 ? bufferFrames : (int) DefaultBufferFrames, (int) MinimumBufferFrames))),
+        batchFrames (plonk::min (capacity / 4, (int) MaximumBatchFrames)),
+        batch (Buffer::newClear (batchFrames * numChannels)),
+        numFramesQueued (0),
+        numFramesWritten (0),
+        numOverflowFrames (0),
+        numOverflows (0),
+        numWriteErrors (0),
+        closeRequested (0),
+        closed (0),
+        attached (0)
+    {
+        plonk_assert (writer.isReady());
+        
+        ResultCode result = pl_RingQueue_Init (&ring, sizeof (SampleType) * numChannels, capacity, PLANKRINGQUEUE_SPSC);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    ~DiskRecorderInternal()
+    {
+        pl_RingQueue_DeInit (&ring);
+    }
+    
+    PLONK_INLINE_LOW int getNumChannels() const throw()                 { return numChannels; }
+    PLONK_INLINE_LOW int getCapacity() const throw()                    { return capacity; }
+    PLONK_INLINE_LOW LongLong getNumFramesQueued() const throw()        { return numFramesQueued.getValueUnchecked(); }
+    PLONK_INLINE_LOW LongLong getNumFramesWritten() const throw()       { return numFramesWritten.getValueUnchecked(); }
+    PLONK_INLINE_LOW LongLong getNumOverflowFrames() const throw()      { return numOverflowFrames.getValueUnchecked(); }
+    PLONK_INLINE_LOW int getNumOverflows() const throw()                { return numOverflows.getValueUnchecked(); }
+    PLONK_INLINE_LOW int getNumWriteErrors() const throw()              { return numWriteErrors.getValueUnchecked(); }
+    PLONK_INLINE_LOW bool isClosed() const throw()                      { return closed.getValue() != 0; }
+    PLONK_INLINE_LOW bool isAttached() const throw()                    { return attached.getValue() != 0; }
+    
+    /** Claim the producer side of the ring for a DiskRecord unit.
+     The ring only supports one producer so only one unit may write to a recorder.
+     @return @c false if another unit has already claimed it. */
+    bool attach() throw()
+    {
+        return attached.compareAndSwap (0, 1);
+    }
+    
+    void detach() throw()
+    {
+        attached.setValue (0);
+    }
+    
+    /** Queue interleaved frames for writing.
+     This must only be called from one thread, normally the audio thread. It never
+     blocks or allocates. Frames that don't fit are dropped and counted as an overflow.
+     @return The number of frames queued. */
+    int write (const SampleType* frames, const int numFrames) throw()
+    {
+        if (closeRequested.getValueUnchecked() != 0)
+            return 0;
+        
+        PlankL numPushed = 0;
+        pl_RingQueue_PushBulk (&ring, frames, numFrames, &numPushed);
+        
+        numFramesQueued.setValue (numFramesQueued.getValueUnchecked() + numPushed);
+        
+        if (numPushed < numFrames)
+        {
+            numOverflowFrames.setValue (numOverflowFrames.getValueUnchecked() + (numFrames - numPushed));
+            ++numOverflows;
+        }
+        
+        return (int) numPushed;
+    }
+    
+    /** Stop queueing frames and close the file once those already queued are written.
+     The file is closed on the DiskRecorderThread. */
+    void close() throw()
+    {
+        if (closeRequested.compareAndSwap (0, 1))
+            DiskRecorderThread::getDefault().wake();
+    }
+    
+    bool drain (const bool finish) throw()
+    {
+        if (closed.getValueUnchecked() != 0)
+            return true;
+        
+        // the thread holds the last reference so nothing can queue any more frames
+        const bool shouldClose = finish || (closeRequested.getValue() != 0) || (this->getRefCount() == 1);
+        
+        SampleType* const batchSamples = batch.getArray();
+        PlankL numPopped;
+        
+        do
+        {
+            numPopped = 0;
+            pl_RingQueue_PopBulk (&ring, batchSamples, batchFrames, &numPopped);
+            
+            if (numPopped > 0)
+            {
+                if (writer.writeFrames ((int) numPopped, batchSamples))
+                    numFramesWritten.setValue (numFramesWritten.getValueUnchecked() + numPopped);
+                else
+                    ++numWriteErrors;
+            }
+        } while (numPopped == batchFrames);
+        
+        if (! shouldClose)
+            return false;
+        
+        writer.close();
+        closed.setValue (1);
+        
+        return true;
+    }
+    
+    friend class DiskRecorderBase<SampleType>;
+    
+private:
+    WriterType writer;
+    const int numChannels;
+    const int capacity;
+    const int batchFrames;
+    Buffer batch;
+    PlankRingQueue ring;
+    
+    AtomicLongLong numFramesQueued;
+    AtomicLongLong numFramesWritten;
+    AtomicLongLong numOverflowFrames;
+    AtomicInt numOverflows;
+    AtomicInt numWriteErrors;
+    AtomicInt closeRequested;
+    AtomicInt closed;
+    AtomicInt attached;
+};
+
+//------------------------------------------------------------------------------
+
+/** Records interleaved frames to an AudioFileWriter without blocking the audio thread.
+ Frames are copied into a preallocated single-producer/single-consumer ring
+ and written to the file in large batches by the shared DiskRecorderThread, so
+ any format the AudioFileWriter supports can be captured regardless of how many 
+ channels there are. If the ring fills because the disk can't keep up the 
+ frames that don't fit are dropped and counted, rather than waiting. 
+ The ring should hold at least a few multiples of the thread's interval.
+ 
+ The file is closed when close() is called or when the last reference to the
+ recorder (including any DiskRecord units) is released.
+ 
+ @see DiskRecordUnit, DiskRecorderThread */
+template<class SampleType>
+class DiskRecorderBase : public SmartPointerContainer< DiskRecorderInternal<SampleType> >
+{
+public:
+    typedef DiskRecorderInternal<SampleType>        Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    typedef WeakPointerContainer<DiskRecorderBase>  Weak;
+    typedef AudioFileWriter<SampleType>             WriterType;
+    
+    enum Constants
+    {
+        DefaultBufferFrames = Internal::DefaultBufferFrames
+    };
+    
+    DiskRecorderBase() throw()
+    :   Base (static_cast<Internal*> (0))
+    {
+    }
+    
+    /** Start recording to a writer. 
+     @param writer          An AudioFileWriter that is ready to write.
+     @param bufferFrames    The depth of the ring in frames, rounded up to a power of 2. */
+    DiskRecorderBase (WriterType const& writer, const int bufferFrames = DefaultBufferFrames) throw()
+    :   Base (new Internal (writer, bufferFrames))
+    {
+        DiskRecorderThread::getDefault().add (this->getInternal());
+    }
+    
+    explicit DiskRecorderBase (Internal* internalToUse) throw()
+	:	Base (internalToUse)
+	{
+	}
+    
+    DiskRecorderBase (DiskRecorderBase const& copy) throw()
+	:	Base (static_cast<Base const&> (copy))
+	{
+	}
+    
+    DiskRecorderBase (Dynamic const& other) throw()
+    :   Base (other.as<DiskRecorderBase>().getInternal())
+    {
+    }
+    
+    /** Assignment operator. */
+    DiskRecorderBase& operator= (DiskRecorderBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */
+    static DiskRecorderBase fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }
+    
+    static const DiskRecorderBase& getNull() throw()
+	{
+		static DiskRecorderBase null;
+		return null;
+	}
+    
+    /** Queue interleaved frames for writing. 
+     This must only be called from one thread, normally the audio thread, and 
+     not while a DiskRecord unit is attached.
+     @return The number of frames queued, any others were dropped. */
+    PLONK_INLINE_LOW int write (const SampleType* frames, const int numFrames) throw()
+    {
+        return this->getInternal()->write (frames, numFrames);
+    }
+    
+    /** Stop recording, the file is closed once the queued frames are written. */
+    PLONK_INLINE_LOW void close() throw()
+    {
+        this->getInternal()->close();
+    }
+    
+    /** Returns @c true once the file has been closed. */
+    PLONK_INLINE_LOW bool isClosed() const throw()
+    {
+        return this->getInternal()->isClosed();
+    }
+    
+    /** Returns @c true while a DiskRecord unit is writing to this recorder. 
+     Only one unit may be attached to a recorder at a time. */
+    PLONK_INLINE_LOW bool isAttached() const throw()
+    {
+        return this->getInternal()->isAttached();
+    }
+    
+    /** Claim the recorder for a single writer, this is done by DiskRecord units.
+     @return @c false if it is already attached. */
+    PLONK_INLINE_LOW bool attach() throw()
+    {
+        return this->getInternal()->attach();
+    }
+    
+    PLONK_INLINE_LOW void detach() throw()
+    {
+        this->getInternal()->detach();
+    }
+    
+    PLONK_INLINE_LOW int getNumChannels() const throw()
+    {
+        return this->getInternal()->getNumChannels();
+    }
+    
+    /** The depth of the ring in frames. */
+    PLONK_INLINE_LOW int getCapacity() const throw()
+    {
+        return this->getInternal()->getCapacity();
+    }
+    
+    PLONK_INLINE_LOW LongLong getNumFramesQueued() const throw()
+    {
+        return this->getInternal()->getNumFramesQueued();
+    }
+    
+    PLONK_INLINE_LOW LongLong getNumFramesWritten() const throw()
+    {
+        return this->getInternal()->getNumFramesWritten();
+    }
+    
+    /** The total number of frames dropped because the ring was full. */
+    PLONK_INLINE_LOW LongLong getNumOverflowFrames() const throw()
+    {
+        return this->getInternal()->getNumOverflowFrames();
+    }
+    
+    /** The number of writes that had to drop frames because the ring was full. */
+    PLONK_INLINE_LOW int getNumOverflows() const throw()
+    {
+        return this->getInternal()->getNumOverflows();
+    }
+    
+    PLONK_INLINE_LOW int getNumWriteErrors() const throw()
+    {
+        return this->getInternal()->getNumWriteErrors();
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(DiskRecorderBase);
+};
+
+
+#endif // PLONK_DISKRECORDER_H
@@ -50,6 +50,7 @@
 #include "../utility/plonk_SampleRate.h"
 #include "../utility/plonk_TimeStamp.h"
 #include "../utility/plonk_InputDictionary.h"
+#include "../utility/plonk_Profiler.h"
 
 //------------------------------------------------------------------------------
 
@@ -188,7 +189,16 @@ public:
     PLONK_INLINE_LOW int getNumChannels() const throw()                               { return this->getInternal()->getNumChannels(); }
     
     PLONK_INLINE_LOW void initValue (SampleType const& value) throw()                 { return this->getInternal()->initValue (value); }
-    PLONK_INLINE_LOW void initChannel (const int index) throw()                       { this->getInternal()->initChannel (index); }
+    PLONK_INLINE_LOW void initChannel (const int index) throw()
+    {
+        this->getInternal()->resolveInputSlots();
+        this->getInternal()->initChannel (index);
+        
+#if PLONK_PROFILE
+        this->getInternal()->initProfileRecord();
+#endif
+    }
+    
     PLONK_INLINE_LOW const SampleType& getValue() const throw()                       { return this->getInternal()->getValue(); }
     
     PLONK_INLINE_LOW ChannelBase getChannel (const int index) throw()                 { return ChannelBase (this->getInternal()->getChannel (index)); }
@@ -229,6 +239,10 @@ public:
     {        
         if (this->needsToProcess (info))
         {
+#if PLONK_PROFILE
+            const ProfileScope scope (this->getInternal()->getProfileRecord(), info, this->getNextTimeStamp(), 
+                                      LongLong (this->getOutputBuffer().length()) * LongLong (sizeof (SampleType)));
+#endif
             this->getInternal()->process (info, channel);
             this->getInternal()->setLastTimeStamp (info.getTimeStamp());
             this->getInternal()->updateTimeStamp();
@@ -236,6 +250,12 @@ public:
             if (info.getShouldDelete() == true)
                 this->getInternal()->setExpiryTimeStamp (this->getInternal()->getNextTimeStamp());
         }
+#if PLONK_PROFILE
+        else
+        {
+            ProfileScope::skip (this->getInternal()->getProfileRecord());
+        }
+#endif
     }
     
     int getTypeCode() const throw()
@@ -68,6 +68,10 @@ public:
     typedef QueueBufferBase<SampleType>             QueueBufferType;
     typedef LockFreeQueue<QueueBufferType>          BufferQueueType;
     typedef Variable<FFTBuffersBase<SampleType>&>   FFTBuffersVariableType;
+    typedef ParamEventsBase<SampleType>             ParamEventsType;
+    typedef DiskRecorderBase<SampleType>            DiskRecorderType;
+    typedef WavetableBankBase<SampleType>           WavetableBankType;
+    typedef STFTEngineBase<SampleType>              STFTEngineType;
 
     ChannelInternalBase (Inputs const& inputDictionary, 
                          BlockSize const& blockSize, 
@@ -102,6 +106,10 @@ public:
     PLONK_INLINE_LOW const QueueType& getInputAsUnitQueue (const int key) const throw()               { return this->template getInputAs<QueueType> (key); }
     PLONK_INLINE_LOW const BufferQueueType& getInputAsBufferQueue (const int key) const throw()       { return this->template getInputAs<BufferQueueType> (key); }
     PLONK_INLINE_LOW const FFTBuffersVariableType& getInputAsFFTBuffers (const int key) const throw() { return this->template getInputAs<FFTBuffersVariableType> (key); }
+    PLONK_INLINE_LOW const ParamEventsType& getInputAsParamEvents (const int key) const throw()       { return this->template getInputAs<ParamEventsType> (key); }
+    PLONK_INLINE_LOW const DiskRecorderType& getInputAsDiskRecorder (const int key) const throw()     { return this->template getInputAs<DiskRecorderType> (key); }
+    PLONK_INLINE_LOW const WavetableBankType& getInputAsWavetableBank (const int key) const throw()   { return this->template getInputAs<WavetableBankType> (key); }
+    PLONK_INLINE_LOW const STFTEngineType& getInputAsSTFTEngine (const int key) const throw()         { return this->template getInputAs<STFTEngineType> (key); }
 
     PLONK_INLINE_LOW UnitType& getInputAsUnit (const int key) throw()                                 { return this->template getInputAs<UnitType> (key); }
     PLONK_INLINE_LOW UnitsType& getInputAsUnits (const int key) throw()                               { return this->template getInputAs<UnitsType> (key); }
@@ -118,6 +126,10 @@ public:
     PLONK_INLINE_LOW QueueType& getInputAsUnitQueue (const int key) throw()                           { return this->template getInputAs<QueueType> (key); }
     PLONK_INLINE_LOW BufferQueueType& getInputAsBufferQueue (const int key) throw()                   { return this->template getInputAs<BufferQueueType> (key); }
     PLONK_INLINE_LOW FFTBuffersVariableType& getInputAsFFTBuffers (const int key) throw()             { return this->template getInputAs<FFTBuffersVariableType> (key); }
+    PLONK_INLINE_LOW ParamEventsType& getInputAsParamEvents (const int key) throw()                   { return this->template getInputAs<ParamEventsType> (key); }
+    PLONK_INLINE_LOW DiskRecorderType& getInputAsDiskRecorder (const int key) throw()                 { return this->template getInputAs<DiskRecorderType> (key); }
+    PLONK_INLINE_LOW WavetableBankType& getInputAsWavetableBank (const int key) throw()               { return this->template getInputAs<WavetableBankType> (key); }
+    PLONK_INLINE_LOW STFTEngineType& getInputAsSTFTEngine (const int key) throw()                     { return this->template getInputAs<STFTEngineType> (key); }
 
     PLONK_INLINE_LOW const Buffer& getOutputBuffer() const throw()                                    { return outputBuffer; }
     PLONK_INLINE_LOW Buffer& getOutputBuffer() throw()                                                { return outputBuffer; }
@@ -175,6 +187,16 @@ public:
         outputBuffer.last() = value;
     }
     
+    /** Describe this channel's processing as a single Plink kernel call.
+     Only channels implemented with Plink override this. 
+     @return @c false if this channel can't be called directly from a 
+             FreezeUnit schedule so must be processed as normal. */
+    virtual bool getPlinkKernel (PlinkKernel<SampleType>& kernel) throw()
+    {
+        (void)kernel;
+        return false;
+    }
+    
     PLONK_INLINE_LOW const Text getOutputTypeName() const throw()         { return TypeUtility<SampleType>::getTypeName(); }
     virtual const Text getInputTypeName() const throw()                   { return TypeUtility<SampleType>::getTypeName(); }
     PLONK_INLINE_LOW int getOutputTypeCode() const throw()                { return TypeUtility<SampleType>::getTypeCode(); }
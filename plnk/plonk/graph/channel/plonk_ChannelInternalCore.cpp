@@ -50,9 +50,15 @@ ChannelInternalCore::ChannelInternalCore (Inputs const& inputsToUse,
     nextTimeStamp (TimeStamp::getZero()),
     expiryTimeStamp (TimeStamp::getMaximum()),
     inputs (inputsToUse),
+    inputSlots(),
+    inputSlotValues (0),
+    inputSlotsRevision (-1),
     blockSize (blockSizeToUse),
     sampleRate (sampleRateToUse),
     overlap (inputs.containsKey (IOKey::OverlapMake) ? getInputAs<DoubleVariable> (IOKey::OverlapMake) : Math<DoubleVariable>::get1())
+#if PLONK_PROFILE
+    , profileRecord (0)
+#endif
 {
     cacheSampleDurationTicks();
     
@@ -61,6 +67,14 @@ ChannelInternalCore::ChannelInternalCore (Inputs const& inputsToUse,
     plonk_assert (overlap.getValue() <= 1.0);
 }
 
+ChannelInternalCore::~ChannelInternalCore()
+{
+#if PLONK_PROFILE
+    if (profileRecord != 0)
+        profileRecord->retire();
+#endif
+}
+
 void ChannelInternalCore::updateTimeStamp() throw()
 {
     if (this->lastTimeStamp >= TimeStamp::getZero()) // would like to avoid this condition..
@@ -73,7 +87,20 @@ void ChannelInternalCore::updateTimeStamp() throw()
 void ChannelInternalCore::setLabel (Text const& newId) throw()
 {
     identifier = newId;
+    
+#if PLONK_PROFILE
+    if (profileRecord != 0)
+        Profiler::getDefault().setLabel (profileRecord, this->getLabel());
+#endif
+}
+
+#if PLONK_PROFILE
+void ChannelInternalCore::initProfileRecord() throw()
+{
+    if ((profileRecord == 0) && ! this->isConstant() && ! this->isNull())
+        profileRecord = Profiler::getDefault().add (this->getName(), this->getLabel());
 }
+#endif
 
 void ChannelInternalCore::setBlockSizeInternal (BlockSize const& newBlockSize) throw()
 {
@@ -96,6 +123,47 @@ void ChannelInternalCore::cacheSampleDurationTicks() const throw()
     cachedSampleDurationTicks = TimeStamp::getTicks() / sampleRate.getValue(); 
 }
 
+void ChannelInternalCore::resolveInputSlots() const throw()
+{
+    Inputs::Internal* const internal = inputs.getInternal();
+    ObjectArray<int> const& keys = internal->getKeys();
+    const int numKeys = keys.length();
+    
+    for (int i = 0; i < IOKey::NumNames; ++i)
+        inputSlots[i] = -1;
+    
+    for (int i = 0; i < numKeys; ++i)
+    {
+        const int key = keys.atUnchecked (i);
+        
+        if (((unsigned int)key < (unsigned int)IOKey::NumNames) && (i <= 127))
+            inputSlots[key] = (signed char)i;
+    }
+    
+    inputSlotValues = internal->getValues().getArray();
+    inputSlotsRevision = internal->getKeyRevision();
+}
+
+Dynamic& ChannelInternalCore::resolveInputSlot (const int key) const throw()
+{
+    Inputs::Internal* const internal = inputs.getInternal();
+    
+    if (internal->getKeyRevision() != inputSlotsRevision)
+        resolveInputSlots();
+    
+    // keys outside the table, or not in the inputs at all, fall back to a search
+    return internal->getValues()[internal->getKeys().indexOf (key)];
+}
+
+void ChannelInternalCore::addDependencies (GraphDependencies& dependencies, const int root) const throw()
+{
+    if (this->isConstant())
+        return;
+    
+    if (dependencies.add (this, root))
+        dependencies.addInputs (inputs, root);
+}
+
 TextArray ChannelInternalCore::getInputNames() const throw()
 {
     return IOKey::collectNames (this->getInputKeys());
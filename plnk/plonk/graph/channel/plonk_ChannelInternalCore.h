@@ -42,6 +42,8 @@
 #include "../plonk_GraphForwardDeclarations.h"
 #include "../utility/plonk_ProcessInfo.h"
 #include "../utility/plonk_BlockSize.h"
+#include "../utility/plonk_Profiler.h"
+#include "../info/plonk_InfoHeaders.h"
 
 
 template<>
@@ -75,7 +77,7 @@ public:
     ChannelInternalCore (Inputs const& inputs,
                          BlockSize const& blockSize, 
                          SampleRate const& sampleRate) throw();
-    virtual ~ChannelInternalCore() { }
+    virtual ~ChannelInternalCore();
     
     const TimeStamp& getNextTimeStamp() const throw() { return nextTimeStamp; }
     void setNextTimeStamp (TimeStamp const& newTimeStamp) throw();
@@ -86,8 +88,15 @@ public:
     PLONK_INLINE_HIGH const Inputs& getInputs() const throw()                                      { return this->inputs; }
     PLONK_INLINE_HIGH Inputs& getInputs() throw()                                                  { return this->inputs; }
     
-    template<class Type> PLONK_INLINE_MID const Type& getInputAs (const int key) const throw()    { return this->inputs[key].asUnchecked<Type>(); }
-    template<class Type> PLONK_INLINE_MID Type& getInputAs (const int key) throw()                { return this->inputs[key].asUnchecked<Type>(); }
+    template<class Type> PLONK_INLINE_MID const Type& getInputAs (const int key) const throw()    { return this->getInputSlot (key).asUnchecked<Type>(); }
+    template<class Type> PLONK_INLINE_MID Type& getInputAs (const int key) throw()                { return this->getInputSlot (key).asUnchecked<Type>(); }
+    
+    /** Rebuilds the table that maps IOKeys directly to the input values.
+     This is called before initChannel() so process() reads its inputs by 
+     index. If keys are later added to or removed from the inputs the table 
+     is rebuilt on the next lookup, replacing the value at an existing key 
+     needs no rebuild. */
+    void resolveInputSlots() const throw();
     
     const BlockSize& getBlockSize() const throw()    { return blockSize; }
     const SampleRate& getSampleRate() const throw()  { return sampleRate; }    
@@ -99,6 +108,12 @@ public:
     double getSampleDurationInTicks() const throw()  { return cachedSampleDurationTicks; }
     double getBlockDurationInTicks() const throw();
     void updateTimeStamp() throw();
+    
+#if PLONK_PROFILE
+    /** Add this channel to the profiler, this is called after initChannel(). */
+    void initProfileRecord() throw();
+    PLONK_INLINE_HIGH ProfileRecord* getProfileRecord() const throw() { return profileRecord; }
+#endif
         
     virtual bool isNull() const throw()                 { return false; }
     virtual bool isConstant() const throw()             { return false; }
@@ -126,6 +141,12 @@ public:
     /** The DSP function.
      This function will do all the processing for derived class. */
     virtual void process (ProcessInfo& info, const int channel) = 0;
+    
+    /** Record this channel and everything it reads from.
+     This is used to find sub-graphs that are independent of each other. 
+     Subclasses that read from channels that aren't in their inputs
+     (e.g., proxies) must override this. @see GraphDependencies */
+    virtual void addDependencies (GraphDependencies& dependencies, const int root) const throw();
         
 protected:
     void setBlockSizeInternal (BlockSize const& newBlockSize) throw();
@@ -138,12 +159,20 @@ private:
     TimeStamp nextTimeStamp;
     TimeStamp expiryTimeStamp;
     Inputs inputs;
+    mutable signed char inputSlots[IOKey::NumNames];
+    mutable Dynamic* inputSlotValues;
+    mutable LongLong inputSlotsRevision; // identifies the inputs' internal and its keys
     BlockSize blockSize;
     SampleRate sampleRate;
     DoubleVariable overlap;
     mutable double cachedSampleDurationTicks;
+#if PLONK_PROFILE
+    ProfileRecord* profileRecord;
+#endif
     
     void cacheSampleDurationTicks() const throw();
+    Dynamic& getInputSlot (const int key) const throw();
+    Dynamic& resolveInputSlot (const int key) const throw();
     
     ChannelInternalCore();
     ChannelInternalCore (const ChannelInternalCore&);
@@ -174,6 +203,22 @@ PLONK_INLINE_HIGH bool ChannelInternalCore::shouldBeDeletedNow (TimeStamp const&
     return time >= expiryTimeStamp;
 }
 
+PLONK_INLINE_HIGH Dynamic& ChannelInternalCore::getInputSlot (const int key) const throw()
+{
+    const Inputs::Internal* const internal = inputs.getInternal();
+    
+    if (((unsigned int)key < (unsigned int)IOKey::NumNames) && 
+        (internal->getKeyRevision() == inputSlotsRevision))
+    {
+        const int slot = inputSlots[key];
+        
+        if (slot >= 0)
+            return inputSlotValues[slot];
+    }
+    
+    return resolveInputSlot (key);
+}
+
 PLONK_INLINE_MID double ChannelInternalCore::getBlockDurationInTicks() const throw()
 { 
     return this->getSampleDurationInTicks() * double (this->getBlockSize().getValue()) * overlap.getValue();
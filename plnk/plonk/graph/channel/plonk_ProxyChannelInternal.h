@@ -135,6 +135,12 @@ public:
         owner.process (info, channel);
     }
     
+    void addDependencies (GraphDependencies& dependencies, const int root) const throw()
+    {
+        if (dependencies.add (static_cast<const ChannelInternalCore*> (this), root))
+            owner.getInternal()->addDependencies (dependencies, root);
+    }
+    
 private:
     ChannelType owner;
     const int proxyIndex;
@@ -0,0 +1,548 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_FREEZECHANNEL_H
+#define PLONK_FREEZECHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class FreezeChannelInternal;
+
+template<class SampleType>
+struct ChannelData< FreezeChannelInternal<SampleType> >
+{
+    ChannelInternalCore::Data base;
+};      
+
+//------------------------------------------------------------------------------
+
+/** Freeze channel. 
+ Processes its input graph from a flat schedule of Plink kernel calls. */
+template<class SampleType>
+class FreezeChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, ChannelData< FreezeChannelInternal<SampleType> > >
+{
+public:
+    typedef ChannelData< FreezeChannelInternal<SampleType> >        Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ObjectArray<ChannelType>                                ChannelArrayType;
+    typedef ChannelInternalBase<SampleType>                         InternalBase;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef PlinkKernel<SampleType>                                 KernelType;
+    typedef typename KernelType::Function                           KernelFunction;
+    typedef PlinkProcess<KernelType::MaxInputs + 1, SampleType>     Process;
+    
+    enum StepTypes
+    {
+        ConstantStep,   // the output buffer of a constant channel, never processed
+        DynamicStep,    // a channel processed as normal via its timestamps
+        KernelStep      // a direct call to a Plink kernel
+    };
+    
+    /** One node of the flattened graph. */
+    class Step
+    {
+    public:
+        Step() throw()
+        :   channelIndex (0),
+            type (DynamicStep),
+            function (0),
+            state (0),
+            numInputs (0),
+            dynamicInputs (0),
+            root (-1),
+            lastUse (-1),
+            slot (-1),
+            samples (0),
+            length (0)
+        {
+            for (int i = 0; i < KernelType::MaxInputs; ++i)
+                inputs[i] = -1;
+        }
+        
+        ChannelType channel;
+        int channelIndex;
+        int type;
+        KernelFunction function;
+        void* state;
+        int numInputs;
+        int inputs[KernelType::MaxInputs];  // step indices, -1 for fixed arrays
+        int dynamicInputs;                  // bit mask of the inputs that need fetching each block
+        int root;                           // the output channel this kernel writes to directly, or -1
+        int lastUse;                        // the last step that reads this step's output
+        int slot;                           // the arena slot holding the output, or -1
+        SampleType* samples;
+        int length;
+        Process process;
+    };
+    
+    typedef ObjectArray<Step>                                       StepArray;
+    
+    FreezeChannelInternal (Inputs const& inputs,
+                           Data const& data,
+                           BlockSize const& blockSize,
+                           SampleRate const& sampleRate,
+                           ChannelArrayType& channels) throw()
+    :   Internal (numChannelsInSource (inputs), 
+                  inputs, data, blockSize, sampleRate,
+                  channels),
+        compiledBlockSize (0),
+        numKernelSteps (0),
+        numDynamicSteps (0)
+    {
+        compile();
+    }
+            
+    Text getName() const throw()
+    {
+        return "Freeze";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic);
+        return keys;
+    }    
+        
+    void initChannel (const int channel) throw()
+    {               
+        const UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        this->initProxyValue (channel, inputUnit.getValue (channel));
+    }    
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        if (compiledBlockSize != this->getBlockSize().getValue())
+            compile();
+        
+        Step* const stepArray = steps.getArray();
+        const int numSteps = steps.length();
+        
+        for (int i = 0; i < numSteps; ++i)
+        {
+            Step& step = stepArray[i];
+            
+            if (step.type == KernelStep)
+            {
+                if (step.root >= 0)
+                    step.process.buffers[0].buffer = this->getOutputSamples (step.root);
+                
+                if (step.dynamicInputs != 0)
+                {
+                    for (int j = 0; j < step.numInputs; ++j)
+                    {
+                        if (step.dynamicInputs & (1 << j))
+                        {
+                            const Step& input = stepArray[step.inputs[j]];
+                            step.process.buffers[j + 1].bufferSize = input.length;
+                            step.process.buffers[j + 1].buffer = input.samples;
+                        }
+                    }
+                }
+                
+                (step.function) (&step.process, step.state);
+            }
+            else if (step.type == DynamicStep)
+            {
+                step.channel.process (info, step.channelIndex);
+                step.samples = step.channel.getOutputSamples();
+                step.length = step.channel.getOutputBuffer().length();
+            }
+        }
+        
+        const int numChannels = this->getNumChannels();
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const Step& step = stepArray[roots.atUnchecked (channel)];
+            
+            if ((step.type == KernelStep) && (step.root == channel))
+                continue;
+            
+            Buffer& outputBuffer (this->getOutputBuffer (channel));
+            SampleType* const outputSamples = outputBuffer.getArray();
+            const int outputBufferLength = outputBuffer.length();
+            const SampleType* const stepSamples = (step.root >= 0) ? this->getOutputSamples (step.root) : step.samples;
+            
+            if (step.length == outputBufferLength)
+            {
+                Buffer::copyData (outputSamples, stepSamples, outputBufferLength);
+            }
+            else if (step.length == 1)
+            {
+                Buffer::fill (outputSamples, stepSamples[0], outputBufferLength);
+            }
+            else
+            {
+                plonk_assertfalse; // the input channels must share the same block size
+                outputBuffer.zero();
+            }
+        }
+    }
+    
+    /** The number of channels called directly as Plink kernels. */
+    PLONK_INLINE_LOW int getNumKernelSteps() const throw()     { return numKernelSteps; }
+    
+    /** The number of channels left to process themselves as normal. */
+    PLONK_INLINE_LOW int getNumDynamicSteps() const throw()    { return numDynamicSteps; }
+    
+    /** The number of block sized buffers in the arena. */
+    PLONK_INLINE_LOW int getNumBuffers() const throw()         { return compiledBlockSize > 0 ? arena.length() / compiledBlockSize : 0; }
+    
+private:
+    StepArray steps;
+    IntArray roots;
+    Buffer arena;
+    int compiledBlockSize;
+    int numKernelSteps;
+    int numDynamicSteps;
+    
+    static PLONK_INLINE_LOW int numChannelsInSource (Inputs const& inputs) throw()
+    {
+        return inputs[IOKey::Generic].asUnchecked<UnitType>().getNumChannels();
+    }
+    
+    /** Flatten the input graph into the schedule.
+     Steps are added depth first so every step comes after the steps it reads. */
+    void compile() throw()
+    {
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        const int numChannels = this->getNumChannels();
+        
+        compiledBlockSize = this->getBlockSize().getValue();
+        steps.clear();
+        roots.setSize (numChannels, false);
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+            roots.atUnchecked (channel) = addStep (inputUnit.wrapAt (channel), channel);
+        
+        demoteSharedSteps();
+        allocateBuffers();
+    }
+    
+    int addStep (ChannelType const& channel, const int channelIndex) throw()
+    {
+        InternalBase* const internal = channel.getInternal();
+        const int numSteps = steps.length();
+        
+        for (int i = 0; i < numSteps; ++i)
+            if (steps.atUnchecked (i).channel.getInternal() == internal)
+                return i;
+        
+        Step step;
+        step.channel = channel;
+        step.channelIndex = channelIndex;
+        
+        KernelType kernel;
+        
+        if (internal->isConstant())
+        {
+            step.type = ConstantStep;
+        }
+        else if ((internal->getBlockSize().getValue() == compiledBlockSize) && internal->getPlinkKernel (kernel))
+        {
+            step.type = KernelStep;
+            step.function = kernel.getFunction();
+            step.state = kernel.getState();
+            step.numInputs = kernel.getNumInputs();
+            
+            Process::init (&step.process, this, 1, step.numInputs);
+            
+            for (int i = 0; i < step.numInputs; ++i)
+            {
+                UnitType* const unit = kernel.getInputUnit (i);
+                
+                if (unit != 0)
+                {
+                    step.inputs[i] = addStep (unit->wrapAt (channelIndex), channelIndex);
+                }
+                else
+                {
+                    step.process.buffers[i + 1].bufferSize = kernel.getInputLength (i);
+                    step.process.buffers[i + 1].buffer = kernel.getInputSamples (i);
+                }
+            }
+        }
+        else
+        {
+            step.type = DynamicStep;
+        }
+        
+        steps.add (step);
+        return steps.length() - 1;
+    }
+    
+    /** Kernels that are also read by a channel processed as normal must be too.
+     Otherwise they would be processed twice in the same block. */
+    void demoteSharedSteps() throw()
+    {
+        Step* const stepArray = steps.getArray();
+        const int numSteps = steps.length();
+        GraphDependencies dependencies;
+        
+        dependencies.reset (1);
+        
+        for (int i = 0; i < numSteps; ++i)
+            if (stepArray[i].type == DynamicStep)
+                stepArray[i].channel.getInternal()->addDependencies (dependencies, 0);
+        
+        for (int i = 0; i < numSteps; ++i)
+        {
+            Step& step = stepArray[i];
+            
+            // dependencies are recorded against the core so must be looked up the same way
+            const ChannelInternalCore* const core = step.channel.getInternal();
+            
+            if ((step.type == KernelStep) && ! dependencies.add (core, 0))
+                step.type = DynamicStep;
+        }
+    }
+    
+    /** Assign each kernel output an arena slot.
+     A slot is reused once the last step that reads it has run. Kernels that 
+     produce an output channel write straight to that channel's buffer. */
+    void allocateBuffers() throw()
+    {
+        Step* const stepArray = steps.getArray();
+        const int numSteps = steps.length();
+        const int numChannels = roots.length();
+        
+        numKernelSteps = 0;
+        numDynamicSteps = 0;
+        
+        for (int i = 0; i < numSteps; ++i)
+        {
+            Step& step = stepArray[i];
+            
+            if (step.type == KernelStep)
+            {
+                for (int j = 0; j < step.numInputs; ++j)
+                    if (step.inputs[j] >= 0)
+                        stepArray[step.inputs[j]].lastUse = i; // steps are in order so this ends up the latest
+                
+                ++numKernelSteps;
+            }
+            else if (step.type == DynamicStep)
+            {
+                ++numDynamicSteps;
+            }
+        }
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            Step& step = stepArray[roots.atUnchecked (channel)];
+            
+            if ((step.type == KernelStep) && (step.root < 0))
+                step.root = channel;
+        }
+        
+        IntArray freeSlots;
+        int numSlots = 0;
+        
+        for (int i = 0; i < numSteps; ++i)
+        {
+            Step& step = stepArray[i];
+            
+            if (step.type != KernelStep)
+                continue;
+            
+            if (step.root < 0)
+            {
+                if (freeSlots.length() > 0)
+                {
+                    step.slot = freeSlots.last();
+                    freeSlots.remove (freeSlots.length() - 1);
+                }
+                else
+                {
+                    step.slot = numSlots++;
+                }
+            }
+            
+            // after allocating the output so a kernel never writes over its own inputs
+            for (int j = 0; j < step.numInputs; ++j)
+            {
+                if (step.inputs[j] >= 0)
+                {
+                    Step& input = stepArray[step.inputs[j]];
+                    
+                    if ((input.type == KernelStep) && (input.slot >= 0) && (input.lastUse == i))
+                    {
+                        freeSlots.add (input.slot);
+                        input.lastUse = -1; // in case this step reads it more than once
+                    }
+                }
+            }
+        }
+        
+        arena = Buffer::newClear (numSlots * compiledBlockSize);
+        SampleType* const arenaSamples = arena.getArray();
+        
+        for (int i = 0; i < numSteps; ++i)
+        {
+            Step& step = stepArray[i];
+            
+            if (step.type == KernelStep)
+            {
+                step.samples = (step.root >= 0) ? this->getOutputSamples (step.root) : arenaSamples + step.slot * compiledBlockSize;
+                step.length = compiledBlockSize;
+                step.process.buffers[0].bufferSize = compiledBlockSize;
+                step.process.buffers[0].buffer = step.samples;
+            }
+            else
+            {
+                step.samples = step.channel.getOutputSamples();
+                step.length = step.channel.getOutputBuffer().length();
+            }
+        }
+        
+        for (int i = 0; i < numSteps; ++i)
+        {
+            Step& step = stepArray[i];
+            
+            if (step.type != KernelStep)
+                continue;
+            
+            step.dynamicInputs = 0;
+            
+            for (int j = 0; j < step.numInputs; ++j)
+            {
+                if (step.inputs[j] >= 0)
+                {
+                    const Step& input = stepArray[step.inputs[j]];
+                    
+                    if (input.type == DynamicStep)
+                    {
+                        step.dynamicInputs |= 1 << j;
+                    }
+                    else
+                    {
+                        step.process.buffers[j + 1].bufferSize = input.length;
+                        step.process.buffers[j + 1].buffer = input.samples;
+                    }
+                }
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Compile a static graph into a flat schedule of Plink kernel calls.
+ 
+ Normally each channel checks its timestamp and calls its inputs, which do the
+ same, on every block. Freeze walks its input graph once and flattens it into 
+ a list of steps in dependency order. Channels implemented with Plink (binary 
+ and unary operators, MulAdd, Saw, Table and WhiteNoise at the same block 
+ size) become direct calls to their Plink kernel reading and writing a 
+ preallocated arena of buffers. An arena buffer is reused once the last kernel 
+ reading it has run. Everything else (including anything read by these other
+ channels) is processed as normal, so the frozen graph can still contain 
+ dynamic parts. Constant inputs are read directly.
+ 
+ This is only available when PLONK_USEPLINK is set. The frozen channels 
+ should not be used outside the frozen graph as they are no longer processed 
+ through their own output buffers. Kernel state (e.g., oscillator phases) stays
+ in the original channels.
+ 
+ @code
+ Unit graph = Saw::ar (110) * 0.2f + Saw::ar (220) * 0.1f;
+ Unit frozen = Freeze::ar (graph);
+ @endcode
+ 
+ @par Factory functions:
+ - ar (input)
+ 
+ @par Inputs:
+ - input: (unit, multi) the graph to freeze
+ 
+ @ingroup ConverterUnits */
+template<class SampleType>
+class FreezeUnit
+{
+public:    
+    typedef FreezeChannelInternal<SampleType>       FreezeInternal;
+    typedef typename FreezeInternal::Data           Data;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        return UnitInfo ("Freeze", "Processes a static graph from a flat schedule of kernel calls.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,        Measure::None,      IOInfo::NoDefault,  IOLimit::None,      IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,        Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::End);
+    }    
+    
+    /** Create a frozen copy of a graph. */
+    static UnitType ar (UnitType const& input) throw()
+    {                
+        plonk_assert (input.channelsHaveSameBlockSize());
+        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);   
+        
+        Data data = { { -1.0, -1.0 } };
+        
+        return UnitType::template proxiesFromInputs<FreezeInternal> (inputs, 
+                                                                     data, 
+                                                                     input.getBlockSize (0), 
+                                                                     input.getSampleRate (0));
+    }
+    
+    /** Get the freeze channel that owns a unit created with ar(). */
+    static FreezeInternal* getInternal (UnitType const& unit) throw()
+    {
+        plonk_assert (unit.getNumChannels() > 0);
+        return static_cast<FreezeInternal*> (unit.atUnchecked (0).getInternal());
+    }
+};
+
+typedef FreezeUnit<PLONK_TYPE_DEFAULT> Freeze;
+
+#endif // PLONK_FREEZECHANNEL_H
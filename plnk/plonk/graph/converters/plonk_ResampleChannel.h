@@ -59,7 +59,7 @@ public:
     typedef InputDictionary                                         Inputs;
     typedef NumericalArray<SampleType>                              Buffer;
     typedef ObjectArray<Buffer>                                     BufferArray;
-    typedef typename TypeUtility<SampleType>::IndexType             IndexType;
+    typedef double                                                  IndexType; // the read position accumulates the increment so needs more precision than float
     
     typedef typename TypeUtility<SampleType>::IndexType             RateType;
     typedef UnitBase<RateType>                                      RateUnitType;
@@ -68,6 +68,7 @@ public:
     typedef InterpSelect<SampleType,IndexType,InterpTypeCode>       InterpSelectType;
     typedef typename InterpSelectType::InterpType                   InterpType;
     typedef typename InterpType::ExtensionBuffer                    ExtensionBuffer;
+    typedef InterpKernel<SampleType,IndexType,InterpTypeCode>       InterpKernelType;
     
     ResampleChannelInternal (Inputs const& inputs,
                              Data const& data,
@@ -113,9 +114,6 @@ public:
             tempBufferPos = tempBufferPosMax;
         }
         
-#warning todo
-        plonk_assertfalse; // !!! MUST CHECK the InterpType::getExtension() change here!!!
-        
         tempBuffers.atUnchecked (channel).zero();
         tempBuffers.atUnchecked (channel).put (tempBufferPos, sourceValue);
 
@@ -210,7 +208,7 @@ public:
                     for (int channel = 0; channel < numChannels; ++channel)
                     {
                         SampleType* tempBufferSamples = this->tempBuffers.atUnchecked (channel).getArray();
-                        const SampleType dcOutput = InterpType::lookup (tempBufferSamples, tempBufferPos);
+                        const SampleType dcOutput = kernel.lookup (tempBufferSamples, tempBufferPos);
                         SampleType* const outputSamples = this->getOutputSamples (channel);
                         NumericalArrayFiller<SampleType>::fill (outputSamples, dcOutput, outputBufferLength);
                     }
@@ -218,6 +216,9 @@ public:
                 else
                 {
                     int outputSamplePosition = 0;
+                    
+                    // the rate is fixed for the block so the kernel renders runs of samples at once
+                    kernel.setIncrement (tempBufferIncrement);
 
                     while (outputSamplePosition < outputBufferLength)
                     {                        
@@ -229,19 +230,15 @@ public:
                         
                         for (int channel = 0; channel < numChannels; ++channel)
                         {
-                            channelSamplePosition = outputSamplePosition;
                             channelBufferPos = tempBufferPos;
                             
                             const SampleType* const tempBufferSamples = tempBuffers.atUnchecked (channel).getArray();
                             SampleType* const outputSamples = this->getOutputSamples (channel);
 
-                            for (channelSamplePosition = outputSamplePosition;
-                                 (channelSamplePosition < outputBufferLength) && (channelBufferPos < tempBufferPosMax);
-                                 ++channelSamplePosition)
-                            {
-                                outputSamples[channelSamplePosition] = InterpType::lookup (tempBufferSamples, channelBufferPos);
-                                channelBufferPos += tempBufferIncrement;
-                            }
+                            channelSamplePosition = outputSamplePosition + kernel.render (outputSamples + outputSamplePosition,
+                                                                                          outputBufferLength - outputSamplePosition,
+                                                                                          tempBufferSamples, channelBufferPos,
+                                                                                          tempBufferIncrement, tempBufferPosMax);
                         }
                         
                         outputSamplePosition = channelSamplePosition;
@@ -274,8 +271,9 @@ public:
                              (channelSamplePosition < outputBufferLength) && (channelBufferPos < tempBufferPosMax);
                              ++channelSamplePosition)
                         {
-                            outputSamples[channelSamplePosition] = InterpType::lookup (tempBufferSamples, channelBufferPos);
                             const IndexType tempBufferIncrement (inputSampleRate * IndexType (data.sampleDuration) * rateSamples[channelSamplePosition]);
+                            kernel.setIncrement (tempBufferIncrement);
+                            outputSamples[channelSamplePosition] = kernel.lookup (tempBufferSamples, channelBufferPos);
                             channelBufferPos += tempBufferIncrement;
                         }
                     }
@@ -312,8 +310,9 @@ public:
                              (channelSamplePosition < outputBufferLength) && (channelBufferPos < tempBufferPosMax);
                              ++channelSamplePosition)
                         {
-                            outputSamples[channelSamplePosition] = InterpType::lookup (tempBufferSamples, channelBufferPos);
                             const IndexType tempBufferIncrement (inputSampleRate * IndexType (data.sampleDuration) * rateSamples[int (ratePositionArray[channel])]);
+                            kernel.setIncrement (tempBufferIncrement);
+                            outputSamples[channelSamplePosition] = kernel.lookup (tempBufferSamples, channelBufferPos);
                             channelBufferPos += tempBufferIncrement;
                             ratePositionArray[channel] += rateIncrement;
                         }
@@ -335,6 +334,7 @@ private:
     IndexType tempBufferUsableLength;
     TimeStamp nextInputTimeStamp;
     DoubleArray ratePositions;
+    InterpKernelType kernel;
 };
 
 
@@ -452,6 +452,7 @@ public:
 
 typedef ResampleUnit<PLONK_TYPE_DEFAULT,Interp::Linear>     ResampleLinear;
 typedef ResampleUnit<PLONK_TYPE_DEFAULT,Interp::Lagrange3>  ResampleLagrange3;
+typedef ResampleUnit<PLONK_TYPE_DEFAULT,Interp::Sinc>       ResampleSinc;
 
 
 #endif // PLONK_RESAMPLECHANNEL_H
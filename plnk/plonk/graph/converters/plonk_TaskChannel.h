@@ -161,16 +161,28 @@ public:
     
     //--------------------------------------------------------------------------
     
-    class InputTask :  public Threading::Thread, public Channel::Receiver
+    /** The job that fills the task buffers.
+     This runs on the shared TaskPool rather than its own thread. It is scheduled
+     each time the owner hands a consumed buffer back via push() so there is no 
+     polling. The pending count ensures only one instance of the job is queued or
+     running at a time, a running job keeps going until it has caught up with
+     all the buffers that were pushed while it was running. 
+     The buffers circulate between this job and the owner's process() through
+     a pair of single-producer/single-consumer ring queues sized to hold all 
+     of them so handing a buffer over never allocates. */
+    class InputTask :  public TaskJobInternal, public Channel::Receiver
     {
     public:
-        typedef LockFreeQueue<TaskBuffer> TaskBufferQueue;
+        typedef RingQueue<TaskBuffer> TaskBufferQueue;
         
         InputTask (InputTaskChannelInternal* o) throw()
-        :   Threading::Thread (Text ("InputTaskChannelInternal::Thread[" + Text (*(LongLong*)&o) + Text ("]"))),
-            weakOwner (ChannelType (static_cast<ChannelInternalType*> (o))),
-            event (Lock::MutexLock),
-            inputEnded (0)
+        :   weakOwner (ChannelType (static_cast<ChannelInternalType*> (o))),
+            activeBuffers (o->getState().numBuffers, TaskBufferQueue::SPSC),
+            freeBuffers (o->getState().numBuffers, TaskBufferQueue::SPSC),
+            inputEnded (0),
+            taskEnded (0),
+            pending (0),
+            buffersFilled (false)
         {
         }
         
@@ -180,17 +192,8 @@ public:
             currentTaskBuffer.getInternal()->messages.push (tm);
         }
         
-        void fillBuffers() throw()
+        void fillBuffers (InputTaskChannelInternal* owner) throw()
         {
-            ChannelType ownerChannel (weakOwner.fromWeak());
-            
-            plonk_assert (ownerChannel.isNotNull());
-            
-            InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
-            
-            Data& data = owner->getState();
-            setPriority (data.priority);
-            
             const int numBuffers = owner->getState().numBuffers;
             
             plonk_assert (numBuffers > 0);
@@ -199,16 +202,20 @@ public:
             const int bufferSize = owner->getNumChannels() * owner->getBlockSize().getValue();
             
             for (int i = 0; i < numBuffers; ++i)
-                activeBuffers.push (TaskBuffer (bufferSize));
+            {
+                const bool pushed = activeBuffers.push (TaskBuffer (bufferSize));
+                plonk_assert (pushed);
+#ifndef PLONK_DEBUG
+                (void)pushed;
+#endif
+            }
         }
         
-        ResultCode run() throw()
+        void run() throw()
         {
-            fillBuffers();
+            int handled = pending.getValue();
             
-            Threading::yield();
-                
-            while (! getShouldExit())
+            while (taskEnded.getValueUnchecked() == 0)
             {
                 ChannelType ownerChannel (weakOwner.fromWeak());
                 
@@ -216,84 +223,93 @@ public:
                     break;
                 
                 InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
-                ProcessInfo& info (owner->getProcessInfo());
-
-                UnitType& inputUnit (owner->getInputAsUnit (IOKey::Generic));
                 
-                if (inputUnit.shouldBeDeletedNow (info))
+                if (! buffersFilled)
                 {
-                    inputEnded.setValue (1);
-                    Threading::sleep (0.01);
-                    continue;
+                    fillBuffers (owner);
+                    buffersFilled = true;
                 }
                 
-                const int numChannels = owner->getNumChannels();
-                const int blockSize = owner->getBlockSize().getValue();
-                const int numFreeBuffers = freeBuffers.length();
+                if (! processFreeBuffers (owner))
+                    break;
+                
+                if (pending.compareAndSwap (handled, 0))
+                    return;
                 
-                plonk_assert (inputUnit.channelsHaveSameBlockSize());
+                handled = pending.getValue(); // more buffers came back while we were busy
+            }
+            
+            // leave the count non-zero so we're never rescheduled
+        }
+        
+        bool processFreeBuffers (InputTaskChannelInternal* owner) throw()
+        {
+            ProcessInfo& info (owner->getProcessInfo());
+            UnitType& inputUnit (owner->getInputAsUnit (IOKey::Generic));
+            
+            const int numChannels = owner->getNumChannels();
+            const int blockSize = owner->getBlockSize().getValue();
 
-                if (numFreeBuffers > 0)
-                {                                        
-                    currentTaskBuffer = freeBuffers.pop(); // nothing else pops so must be still available
-                    Buffer& buffer = currentTaskBuffer.getInternal()->buffer;
-                    buffer.setSize (blockSize * numChannels, false);
-                    
-                    SampleType* bufferSamples = buffer.getArray();
+            plonk_assert (inputUnit.channelsHaveSameBlockSize());
 
-                    for (int channel = 0; channel < numChannels; ++channel)
-                    {
-                        const Buffer& inputBuffer (inputUnit.process (info, channel));                    
-                        const SampleType* inputSamples = inputBuffer.getArray();
-                        const int inputBufferLength = inputBuffer.length();
-                                                
-                        if (buffer.length() == (numChannels * inputBufferLength))
-                        {
-                            NumericalArray<SampleType>::copyData (bufferSamples, inputSamples, inputBufferLength);
-                            bufferSamples += inputBufferLength;
-                        }
-                        else
-                        {
-                            // probably got deleted..?
-                            buffer.zero();
-                            break;
-                        }
-                    }
-                    
-                    activeBuffers.push (currentTaskBuffer);
+            while (freeBuffers.pop (currentTaskBuffer)) // nothing else pops so only this job takes buffers
+            {
+                if (inputUnit.shouldBeDeletedNow (info))
+                {
                     currentTaskBuffer = TaskBuffer::getNull();
-
-                    plonk_assert (inputUnit.channelsHaveSameSampleRate());
-                    info.offsetTimeStamp (owner->getSampleRate().getSampleDurationInTicks() * blockSize);
+                    inputEnded.setValue (1);
+                    return false;
                 }
+
+                Buffer& buffer = currentTaskBuffer.getInternal()->buffer;
+                buffer.setSize (blockSize * numChannels, false);
                 
-                if (numFreeBuffers == 1)
-                {
-                    event.wait (0.5);
-                }
-                else if (numFreeBuffers < (activeBuffers.length() * 2))
-                {
-                    Threading::sleep (owner->getBlockDurationInTicks() * TimeStamp::getReciprocalTicks());
-                }
-                else
+                SampleType* bufferSamples = buffer.getArray();
+
+                for (int channel = 0; channel < numChannels; ++channel)
                 {
-                    Threading::yield();
+                    const Buffer& inputBuffer (inputUnit.process (info, channel));                    
+                    const SampleType* inputSamples = inputBuffer.getArray();
+                    const int inputBufferLength = inputBuffer.length();
+                                            
+                    if (buffer.length() == (numChannels * inputBufferLength))
+                    {
+                        NumericalArray<SampleType>::copyData (bufferSamples, inputSamples, inputBufferLength);
+                        bufferSamples += inputBufferLength;
+                    }
+                    else
+                    {
+                        // probably got deleted..?
+                        buffer.zero();
+                        break;
+                    }
                 }
+                
+                const bool pushed = activeBuffers.push (currentTaskBuffer);
+                plonk_assert (pushed); // can't be full as there are only numBuffers in circulation
+#ifndef PLONK_DEBUG
+                (void)pushed;
+#endif
+                
+                currentTaskBuffer = TaskBuffer::getNull();
+
+                plonk_assert (inputUnit.channelsHaveSameSampleRate());
+                info.offsetTimeStamp (owner->getSampleRate().getSampleDurationInTicks() * blockSize);
             }
             
-            freeBuffers.clearAll();
-            activeBuffers.clearAll();
-            
-            delete this;
-            
-            return PlankResult_ThreadWasDeleted;
+            return true;
+        }
+        
+        /** Schedule the job on the pool unless it is already queued or running. */
+        PLONK_INLINE_LOW void signal() throw()
+        {
+            if (++pending == 1)
+                TaskPool::getDefault().schedule (TaskJob (this));
         }
                 
         void end() throw()
         {
-            Lock e = this->event; // take a shared copy of the event
-            setShouldExit();      // this might delete this object before the next line
-            e.signal();           // or this will proceed past the wait, or be harmless if the thread died already
+            taskEnded.setValue (1); // the job will be deleted when the pool releases it
         }
     
         PLONK_INLINE_LOW bool pop (TaskBuffer& buffer) throw()
@@ -304,8 +320,14 @@ public:
         PLONK_INLINE_LOW void push (TaskBuffer const& buffer) throw()
         {
             buffer.getInternal()->messages.clear();
-            freeBuffers.push (buffer);
-            event.signal();
+            
+            const bool pushed = freeBuffers.push (buffer);
+            plonk_assert (pushed);
+#ifndef PLONK_DEBUG
+            (void)pushed;
+#endif
+            
+            signal();
         }
         
         PLONK_INLINE_LOW bool inputHasEnded() const throw()
@@ -318,8 +340,10 @@ public:
         TaskBufferQueue activeBuffers;
         TaskBufferQueue freeBuffers;
         TaskBuffer currentTaskBuffer;
-        Lock event;
         AtomicInt inputEnded;
+        AtomicInt taskEnded;
+        AtomicInt pending;
+        bool buffersFilled;
     };
     
     //--------------------------------------------------------------------------
@@ -334,13 +358,15 @@ public:
                   channels),
         task (new InputTask (this))
     {
+        task->incrementRefCount(); // the pool holds its own references while the job is queued
+        
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         inputUnit.addReceiverToChannels (task);
         
         if (data.resampleInput)
             inputUnit = ResampleType::ar (inputUnit, 1, blockSize, sampleRate);
         
-        task->start();
+        task->signal(); // first run fills the initial buffers
     }
     
     ~InputTaskChannelInternal()
@@ -353,7 +379,8 @@ public:
     {
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         inputUnit.removeReceiverFromChannels (task);
-        task->end(); // will delete the task when its thread exits
+        task->end();
+        task->decrementRefCount(); // will delete the task once the pool has finished with it
         task = 0;
     }
             
@@ -451,6 +478,7 @@ private:
 /** Defer a unit's processing to a separate task, thread, process or core. 
   
  Can also be used to distribute proessing across threads, processors or cores.
+ The tasks run as jobs on a shared TaskPool which has one worker thread per core.
  Very important to use this to wrap units that access files etc
  (e.g., FilePlayUnit).
  
@@ -463,7 +491,7 @@ private:
  @par @par Inputs:
  - input: (input, multi) the input unit to defer to a separate task
  - numBuffers: (int) the number of buffers to queue, also affects latency
- - priority: (int) the priority of the task (0-100, 100 is highest)
+ - priority: (int) ignored, tasks now share the worker threads of TaskPool::getDefault()
  - preferredBlockSize: the preferred output block size 
  - preferredSampleRate: the preferred output sample rate
 
@@ -116,7 +116,9 @@ public:
         NumProcessBuffers = 6
     };
     
-    ConvolveHelper (const int maxFFTSizeToAllow) throw()
+    /** The partition arguments are not used by this helper. They are here so 
+     ConvolveChannelInternal can create either this or PartitionedConvolveHelper. */
+    ConvolveHelper (const int maxFFTSizeToAllow, const int /*partitionSize*/ = 0, const bool /*backgroundTail*/ = false) throw()
     :   maxFFTSize (maxFFTSizeToAllow),
         processBuffers (Buffer::withSize (maxFFTSize * NumProcessBuffers))
     {
@@ -310,6 +312,414 @@ private:
 
 //------------------------------------------------------------------------------
 
+/** Partitioned overlap-save convolution.
+ 
+ The IR is held as a series of segments. Each segment is an FFTBuffersBase of
+ equal sized partitions along with a frequency-domain delay line of the input 
+ spectra for that partition size. Each input frame needs one forward and one
+ inverse FFT per segment, every partition then only costs a complex
+ multiply-accumulate.
+ 
+ If the head partition size is the same as the IR's own partition size (half 
+ its FFT size) the IR's FFTBuffers are used as they are and the partitioning 
+ is uniform. Otherwise the first two partitions of the IR are split again into 
+ short partitions at the head which double in size up to the IR's partition 
+ size, the rest of the IR is then used as is for the tail. In both cases the 
+ latency is the head partition size.
+ 
+ Each segment after the first has a whole frame of its own partition size 
+ before its result is needed so these can be computed on the default TaskPool.
+ If a worker has not picked a segment up by then it is computed on the calling
+ thread instead. */
+template<class SampleType>
+class PartitionedConvolveHelper
+{
+public:
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef FFTEngineBase<SampleType>                               FFTEngineType;
+    typedef FFTBuffersBase<SampleType>                              FFTBuffersType;
+    
+    enum Constants
+    {
+        NumHeadPartitions = 4,
+        NumPartitionsPerSize = 2,
+        DefaultPartitionSize = 64
+    };
+    
+    PartitionedConvolveHelper (const int /*maxFFTSize*/, const int partitionSizeToUse, const bool backgroundTailToUse) throw()
+    :   preferredPartitionSize (partitionSizeToUse),
+        backgroundTail (backgroundTailToUse),
+        partitionSize (DefaultPartitionSize),
+        inputMask (0),
+        outputMask (0),
+        count (0)
+    {
+    }
+    
+    ~PartitionedConvolveHelper()
+    {
+        clearSegments();
+    }
+    
+    /** Get the latency in samples for the current IR. */
+    PLONK_INLINE_LOW int getLatency() const throw()
+    {
+        return partitionSize;
+    }
+    
+    void reset (FFTBuffersType const& irBuffers, const int channel) throw()
+    {
+        clearSegments();
+        
+        const int numDivisions = irBuffers.getNumDivisions();
+        const int numChannels = irBuffers.getNumChannels();
+        const int maxPartitionSize = (int) irBuffers.getFFTEngine().halfLength();
+        
+        // if we have no IR or the channel requested is out of range we just output zeros
+        if (numDivisions == 0 || channel >= numChannels || maxPartitionSize <= 0)
+        {
+            partitionSize = DefaultPartitionSize;
+        }
+        else
+        {
+            partitionSize = preferredPartitionSize > 0
+                          ? plonk::min (Bits::nextPowerOf2 (preferredPartitionSize), maxPartitionSize)
+                          : maxPartitionSize;
+            
+            if (partitionSize == maxPartitionSize)
+            {
+                segments.add (new Segment (irBuffers, channel, 0, 0, false));
+            }
+            else
+            {
+                addHeadSegments (irBuffers, channel, maxPartitionSize);
+                
+                if (numDivisions > 2)
+                    segments.add (new Segment (irBuffers, channel, 2, maxPartitionSize * 2, backgroundTail));
+            }
+        }
+        
+        const int largestSize = plonk::max (maxPartitionSize, partitionSize);
+        const int inputLength = Bits::nextPowerOf2 (largestSize * 2);
+        const int outputLength = Bits::nextPowerOf2 ((largestSize + partitionSize) * 2);
+        
+        if (inputBuffer.length() < inputLength)
+            inputBuffer = Buffer::withSize (inputLength);
+        
+        if (outputBuffer.length() < outputLength)
+            outputBuffer = Buffer::withSize (outputLength);
+        
+        zeroSamples (inputBuffer.getArray(), inputLength);
+        zeroSamples (outputBuffer.getArray(), outputLength);
+        
+        inputMask  = inputLength - 1;
+        outputMask = outputLength - 1;
+        count      = 0;
+    }
+    
+    template<class OutputFunctionType, class InputFunctionType>
+    void process (SampleType* outputSamples, const SampleType* inputSamples, const int outputBufferLength, const int /*channel*/) throw()
+    {
+        SampleType* const inputBufferSamples = inputBuffer.getArray();
+        SampleType* const outputBufferSamples = outputBuffer.getArray();
+        const UnsignedLong partitionMask = partitionSize - 1;
+        int samplesRemaining = outputBufferLength;
+        
+        while (samplesRemaining > 0)
+        {
+            const int hop = plonk::min (samplesRemaining, partitionSize - (int) (count & partitionMask));
+            SampleType* const inputPosition = inputBufferSamples + (count & inputMask);
+            SampleType* const outputPosition = outputBufferSamples + (count & outputMask);
+            
+            InputFunctionType::calc (inputPosition, inputSamples, hop);
+            OutputFunctionType::calc (outputSamples, outputPosition, hop);
+            zeroSamples (outputPosition, hop);
+            
+            inputSamples     += hop;
+            outputSamples    += hop;
+            samplesRemaining -= hop;
+            count            += hop;
+            
+            if ((count & partitionMask) == 0)
+                processFrames();
+        }
+    }
+    
+private:
+    class Segment;
+    
+    /** Runs a segment on a TaskPool worker. 
+     The state is claimed with a compare-and-swap so whichever of the worker or 
+     the audio thread gets there first does the work. The job outlives its 
+     segment if it is still queued when the segment is deleted, in that case 
+     the Finished state stops it touching the segment. */
+    class SegmentJob : public TaskJobInternal
+    {
+    public:
+        enum States { Idle, Queued, Running, Done, Finished };
+        
+        SegmentJob (Segment* segmentToUse) throw()
+        :   segment (segmentToUse),
+            state (Idle)
+        {
+        }
+        
+        void run() throw()
+        {
+            tryCompute();
+        }
+        
+        bool tryCompute() throw()
+        {
+            if (! state.compareAndSwap (Queued, Running))
+                return false;
+            
+            segment->compute();
+            state.setValue (Done);
+            return true;
+        }
+        
+        Segment* const segment;
+        AtomicInt state;
+    };
+    
+    class Segment
+    {
+    public:
+        Segment (FFTBuffersType const& irBuffersToUse,
+                 const int irChannelToUse,
+                 const int firstDivisionToUse,
+                 const int offsetToUse,
+                 const bool runInBackground) throw()
+        :   irBuffers (irBuffersToUse),
+            fftEngine (irBuffersToUse.getFFTEngine().length()), // our own engine as we may be on another thread
+            irChannel (irChannelToUse),
+            firstDivision (firstDivisionToUse),
+            numPartitions (irBuffersToUse.getNumDivisions() - firstDivisionToUse),
+            size ((int) irBuffersToUse.getFFTEngine().halfLength()),
+            offset (offsetToUse),
+            delayLinePosition (0),
+            buffers (Buffer::newClear (size * 2 * (numPartitions + 3))),
+            job (runInBackground ? new SegmentJob (this) : 0),
+            jobContainer (job)
+        {
+            SampleType* const buffersBase = buffers.getArray();
+            const int fftSize = size * 2;
+            
+            frameSamples     = buffersBase;
+            spectrumSamples  = buffersBase + fftSize;
+            resultSamples    = buffersBase + fftSize * 2;
+            delayLineSamples = buffersBase + fftSize * 3;
+        }
+        
+        ~Segment()
+        {
+            if (job != 0)
+            {
+                while (! (job->state.compareAndSwap (SegmentJob::Idle,   SegmentJob::Finished) ||
+                          job->state.compareAndSwap (SegmentJob::Queued, SegmentJob::Finished) ||
+                          job->state.compareAndSwap (SegmentJob::Done,   SegmentJob::Finished)))
+                    Threading::yield();
+            }
+        }
+        
+        /** Copy the most recent frame (twice the partition size) from the input history. */
+        void captureFrame (const SampleType* const inputBufferSamples, const UnsignedLong inputMask, const UnsignedLong count) throw()
+        {
+            const int fftSize = size * 2;
+            const int start = (int) ((count - fftSize) & inputMask);
+            const int length1 = plonk::min (fftSize, (int) inputMask + 1 - start);
+            
+            moveSamples (frameSamples, inputBufferSamples + start, length1);
+            moveSamples (frameSamples + length1, inputBufferSamples, fftSize - length1);
+        }
+        
+        /** Transform the frame into the delay line and sum the partitions. */
+        void compute() throw()
+        {
+            const int fftSize = size * 2;
+            SampleType* const delayLineInput = delayLineSamples + delayLinePosition * fftSize;
+            const SampleType* irSamples = irBuffers.getDivision (irChannel, firstDivision);
+            int position = delayLinePosition;
+            
+            fftEngine.forward (delayLineInput, frameSamples);
+            complexMultiply (spectrumSamples, delayLineInput, irSamples, size);
+            
+            for (int i = 1; i < numPartitions; ++i)
+            {
+                position   = (position == 0 ? numPartitions : position) - 1;
+                irSamples += fftSize;
+                complexMultiplyAccumulate (spectrumSamples, delayLineSamples + position * fftSize, irSamples, size);
+            }
+            
+            fftEngine.inverse (resultSamples, spectrumSamples);
+            
+            if (++delayLinePosition == numPartitions)
+                delayLinePosition = 0;
+        }
+        
+        /** Add the valid half of the last result to the output for the frame ending at frameEnd. */
+        void addResult (SampleType* const outputBufferSamples, const UnsignedLong outputMask,
+                        const UnsignedLong frameEnd, const int latency) throw()
+        {
+            const int start = (int) ((frameEnd - size + offset + latency) & outputMask);
+            const int length1 = plonk::min (size, (int) outputMask + 1 - start);
+            
+            accumulateSamples (outputBufferSamples + start, resultSamples + size, length1);
+            accumulateSamples (outputBufferSamples, resultSamples + size + length1, size - length1);
+        }
+        
+        bool isPending() const throw()
+        {
+            return job->state.getValueUnchecked() != SegmentJob::Idle;
+        }
+        
+        void schedule() throw()
+        {
+            job->state.setValue (SegmentJob::Queued);
+            TaskPool::getDefault().schedule (jobContainer);
+        }
+        
+        /** Collect the result of the last frame, computing it here if no worker has started it.
+         This spins on the audio thread while a worker is part way through the
+         segment. The wait is bounded by the one compute already running as 
+         the audio thread claims any job still Queued and does it itself, so 
+         a worker that never picks the job up can't stall the audio. */
+        void waitUntilDone() throw()
+        {
+            if (! job->tryCompute())
+            {
+                plonk_assert ((job->state.getValue() == SegmentJob::Running) || 
+                              (job->state.getValue() == SegmentJob::Done));
+                
+                while (job->state.getValue() != SegmentJob::Done)
+                    Threading::yield();
+            }
+            
+            job->state.setValue (SegmentJob::Idle);
+        }
+        
+        FFTBuffersType irBuffers;
+        FFTEngineType fftEngine;
+        const int irChannel;
+        const int firstDivision;
+        const int numPartitions;
+        const int size;
+        const int offset;
+        int delayLinePosition;
+        
+        Buffer buffers;
+        SampleType* frameSamples;
+        SampleType* spectrumSamples;
+        SampleType* resultSamples;
+        SampleType* delayLineSamples;
+        
+        SegmentJob* const job;
+        TaskJob jobContainer;
+        
+    private:
+        Segment (Segment const&);
+        Segment& operator= (Segment const&);
+    };
+    
+    /** Recover the first two partitions of the IR and split them into 
+     NumHeadPartitions of the head size followed by NumPartitionsPerSize of 
+     each doubling size up to half the IR's partition size. Each segment then 
+     starts at twice its partition size which gives the later segments their 
+     whole frame to complete. */
+    void addHeadSegments (FFTBuffersType const& irBuffers, const int channel, const int maxPartitionSize) throw()
+    {
+        const int headLength = maxPartitionSize * 2;
+        const int headEnd = plonk::min (headLength, irBuffers.getOriginalLength());
+        const int numHeadDivisions = plonk::min (2, irBuffers.getNumDivisions());
+        
+        FFTEngineType fftEngine (headLength);
+        Buffer headBuffer (Buffer::newClear (headLength));
+        Buffer tempBuffer (Buffer::withSize (headLength));
+        
+        for (int division = 0; division < numHeadDivisions; ++division)
+        {
+            fftEngine.inverse (tempBuffer.getArray(), irBuffers.getDivision (channel, division));
+            moveSamples (headBuffer.getArray() + division * maxPartitionSize, tempBuffer.getArray(), maxPartitionSize);
+        }
+        
+        int size = partitionSize;
+        int numPartitions = NumHeadPartitions;
+        int offset = 0;
+        
+        while (offset < headEnd)
+        {
+            const int length = plonk::min (size * numPartitions, headEnd - offset);
+            Buffer segmentBuffer (Buffer::withSize (length));
+            moveSamples (segmentBuffer.getArray(), headBuffer.getArray() + offset, length);
+            
+            segments.add (new Segment (FFTBuffersType (FFTEngineType (size * 2), segmentBuffer),
+                                       0, 0, offset, backgroundTail && (offset > 0)));
+            
+            offset       += size * numPartitions;
+            size         *= 2;
+            numPartitions = NumPartitionsPerSize;
+        }
+    }
+    
+    /** Called at the end of each head partition. 
+     Background segments collect the result of their previous frame before 
+     starting on the next. */
+    void processFrames() throw()
+    {
+        SampleType* const inputBufferSamples = inputBuffer.getArray();
+        SampleType* const outputBufferSamples = outputBuffer.getArray();
+        
+        for (int i = 0; i < segments.length(); ++i)
+        {
+            Segment& segment = *segments.atUnchecked (i);
+            
+            if ((count & (segment.size - 1)) != 0)
+                continue;
+            
+            if (segment.job != 0)
+            {
+                if (segment.isPending())
+                {
+                    segment.waitUntilDone();
+                    segment.addResult (outputBufferSamples, outputMask, count - segment.size, partitionSize);
+                }
+                
+                segment.captureFrame (inputBufferSamples, inputMask, count);
+                segment.schedule();
+            }
+            else
+            {
+                segment.captureFrame (inputBufferSamples, inputMask, count);
+                segment.compute();
+                segment.addResult (outputBufferSamples, outputMask, count, partitionSize);
+            }
+        }
+    }
+    
+    void clearSegments() throw()
+    {
+        for (int i = 0; i < segments.length(); ++i)
+            delete segments.atUnchecked (i);
+        
+        segments.clear();
+    }
+    
+    const int preferredPartitionSize;
+    const bool backgroundTail;
+    int partitionSize;
+    
+    Buffer inputBuffer;
+    Buffer outputBuffer;
+    UnsignedLong inputMask;
+    UnsignedLong outputMask;
+    UnsignedLong count;
+    
+    ObjectArray<Segment*> segments;
+};
+
+//------------------------------------------------------------------------------
+
 struct ConvolveChannelData
 {
     ChannelInternalCore::Data base;
@@ -317,19 +727,27 @@ struct ConvolveChannelData
     int maxFFTSize;
     int fadeSamples;
     bool keepPreviousTail;
+    int partitionSize;
+    bool backgroundTail;
+    bool deferPrepare;
 };
 
 //------------------------------------------------------------------------------
 
-/** Convolve channel. */
-template<class SampleType>
+/** Convolve channel. 
+ HelperType does the convolution for each channel, either ConvolveHelper or 
+ PartitionedConvolveHelper. When the IR changes the current helpers are reset
+ with it straight away on the audio thread. With deferPrepare the new helpers 
+ are instead built and reset on the I/O TaskPool, the old IR carries on until 
+ they are ready to be swapped in so the audio thread doesn't allocate. */
+template<class SampleType, class HelperType>
 class ConvolveChannelInternal : public ProxyOwnerChannelInternal<SampleType, ConvolveChannelData>
 {
 public:
     typedef ConvolveChannelData                                     Data;
     typedef ChannelBase<SampleType>                                 ChannelType;
     typedef ObjectArray<ChannelType>                                ChannelArrayType;
-    typedef ConvolveChannelInternal<SampleType>                     ConvolveInternal;
+    typedef ConvolveChannelInternal<SampleType,HelperType>          ConvolveInternal;
     typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
     typedef ChannelInternalBase<SampleType>                         InternalBase;
     typedef UnitBase<SampleType>                                    UnitType;
@@ -338,7 +756,7 @@ public:
     typedef FFTEngineBase<SampleType>                               FFTEngineType;
     typedef FFTBuffersBase<SampleType>                              FFTBuffersType;
     typedef Variable<FFTBuffersType&>                               FFTBuffersVariableType;
-    typedef ConvolveHelper<SampleType>                              ConvolveHelperType;
+    typedef HelperType                                              ConvolveHelperType;
     
     ConvolveChannelInternal (Inputs const& inputs,
                              Data const& data,
@@ -350,12 +768,19 @@ public:
         thisSync (0),
         fadePreviousInputSamplesRemaining (0),
         fadePreviousOutputSamplesRemaining (0),
-        holdPreviousOutputSamplesRemaining (0)
+        holdPreviousOutputSamplesRemaining (0),
+        prepareJob (new PrepareJob (this)),
+        prepareJobContainer (prepareJob)
     {
     }
     
     ~ConvolveChannelInternal()
     {
+        while (! (prepareJob->state.compareAndSwap (PrepareJob::Idle,   PrepareJob::Finished) ||
+                  prepareJob->state.compareAndSwap (PrepareJob::Queued, PrepareJob::Finished) ||
+                  prepareJob->state.compareAndSwap (PrepareJob::Done,   PrepareJob::Finished)))
+            Threading::yield();
+        
         for (int i = 0; i < convolveHelpers.length(); ++i)
             delete convolveHelpers.atUnchecked (i);
     }
@@ -387,11 +812,12 @@ public:
 
             const Data& data = this->getState();
             const int fftSize = data.maxFFTSize <= 0 ? (int) irBuffers.getFFTEngine().length() : data.maxFFTSize;
+            const int partitionSize = data.partitionSize <= 0 ? this->getBlockSize().getValue() : data.partitionSize;
             
             for (int i = 0; i < numChannels; ++i)
             {
-                ConvolverPair* convolvePair = new ConvolverPair (fftSize);
-                convolvePair->currentConvolver->reset (irBuffers, channel);
+                ConvolverPair* convolvePair = new ConvolverPair (fftSize, partitionSize, data.backgroundTail);
+                convolvePair->currentConvolver->reset (irBuffers, i);
                 convolveHelpers.add (convolvePair);
             }
             
@@ -520,7 +946,7 @@ public:
                     fadePreviousOutputSamplesRemaining -= numSamplesThisTime;
                 }
             }
-            else if (currentIRBuffers == newIRBuffers)
+            else if ((currentIRBuffers == newIRBuffers) || (data.deferPrepare && ! swapPreparedConvolvers (newIRBuffers)))
             {
                 numSamplesThisTime = numSamplesRemaining;
                 
@@ -537,16 +963,17 @@ public:
             }
             else
             {
-                for (int channel = 0; channel < numChannels; ++channel)
-                {
-                    ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
-                    convolvePair.currentConvolver.swapWith (convolvePair.previousConvolver);
-                }
+                // the old current convolvers are now previous and the current ones have the new IR
+                if (! data.deferPrepare)
+                    resetConvolvers (newIRBuffers);
+                
+                // when deferred this may not be the latest IR if it changed again while preparing
+                const FFTBuffersType& swappedIRBuffers = data.deferPrepare ? preparedIRBuffers : newIRBuffers;
                 
                 fadePreviousInputSamplesRemaining  = data.fadeSamples;
                 holdPreviousOutputSamplesRemaining = data.keepPreviousTail
                                                    ? (int) currentIRBuffers.getNumDivisions() * (int) currentIRBuffers.getFFTEngine().halfLength()
-                                                   : (int) newIRBuffers.getFFTEngine().halfLength(); // minimum to avoid a gap due to latency
+                                                   : (int) swappedIRBuffers.getFFTEngine().halfLength(); // minimum to avoid a gap due to latency
                 fadePreviousOutputSamplesRemaining = data.fadeSamples;
                 
                 if (fadePreviousInputSamplesRemaining > 0)
@@ -555,13 +982,7 @@ public:
                     slope = level / fadePreviousInputSamplesRemaining;
                 }
                 
-                currentIRBuffers = newIRBuffers;
-                
-                for (int channel = 0; channel < numChannels; ++channel)
-                {
-                    ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
-                    convolvePair.currentConvolver->reset (newIRBuffers, channel);
-                }
+                currentIRBuffers = swappedIRBuffers;
                 
                 //... and back round again...
             }
@@ -572,6 +993,84 @@ public:
     }
 
 private:
+    /** Builds the convolvers for a new IR on the I/O TaskPool. 
+     This is kept off the default pool so a long IR doesn't hold up the
+     partitioned convolvers' own jobs. The job outlives the channel if it is 
+     still queued when the channel is deleted, in that case the Finished state
+     stops it touching the channel. */
+    class PrepareJob : public TaskJobInternal
+    {
+    public:
+        enum States { Idle, Queued, Running, Done, Finished };
+        
+        PrepareJob (ConvolveInternal* ownerToUse) throw()
+        :   owner (ownerToUse),
+            state (Idle)
+        {
+        }
+        
+        void run() throw()
+        {
+            if (! state.compareAndSwap (Queued, Running))
+                return;
+            
+            owner->prepareConvolvers();
+            state.setValue (Done);
+        }
+        
+        ConvolveInternal* const owner;
+        AtomicInt state;
+    };
+    
+    /** I/O side, resets a new convolver for each channel with preparedIRBuffers.
+     This also deletes the convolvers retired by the last swap. */
+    void prepareConvolvers() throw()
+    {
+        for (int channel = 0; channel < convolveHelpers.length(); ++channel)
+            convolveHelpers.atUnchecked (channel)->prepare (preparedIRBuffers, channel);
+    }
+    
+    /** Audio side, the immediate path: the current convolvers become previous 
+     and the old previous ones are reset with the new IR. */
+    void resetConvolvers (FFTBuffersType const& newIRBuffers) throw()
+    {
+        for (int channel = 0; channel < convolveHelpers.length(); ++channel)
+        {
+            ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
+            convolvePair.currentConvolver.swapWith (convolvePair.previousConvolver);
+            convolvePair.currentConvolver->reset (newIRBuffers, channel);
+        }
+    }
+    
+    /** Audio side, with deferPrepare starts preparing convolvers for a new IR or 
+     swaps them in if they are ready. 
+     @return @c true if they were swapped in. */
+    bool swapPreparedConvolvers (FFTBuffersType const& newIRBuffers) throw()
+    {
+        const int state = prepareJob->state.getValue();
+        
+        if (state == PrepareJob::Idle)
+        {
+            preparedIRBuffers = newIRBuffers;
+            prepareJob->state.setValue (PrepareJob::Queued);
+            TaskPool::getIO().schedule (prepareJobContainer);
+        }
+        else if (state == PrepareJob::Done)
+        {
+            for (int channel = 0; channel < convolveHelpers.length(); ++channel)
+            {
+                ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
+                convolvePair.previousConvolver.swapWith (convolvePair.preparedConvolver);
+                convolvePair.currentConvolver.swapWith (convolvePair.previousConvolver);
+            }
+            
+            prepareJob->state.setValue (PrepareJob::Idle);
+            return true;
+        }
+        
+        return false;
+    }
+    
     PLONK_INLINE_HIGH static int decideNumChannels (Inputs const& inputs, Data const& data) throw()
     {
         return data.numChannels > 0
@@ -615,19 +1114,39 @@ private:
     SampleType level;
     SampleType slope;
     
+    /** The prepared convolver is built for the next IR, after a swap it holds 
+     the retired previous one until the next IR is prepared. */
     struct ConvolverPair
     {
-        ConvolverPair (const int maxFFTSize) throw()
-        :   currentConvolver (new ConvolveHelperType (maxFFTSize)),
-            previousConvolver (new ConvolveHelperType (maxFFTSize))
+        ConvolverPair (const int maxFFTSizeToUse, const int partitionSizeToUse, const bool backgroundTailToUse) throw()
+        :   maxFFTSize (maxFFTSizeToUse),
+            partitionSize (partitionSizeToUse),
+            backgroundTail (backgroundTailToUse),
+            currentConvolver (new ConvolveHelperType (maxFFTSize, partitionSize, backgroundTail)),
+            previousConvolver (new ConvolveHelperType (maxFFTSize, partitionSize, backgroundTail))
+        {
+        }
+        
+        void prepare (FFTBuffersType const& irBuffers, const int channel) throw()
         {
+            preparedConvolver = new ConvolveHelperType (maxFFTSize, partitionSize, backgroundTail);
+            preparedConvolver->reset (irBuffers, channel);
         }
         
+        const int maxFFTSize;
+        const int partitionSize;
+        const bool backgroundTail;
+        
         ScopedPointerContainer<ConvolveHelperType> currentConvolver;
         ScopedPointerContainer<ConvolveHelperType> previousConvolver;
+        ScopedPointerContainer<ConvolveHelperType> preparedConvolver;
     };
     
     ObjectArray<ConvolverPair*> convolveHelpers;
+    
+    FFTBuffersType preparedIRBuffers;
+    PrepareJob* const prepareJob;
+    TaskJob prepareJobContainer;
 };
 
 
@@ -636,14 +1155,20 @@ private:
 
 /** Convolve Unit.
  
- Latency is half the FFT size.
+ Latency is half the FFT size for ar(). For arPartitioned() latency is the 
+ head partition size, by default this is the block size.
  
  @par Factory functions:
  - ar (input, fftBuffers)
+ - arPartitioned (input, fftBuffers)
  
  @par Inputs:
  - input: (unit, multi) the unit to convolve
  - fftBuffers: (fft-buffers) the impulse response
+ - partitionSize: (int) the head partition size for arPartitioned(), 0 uses the block size
+ - backgroundTail: (bool) compute the larger partitions on the default TaskPool
+ - deferPrepare: (bool) when the IR changes build the new convolvers on the I/O TaskPool 
+   and keep the old IR until they are ready, rather than resetting them on the audio thread
 
  
  @ingroup FFTUnits */
@@ -652,6 +1177,8 @@ class ConvolveUnit
 {
 public:
     typedef ConvolveChannelInternal<SampleType>                     ConvolveInternal;
+    typedef PartitionedConvolveHelper<SampleType>                   PartitionedHelperType;
+    typedef ConvolveChannelInternal<SampleType,PartitionedHelperType> PartitionedConvolveInternal;
     typedef typename ConvolveInternal::Data                         Data;
     typedef UnitBase<SampleType>                                    UnitType;
     typedef InputDictionary                                         Inputs;
@@ -679,7 +1206,8 @@ public:
                                          const int numChannels = 0,
                                          const int maxFFTSize = 0,
                                          const int fadeSamples = 64,
-                                         IntVariable const& sync = IntVariable()) throw()
+                                         IntVariable const& sync = IntVariable(),
+                                         const bool deferPrepare = false) throw()
     {
         plonk_assert ((fadeSamples % 4) == 0);
         plonk_assert ((maxFFTSize % 4) == 0);
@@ -689,13 +1217,44 @@ public:
         inputs.put (IOKey::FFTBuffers, fftBuffers);
         inputs.put (IOKey::Sync, sync);
         
-        Data data = { { -1.0, -1.0 }, numChannels, maxFFTSize, fadeSamples, keepPreviousTail };
+        Data data = { { -1.0, -1.0 }, numChannels, maxFFTSize, fadeSamples, keepPreviousTail, 0, false, deferPrepare };
         
         return UnitType::template proxiesFromInputs<ConvolveInternal> (inputs,
                                                                        data,
                                                                        BlockSize::noPreference(),
                                                                        SampleRate::noPreference());
     }
+    
+    /** Partitioned overlap-save convolution.
+     If partitionSize is less than half the FFT size of fftBuffers the IR is 
+     partitioned non-uniformly: partitionSize at the head growing to half the
+     FFT size for the tail. Otherwise the partitions are uniform, half the FFT 
+     size. Latency is the smaller of these. */
+    static PLONK_INLINE_LOW UnitType arPartitioned (UnitType const& input,
+                                                    FFTBuffersVariableType const& fftBuffers,
+                                                    const int partitionSize = 0,
+                                                    const bool backgroundTail = true,
+                                                    const bool keepPreviousTail = false,
+                                                    const int numChannels = 0,
+                                                    const int fadeSamples = 64,
+                                                    IntVariable const& sync = IntVariable(),
+                                                    const bool deferPrepare = false) throw()
+    {
+        plonk_assert ((fadeSamples % 4) == 0);
+        plonk_assert (partitionSize >= 0);
+        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::FFTBuffers, fftBuffers);
+        inputs.put (IOKey::Sync, sync);
+        
+        Data data = { { -1.0, -1.0 }, numChannels, 0, fadeSamples, keepPreviousTail, partitionSize, backgroundTail, deferPrepare };
+        
+        return UnitType::template proxiesFromInputs<PartitionedConvolveInternal> (inputs,
+                                                                                  data,
+                                                                                  BlockSize::noPreference(),
+                                                                                  SampleRate::noPreference());
+    }
 };
 
 
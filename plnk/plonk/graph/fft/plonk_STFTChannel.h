@@ -0,0 +1,196 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_STFTCHANNEL_H
+#define PLONK_STFTCHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+
+/** STFT analysis/resynthesis channel. */
+template<class SampleType>
+class STFTChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, ChannelInternalCore::Data>
+{
+public:
+    typedef ChannelInternalCore::Data                               Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ObjectArray<ChannelType>                                ChannelArrayType;
+    typedef STFTChannelInternal<SampleType>                         STFTInternal;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
+    typedef ChannelInternalBase<SampleType>                         InternalBase;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef NumericalArray<SampleType*>                             BufferArray;
+    typedef NumericalArray<const SampleType*>                       ConstBufferArray;
+    typedef STFTEngineBase<SampleType>                              STFTEngineType;
+
+    STFTChannelInternal (Inputs const& inputs,
+                         Data const& data, 
+                         BlockSize const& blockSize,
+                         SampleRate const& sampleRate,
+                         ChannelArrayType& channels) throw()
+    :   Internal (inputs.getMaxNumChannels(), inputs, data, blockSize, sampleRate, channels),
+        inputArrays (ConstBufferArray::withSize (inputs.getMaxNumChannels())),
+        outputArrays (BufferArray::withSize (inputs.getMaxNumChannels()))
+    {
+    }
+    
+    Text getName() const throw()
+    {
+        return "STFT";
+    }        
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::STFTEngine);
+        return keys;
+    }
+    
+    void initChannel (const int channel) throw()
+    {
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            const UnitType& input = this->getInputAsUnit (IOKey::Generic);
+
+            // all need to be the same input BS and SR
+            this->setBlockSize (input.getBlockSize (0));
+            this->setSampleRate (input.getSampleRate (0));
+            
+            this->getInputAsSTFTEngine (IOKey::STFTEngine).setNumChannels (this->getNumChannels());
+        }
+                
+        this->initProxyValue (channel, SampleType (0)); // the output is delayed by the FFT size
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {                
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        STFTEngineType& engine (this->getInputAsSTFTEngine (IOKey::STFTEngine));
+        
+        const int numChannels = this->getNumChannels();
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        
+        plonk_assert (engine.getNumChannels() == numChannels);
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const Buffer& inputBuffer (inputUnit.process (info, channel));
+            
+            plonk_assert (inputBuffer.length() == outputBufferLength);
+            
+            inputArrays.put (channel, inputBuffer.getArray());
+            outputArrays.put (channel, this->getOutputSamples (channel));
+        }
+        
+        engine.process (outputArrays.getArray(), inputArrays.getArray(), outputBufferLength);
+    }
+    
+private:
+    ConstBufferArray inputArrays;
+    BufferArray outputArrays;
+};
+
+//------------------------------------------------------------------------------
+
+/** Analyse and resynthesise a multichannel signal with an STFTEngine.
+ All the input channels are processed together by the engine which calls its
+ spectral function (if any) with the spectra of all the channels for each frame.
+ This replaces a chain of OverlapMake, FFT, spectral processing, IFFT and 
+ OverlapMix units. The output is delayed by the FFT size of the engine.
+ 
+ Each STFT unit needs its own engine as the engine holds the state of the 
+ analysis and resynthesis. Only float and double are supported.
+ 
+ @par Factory functions:
+ - ar (input, engine)
+ 
+ @par Inputs:
+ - input: (unit, multi) the unit to process
+ - engine: (stftengine) the engine to use, this is set to the number of channels in the input
+ 
+ @ingroup ConverterUnits FFTUnits */
+template<class SampleType>
+class STFTUnit
+{
+public:    
+    typedef STFTChannelInternal<SampleType>             STFTInternal;
+    typedef typename STFTInternal::Data                 Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;    
+    typedef STFTEngineBase<SampleType>                  STFTEngineType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {        
+        return UnitInfo ("STFT", "Analyses and resynthesises a signal using a short-time Fourier transform.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,         Measure::None,      IOInfo::NoDefault,   IOLimit::None,      IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,         Measure::None,
+                         IOKey::STFTEngine,      Measure::None,
+                         IOKey::End);
+    }    
+    
+    /** Process a signal through an STFT engine. */
+    static UnitType ar (UnitType const& input, 
+                        STFTEngineType const& engine) throw()
+    {                        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::STFTEngine, engine);
+        
+        Data data = { -1.0, -1.0 };
+        
+        return UnitType::template proxiesFromInputs<STFTInternal> (inputs,
+                                                                   data,
+                                                                   BlockSize::noPreference(),
+                                                                   SampleRate::noPreference());
+    }
+};
+
+typedef STFTUnit<PLONK_TYPE_DEFAULT> STFT;
+
+
+#endif // PLONK_STFTCHANNEL_H
@@ -130,6 +130,197 @@ private:
 
 //------------------------------------------------------------------------------
 
+/** A bank of identical-form FIR/IIR filters processed in lockstep.
+ This is used by FilterUnit in place of one FilterChannelInternal per channel
+ where a multichannel filter has all its inputs running at the same rate. The 
+ filter states are stored structure-of-arrays in groups of Lanes channels and 
+ each sample is computed for a whole group at once using the form's 
+ processLanes() function. */
+template<class FormType>
+class FilterBankChannelInternal 
+:   public ProxyOwnerChannelInternal<typename FormType::SampleDataType, 
+                                     typename FormType::Data>
+{
+public:
+    typedef typename FormType::SampleDataType                       SampleType;
+    typedef typename FormType::Data                                 Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ObjectArray<ChannelType>                                ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray<SampleType>                              Buffer;
+    
+    enum Constants
+    {
+        Lanes = 32 / sizeof (SampleType), // one 256-bit vector
+        NumCoeffs = FormType::NumCoeffs,
+        NumStates = FormType::NumStates
+    };
+    
+    FilterBankChannelInternal (Inputs const& inputs, 
+                               Data const& data, 
+                               BlockSize const& blockSize,
+                               SampleRate const& sampleRate,
+                               ChannelArrayType& channels) throw()
+    :   Internal (getNumChannelsFromInputs (inputs), inputs, data, blockSize, sampleRate, channels)
+    {
+        const int numGroups = (this->getNumChannels() + Lanes - 1) / Lanes;
+        states = Buffer::newClear (numGroups * NumStates * Lanes);
+    }
+    
+    static int getNumChannelsFromInputs (Inputs const& inputs) throw()
+    {
+        const UnitType& input = inputs[IOKey::Generic].asUnchecked<UnitType>();
+        const UnitType& coeffs = inputs[IOKey::Coeffs].asUnchecked<UnitType>();
+        return plonk::max (input.getNumChannels(), coeffs.getNumChannels() / NumCoeffs);
+    }
+    
+    Text getName() const throw()
+    {
+        return "Filter Bank (" + FormType::getName() + ")";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Coeffs);
+        return keys;
+    }    
+    
+    void initChannel (const int channel) throw()
+    {        
+        const UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (inputUnit.getBlockSize (0),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (inputUnit.getSampleRate (0),
+                                                     this->getSampleRate()));
+            
+            this->setOverlap (inputUnit.getOverlap (0));
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }    
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        UnitType& coeffsUnit (this->getInputAsUnit (IOKey::Coeffs));
+        
+        const int numChannels = this->getNumChannels();
+        const int outputLength = this->getOutputBuffer (0).length();
+        
+        if (laneInputs.length() != (outputLength * Lanes))
+        {
+            laneInputs = Buffer::newClear (outputLength * Lanes);
+            laneOutputs = Buffer::newClear (outputLength * Lanes);
+            laneCoeffs = Buffer::newClear (outputLength * NumCoeffs * Lanes);
+        }
+        
+        SampleType* const inputs = laneInputs.getArray();
+        SampleType* const outputs = laneOutputs.getArray();
+        SampleType* const coeffs = laneCoeffs.getArray();
+        
+        int i, lane, k;
+        
+        for (int firstChannel = 0; firstChannel < numChannels; firstChannel += Lanes)
+        {
+            const int numLanes = plonk::min (int (Lanes), numChannels - firstChannel);
+            
+            for (lane = 0; lane < numLanes; ++lane)
+            {
+                const int channel = firstChannel + lane;
+                const Buffer& inputBuffer (inputUnit.process (info, channel));
+                const bool inputMatches = inputBuffer.length() == outputLength;
+                
+                gather (inputs + lane, Lanes, inputBuffer, outputLength);
+                
+                for (k = 0; k < NumCoeffs; ++k)
+                {
+                    const Buffer& coeffBuffer (coeffsUnit.process (info, channel * NumCoeffs + k));
+                    gather (coeffs + k * Lanes + lane, NumCoeffs * Lanes, coeffBuffer, outputLength, inputMatches);
+                }
+            }
+            
+            for (lane = numLanes; lane < Lanes; ++lane)
+            {
+                for (i = 0; i < outputLength; ++i)
+                    inputs[i * Lanes + lane] = SampleType (0);
+                
+                for (i = 0; i < outputLength * NumCoeffs; ++i)
+                    coeffs[i * Lanes + lane] = SampleType (0);
+            }
+            
+            SampleType* const groupStates = states.getArray() + (firstChannel / Lanes) * NumStates * Lanes;
+            
+            for (i = 0; i < outputLength; ++i)
+                FormType::template processLanes<Lanes> (outputs + i * Lanes, 
+                                                        inputs + i * Lanes, 
+                                                        coeffs + i * NumCoeffs * Lanes, 
+                                                        groupStates);
+            
+            for (lane = 0; lane < numLanes; ++lane)
+            {
+                SampleType* const outputSamples = this->getOutputSamples (firstChannel + lane);
+                
+                for (i = 0; i < outputLength; ++i)
+                    outputSamples[i] = outputs[i * Lanes + lane];
+            }
+            
+            for (i = 0; i < NumStates * Lanes; ++i)
+                groupStates[i] = zap (groupStates[i]);
+        }
+    }
+    
+private:
+    Buffer states;
+    Buffer laneInputs;
+    Buffer laneOutputs;
+    Buffer laneCoeffs;
+    
+    /** Copies a source buffer into one lane of an interleaved scratch buffer. 
+     Sources of a different length are stepped through as in the single-channel
+     forms, or just the first value is used if @c resample is false. */
+    static PLONK_INLINE_LOW void gather (SampleType* const dst, 
+                                         const int stride,
+                                         Buffer const& source,
+                                         const int outputLength,
+                                         const bool resample = true) throw()
+    {
+        const SampleType* const sourceSamples = source.getArray();
+        const int sourceLength = source.length();
+        int i;
+        
+        if (sourceLength == outputLength)
+        {
+            for (i = 0; i < outputLength; ++i)
+                dst[i * stride] = sourceSamples[i];
+        }
+        else if ((sourceLength == 1) || ! resample)
+        {
+            const SampleType value = sourceSamples[0];
+            
+            for (i = 0; i < outputLength; ++i)
+                dst[i * stride] = value;
+        }
+        else
+        {
+            double position = 0.0;
+            const double increment = double (sourceLength) / double (outputLength);
+            
+            for (i = 0; i < outputLength; ++i)
+            {
+                dst[i * stride] = sourceSamples[int (position)];
+                position += increment;
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
 /** A generic FIR/IIR filter. 
  This is broadly for internal use. It is employed by the various standard filters.
  @see LPFUnit LPFP1Unit RLPFUnit HPFUnit HPFP1Unit RHPFUnit BPFUnit BRFUnit LowShelfUnit HighShelfUnit NotchUnit LagUnit DecayUnit
@@ -141,6 +332,7 @@ public:
     typedef typename FormType::SampleDataType       SampleType;
 
     typedef FilterChannelInternal<FormType>         FilterInternal;
+    typedef FilterBankChannelInternal<FormType>     FilterBankInternal;
     typedef typename FilterInternal::Data           Data;
     typedef ChannelBase<SampleType>                 ChannelType;
     typedef ChannelInternal<SampleType,Data>        Internal;
@@ -149,6 +341,11 @@ public:
     typedef NumericalArray2D<ChannelType,UnitType>  UnitsType;
     typedef InputDictionary                         Inputs;
     
+    enum Constants
+    {
+        FilterBankMinimumChannels = 4
+    };
+    
     static PLONK_INLINE_LOW UnitInfos getInfo() throw()
     {
         const double blockSize = (double)BlockSize::noPreference().getValue();
@@ -194,6 +391,20 @@ public:
         Memory::zero (data);
         data.base.sampleRate = -1.0;        
         data.base.sampleDuration = -1.0;
+        
+        if (canUseBank (input, numOutputChannels))
+        {
+            Inputs inputs;
+            inputs.put (IOKey::Generic, input);
+            inputs.put (IOKey::Coeffs, coeffs);
+            inputs.put (IOKey::Multiply, mul);
+            inputs.put (IOKey::Add, add);
+            
+            return UnitType::template proxiesFromInputs<FilterBankInternal> (inputs, 
+                                                                             data, 
+                                                                             preferredBlockSize, 
+                                                                             preferredSampleRate);
+        }
                 
         for (int i = 0; i < numOutputChannels; ++i)
         {
@@ -213,6 +424,29 @@ public:
         return UnitType::applyMulAdd (result, mul, add);
     }
     
+private:
+    /** Multichannel filters use a FilterBankChannelInternal if all the input
+     channels run at the same block size, sample rate and overlap. */
+    static bool canUseBank (UnitType const& input, const int numOutputChannels) throw()
+    {
+        if (numOutputChannels < FilterBankMinimumChannels)
+            return false;
+        
+        const int numInputChannels = input.getNumChannels();
+        const int blockSize = input.getBlockSize (0).getValue();
+        const double sampleRate = input.getSampleRate (0).getValue();
+        const double overlap = input.getOverlap (0).getValue();
+        
+        for (int i = 1; i < numInputChannels; ++i)
+        {
+            if ((input.getBlockSize (i).getValue() != blockSize) ||
+                (input.getSampleRate (i).getValue() != sampleRate) ||
+                (input.getOverlap (i).getValue() != overlap))
+                return false;
+        }
+        
+        return true;
+    }
 };
 
 
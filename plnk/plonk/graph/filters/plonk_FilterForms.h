@@ -139,6 +139,28 @@ public:
         return process (input, coeffs, data.y1);
     }
 
+    enum States
+    {
+        StateY1,
+        NumStates
+    };
+    
+    /** Process one sample in each of a bank of filters running in lockstep.
+     The coefficients and states are stored structure-of-arrays with Lanes
+     values for each so the compiler can vectorise the loop across the lanes.
+     @see FilterBankChannelInternal */
+    template<int Lanes>
+    static PLONK_INLINE_HIGH void processLanes (SampleType* const output,
+                                                const SampleType* const input,
+                                                const SampleType* const coeffs,
+                                                SampleType* const states) throw()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            output[lane] = process (input[lane],
+                                    coeffs[CoeffA0 * Lanes + lane], coeffs[CoeffA1 * Lanes + lane], coeffs[CoeffB1 * Lanes + lane],
+                                    states[StateY1 * Lanes + lane]);
+    }
+
     static void process (SampleType* const outputSamples,
                          const int outputLength,
                          UnitType& inputUnit, 
@@ -260,6 +282,22 @@ public:
         return process (input, coeffs[CoeffB1], data.y1);
     }
         
+    enum States
+    {
+        StateY1,
+        NumStates
+    };
+    
+    template<int Lanes>
+    static PLONK_INLINE_HIGH void processLanes (SampleType* const output,
+                                                const SampleType* const input,
+                                                const SampleType* const coeffs,
+                                                SampleType* const states) throw()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            output[lane] = process (input[lane], coeffs[CoeffB1 * Lanes + lane], states[StateY1 * Lanes + lane]);
+    }
+        
     static void process (SampleType* const outputSamples,
                          const int outputLength,
                          UnitType& inputUnit, 
@@ -361,6 +399,24 @@ public:
         return process (input, coeffs[CoeffB1], data.y1, data.x1);
     }
     
+    enum States
+    {
+        StateY1,
+        StateX1,
+        NumStates
+    };
+    
+    template<int Lanes>
+    static PLONK_INLINE_HIGH void processLanes (SampleType* const output,
+                                                const SampleType* const input,
+                                                const SampleType* const coeffs,
+                                                SampleType* const states) throw()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            output[lane] = process (input[lane], coeffs[CoeffB1 * Lanes + lane], 
+                                    states[StateY1 * Lanes + lane], states[StateX1 * Lanes + lane]);
+    }
+    
     static void process (SampleType* const outputSamples,
                          const int outputLength,
                          UnitType& inputUnit,
@@ -470,6 +526,23 @@ public:
         return process (input, coeffs[CoeffB1u], coeffs[CoeffB1d], data.y1);
     }
     
+    enum States
+    {
+        StateY1,
+        NumStates
+    };
+    
+    template<int Lanes>
+    static PLONK_INLINE_HIGH void processLanes (SampleType* const output,
+                                                const SampleType* const input,
+                                                const SampleType* const coeffs,
+                                                SampleType* const states) throw()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            output[lane] = process (input[lane], coeffs[CoeffB1u * Lanes + lane], coeffs[CoeffB1d * Lanes + lane], 
+                                    states[StateY1 * Lanes + lane]);
+    }
+    
     static void process (SampleType* const outputSamples,
                          const int outputLength,
                          UnitType& inputUnit,
@@ -599,6 +672,26 @@ public:
         return process (input, coeffs, data.y1, data.y2);
     }
 
+    enum States
+    {
+        StateY1,
+        StateY2,
+        NumStates
+    };
+    
+    template<int Lanes>
+    static PLONK_INLINE_HIGH void processLanes (SampleType* const output,
+                                                const SampleType* const input,
+                                                const SampleType* const coeffs,
+                                                SampleType* const states) throw()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            output[lane] = process (input[lane], 
+                                    coeffs[CoeffA0 * Lanes + lane], coeffs[CoeffA1 * Lanes + lane], coeffs[CoeffA2 * Lanes + lane], 
+                                    coeffs[CoeffB1 * Lanes + lane], coeffs[CoeffB2 * Lanes + lane], 
+                                    states[StateY1 * Lanes + lane], states[StateY2 * Lanes + lane]);
+    }
+
     static void process (SampleType* const outputSamples,
                          const int outputLength,
                          UnitType& inputUnit, 
@@ -759,6 +852,26 @@ public:
         return process (input, coeffs, data.y1, data.y2);
     }
 
+    enum States
+    {
+        StateY1,
+        StateY2,
+        NumStates
+    };
+    
+    template<int Lanes>
+    static PLONK_INLINE_HIGH void processLanes (SampleType* const output,
+                                                const SampleType* const input,
+                                                const SampleType* const coeffs,
+                                                SampleType* const states) throw()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            output[lane] = process (input[lane], 
+                                    coeffs[CoeffA0 * Lanes + lane], coeffs[CoeffA1 * Lanes + lane], coeffs[CoeffA2 * Lanes + lane], 
+                                    coeffs[CoeffB1 * Lanes + lane], coeffs[CoeffB2 * Lanes + lane], 
+                                    states[StateY1 * Lanes + lane], states[StateY2 * Lanes + lane]);
+    }
+
     static void process (SampleType* const outputSamples,
                          const int outputLength,
                          UnitType& inputUnit, 
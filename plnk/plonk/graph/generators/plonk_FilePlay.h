@@ -52,6 +52,8 @@ PLONK_CHANNELDATA_DECLARE(FilePlayChannelInternal,SampleType)
     
     bool done;//:1;
     bool deleteWhenDone;//:1;
+    
+    int readAhead;
 };
 
 //------------------------------------------------------------------------------
@@ -70,6 +72,8 @@ public:
     typedef UnitBase<SampleType>                                        UnitType;
     typedef InputDictionary                                             Inputs;
     typedef NumericalArray<SampleType>                                  Buffer;
+    typedef AudioFileStreamBase<SampleType>                             AudioFileStreamType;
+    typedef AudioFileStreamInternal<SampleType>                         AudioFileStreamInternalType;
 
     FilePlayChannelInternal (Inputs const& inputs, 
                              Data const& data, 
@@ -79,7 +83,9 @@ public:
     :   Internal (decideNumChannels (inputs, data), 
                   inputs, data, blockSize, sampleRate,
                   channels),
-        zero (0)
+        zero (0),
+        fileSampleRate (0.0),
+        lastSeekTime (-1.0)
     {
 //        AudioFileReader& file = this->getInputAsAudioFileReader (IOKey::AudioFileReader);
 //        file.setOwner (this);
@@ -107,14 +113,32 @@ public:
         if ((channel % this->getNumChannels()) == 0)
         {
             const AudioFileReader& file = this->getInputAsAudioFileReader (IOKey::AudioFileReader);
+            const Data& data = this->getState();
 
-            double fileSampleRate = file.getSampleRate();
+            fileSampleRate = file.getSampleRate();
             
             if (fileSampleRate <= 0.0)
                 fileSampleRate = file.getDefaultSampleRate();
 
             this->setSampleRate (SampleRate::decide (fileSampleRate, this->getSampleRate()));
-            buffer.setSize (this->getBlockSize().getValue() * file.getNumChannels(), false);
+            
+            if (data.readAhead > 0)
+            {
+                const IntVariable& loopCount (this->template getInputAs<IntVariable> (IOKey::LoopCount));
+                lastSeekTime = this->template getInputAs<DoubleVariable> (IOKey::Time).getValue();
+                
+                const AudioFileMetaData metaData = file.getMetaData();
+                
+                if (metaData.isNotNull())
+                    cuePoints = metaData.getCuePoints();
+                
+                stream = AudioFileStreamType (file, loopCount, data.readAhead,
+                                              lastSeekTime > 0.0 ? LongLong (lastSeekTime * fileSampleRate) : LongLong (0));
+            }
+            else
+            {
+                buffer.setSize (this->getBlockSize().getValue() * file.getNumChannels(), false);
+            }
         }
         
         this->initProxyValue (channel, 0);
@@ -122,6 +146,12 @@ public:
     
     void process (ProcessInfo& info, const int /*channel*/) throw()
     {
+        if (stream.isNotNull())
+        {
+            processStream (info);
+            return;
+        }
+        
         Data& data = this->getState();
         
         IntVariable& loopCount (this->template getInputAs<IntVariable> (IOKey::LoopCount));
@@ -296,9 +326,115 @@ public:
     }
 
 private:
+    void processStream (ProcessInfo& info) throw()
+    {
+        Data& data = this->getState();
+        const double seekTime = this->template getInputAs<DoubleVariable> (IOKey::Time).getValue();
+        
+        if (seekTime != lastSeekTime)
+        {
+            lastSeekTime = seekTime;
+            
+            if (seekTime >= 0.0)
+                stream.seek (LongLong (seekTime * fileSampleRate));
+        }
+        
+        const int numChannels = this->getNumChannels();
+        const int blockSize = this->getBlockSize().getValue();
+        int channel;
+        int offset = 0;
+        
+        while (offset < blockSize)
+        {
+            int events;
+            int numFrames = stream.beginRead (events);
+            
+            if (events & AudioFileStreamInternalType::EventSeeked)
+            {
+                data.done = false;
+                data.cueIndex = 0;
+            }
+            
+            if (events & AudioFileStreamInternalType::EventLooped)
+                data.cueIndex = 0;
+            
+            if (events & AudioFileStreamInternalType::EventFileChanged)
+                this->update (Text::getMessageAudioFileChanged(), this->getInputAsAudioFileReader (IOKey::AudioFileReader));
+
+            if (events & AudioFileStreamInternalType::EventNumChannelsChanged)
+                this->update (Text::getMessageNumChannelsChanged(), IntVariable (stream.getFileNumChannels()));
+            
+            if (numFrames > 0)
+                numFrames = limitToNextCue (data, numFrames);
+            
+            const int numFramesThisTime = plonk::min (numFrames, blockSize - offset);
+            
+            if (numFramesThisTime > 0)
+            {
+                for (channel = 0; channel < numChannels; ++channel)
+                    stream.readChannel (this->getOutputSamples (channel) + offset, channel, numFramesThisTime);
+                
+                stream.endRead (numFramesThisTime);
+                offset += numFramesThisTime;
+            }
+            else
+            {
+                // ended, or the I/O hasn't kept up
+                for (channel = 0; channel < numChannels; ++channel)
+                {
+                    SampleType* const outputSamples = this->getOutputSamples (channel) + offset;
+                    
+                    for (int i = 0; i < blockSize - offset; ++i)
+                        outputSamples[i] = SampleType (0);
+                }
+                
+                if (stream.hasEnded() && ! data.done)
+                {
+                    data.done = true;
+                    this->update (Text::getMessageDone(), Dynamic::getNull());
+                }
+                
+                offset = blockSize;
+            }
+        }
+        
+        if (data.done && data.deleteWhenDone)
+            info.setShouldDelete();
+    }
+    
+    /** Send messages for cue points at the current position and stop the
+     frames to read at the next one. */
+    int limitToNextCue (Data& data, const int numFrames) throw()
+    {
+        if (cuePoints.length() == 0)
+            return numFrames;
+        
+        const LongLong position = stream.getFramePosition();
+        AudioFileCuePoint cue = cuePoints[data.cueIndex];
+        
+        while (cue.isNotNull() && (cue.getFramePosition (fileSampleRate) <= position))
+        {
+            if (cue.getFramePosition (fileSampleRate) == position)
+                this->update (Text::getMessageCuePoint(), Text (cue.getLabel()));
+            
+            ++data.cueIndex;
+            cue = cuePoints[data.cueIndex];
+        }
+        
+        if (cue.isNull())
+            return numFrames;
+        
+        return int (plonk::min (LongLong (numFrames), cue.getFramePosition (fileSampleRate) - position));
+    }
+    
     Buffer buffer; // might need to use a signal...
     IntVariable zero;
     
+    AudioFileStreamType stream;
+    AudioFileCuePointArray cuePoints;
+    double fileSampleRate;
+    double lastSeekTime;
+    
     static const int decideNumChannels (Inputs const& inputs, Data const& data) throw()
     {
         if (data.numChannels > 0)
@@ -321,16 +457,20 @@ private:
  
  The sample rate of the unit is by default set to the sample rate of the audio file.
  
- NB This should not be used directly in a real-time audio thread. It should
- be wrapped in a TaskUnit which buffers the audio on a separate thread.
+ NB ar() should not be used directly in a real-time audio thread. It should
+ be wrapped in a TaskUnit which buffers the audio on a separate thread. Or use 
+ arStream() which reads ahead on the shared disk I/O threads.
  
  @par Factory functions:
  - ar (file, loopCount=0, mul=1, add=0, allowAutoDelete=true, preferredBlockSize=default, preferredSampleRate=noPref)
+ - arStream (file, loopCount=0, readAheadFrames=0, seekTime=-1, mul=1, add=0, allowAutoDelete=true, preferredBlockSize=default, preferredSampleRate=noPref)
  - kr (file, loopCount=0, mul=1, add=0, allowAutoDelete=true)
  
  @par Inputs:
  - file: (audiofilereader, multi) the audio file reader to use
  - loopCount: (value) a control to tell the file player how many times to loop (0=infinite)
+ - readAheadFrames: (int) for arStream() the number of frames to decode ahead 
+ - seekTime: (value) for arStream() set this to a time in seconds to jump to that position
  - mul: (unit, multi) the multiplier applied to the output
  - add: (unit, multi) the offset added to the output
  - allowAutoDelete: (bool) whether this unit can be caused to be deleted by the unit it contains
@@ -390,7 +530,45 @@ public:
             inputs.put (IOKey::Multiply, mul);
             inputs.put (IOKey::Add, add);
                             
-            Data data = { { -1.0, -1.0 }, file.getDefaultNumChannels(), 0, false, deleteWhenDone };
+            Data data = { { -1.0, -1.0 }, file.getDefaultNumChannels(), 0, false, deleteWhenDone, 0 };
+            
+            return UnitType::template proxiesFromInputs<FilePlayInternal> (inputs, 
+                                                                           data, 
+                                                                           preferredBlockSize, 
+                                                                           preferredSampleRate);
+        } 
+        else return UnitType::getNull();
+    }
+    
+    /** Create an audio rate audio file player that streams from a background thread. 
+     The file is decoded ahead into a ring of readAheadFrames on the shared 
+     TaskPool::getIO() threads so this is safe to use directly in the audio 
+     thread. Setting seekTime to a new value moves the play position 
+     without blocking, the output is silent until the frames after the 
+     seek are ready. 
+     @param readAheadFrames The number of frames to decode ahead, 0 uses the default (16384). 
+     @param seekTime        The position in seconds to play from, negative values are ignored. */
+    static UnitType arStream (AudioFileReader const& file,
+                              IntVariable const& loopCount = 0,
+                              const int readAheadFrames = 0,
+                              DoubleVariable const& seekTime = -1.0,
+                              UnitType const& mul = SampleType (1),
+                              UnitType const& add = SampleType (0),
+                              const bool deleteWhenDone = true,
+                              BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                              SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+    {             
+        if (file.isReady() && ! file.isOwned())
+        {            
+            Inputs inputs;
+            inputs.put (IOKey::AudioFileReader, file);
+            inputs.put (IOKey::LoopCount, loopCount);
+            inputs.put (IOKey::Time, seekTime);
+            inputs.put (IOKey::Multiply, mul);
+            inputs.put (IOKey::Add, add);
+            
+            const int readAhead = readAheadFrames > 0 ? readAheadFrames : (int) AudioFileStreamInternal<SampleType>::DefaultReadAhead;
+            Data data = { { -1.0, -1.0 }, file.getDefaultNumChannels(), 0, false, deleteWhenDone, readAhead };
             
             return UnitType::template proxiesFromInputs<FilePlayInternal> (inputs, 
                                                                            data, 
@@ -471,6 +649,43 @@ public:
             }
         };
 
+        /** A simple file player using windowed-sinc sample rate conversion.
+         Use this for high quality conversion of files at a different sample 
+         rate to the default, or varispeed playback, on the fly. */
+        class Sinc
+        {
+        public:
+            typedef InputTaskUnit<SampleType,Interp::Sinc>          TaskType;
+            typedef ResampleUnit<SampleType,Interp::Sinc>           ResampleType;
+            typedef typename ResampleType::RateType                 RateType;
+            typedef typename ResampleType::RateUnitType             RateUnitType;
+            
+            static UnitType ar (AudioFileReader const& file,
+                                RateUnitType const& rate = Math<RateUnitType>::get1(),
+                                IntVariable const& loopCount = 0,
+                                const int blockSizeMultiplier = 0,
+                                const int numBuffers = 16)
+            {
+                double fileSampleRate = file.getSampleRate();
+                
+                if (fileSampleRate <= 0.0)
+                    fileSampleRate = file.getDefaultSampleRate();
+
+                const DoubleVariable multiplier = blockSizeMultiplier <= 0 ?
+                                                  (DoubleVariable (fileSampleRate) / SampleRate::getDefault()).ceil() * 2.0 :
+                                                  DoubleVariable (blockSizeMultiplier);
+                
+                UnitType play = FilePlayUnit::ar (file, loopCount,
+                                                  SampleType (1), SampleType (0),
+                                                  true,
+                                                  BlockSize::getMultipleOfDefault (multiplier));
+                
+                UnitType task = TaskType::ar (play, numBuffers);
+                
+                return ResampleType::ar (task, rate);
+            }
+        };
+
     };
 };
 
@@ -0,0 +1,452 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_OSCILLATORBANK_H
+#define PLONK_OSCILLATORBANK_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+/** Renders a group of oscillator voices.
+ Voice @c lane of the group reads the table at @c tables + @c offsets[lane] 
+ and writes @c outputs[lane]. Increments are in lane order, one set of lanes 
+ every @c incrementStride values (a stride of 0 uses the same increments for 
+ the whole block). Positions are kept in [0, tableLength) which requires each 
+ increment to be less than a table length. The table must be stored twice, 
+ as WavetableBase does, so the sample after any position is readable without 
+ wrapping. */
+template<class SampleType, class FrequencyType>
+class OscillatorBankLanes
+{
+public:
+    enum Constants { NumLanes = 4 };
+
+    static PLONK_INLINE_LOW void process (FrequencyType* const positions,
+                                          const FrequencyType* const increments,
+                                          const int incrementStride,
+                                          const SampleType* const tables,
+                                          const int* const offsets,
+                                          SampleType* const* const outputs,
+                                          const int numSamples,
+                                          const FrequencyType tableLength) throw()
+    {
+        typedef InterpLinear<SampleType,FrequencyType> InterpType;
+
+        const FrequencyType table0 (0);
+
+        // a voice at a time, as Table does, there is nothing to gain from interleaving them in scalar code
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            const SampleType* const tableSamples = tables + offsets[lane];
+            SampleType* const outputSamples = outputs[lane];
+            const FrequencyType* incrementSamples = increments + lane;
+            FrequencyType position = positions[lane];
+
+            for (int i = 0; i < numSamples; ++i, incrementSamples += incrementStride)
+            {
+                outputSamples[i] = InterpType::lookup (tableSamples, position);
+                position += *incrementSamples;
+
+                if (position >= tableLength)
+                    position -= tableLength;
+                else if (position < table0)
+                    position += tableLength;
+            }
+
+            positions[lane] = position;
+        }
+    }
+};
+
+#if PLANK_VSIMD_HASGATHER
+
+/** Renders a group of oscillator voices with one voice per SIMD lane.
+ The phase update, wrapping, table reads and interpolation are done for all 
+ lanes at once. This needs a hardware gather (e.g., AVX2), without it the 
+ lanes are no faster than running the voices one after the other. */
+template<>
+class OscillatorBankLanes<float,float>
+{
+public:
+    enum Constants { NumLanes = PLANK_SIMDF_LENGTH };
+
+    static PLONK_INLINE_LOW void process (float* const positions,
+                                          const float* increments,
+                                          const int incrementStride,
+                                          const float* const tables,
+                                          const int* const offsets,
+                                          float* const* const outputs,
+                                          const int numSamples,
+                                          const float tableLength) throw()
+    {
+        float output[NumLanes];
+
+        const PlankVF length = PLANK_VSIMDF_SET1 (tableLength);
+        const PlankVF zero = PLANK_VSIMDF_SET1 (0.f);
+        const PlankVFI tableOffsets = PLANK_VSIMDFI_LOAD (offsets);
+        PlankVF position = PLANK_VSIMDF_LOAD (positions);
+        int lane;
+
+        for (int i = 0; i < numSamples; ++i, increments += incrementStride)
+        {
+            const PlankVFI index = PLANK_VSIMDF_TOINT (position);
+            const PlankVFI tableIndex = PLANK_VSIMDFI_ADD (index, tableOffsets);
+            const PlankVF v0 = PLANK_VSIMDF_GATHER (tables, tableIndex);
+            const PlankVF v1 = PLANK_VSIMDF_GATHER (tables + 1, tableIndex);
+            const PlankVF frac = PLANK_VSIMDF_SUB (position, PLANK_VSIMDF_FROMINT (index));
+            PLANK_VSIMDF_STORE (output, PLANK_VSIMDF_ADD (v0, PLANK_VSIMDF_MUL (PLANK_VSIMDF_SUB (v1, v0), frac)));
+
+            for (lane = 0; lane < NumLanes; ++lane)
+                outputs[lane][i] = output[lane];
+
+            position = PLANK_VSIMDF_ADD (position, PLANK_VSIMDF_LOAD (increments));
+            position = PLANK_VSIMDF_SUB (position, PLANK_VSIMDF_AND (PLANK_VSIMDF_CMPGE (position, length), length));
+            position = PLANK_VSIMDF_ADD (position, PLANK_VSIMDF_AND (PLANK_VSIMDF_CMPLT (position, zero), length));
+        }
+
+        PLANK_VSIMDF_STORE (positions, position);
+    }
+};
+
+#endif // PLANK_VSIMD_HASGATHER
+
+//------------------------------------------------------------------------------
+
+template<class SampleType> class OscillatorBankChannelInternal;
+
+template<class SampleType>
+struct ChannelData< OscillatorBankChannelInternal<SampleType> >
+{
+    ChannelInternalCore::Data base;
+};
+
+/** Oscillator bank channel.
+ Renders one voice per output channel from a shared WavetableBank. */
+template<class SampleType>
+class OscillatorBankChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, ChannelData< OscillatorBankChannelInternal<SampleType> > >
+{
+public:
+    typedef ChannelData< OscillatorBankChannelInternal<SampleType> >    Data;
+    typedef ChannelBase<SampleType>                                     ChannelType;
+    typedef ObjectArray<ChannelType>                                    ChannelArrayType;
+    typedef OscillatorBankChannelInternal<SampleType>                   OscillatorBankInternal;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                  Internal;
+    typedef ChannelInternalBase<SampleType>                             InternalBase;
+    typedef UnitBase<SampleType>                                        UnitType;
+    typedef InputDictionary                                             Inputs;
+    typedef NumericalArray<SampleType>                                  Buffer;
+    typedef WavetableBankBase<SampleType>                               WavetableBankType;
+
+    typedef typename TypeUtility<SampleType>::IndexType                 FrequencyType;
+    typedef UnitBase<FrequencyType>                                     FrequencyUnitType;
+    typedef NumericalArray<FrequencyType>                               FrequencyBufferType;
+    typedef OscillatorBankLanes<SampleType,FrequencyType>               LanesType;
+
+    enum Constants { NumLanes = LanesType::NumLanes };
+
+    OscillatorBankChannelInternal (Inputs const& inputs,
+                                   Data const& data,
+                                   BlockSize const& blockSize,
+                                   SampleRate const& sampleRate,
+                                   ChannelArrayType& channels) throw()
+    :   Internal (numVoicesInInputs (inputs),
+                  inputs, data, blockSize, sampleRate,
+                  channels),
+        numGroups ((this->getNumChannels() + NumLanes - 1) / NumLanes),
+        positions (FrequencyBufferType::newClear (numGroups * NumLanes)),
+        zeroFrequency (0)
+    {
+    }
+
+    Text getName() const throw()
+    {
+        return "Oscillator Bank";
+    }
+
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::WavetableBank,
+                             IOKey::Frequency);
+        return keys;
+    }
+
+    void initChannel (const int channel) throw()
+    {
+        const FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (frequencyUnit.getBlockSize (channel),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (frequencyUnit.getSampleRate (channel),
+                                                     this->getSampleRate()));
+            this->setOverlap (frequencyUnit.getOverlap (channel));
+            
+            const int blockSize = this->getBlockSize().getValue();
+            increments = FrequencyBufferType::newClear (blockSize * NumLanes);
+            spare = Buffer::newClear (blockSize);
+        }
+
+        this->initProxyValue (channel, SampleType (0));
+    }
+
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        const Data& data = this->getState();
+        const double sampleDuration = data.base.sampleDuration;
+
+        FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        const WavetableBankType& bank (this->getInputAsWavetableBank (IOKey::WavetableBank));
+
+        const int numVoices = this->getNumChannels();
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        const FrequencyType tableLength = FrequencyType (bank.getTableLength());
+        const FrequencyType tableLengthOverSampleRate = FrequencyType (tableLength * sampleDuration);
+        const SampleType* const tableSamples = bank.getSamples();
+
+        if (increments.length() != (outputBufferLength * NumLanes))
+        {
+            increments.setSize (outputBufferLength * NumLanes, false);
+            spare.setSize (outputBufferLength, false);
+        }
+
+        FrequencyType* const incrementSamples = increments.getArray();
+        FrequencyType* const positionSamples = positions.getArray();
+        const FrequencyType* frequencySamples[NumLanes];
+        int frequencyBufferLengths[NumLanes];
+        int offsets[NumLanes];
+        SampleType* outputs[NumLanes];
+        int i, lane;
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            const int numLanes = plonk::min (int (NumLanes), numVoices - group * NumLanes);
+            bool isConstant = true;
+
+            for (lane = 0; lane < numLanes; ++lane)
+            {
+                const FrequencyBufferType& frequencyBuffer (frequencyUnit.process (info, group * NumLanes + lane));
+                frequencySamples[lane] = frequencyBuffer.getArray();
+                frequencyBufferLengths[lane] = frequencyBuffer.length();
+                isConstant = isConstant && (frequencyBufferLengths[lane] == 1);
+            }
+
+            // unused lanes in the last group run silently
+            for (lane = numLanes; lane < NumLanes; ++lane)
+            {
+                frequencySamples[lane] = &zeroFrequency;
+                frequencyBufferLengths[lane] = 1;
+                offsets[lane] = 0;
+                outputs[lane] = spare.getArray();
+            }
+
+            // transpose the increments into lane order, voices with a constant frequency only need one set
+            const int incrementLength = isConstant ? 1 : outputBufferLength;
+
+            for (lane = 0; lane < NumLanes; ++lane)
+            {
+                const FrequencyType* const voiceFrequencySamples = frequencySamples[lane];
+                const int frequencyBufferLength = frequencyBufferLengths[lane];
+                FrequencyType maximumIncrement (0);
+
+                if (frequencyBufferLength == incrementLength)
+                {
+                    for (i = 0; i < incrementLength; ++i)
+                    {
+                        const FrequencyType increment = voiceFrequencySamples[i] * tableLengthOverSampleRate;
+                        incrementSamples[i * NumLanes + lane] = increment;
+                        maximumIncrement = plonk::max (maximumIncrement, plonk::abs (increment));
+                    }
+                }
+                else if (frequencyBufferLength == 1)
+                {
+                    const FrequencyType increment = voiceFrequencySamples[0] * tableLengthOverSampleRate;
+
+                    for (i = 0; i < incrementLength; ++i)
+                        incrementSamples[i * NumLanes + lane] = increment;
+
+                    maximumIncrement = plonk::abs (increment);
+                }
+                else
+                {
+                    double frequencyPosition = 0.0;
+                    const double frequencyIncrement = double (frequencyBufferLength) / double (incrementLength);
+
+                    for (i = 0; i < incrementLength; ++i)
+                    {
+                        const FrequencyType increment = voiceFrequencySamples[int (frequencyPosition)] * tableLengthOverSampleRate;
+                        incrementSamples[i * NumLanes + lane] = increment;
+                        maximumIncrement = plonk::max (maximumIncrement, plonk::abs (increment));
+                        frequencyPosition += frequencyIncrement;
+                    }
+                }
+
+                if (lane < numLanes)
+                {
+                    // the level is chosen for the highest frequency in the block so it never aliases
+                    offsets[lane] = bank.getLevelOffset (bank.getLevelForIncrement (maximumIncrement));
+                    outputs[lane] = this->getOutputSamples (group * NumLanes + lane);
+                }
+            }
+
+            LanesType::process (positionSamples + group * NumLanes,
+                                incrementSamples, isConstant ? 0 : int (NumLanes),
+                                tableSamples, offsets, outputs,
+                                outputBufferLength, tableLength);
+        }
+    }
+
+private:
+    const int numGroups;
+    FrequencyBufferType positions;  // one per voice, padded to a whole number of lane groups
+    FrequencyBufferType increments; // one block of increments per lane, interleaved in lane order
+    Buffer spare;                   // output for the unused lanes of the last group
+    FrequencyType zeroFrequency;
+
+    static PLONK_INLINE_LOW int numVoicesInInputs (Inputs const& inputs) throw()
+    {
+        return inputs[IOKey::Frequency].asUnchecked<FrequencyUnitType>().getNumChannels();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** A bank of band limited wavetable oscillators.
+
+ Each channel of the frequency input is one voice with its own phase, all
+ voices read the same WavetableBank. The voices are rendered together with
+ one voice per SIMD lane when the sample type is float and the SIMD vector
+ library has a gather (PLANK_VEC_SIMD with AVX2). Each voice reads the bank
+ level that is band limited for the highest frequency it reaches in each block.
+ This is cheaper than creating a Table unit for each voice and avoids
+ aliasing at high frequencies.
+
+ @code
+ Unit voices = OscillatorBank::ar (WavetableBank::harmonicSaw(),
+                                   FloatArray (110.f, 110.5f, 220.f, 330.3f),
+                                   0.1f);
+ Unit output = voices.mix();
+ @endcode
+
+ @par Factory functions:
+ - ar (bank, frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (bank, frequency=440, mul=1, add=0)
+
+ @par Inputs:
+ - bank: (wavetablebank) the band limited tables to use for all the voices
+ - frequency: (unit, multi) the frequency of each voice in Hz, one channel per voice
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup GeneratorUnits ControlUnits */
+template<class SampleType>
+class OscillatorBankUnit
+{
+public:
+    typedef OscillatorBankChannelInternal<SampleType>   OscillatorBankInternal;
+    typedef typename OscillatorBankInternal::Data       Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef WavetableBankBase<SampleType>               WavetableBankType;
+
+    typedef typename OscillatorBankInternal::FrequencyType         FrequencyType;
+    typedef typename OscillatorBankInternal::FrequencyUnitType     FrequencyUnitType;
+
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+
+        return UnitInfo ("OscillatorBank", "A bank of band limited wavetable oscillators.",
+
+                         // output
+                         ChannelCount::VariableChannelCount,
+                         IOKey::Generic,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::End,
+
+                         // inputs
+                         IOKey::WavetableBank,  Measure::None,
+                         IOKey::Frequency,      Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,   0.0, 0.5,
+                         IOKey::Multiply,       Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,            Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,      Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate,     Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+
+    /** Create an audio rate oscillator bank. */
+    static UnitType ar (WavetableBankType const& bank,
+                        FrequencyUnitType const& frequency = FrequencyType (440),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {
+        Inputs inputs;
+        inputs.put (IOKey::WavetableBank, bank);
+        inputs.put (IOKey::Frequency, frequency);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+
+        Data data = { { -1.0, -1.0 } };
+
+        return UnitType::template proxiesFromInputs<OscillatorBankInternal> (inputs,
+                                                                             data,
+                                                                             preferredBlockSize,
+                                                                             preferredSampleRate);
+    }
+
+    /** Create a control rate oscillator bank. */
+    static UnitType kr (WavetableBankType const& bank,
+                        FrequencyUnitType const& frequency,
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return ar (bank, frequency, mul, add,
+                   BlockSize::getControlRateBlockSize(),
+                   SampleRate::getControlRate());
+    }
+};
+
+typedef OscillatorBankUnit<PLONK_TYPE_DEFAULT> OscillatorBank;
+
+#endif // PLONK_OSCILLATORBANK_H
@@ -321,6 +321,18 @@ public:
         
         plink_SawProcessF (&p, &this->getState());
     }
+    
+    bool getPlinkKernel (PlinkKernel<float>& kernel) throw()
+    {
+        kernel.setFunction (&SawInternal::plinkKernel, &this->getState());
+        kernel.addInput (ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency));
+        return true;
+    }
+    
+    static void plinkKernel (void* pp, void* state) throw()
+    {
+        plink_SawProcessF (pp, static_cast<SawProcessStateF*> (state));
+    }
   
 private:
     Process p;
@@ -296,6 +296,21 @@ public:
         plink_TableProcessF (&p, &this->getState());
     }
     
+    bool getPlinkKernel (PlinkKernel<float>& kernel) throw()
+    {
+        const WavetableType& table (this->getInputAsWavetable (IOKey::Wavetable));
+        
+        kernel.setFunction (&TableInternal::plinkKernel, &this->getState());
+        kernel.addInput (ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency));
+        kernel.addInput (table.getArray(), table.length());
+        return true;
+    }
+    
+    static void plinkKernel (void* pp, void* state) throw()
+    {
+        plink_TableProcessF (pp, static_cast<TableProcessStateF*> (state));
+    }
+    
 private:
     Process p;
 };    
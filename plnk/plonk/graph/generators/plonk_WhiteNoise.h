@@ -79,14 +79,15 @@ public:
     typedef ChannelInternal<SampleType,Data>                                Internal;
     typedef ChannelInternalBase<SampleType>                                 InternalBase;
     typedef UnitBase<SampleType>                                            UnitType;
+    typedef typename Data::LimitType                                        LimitType;
     
     WhiteNoiseChannelInternal (Inputs const& inputs, 
                                Data const& data, 
                                BlockSize const& blockSize,
                                SampleRate const& sampleRate) throw()
-    :   Internal (inputs, data, blockSize, sampleRate)
+    :   Internal (inputs, data, blockSize, sampleRate),
+        rng (data.rng)
     {
-        rng.seed (data.rng.value);
     }
             
     Text getName() const throw()
@@ -116,8 +117,7 @@ public:
         SampleType* const outputSamples = this->getOutputSamples();
         const int outputBufferLength = this->getOutputBuffer().length();
         
-        for (int i = 0; i < outputBufferLength; ++i) 
-            outputSamples[i] = SampleType (rng.uniform (data.minValue, data.maxValue));
+        rng.uniform (outputSamples, outputBufferLength, data.minValue, data.maxValue);
     }
     
 private:
@@ -139,7 +139,7 @@ public:
     typedef ChannelInternal<float,Data>         Internal;
     typedef ChannelInternalBase<float>          InternalBase;
     typedef UnitBase<float>                     UnitType;
-        
+    typedef float                               LimitType;
     
     enum Outputs { Output, NumOutputs };
     enum InputIndices  { NumInputs };
@@ -187,6 +187,17 @@ public:
         plink_WhiteNoiseProcessF_N (&p, &this->getState());
     }
     
+    bool getPlinkKernel (PlinkKernel<float>& kernel) throw()
+    {
+        kernel.setFunction (&WhiteNoiseInternal::plinkKernel, &this->getState());
+        return true;
+    }
+    
+    static void plinkKernel (void* pp, void* state) throw()
+    {
+        plink_WhiteNoiseProcessF_N (pp, static_cast<WhiteNoiseProcessStateF*> (state));
+    }
+    
 private:
     Process p;
 };
@@ -219,7 +230,7 @@ public:
     typedef ChannelInternal<SampleType,Data>        Internal;
     typedef ChannelInternalBase<SampleType>         ChannelInternalType;
     typedef UnitBase<SampleType>                    UnitType;
-    typedef typename Data::LimitType                LimitType;
+    typedef typename WhiteNoiseInternal::LimitType  LimitType;
     
     static PLONK_INLINE_LOW UnitInfos getInfo() throw()
     {
@@ -255,11 +266,15 @@ public:
         
         Inputs inputs;
         
+        // one seed per unit with each channel on its own stream so the channels never overlap
+        const unsigned int seed = RNG::global().uniformInt();
+        
         for (int i = 0; i < numChannels; ++i) 
         {
             PlankRNG rng;
             pl_RNG_Init (&rng);
-            pl_RNG_Seed (&rng, RNG::global().uniformInt());
+            pl_RNG_Seed (&rng, seed);
+            pl_RNG_SetStream (&rng, i);
             Data data = { { -1.0, -1.0 }, (LimitType)-peak, (LimitType)peak, rng };
             ChannelInternalType* internal = new WhiteNoiseInternal (inputs, 
                                                                     data, 
@@ -106,6 +106,10 @@ IOKey::Name IOKey::fromInt (const int value) throw()
         IOKey::UnitQueue,
         IOKey::BufferQueue,
         IOKey::FFTBuffers,
+        IOKey::ParamEvents,
+        IOKey::DiskRecorder,
+        IOKey::WavetableBank,
+        IOKey::STFTEngine,
         IOKey::AutoDeleteFlag,
         IOKey::PurgeExpiredUnitsFlag,
         IOKey::HarmonicCount,
@@ -204,6 +208,10 @@ Text IOKey::getName (const int keyIndex) throw()
         "UnitQueue",
         "BufferQueue",
         "FFTBuffers",
+        "ParamEvents",
+        "DiskRecorder",
+        "WavetableBank",
+        "STFTEngine",
         
         "Auto Delete Flag",
         "Purge Expired Units Flag",
@@ -288,6 +296,10 @@ IOKey::IOType IOKey::getType (const int keyIndex) throw()
         IOKey::TypeUnitQueue,
         IOKey::TypeBufferQueue,
         IOKey::TypeFFTBuffers,
+        IOKey::TypeParamEvents,
+        IOKey::TypeDiskRecorder,
+        IOKey::TypeWavetableBank,
+        IOKey::TypeSTFTEngine,
         
         IOKey::TypeBool,            //"Auto Delete Flag"
         IOKey::TypeBool,            //"Purge Expired Units Flag"
@@ -373,6 +385,10 @@ Text IOKey::getTypeName (const int keyIndex) throw()
         "UnitQueue",
         "BufferQueue",
         "FFTBuffers",
+        "ParamEvents",
+        "DiskRecorder",
+        "WavetableBank",
+        "STFTEngine",
         
         "Bool",             //"Auto Delete Flag"
         "Bool",             //"Purge Expired Units Flag"
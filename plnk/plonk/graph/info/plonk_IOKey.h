@@ -72,6 +72,10 @@ public:
         TypeUnitQueue,
         TypeBufferQueue,
         TypeFFTBuffers,
+        TypeParamEvents,
+        TypeDiskRecorder,
+        TypeWavetableBank,
+        TypeSTFTEngine,
         TypeBlockSize,
         TypeSampleRate,
         TypeBool,
@@ -149,6 +153,10 @@ public:
         UnitQueue,              ///< A unit queue
         BufferQueue,            ///< A buffer queue
         FFTBuffers,             ///< Some FFT Buffers
+        ParamEvents,            ///< A queue of timestamped parameter events
+        DiskRecorder,           ///< A recorder that writes frames to disk
+        WavetableBank,          ///< A set of band limited wavetables, one per octave
+        STFTEngine,             ///< A multichannel STFT analysis/resynthesis engine
 
         AutoDeleteFlag,         ///< To control the auto deletion
         PurgeExpiredUnitsFlag,
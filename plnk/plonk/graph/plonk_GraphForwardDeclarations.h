@@ -54,6 +54,7 @@ class ProcessInfo;
 class ProcessInfoInternal;
 class TimeStamp;
 class InputDictionary;
+class GraphDependencies;
 
 // info
 class IOKey;
@@ -66,6 +67,9 @@ typedef ObjectArray<UnitInfo>   UnitInfos;
 
 // core templated graph types
 template<class SampleType>                                              class BusBuffer;
+template<class SampleType>                                              class ParamEventsBase;
+template<class SampleType>                                              class DiskRecorderBase;
+template<class SampleType>                                              class PlinkKernel;
 template<class SampleType>                                              class ChannelBase;
 template<class SampleType>                                              class ChannelInternalBase;
 template<class SampleType, class DataType>                              class ChannelInternal;
@@ -82,8 +86,9 @@ template<class SampleType, PLONK_BINARYOPFUNCTION(SampleType, op)>      class Bi
 template<class SampleType, PLONK_UNARYOPFUNCTION(SampleType, op)>       class UnaryOpChannelInternal;
 template<class SampleType>                                              class MulAddChannelInternal;
 
-template<class SampleType>                                              class ConvolveChannelInternal;
 template<class SampleType>                                              class ConvolveHelper;
+template<class SampleType>                                              class PartitionedConvolveHelper;
+template<class SampleType, class HelperType = ConvolveHelper<SampleType> > class ConvolveChannelInternal;
 
 // common units
 template<class SampleType>                                              class MulAddUnit;
@@ -93,6 +98,9 @@ template<class SampleType>                                              class Mi
 template<class SampleType>                                              class OverlapMakeUnit;
 template<class SampleType>                                              class OverlapMixUnit;
 template<class SampleType>                                              class ParamUnit;
+template<class SampleType>                                              class ParamEventUnit;
+template<class SampleType>                                              class DiskRecordUnit;
+template<class SampleType>                                              class FreezeUnit;
 template<class SampleType>                                              class RampUnit;
 template<class SampleType>                                              class AtomicVariableUnit;
 template<class SampleType,
@@ -154,6 +162,12 @@ typedef BusBuffer<Int24>                Int24Bus;
 typedef BusBuffer<short>                ShortBus;
 typedef BusBuffer<Long>                 LongBus;
 
+typedef ParamEventsBase<float>          FloatParamEvents;
+typedef ParamEventsBase<double>         DoubleParamEvents;
+
+typedef DiskRecorderBase<float>         FloatDiskRecorder;
+typedef DiskRecorderBase<double>        DoubleDiskRecorder;
+
 #define PLONK_BUSARRAYBASETYPE NumericalArray
 typedef PLONK_BUSARRAYBASETYPE<FloatBus>                    FloatBusses;
 typedef PLONK_BUSARRAYBASETYPE<DoubleBus>                   DoubleBusses;
@@ -184,6 +198,8 @@ typedef PLONK_UNITBASETYPE<UnitBase<PLONK_TYPE_DEFAULT> >   UnitRaw;
 typedef NumericalArray2D<Channel,Unit>                      Units;
 typedef BusBuffer<PLONK_TYPE_DEFAULT>                       Bus;
 typedef PLONK_BUSARRAYBASETYPE<Bus>                         Busses;
+typedef ParamEventsBase<PLONK_TYPE_DEFAULT>                 ParamEvents;
+typedef DiskRecorderBase<PLONK_TYPE_DEFAULT>                DiskRecorder;
 
 // variable graph objects
 typedef Variable< ChannelBase<float>& >                     FloatChannelVariable;
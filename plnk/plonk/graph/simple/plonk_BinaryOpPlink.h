@@ -129,6 +129,17 @@
         p.buffers[2].buffer = rightBuffer.getArray();\
         \
         PLONK_PLINK_BINARYOPCHANNEL_FUNCTION(PLANKOP,F) (&p,0);\
+    }\
+    \
+    bool getPlinkKernel (PlinkKernel<float>& kernel) throw() {\
+        kernel.setFunction (&BinaryOpInternal::plinkKernel, 0);\
+        kernel.addInput (this->getInputAsUnit (IOKey::LeftOperand));\
+        kernel.addInput (this->getInputAsUnit (IOKey::RightOperand));\
+        return true;\
+    }\
+    \
+    static void plinkKernel (void* pp, void* /*state*/) throw() {\
+        PLONK_PLINK_BINARYOPCHANNEL_FUNCTION(PLANKOP,F) (pp,0);\
     }
 
 #define PLONK_PLINK_BINARYOPCHANNEL(PLONKOP, PLANKOP)\
@@ -0,0 +1,261 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_DISKRECORDCHANNEL_H
+#define PLONK_DISKRECORDCHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class DiskRecordChannelInternal;
+
+template<class SampleType>
+struct ChannelData< DiskRecordChannelInternal<SampleType> >
+{
+    ChannelInternalCore::Data base;
+};      
+
+//------------------------------------------------------------------------------
+
+/** Disk record channel. 
+ Copies its input to its output and queues the frames on a DiskRecorder. The 
+ recorder's ring has a single producer so the channel attaches to it, a second 
+ channel on the same recorder only passes its input through. */
+template<class SampleType>
+class DiskRecordChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, ChannelData< DiskRecordChannelInternal<SampleType> > >
+{
+public:
+    typedef ChannelData< DiskRecordChannelInternal<SampleType> >    Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ObjectArray<ChannelType>                                ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef DiskRecorderBase<SampleType>                            DiskRecorderType;
+    
+    DiskRecordChannelInternal (Inputs const& inputs,
+                               Data const& data,
+                               BlockSize const& blockSize,
+                               SampleRate const& sampleRate,
+                               ChannelArrayType& channels) throw()
+    :   Internal (numChannelsInSource (inputs), 
+                  inputs, data, blockSize, sampleRate,
+                  channels),
+        frames (Buffer::newClear (blockSize.getValue() * numChannelsInRecorder (inputs))),
+        attached (attachToRecorder (inputs))
+    {
+        plonk_assert (attached); // another DiskRecord unit is already writing to this recorder
+    }
+    
+    ~DiskRecordChannelInternal()
+    {
+        if (attached)
+            this->getInputAsDiskRecorder (IOKey::DiskRecorder).detach();
+    }
+            
+    Text getName() const throw()
+    {
+        return "Disk Record";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::DiskRecorder);
+        return keys;
+    }    
+        
+    void initChannel (const int channel) throw()
+    {               
+        this->initProxyValue (channel, 0);
+    }    
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {                
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        DiskRecorderType& recorder (this->getInputAsDiskRecorder (IOKey::DiskRecorder));
+        
+        const int numChannels = this->getNumChannels();
+        const int numRecorderChannels = recorder.getNumChannels();
+        const int maxFrames = frames.length() / numRecorderChannels;
+        SampleType* const frameSamples = frames.getArray();
+        
+        plonk_assert (inputUnit.channelsHaveSameBlockSize());
+        
+        int numFrames = 0;
+        int channel;
+        
+        for (channel = 0; channel < numChannels; ++channel)
+        {
+            const Buffer& inputBuffer (inputUnit.process (info, channel));
+            Buffer& outputBuffer (this->getOutputBuffer (channel));
+            
+            plonk_assert (inputBuffer.length() == outputBuffer.length());
+            
+            Buffer::copyData (outputBuffer.getArray(), inputBuffer.getArray(), outputBuffer.length());
+            numFrames = outputBuffer.length();
+        }
+        
+        if (! attached || recorder.isClosed())
+            return;
+        
+        // interleave in chunks that fit the preallocated frames, extra recorder channels are silent
+        for (int start = 0; start < numFrames; start += maxFrames)
+        {
+            const int numChunkFrames = plonk::min (numFrames - start, maxFrames);
+            
+            for (channel = 0; channel < numRecorderChannels; ++channel)
+            {
+                SampleType* frameSample = frameSamples + channel;
+                
+                if (channel < numChannels)
+                {
+                    const SampleType* const outputSamples = this->getOutputBuffer (channel).getArray() + start;
+                    
+                    for (int i = 0; i < numChunkFrames; ++i, frameSample += numRecorderChannels)
+                        *frameSample = outputSamples[i];
+                }
+                else
+                {
+                    for (int i = 0; i < numChunkFrames; ++i, frameSample += numRecorderChannels)
+                        *frameSample = SampleType (0);
+                }
+            }
+            
+            recorder.write (frameSamples, numChunkFrames);
+        }
+    }
+    
+private:
+    Buffer frames;
+    const bool attached;
+    
+    static PLONK_INLINE_LOW int numChannelsInSource (Inputs const& inputs) throw()
+    {
+        return inputs[IOKey::Generic].asUnchecked<UnitType>().getNumChannels();
+    }
+    
+    static PLONK_INLINE_LOW int numChannelsInRecorder (Inputs const& inputs) throw()
+    {
+        return inputs[IOKey::DiskRecorder].asUnchecked<DiskRecorderType>().getNumChannels();
+    }
+    
+    static PLONK_INLINE_LOW bool attachToRecorder (Inputs const& inputs) throw()
+    {
+        DiskRecorderType recorder (inputs[IOKey::DiskRecorder].asUnchecked<DiskRecorderType>());
+        return recorder.attach();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Record a unit to disk without blocking the audio thread.
+ 
+ The input is passed through to the output unchanged and also queued on a
+ DiskRecorder, which writes it to its AudioFileWriter in large batches on the
+ shared DiskRecorderThread. The audio thread only interleaves the channels 
+ into a preallocated block and copies it into the recorder's ring. If the ring
+ is full the frames are dropped and counted in the recorder's overflow counters.
+ Input channels beyond the number in the file are not recorded, extra file 
+ channels are recorded as silence. Only one DiskRecord unit may record to a 
+ recorder at a time, a second one asserts and only passes its input through.
+ 
+ @code
+ DiskRecorder recorder (AudioFileWriter<float> ("/path/to/take.wav", 64, 48000.0));
+ Unit capture = DiskRecord::ar (inputs, recorder);
+ ...
+ recorder.close();
+ @endcode
+ 
+ @par Factory functions:
+ - ar (input, recorder)
+ 
+ @par Inputs:
+ - input: (unit, multi) the input unit to record
+ - recorder: (diskrecorder) the recorder to queue the frames on
+ 
+ @see DiskRecorderBase
+ @ingroup MiscUnits */
+template<class SampleType>
+class DiskRecordUnit
+{
+public:    
+    typedef DiskRecordChannelInternal<SampleType>   DiskRecordInternal;
+    typedef typename DiskRecordInternal::Data       Data;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    typedef DiskRecorderBase<SampleType>            DiskRecorderType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        return UnitInfo ("DiskRecord", "Records samples to disk on a background thread (and copies them to its output).",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,        Measure::None,      IOInfo::NoDefault,  IOLimit::None,      IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,        Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::DiskRecorder,   Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::End);
+    }    
+    
+    /** Create an audio rate disk recorder. */
+    static UnitType ar (UnitType const& input,
+                        DiskRecorderType const& recorder) throw()
+    {                
+        plonk_assert (recorder.getNumChannels() > 0);
+        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);   
+        inputs.put (IOKey::DiskRecorder, recorder);
+        
+        Data data = { { -1.0, -1.0 } };
+        
+        return UnitType::template proxiesFromInputs<DiskRecordInternal> (inputs, 
+                                                                         data, 
+                                                                         input.getBlockSize (0), 
+                                                                         input.getSampleRate (0));
+    }
+};
+
+typedef DiskRecordUnit<PLONK_TYPE_DEFAULT> DiskRecord;
+
+#endif // PLONK_DISKRECORDCHANNEL_H
@@ -42,12 +42,427 @@
 #include "../channel/plonk_ChannelInternalCore.h"
 #include "../plonk_GraphForwardDeclarations.h"
 
+/** Processes the independent inputs of a mixer in parallel.
+ The roots are either the units in an array (for the unit mixer) or the
+ channels of a single unit (for the channel mixer). Roots that share any part 
+ of their graphs are grouped and each group is processed in order on one 
+ thread using its own ProcessInfo. The mixer sums the collected outputs in a
+ fixed order after the barrier so the result is the same as the serial mix.
+ 
+ Walking the graphs allocates so the groups are found on the I/O pool 
+ whenever the roots change and the new schedule is swapped in once it is 
+ ready. Until then the blocks are processed serially, which also initialises
+ any shared constants. */
+template<class SampleType>
+class MixerTaskBatchInternal : public TaskBatchInternal
+{
+public:
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef NumericalArray<SampleType>                  Buffer;
+    typedef NumericalArray2D<ChannelType,UnitType>      UnitsType;
+    
+    MixerTaskBatchInternal() throw()
+    :   TaskBatchInternal (TaskPool::getDefault().getNumWorkers()),
+        currentUnits (0),
+        currentUnit (0),
+        resetShouldDelete (false),
+        schedule (0),
+        builtSchedule (0),
+        buildJob (new BuildJob (this)),
+        buildJobContainer (buildJob)
+    {
+    }
+    
+    ~MixerTaskBatchInternal()
+    {
+        if (schedule != 0)
+            schedule->decrementRefCount();
+        
+        Schedule* const built = builtSchedule.swap (0);
+        
+        if (built != 0)
+            built->decrementRefCount();
+    }
+    
+    /** Prepare to process an array of units. 
+     @return @c true if this block can be processed in parallel. */
+    bool prepareUnits (UnitsType& units, const int numChannelsToUse) throw()
+    {
+        currentUnits = &units;
+        currentUnit = 0;
+        adoptBuiltSchedule();
+        
+        if ((schedule != 0) && schedule->matchesUnits (units, numChannelsToUse))
+            return schedule->canProcessInParallel();
+        
+        requestBuild (&units, 0, numChannelsToUse);
+        return false;
+    }
+    
+    /** Prepare to process the channels of a single unit.
+     @return @c true if this block can be processed in parallel. */
+    bool prepareChannels (UnitType& unit) throw()
+    {
+        currentUnits = 0;
+        currentUnit = &unit;
+        adoptBuiltSchedule();
+        
+        if ((schedule != 0) && schedule->matchesChannels (unit))
+            return schedule->canProcessInParallel();
+        
+        requestBuild (0, &unit, 1);
+        return false;
+    }
+    
+    /** Process all the groups and wait for them to finish. 
+     The should-delete flags of the groups are merged back into the mixer's info. */
+    void process (ProcessInfo& info, const bool allowAutoDelete, const bool resetAfterEachInput) throw()
+    {
+        const int numGroups = schedule->dependencies.getNumGroups();
+        const int numOutputs = schedule->outputs.length();
+        const Buffer** const outputArray = schedule->outputs.getArray();
+        
+        for (int i = 0; i < numOutputs; ++i)
+            outputArray[i] = 0;
+        
+        for (int group = 0; group < numGroups; ++group)
+        {
+            ProcessInfo& groupInfo = schedule->infos.atUnchecked (group);
+            groupInfo.setTimeStamp (info.getTimeStamp());
+            
+            if (info.getShouldDelete())
+                groupInfo.setShouldDelete();
+            else
+                groupInfo.resetShouldDelete();
+        }
+        
+        resetShouldDelete = (allowAutoDelete == false) && resetAfterEachInput;
+        this->run (TaskPool::getDefault(), numGroups);
+        
+        if (allowAutoDelete)
+        {
+            for (int group = 0; group < numGroups; ++group)
+                if (schedule->infos.atUnchecked (group).getShouldDelete())
+                    info.setShouldDelete();
+        }
+        else
+        {
+            info.resetShouldDelete();
+        }
+    }
+    
+    /** Get an input's output buffer from the last call to process().
+     For units the index is (unit * numChannels + channel), for channels it is the channel.
+     This is null if the input was skipped as it had expired. */
+    PLONK_INLINE_LOW const Buffer* getOutput (const int index) const throw()
+    {
+        return schedule->outputs.atUnchecked (index);
+    }
+    
+    void runItem (const int group) throw()
+    {
+        ProcessInfo& groupInfo = schedule->infos.atUnchecked (group);
+        const int* const roots = schedule->groupRoots.getArray();
+        const int end = schedule->groupStarts.atUnchecked (group + 1);
+        const int numChannels = schedule->numChannels;
+        
+        for (int i = schedule->groupStarts.atUnchecked (group); i < end; ++i)
+        {
+            const int root = roots[i];
+            
+            if (currentUnits != 0)
+            {
+                UnitType& inputUnit (currentUnits->atUnchecked (root));
+                
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    if (! inputUnit.wrapAt (channel).shouldBeDeletedNow (groupInfo.getTimeStamp()))
+                    {
+                        plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+
+                        schedule->outputs.atUnchecked (root * numChannels + channel) = &inputUnit.process (groupInfo, channel);
+                        
+                        if (resetShouldDelete)
+                            groupInfo.resetShouldDelete();
+                    }
+                }
+            }
+            else
+            {
+                plonk_assert (currentUnit->getOverlap (root) == Math<DoubleVariable>::get1());
+                schedule->outputs.atUnchecked (root) = &currentUnit->process (groupInfo, root);
+            }
+        }
+    }
+    
+private:
+    /** The groups found by walking the graphs of one set of roots. 
+     The roots are held so the audio thread can check the schedule still 
+     applies by comparing pointers, which doesn't allocate. */
+    class Schedule : public SmartPointer
+    {
+    public:
+        Schedule (const int numChannelsToUse, const int revision) throw()
+        :   numChannels (numChannelsToUse),
+            inputsRevision (revision)
+        {
+        }
+        
+        bool matchesUnits (UnitsType const& units, const int numChannelsToUse) const throw()
+        {
+            const int numUnits = units.length();
+            
+            if ((numChannelsToUse != numChannels) || (cachedChannels.length() != 0) || 
+                (numUnits != cachedUnits.length()) || (GraphDependencies::getInputsRevision() != inputsRevision))
+                return false;
+            
+            for (int i = 0; i < numUnits; ++i)
+                if (units.atUnchecked (i).getInternal() != cachedUnits.atUnchecked (i).getInternal())
+                    return false;
+            
+            return true;
+        }
+        
+        bool matchesChannels (UnitType const& unit) const throw()
+        {
+            const int numUnitChannels = unit.getNumChannels();
+            
+            if ((cachedUnits.length() != 0) || (numUnitChannels != cachedChannels.length()) || 
+                (GraphDependencies::getInputsRevision() != inputsRevision))
+                return false;
+            
+            for (int i = 0; i < numUnitChannels; ++i)
+                if (unit.atUnchecked (i).getInternal() != cachedChannels.atUnchecked (i).getInternal())
+                    return false;
+            
+            return true;
+        }
+        
+        PLONK_INLINE_LOW bool canProcessInParallel() const throw()
+        {
+            return !dependencies.isSerial() && (dependencies.getNumGroups() > 1);
+        }
+        
+        void addUnits (ObjectArray<UnitType> const& units) throw()
+        {
+            const int numUnits = units.length();
+            cachedUnits.setSize (numUnits, false);
+            dependencies.reset (numUnits);
+            
+            for (int i = 0; i < numUnits; ++i)
+            {
+                cachedUnits.atUnchecked (i) = units.atUnchecked (i);
+                dependencies.addUnit (units.atUnchecked (i), i);
+            }
+        }
+        
+        void addChannels (ObjectArray<ChannelType> const& channels) throw()
+        {
+            const int numUnitChannels = channels.length();
+            cachedChannels.setSize (numUnitChannels, false);
+            dependencies.reset (numUnitChannels);
+            
+            for (int i = 0; i < numUnitChannels; ++i)
+            {
+                cachedChannels.atUnchecked (i) = channels.atUnchecked (i);
+                channels.atUnchecked (i).getInternal()->addDependencies (dependencies, i);
+            }
+        }
+        
+        void findGroups() throw()
+        {
+            dependencies.findGroups();
+            
+            const int numRoots = dependencies.getNumRoots();
+            const int numGroups = dependencies.getNumGroups();
+            
+            // sort the roots by group keeping them in order within each group
+            groupStarts.setSize (numGroups + 1, false);
+            groupRoots.setSize (numRoots, false);
+            
+            int* const starts = groupStarts.getArray();
+            int* const roots = groupRoots.getArray();
+            int group, root;
+            
+            for (group = 0; group <= numGroups; ++group)
+                starts[group] = 0;
+            
+            for (root = 0; root < numRoots; ++root)
+                ++starts[dependencies.getGroup (root) + 1];
+            
+            for (group = 0; group < numGroups; ++group)
+                starts[group + 1] += starts[group];
+            
+            IntArray positions (groupStarts.copy());
+            
+            for (root = 0; root < numRoots; ++root)
+                roots[positions.atUnchecked (dependencies.getGroup (root))++] = root;
+            
+            infos.setSize (numGroups, false);
+            
+            for (group = 0; group < numGroups; ++group)
+                infos.atUnchecked (group) = ProcessInfo();
+            
+            outputs.setSize (numRoots * numChannels, false);
+        }
+        
+        const int numChannels;
+        const int inputsRevision;
+        GraphDependencies dependencies;
+        ObjectArray<UnitType> cachedUnits;
+        ObjectArray<ChannelType> cachedChannels;
+        IntArray groupStarts;
+        IntArray groupRoots;
+        ObjectArray<ProcessInfo> infos;
+        ObjectArray<const Buffer*> outputs;
+    };
+    
+    /** Builds a schedule on the I/O pool, one is made for each batch and rescheduled.
+     The roots to walk are copied by the audio thread into arrays the job has
+     allocated, and only while the job is Idle. If there isn't room the job 
+     grows the arrays instead of building and the audio thread asks again. 
+     Scheduling takes a reference to the batch that is released once the 
+     job is idle again. */
+    class BuildJob : public TaskJobInternal
+    {
+    public:
+        enum States { Idle, Queued };
+        
+        BuildJob (MixerTaskBatchInternal* batchToUse) throw()
+        :   batch (batchToUse),
+            forUnits (false),
+            numChannels (0),
+            inputsRevision (0),
+            sizeNeeded (0),
+            state (Idle)
+        {
+        }
+        
+        void run() throw()
+        {
+            if (sizeNeeded > 0)
+            {
+                grow (units, sizeNeeded);
+                grow (channels, sizeNeeded);
+                sizeNeeded = 0;
+            }
+            else
+            {
+                Schedule* const built = new Schedule (numChannels, inputsRevision);
+                
+                if (forUnits)
+                    built->addUnits (units);
+                else
+                    built->addChannels (channels);
+                
+                built->findGroups();
+                built->incrementRefCount();
+                
+                Schedule* const unadopted = batch->builtSchedule.swap (built);
+                
+                if (unadopted != 0)
+                    unadopted->decrementRefCount();
+                
+                // release the roots here rather than on the audio thread
+                units.setSize (0, false);
+                channels.setSize (0, false);
+            }
+            
+            MixerTaskBatchInternal* const owner = batch;
+            state.setValue (Idle);
+            owner->decrementRefCount(); // may delete the batch, the pool still holds this job
+        }
+        
+        template<class ArrayType>
+        static void grow (ArrayType& array, const int size) throw()
+        {
+            if (array.sizeAllocated() < size)
+            {
+                array.setSize (size * 2, false);
+                array.setSize (0, false);
+            }
+        }
+        
+        MixerTaskBatchInternal* const batch;
+        ObjectArray<UnitType> units;
+        ObjectArray<ChannelType> channels;
+        bool forUnits;
+        int numChannels;
+        int inputsRevision;
+        int sizeNeeded;
+        AtomicInt state;
+    };
+    
+    void adoptBuiltSchedule() throw()
+    {
+        Schedule* const built = builtSchedule.swap (0);
+        
+        if (built != 0)
+        {
+            if (schedule != 0)
+                schedule->decrementRefCount();
+            
+            schedule = built;
+        }
+    }
+    
+    /** Queue a walk of either the units or the channels of a unit, unless one 
+     is already on its way. Only references are copied here so this doesn't allocate. */
+    void requestBuild (UnitsType const* const units, UnitType const* const unit, const int numChannels) throw()
+    {
+        if (buildJob->state.getValue() != BuildJob::Idle)
+            return;
+        
+        const int numRoots = (units != 0) ? units->length() : unit->getNumChannels();
+        
+        if ((buildJob->units.sizeAllocated() < numRoots) || (buildJob->channels.sizeAllocated() < numRoots))
+        {
+            buildJob->sizeNeeded = numRoots;
+        }
+        else if (units != 0)
+        {
+            buildJob->units.setSize (numRoots, false);
+            
+            for (int i = 0; i < numRoots; ++i)
+                buildJob->units.atUnchecked (i) = units->atUnchecked (i);
+        }
+        else
+        {
+            buildJob->channels.setSize (numRoots, false);
+            
+            for (int i = 0; i < numRoots; ++i)
+                buildJob->channels.atUnchecked (i) = unit->atUnchecked (i);
+        }
+        
+        buildJob->forUnits = units != 0;
+        buildJob->numChannels = numChannels;
+        buildJob->inputsRevision = GraphDependencies::getInputsRevision();
+        buildJob->state.setValue (BuildJob::Queued);
+        
+        this->incrementRefCount();
+        TaskPool::getIO().schedule (buildJobContainer);
+    }
+    
+    UnitsType* currentUnits;
+    UnitType* currentUnit;
+    bool resetShouldDelete;
+    
+    Schedule* schedule;
+    AtomicValue<Schedule*> builtSchedule;
+    BuildJob* const buildJob;
+    TaskJob buildJobContainer;
+};
+
+//------------------------------------------------------------------------------
+
 template<class SampleType> class ChannelMixerChannelInternal;
 
 PLONK_CHANNELDATA_DECLARE(ChannelMixerChannelInternal,SampleType)
 {    
     ChannelInternalCore::Data base;
     bool allowAutoDelete;//:1;
+    bool parallel;//:1;
 };      
 
 
@@ -66,12 +481,15 @@ public:
     typedef UnitBase<SampleType>                                                UnitType;
     typedef InputDictionary                                                     Inputs;
     typedef NumericalArray<SampleType>                                          Buffer;
+    typedef MixerTaskBatchInternal<SampleType>                                  BatchInternal;
+    typedef SmartPointerContainer<BatchInternal>                                Batch;
     
     ChannelMixerChannelInternal (Inputs const& inputs, 
                                  Data const& data, 
                                  BlockSize const& blockSize,
                                  SampleRate const& sampleRate) throw()
-    :   Internal (inputs, data, blockSize, sampleRate)
+    :   Internal (inputs, data, blockSize, sampleRate),
+        batch (data.parallel ? new BatchInternal() : 0)
     {
     }
     
@@ -113,6 +531,8 @@ public:
     {
         int i;
         
+        const Data& data = this->getState();
+
         this->getOutputBuffer().zero();
         SampleType* const outputSamples = this->getOutputSamples();
         const int outputBufferLength = this->getOutputBuffer().length();
@@ -120,12 +540,16 @@ public:
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         
         const int numChannels = inputUnit.getNumChannels();
+        const bool parallel = batch.isNotNull() && batch.getInternal()->prepareChannels (inputUnit);
+        
+        if (parallel)
+            batch.getInternal()->process (info, data.allowAutoDelete, false);
         
         for (int channel = 0; channel < numChannels; ++channel)
         {
             plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
             
-            const Buffer& inputBuffer (inputUnit.process (info, channel));
+            const Buffer& inputBuffer (parallel ? *batch.getInternal()->getOutput (channel) : inputUnit.process (info, channel));
             const SampleType* const inputSamples = inputBuffer.getArray();
             const int inputBufferLength = inputBuffer.length();
             
@@ -150,11 +574,12 @@ public:
             }
         }
         
-        const Data& data = this->getState();
-        
         if (data.allowAutoDelete == false)
             info.resetShouldDelete();
     }
+    
+private:
+    Batch batch;
 };
 
 //------------------------------------------------------------------------------
@@ -167,6 +592,7 @@ PLONK_CHANNELDATA_DECLARE(UnitMixerChannelInternal,SampleType)
     int preferredNumChannels;
     bool allowAutoDelete;//:1;
     bool purgeExpiredUnits;//:1;
+    bool parallel;//:1;
 };      
 
 
@@ -185,6 +611,8 @@ public:
     typedef InputDictionary                                                     Inputs;
     typedef NumericalArray<SampleType>                                          Buffer;
     typedef NumericalArray2D<ChannelType,UnitType>                              UnitsType;
+    typedef MixerTaskBatchInternal<SampleType>                                  BatchInternal;
+    typedef SmartPointerContainer<BatchInternal>                                Batch;
         
     UnitMixerChannelInternal (Inputs const& inputs, 
                               Data const& data, 
@@ -192,7 +620,8 @@ public:
                               SampleRate const& sampleRate,
                               ChannelArrayType& channels) throw()
     :   Internal (data.preferredNumChannels > 0 ? data.preferredNumChannels : inputs.getMaxNumChannels(),
-                  inputs, data, blockSize, sampleRate, channels)
+                  inputs, data, blockSize, sampleRate, channels),
+        batch (data.parallel ? new BatchInternal() : 0)
     {
     }
 
@@ -247,6 +676,10 @@ public:
         
         const int numChannels = this->getNumChannels();
         const int numUnits = units.length();
+        const bool parallel = batch.isNotNull() && batch.getInternal()->prepareUnits (units, numChannels);
+        
+        if (parallel)
+            batch.getInternal()->process (info, data.allowAutoDelete, true);
         
         // ..and process.
         for (channel = 0; channel < numChannels; ++channel)
@@ -258,13 +691,30 @@ public:
             
             for (unit = 0; unit < numUnits; ++unit)
             {
-                UnitType& inputUnit (units.atUnchecked (unit));
+                const Buffer* inputBufferPtr = 0;
                 
-                if (! inputUnit.wrapAt (channel).shouldBeDeletedNow (info.getTimeStamp()))
+                if (parallel)
                 {
-                    plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+                    // already processed, just sum in the same order as below
+                    inputBufferPtr = batch.getInternal()->getOutput (unit * numChannels + channel);
+                }
+                else 
+                {
+                    UnitType& inputUnit (units.atUnchecked (unit));
                     
-                    const Buffer& inputBuffer (inputUnit.process (info, channel));
+                    if (! inputUnit.wrapAt (channel).shouldBeDeletedNow (info.getTimeStamp()))
+                    {
+                        plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+                        inputBufferPtr = &inputUnit.process (info, channel);
+                        
+                        if (data.allowAutoDelete == false)
+                            info.resetShouldDelete();    
+                    }
+                }
+                
+                if (inputBufferPtr != 0)
+                {
+                    const Buffer& inputBuffer (*inputBufferPtr);
                     const SampleType* const inputSamples = inputBuffer.getArray();
                     const int inputBufferLength = inputBuffer.length();
                     
@@ -287,13 +737,13 @@ public:
                             inputPosition += inputIncrement;
                         }        
                     }
-                    
-                    if (data.allowAutoDelete == false)
-                        info.resetShouldDelete();    
                 }
             }
         }
     }    
+    
+private:
+    Batch batch;
 };
 
 //------------------------------------------------------------------------------
@@ -479,11 +929,15 @@ public:
     typedef UnaryOpChannelInternal<float,UnaryOpFunctionsType::move>    UnaryOpChannel;
     typedef UnaryOpChannel::Process                                     UnaryProcess;
     
+    typedef MixerTaskBatchInternal<float>                               BatchInternal;
+    typedef SmartPointerContainer<BatchInternal>                        Batch;
+    
     ChannelMixerChannelInternal (Inputs const& inputs, 
                                  Data const& data, 
                                  BlockSize const& blockSize,
                                  SampleRate const& sampleRate) throw()
-    :   Internal (inputs, data, blockSize, sampleRate)
+    :   Internal (inputs, data, blockSize, sampleRate),
+        batch (data.parallel ? new BatchInternal() : 0)
     {
         plonk_staticassert (BinaryOpChannel::NumBuffers == (BinaryOpChannel::NumInputs + BinaryOpChannel::NumOutputs));
         Process::init (&p, this, BinaryOpChannel::NumOutputs, BinaryOpChannel::NumInputs);
@@ -525,12 +979,18 @@ public:
     
     void process (ProcessInfo& info, const int /*channel*/) throw()
     {        
+        const Data& data = this->getState();
+
         float* const outputSamples = this->getOutputSamples();
         const int outputBufferLength = this->getOutputBuffer().length();
         pl_VectorClearF_N (outputSamples, outputBufferLength);
         
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         const int numChannels = inputUnit.getNumChannels();
+        const bool parallel = batch.isNotNull() && batch.getInternal()->prepareChannels (inputUnit);
+        
+        if (parallel)
+            batch.getInternal()->process (info, data.allowAutoDelete, false);
         
         p.buffers[0].bufferSize = outputBufferLength;
         p.buffers[0].buffer     = outputSamples;
@@ -539,7 +999,7 @@ public:
         {
             plonk_assert (inputUnit.getOverlap (0) == Math<DoubleVariable>::get1());
             
-            const Buffer& inputBuffer (inputUnit.process (info, 0));
+            const Buffer& inputBuffer (parallel ? *batch.getInternal()->getOutput (0) : inputUnit.process (info, 0));
             const float* const inputSamples = inputBuffer.getArray();
             const int inputBufferLength = inputBuffer.length();
             
@@ -563,7 +1023,7 @@ public:
         {
             plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
             
-            const Buffer& inputBuffer (inputUnit.process (info, channel));
+            const Buffer& inputBuffer (parallel ? *batch.getInternal()->getOutput (channel) : inputUnit.process (info, channel));
             const float* const inputSamples = inputBuffer.getArray();
             const int inputBufferLength = inputBuffer.length();
             
@@ -579,14 +1039,13 @@ public:
             }
         }
         
-        const Data& data = this->getState();
-        
         if (data.allowAutoDelete == false)
             info.resetShouldDelete();
     }
     
 private:
     Process p;
+    Batch batch;
 };
 
 
@@ -607,6 +1066,9 @@ public:
 
     typedef BinaryOpChannelInternal<float,BinaryOpFunctionsType::addop> BinaryOpChannel;
     typedef BinaryOpChannel::Process                                    Process;
+    
+    typedef MixerTaskBatchInternal<float>                               BatchInternal;
+    typedef SmartPointerContainer<BatchInternal>                        Batch;
 
     UnitMixerChannelInternal (Inputs const& inputs, 
                               Data const& data, 
@@ -614,7 +1076,8 @@ public:
                               SampleRate const& sampleRate,
                               ChannelArrayType& channels) throw()
     :   Internal (data.preferredNumChannels > 0 ? data.preferredNumChannels : inputs.getMaxNumChannels(),
-                  inputs, data, blockSize, sampleRate, channels)
+                  inputs, data, blockSize, sampleRate, channels),
+        batch (data.parallel ? new BatchInternal() : 0)
     {
         plonk_staticassert (BinaryOpChannel::NumBuffers == (BinaryOpChannel::NumInputs + BinaryOpChannel::NumOutputs));
         Process::init (&p, this, BinaryOpChannel::NumOutputs, BinaryOpChannel::NumInputs);
@@ -669,6 +1132,10 @@ public:
         
         const int numChannels = this->getNumChannels();
         const int numUnits = units.length();
+        const bool parallel = batch.isNotNull() && batch.getInternal()->prepareUnits (units, numChannels);
+        
+        if (parallel)
+            batch.getInternal()->process (info, data.allowAutoDelete, true);
         
         // ..and process.
         for (channel = 0; channel < numChannels; ++channel)
@@ -685,13 +1152,30 @@ public:
 
             for (unit = 0; unit < numUnits; ++unit)
             {
-                UnitType& inputUnit (units.atUnchecked (unit));
+                const Buffer* inputBufferPtr = 0;
                 
-                if (! inputUnit.wrapAt (channel).shouldBeDeletedNow (info.getTimeStamp()))
+                if (parallel)
                 {
-                    plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+                    // already processed, just sum in the same order as below
+                    inputBufferPtr = batch.getInternal()->getOutput (unit * numChannels + channel);
+                }
+                else 
+                {
+                    UnitType& inputUnit (units.atUnchecked (unit));
                     
-                    const Buffer& inputBuffer (inputUnit.process (info, channel));
+                    if (! inputUnit.wrapAt (channel).shouldBeDeletedNow (info.getTimeStamp()))
+                    {
+                        plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+                        inputBufferPtr = &inputUnit.process (info, channel);
+                        
+                        if (data.allowAutoDelete == false)
+                            info.resetShouldDelete();    
+                    }
+                }
+                
+                if (inputBufferPtr != 0)
+                {
+                    const Buffer& inputBuffer (*inputBufferPtr);
                     const float* const inputSamples = inputBuffer.getArray();
                     const int inputBufferLength = inputBuffer.length();
                     
@@ -705,9 +1189,6 @@ public:
                         p.buffers[2].buffer     = inputBuffer.getArray();
                         plink_BinaryOpProcessAddF_NNn (&p, 0);
                     }
-                    
-                    if (data.allowAutoDelete == false)
-                        info.resetShouldDelete();    
                 }
             }
         }
@@ -715,6 +1196,7 @@ public:
     
 private:
     Process p;
+    Batch batch;
 };
 
 
@@ -730,6 +1212,8 @@ private:
  - ar (input, allowAutoDelete=true, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
  - ar (array, allowAutoDelete=true, purgeNullUnits=true, preferredNumChannels=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
  - ar (queue, allowAutoDelete=true, purgeNullUnits=true, preferredNumChannels=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - arParallel (input, allowAutoDelete=true, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - arParallel (array, allowAutoDelete=true, purgeNullUnits=true, preferredNumChannels=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
  
  @par Inputs:
  - input: (unit) the input unit to mix
@@ -742,6 +1226,10 @@ private:
  - add: (unit, multi) the offset added to the output
  - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
  - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ The arParallel() versions process the independent inputs on the TaskPool worker 
+ threads. Inputs that share any units, busses or variables are processed together 
+ on the same thread. The result is the same as the serial mix.
 
  @ingroup MathsUnits */
 template<class SampleType>
@@ -826,7 +1314,30 @@ public:
         inputs.put (IOKey::Multiply, mul);
         inputs.put (IOKey::Add, add);
         
-        Data data = { { -1.0, -1.0 }, allowAutoDelete };
+        Data data = { { -1.0, -1.0 }, allowAutoDelete, false };
+        
+        return UnitType::template createFromInputs<ChannelMixerInternal> (inputs, 
+                                                                          data, 
+                                                                          preferredBlockSize, 
+                                                                          preferredSampleRate);
+    }
+    
+    /** Create an audio rate channel mixer that processes independent input channels in parallel. */
+    static UnitType arParallel (UnitType const& input, 
+                                const bool allowAutoDelete = true,
+                                UnitType const& mul = SampleType (1),
+                                UnitType const& add = SampleType (0),
+                                BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                                SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {           
+        typedef PLONK_CHANNELDATA_NAME(ChannelMixerChannelInternal,SampleType) Data;
+
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+        
+        Data data = { { -1.0, -1.0 }, allowAutoDelete, true };
         
         return UnitType::template createFromInputs<ChannelMixerInternal> (inputs, 
                                                                           data, 
@@ -851,7 +1362,32 @@ public:
         inputs.put (IOKey::Multiply, mul);
         inputs.put (IOKey::Add, add);
         
-        Data data = { { -1.0, -1.0 }, preferredNumChannels, allowAutoDelete, purgeExpiredUnits };
+        Data data = { { -1.0, -1.0 }, preferredNumChannels, allowAutoDelete, purgeExpiredUnits, false };
+        
+        return UnitType::template proxiesFromInputs<UnitMixerInternal> (inputs, 
+                                                                        data, 
+                                                                        preferredBlockSize, 
+                                                                        preferredSampleRate);
+    }
+    
+    /** Create an audio rate unit mixer that processes independent units in parallel. */
+    static UnitType arParallel (UnitsType const& array, 
+                                const bool allowAutoDelete = true,
+                                const bool purgeExpiredUnits = true,
+                                const int preferredNumChannels = 0,
+                                UnitType const& mul = SampleType (1),
+                                UnitType const& add = SampleType (0),
+                                BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                                SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {        
+        typedef PLONK_CHANNELDATA_NAME(UnitMixerChannelInternal,SampleType) Data;
+
+        Inputs inputs;
+        inputs.put (IOKey::Units, array);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+        
+        Data data = { { -1.0, -1.0 }, preferredNumChannels, allowAutoDelete, purgeExpiredUnits, true };
         
         return UnitType::template proxiesFromInputs<UnitMixerInternal> (inputs, 
                                                                         data, 
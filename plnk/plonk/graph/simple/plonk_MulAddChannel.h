@@ -333,6 +333,20 @@ public:
         plink_MulAddProcessF (&p, 0);
     }
     
+    bool getPlinkKernel (PlinkKernel<float>& kernel) throw()
+    {
+        kernel.setFunction (&MulAddInternal::plinkKernel, 0);
+        kernel.addInput (this->getInputAsUnit (IOKey::Generic));
+        kernel.addInput (this->getInputAsUnit (IOKey::Multiply));
+        kernel.addInput (this->getInputAsUnit (IOKey::Add));
+        return true;
+    }
+    
+    static void plinkKernel (void* pp, void* /*state*/) throw()
+    {
+        plink_MulAddProcessF (pp, 0);
+    }
+    
 private:
     Process p;
 };
@@ -0,0 +1,277 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_PARAMEVENTCHANNEL_H
+#define PLONK_PARAMEVENTCHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../utility/plonk_ParamEvents.h"
+
+template<class SampleType> class ParamEventChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(ParamEventChannelInternal,SampleType)
+{
+    ChannelInternalCore::Data base;
+    int target;
+    int numSmoothSamplesRemaining;
+    SampleType currValue;
+    SampleType targetValue;
+    SampleType inc;
+};
+
+/** Parameter event channel. */
+template<class SampleType>
+class ParamEventChannelInternal 
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(ParamEventChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(ParamEventChannelInternal,SampleType)    Data;
+    typedef ChannelBase<SampleType>                                         ChannelType;
+    typedef ParamEventChannelInternal<SampleType>                           ParamEventChannelInternalType;
+    typedef ChannelInternal<SampleType,Data>                                Internal;
+    typedef ChannelInternalBase<SampleType>                                 InternalBase;
+    typedef UnitBase<SampleType>                                            UnitType;
+    typedef InputDictionary                                                 Inputs;
+    typedef NumericalArray<SampleType>                                      Buffer;
+    typedef ParamEventsBase<SampleType>                                     ParamEventsType;
+    typedef typename ParamEventsType::Event                                 Event;
+    
+    ParamEventChannelInternal (Inputs const& inputs, 
+                               Data const& data,
+                               BlockSize const& blockSize,
+                               SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate)
+    {
+    }
+    
+    Text getName() const throw()
+    {        
+        return "Param Event";
+    }        
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::ParamEvents, IOKey::SampleCount);
+        return keys;
+    }    
+    
+    InternalBase* getChannel (const int /*index*/) throw()
+    {
+        return this;
+    }        
+    
+    void initChannel (const int /*channel*/) throw()
+    {
+        this->initValue (this->getState().currValue);
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        Data& data = this->getState();
+        ParamEventsType& events = this->getInputAsParamEvents (IOKey::ParamEvents);
+        const int numSmoothSamples = ChannelInternalCore::getInputAs<IntVariable> (IOKey::SampleCount).getValue();
+        const TimeStamp& blockTime = info.getTimeStamp();
+        const double sampleDurationTicks = this->getSampleDurationInTicks();
+        
+        SampleType* const outputSamples = this->getOutputSamples();
+        const int outputBufferLength = this->getOutputBuffer().length();
+        
+        events.drain (data.target);
+        
+        int numEvents;
+        const Event* const pending = events.getPending (data.target, numEvents);
+        int numConsumed = 0;
+        int i = 0;
+        
+        for (;;)
+        {
+            int eventOffset = outputBufferLength;
+            
+            if (numConsumed < numEvents)
+            {
+                // late events are applied at the start of this block
+                const double offset = (pending[numConsumed].time - blockTime).getValue() / sampleDurationTicks;
+                
+                if (offset < double (outputBufferLength))
+                    eventOffset = (offset <= double (i)) ? i : int (offset + 0.5);
+            }
+            
+            // render up to the next event
+            const int numSmoothSamplesThisTime = plonk::min (data.numSmoothSamplesRemaining, eventOffset - i);
+            
+            for (int j = 0; j < numSmoothSamplesThisTime; ++j)
+            {
+                outputSamples[i++] = data.currValue;
+                data.currValue += data.inc;
+            }
+            
+            data.numSmoothSamplesRemaining -= numSmoothSamplesThisTime;
+            
+            if ((numSmoothSamplesThisTime > 0) && (data.numSmoothSamplesRemaining == 0))
+                data.currValue = data.targetValue;
+            
+            while (i < eventOffset)
+                outputSamples[i++] = data.currValue;
+            
+            if (eventOffset >= outputBufferLength)
+                break;
+            
+            // start the change for this event
+            data.targetValue = pending[numConsumed++].value;
+            
+            if (numSmoothSamples > 0)
+            {
+                data.numSmoothSamplesRemaining = numSmoothSamples;
+                data.inc = (data.targetValue - data.currValue) / SampleType (numSmoothSamples);
+            }
+            else
+            {
+                data.numSmoothSamplesRemaining = 0;
+                data.currValue = data.targetValue;
+            }
+        }
+        
+        events.consume (data.target, numConsumed);
+    }
+};
+
+
+
+//------------------------------------------------------------------------------
+
+/** Parameter event unit.
+ Outputs a parameter value changed by timestamped events pushed to a
+ ParamEvents queue from other threads. Each event takes effect at the sample 
+ given by its time stamp, so several changes in one block are all heard. 
+ 
+ @par Factory functions:
+ - ar (events, target=0, initValue=0, numSmoothSamples=0, preferredBlockSize=default)
+ - kr (events, target=0, initValue=0)
+ 
+ @par Inputs:
+ - events: (paramevents) the queue of events
+ - target: (int) the index of the target in the queue to follow
+ - initValue: (value) the output before the first event
+ - numSmoothSamples: (intvariable) the number of samples over which to ramp to each new value, 0 changes the value in one sample 
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ 
+ @ingroup ControlUnits */
+template<class SampleType>
+class ParamEventUnit
+{
+public:    
+    typedef ParamEventChannelInternal<SampleType>           ParamEventChannelInternalType;
+    typedef typename ParamEventChannelInternalType::Data    Data;
+    typedef ChannelBase<SampleType>                         ChannelType;
+    typedef ChannelInternal<SampleType,Data>                Internal;
+    typedef ChannelInternalBase<SampleType>                 InternaBase;
+    typedef UnitBase<SampleType>                            UnitType;
+    typedef InputDictionary                                 Inputs;
+    typedef NumericalArray<SampleType>                      Buffer;
+    typedef ParamEventsBase<SampleType>                     ParamEventsType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        
+        return UnitInfo ("ParamEvent", "A parameter value set by sample accurate timestamped events.",
+                         
+                         // output
+                         1, 
+                         IOKey::Generic,        Measure::None,      IOInfo::NoDefault,  IOLimit::None, 
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::ParamEvents,    Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::SampleCount,    Measure::Samples,   0.0,                IOLimit::Minimum, Measure::Samples,             0.0,
+                         IOKey::BlockSize,      Measure::Samples,   blockSize,          IOLimit::Minimum, Measure::Samples,             1.0,
+                         IOKey::End);
+    }    
+    
+    /** Create an audio rate parameter following one target of an event queue. */
+    static UnitType ar (ParamEventsType const& events,
+                        const int target = 0,
+                        SampleType const& initValue = SampleType (0),
+                        IntVariable const& numSmoothSamples = 0,
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault()) throw()
+    {
+        plonk_assert ((target >= 0) && (target < events.getNumTargets()));
+        plonk_assert (numSmoothSamples.getValue() >= 0);
+        
+        Inputs inputs;
+        inputs.put (IOKey::ParamEvents, events);
+        inputs.put (IOKey::SampleCount, numSmoothSamples);
+        
+        Data data = { { -1.0, -1.0 }, target, 0, initValue, initValue, SampleType (0) };
+        
+        const SampleRate preferredSampleRate = (preferredBlockSize == BlockSize::getDefault())
+                                             ? SampleRate::getDefault()
+                                             : (SampleRate::getDefault() / BlockSize::getDefault()) * preferredBlockSize;
+        
+        return UnitType::template createFromInputs<ParamEventChannelInternalType> (inputs, 
+                                                                                   data,
+                                                                                   preferredBlockSize,
+                                                                                   preferredSampleRate);
+    }   
+    
+    /** Create a control rate parameter following one target of an event queue. */
+    static UnitType kr (ParamEventsType const& events,
+                        const int target = 0,
+                        SampleType const& initValue = SampleType (0)) throw()
+    {
+        plonk_assert ((target >= 0) && (target < events.getNumTargets()));
+        
+        Inputs inputs;
+        inputs.put (IOKey::ParamEvents, events);
+        inputs.put (IOKey::SampleCount, IntVariable (0));
+        
+        Data data = { { -1.0, -1.0 }, target, 0, initValue, initValue, SampleType (0) };
+        
+        return UnitType::template createFromInputs<ParamEventChannelInternalType> (inputs, 
+                                                                                   data, 
+                                                                                   BlockSize::getControlRateBlockSize(), 
+                                                                                   SampleRate::getControlRate());        
+    }
+};
+
+typedef ParamEventUnit<PLONK_TYPE_DEFAULT> ParamEvent;
+
+
+
+#endif // PLONK_PARAMEVENTCHANNEL_H
@@ -160,6 +160,9 @@ private:
 /** Queue unit.
  Plays a queue of units in sequence.
  
+ Construct the queue with a capacity (e.g., UnitQueue queue (64)) to avoid
+ allocating as units are queued, pushes then fail once the queue is full.
+ 
  @par Factory functions:
  - ar (queue, preferredNumChannels, preferredBlockSize=default, preferredSampleRate=default)
  - kr (queue, preferredNumChannels)
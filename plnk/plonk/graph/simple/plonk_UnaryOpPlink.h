@@ -116,6 +116,16 @@
         p.buffers[1].buffer = operandBuffer.getArray();\
         \
         PLONK_PLINK_UNARYOPCHANNEL_FUNCTION(PLANKOP,F) (&p,0);\
+    }\
+    \
+    bool getPlinkKernel (PlinkKernel<float>& kernel) throw() {\
+        kernel.setFunction (&UnaryOpInternal::plinkKernel, 0);\
+        kernel.addInput (this->getInputAsUnit (IOKey::Generic));\
+        return true;\
+    }\
+    \
+    static void plinkKernel (void* pp, void* /*state*/) throw() {\
+        PLONK_PLINK_UNARYOPCHANNEL_FUNCTION(PLANKOP,F) (pp,0);\
     }
 
 #define PLONK_PLINK_UNARYOPCHANNEL(PLONKOP, PLANKOP)\
@@ -0,0 +1,273 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+GraphDependencies::GraphDependencies() throw()
+:   numNodes (0),
+    numRoots (0),
+    numGroups (0),
+    serial (false)
+{
+}
+
+static PLONK_INLINE_LOW int graphDependenciesHash (const void* node, const int mask) throw()
+{
+    const UnsignedLong bits = reinterpret_cast<UnsignedLong> (node);
+    return int (((bits >> 4) * 2654435761UL) & UnsignedLong (mask));
+}
+
+void GraphDependencies::reset (const int numRootsToUse) throw()
+{
+    const int minimumSize = 256;
+    
+    numRoots = numRootsToUse;
+    numNodes = 0;
+    numGroups = 0;
+    serial = false;
+    
+    if (nodes.length() < minimumSize)
+    {
+        nodes.setSize (minimumSize, false);
+        nodeRoots.setSize (minimumSize, false);
+    }
+    
+    const void** const nodeArray = nodes.getArray();
+    const int capacity = nodes.length();
+    
+    for (int i = 0; i < capacity; ++i)
+        nodeArray[i] = 0;
+    
+    parents.setSize (numRoots, false);
+    groups.setSize (numRoots, false);
+    
+    for (int i = 0; i < numRoots; ++i)
+        parents.atUnchecked (i) = i;
+}
+
+bool GraphDependencies::add (const void* node, const int root) throw()
+{
+    plonk_assert (node != 0);
+    plonk_assert ((root >= 0) && (root < numRoots));
+    
+    if ((numNodes * 2) >= nodes.length())
+        grow();
+    
+    const void** const nodeArray = nodes.getArray();
+    int* const rootArray = nodeRoots.getArray();
+    const int mask = nodes.length() - 1;
+    int index = graphDependenciesHash (node, mask);
+    
+    while (nodeArray[index] != 0)
+    {
+        if (nodeArray[index] == node)
+        {
+            join (rootArray[index], root);
+            return false;
+        }
+        
+        index = (index + 1) & mask;
+    }
+    
+    nodeArray[index] = node;
+    rootArray[index] = root;
+    ++numNodes;
+    
+    return true;
+}
+
+void GraphDependencies::grow() throw()
+{
+    const ObjectArray<const void*> oldNodes (nodes);
+    const IntArray oldRoots (nodeRoots);
+    const int oldCapacity = oldNodes.length();
+    const int capacity = oldCapacity * 2;
+    const int mask = capacity - 1;
+    
+    nodes = ObjectArray<const void*>();
+    nodeRoots = IntArray();
+    nodes.setSize (capacity, false);
+    nodeRoots.setSize (capacity, false);
+    
+    const void** const nodeArray = nodes.getArray();
+    int* const rootArray = nodeRoots.getArray();
+    
+    for (int i = 0; i < capacity; ++i)
+        nodeArray[i] = 0;
+    
+    for (int i = 0; i < oldCapacity; ++i)
+    {
+        const void* const node = oldNodes.atUnchecked (i);
+        
+        if (node != 0)
+        {
+            int index = graphDependenciesHash (node, mask);
+            
+            while (nodeArray[index] != 0)
+                index = (index + 1) & mask;
+            
+            nodeArray[index] = node;
+            rootArray[index] = oldRoots.atUnchecked (i);
+        }
+    }
+}
+
+int GraphDependencies::find (int root) throw()
+{
+    int* const parentArray = parents.getArray();
+
+    while (parentArray[root] != root)
+    {
+        parentArray[root] = parentArray[parentArray[root]];
+        root = parentArray[root];
+    }
+    
+    return root;
+}
+
+void GraphDependencies::join (const int rootA, const int rootB) throw()
+{
+    const int a = find (rootA);
+    const int b = find (rootB);
+    
+    // keep the lowest root as the representative so groups are numbered in root order
+    if (a < b)
+        parents.atUnchecked (b) = a;
+    else if (b < a)
+        parents.atUnchecked (a) = b;
+}
+
+void GraphDependencies::findGroups() throw()
+{
+    int* const groupArray = groups.getArray();
+    numGroups = 0;
+    
+    for (int i = 0; i < numRoots; ++i)
+    {
+        const int representative = find (i);
+        
+        if (representative == i)
+            groupArray[i] = numGroups++;
+        else
+            groupArray[i] = groupArray[representative]; // representative is always lower so already numbered
+    }
+}
+
+static AtomicInt& getGraphDependenciesInputsRevision() throw()
+{
+    static AtomicInt revision;
+    return revision;
+}
+
+int GraphDependencies::getInputsRevision() throw()
+{
+    return getGraphDependenciesInputsRevision().getValue();
+}
+
+void GraphDependencies::inputsChanged() throw()
+{
+    ++getGraphDependenciesInputsRevision();
+}
+
+template<class SampleType>
+static PLONK_INLINE_LOW void graphDependenciesAddUnit (GraphDependencies& dependencies, Dynamic const& item, const int root) throw()
+{
+    dependencies.addUnit (item.asUnchecked< UnitBase<SampleType> >(), root);
+}
+
+template<class SampleType>
+static PLONK_INLINE_LOW void graphDependenciesAddUnits (GraphDependencies& dependencies, Dynamic const& item, const int root) throw()
+{
+    typedef NumericalArray2D<ChannelBase<SampleType>,UnitBase<SampleType> > UnitsType;
+    dependencies.addUnits (item.asUnchecked<UnitsType>(), root);
+}
+
+void GraphDependencies::addInputs (InputDictionary const& inputs, const int root) throw()
+{
+    const DynamicArray& items = inputs.getValues();
+    const int numItems = items.length();
+    
+    for (int i = 0; i < numItems; ++i)
+    {
+        const Dynamic& item = items.atUnchecked (i);
+        
+        if (item.isItemNull())
+            continue;
+        
+        const int type = item.getTypeCode();
+        
+        switch (type)
+        {
+            case TypeCode::FloatUnit:   graphDependenciesAddUnit<float>   (*this, item, root); break;
+            case TypeCode::DoubleUnit:  graphDependenciesAddUnit<double>  (*this, item, root); break;
+            case TypeCode::IntUnit:     graphDependenciesAddUnit<int>     (*this, item, root); break;
+            case TypeCode::ShortUnit:   graphDependenciesAddUnit<short>   (*this, item, root); break;
+            case TypeCode::Int24Unit:   graphDependenciesAddUnit<Int24>   (*this, item, root); break;
+            case TypeCode::LongUnit:    graphDependenciesAddUnit<Long>    (*this, item, root); break;
+
+            case TypeCode::FloatUnits:  graphDependenciesAddUnits<float>  (*this, item, root); break;
+            case TypeCode::DoubleUnits: graphDependenciesAddUnits<double> (*this, item, root); break;
+            case TypeCode::IntUnits:    graphDependenciesAddUnits<int>    (*this, item, root); break;
+            case TypeCode::ShortUnits:  graphDependenciesAddUnits<short>  (*this, item, root); break;
+            case TypeCode::Int24Units:  graphDependenciesAddUnits<Int24>  (*this, item, root); break;
+            case TypeCode::LongUnits:   graphDependenciesAddUnits<Long>   (*this, item, root); break;
+                
+            default:
+                if (TypeCode::isUnitQueue (type) ||
+                    ((type >= TypeCode::FloatChannelVariable) && (type <= TypeCode::LongUnitsVariable)))
+                {
+                    // these can be changed to refer to different units at any time
+                    setSerial();
+                }
+                else
+                {
+                    // everything else is shared state (busses, variables, signals, files etc)
+                    const void* const node = item.getItem().getInternal();
+                    
+                    if (node != 0)
+                        add (node, root);
+                }
+        }
+    }
+}
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,127 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_GRAPHDEPENDENCIES_H
+#define PLONK_GRAPHDEPENDENCIES_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+
+/** Finds which of a set of sub-graphs share any of their nodes.
+ Each sub-graph is walked from its root and every channel, bus, variable etc.
+ that it reads from is recorded against that root. Roots that reach the same
+ node are joined into the same group. Different groups are then independent of 
+ each other and can be processed on separate threads.
+ 
+ Constant channels are ignored as they only process once. Inputs that can
+ change which units they refer to (e.g., unit variables and unit queues) can't
+ be tracked so they mark the whole set as serial. 
+ @see UnitMixerChannelInternal, ChannelMixerChannelInternal */
+class GraphDependencies
+{
+public:
+    GraphDependencies() throw();
+    
+    /** Clear all recorded nodes ready to walk a new set of roots. */
+    void reset (const int numRoots) throw();
+    
+    /** Record that a root reads from a node.
+     @return @c true if this node hadn't been seen before so its own 
+             inputs need to be walked, otherwise @c false. */
+    bool add (const void* node, const int root) throw();
+    
+    /** Walk all of the items in an input dictionary. */
+    void addInputs (InputDictionary const& inputs, const int root) throw();
+    
+    /** Walk all the channels of a unit. */
+    template<class SampleType>
+    void addUnit (UnitBase<SampleType> const& unit, const int root) throw()
+    {
+        const int numChannels = unit.getNumChannels();
+        
+        for (int i = 0; i < numChannels; ++i)
+            unit.atUnchecked (i).getInternal()->addDependencies (*this, root);
+    }
+    
+    /** Walk all the channels of all the units in an array. */
+    template<class SampleType>
+    void addUnits (NumericalArray2D<ChannelBase<SampleType>,UnitBase<SampleType> > const& units, const int root) throw()
+    {
+        const int numUnits = units.length();
+        
+        for (int i = 0; i < numUnits; ++i)
+            addUnit (units.atUnchecked (i), root);
+    }
+    
+    /** Mark the set as unsuitable for parallel processing. */
+    PLONK_INLINE_LOW void setSerial() throw()              { serial = true; }
+    PLONK_INLINE_LOW bool isSerial() const throw()         { return serial; }
+    
+    PLONK_INLINE_LOW int getNumRoots() const throw()       { return numRoots; }
+    
+    /** Get the group a root belongs to.
+     Groups are numbered from 0 in the order of their lowest root. 
+     Only valid after calling findGroups(). */
+    PLONK_INLINE_LOW int getGroup (const int root) const throw()   { return groups.atUnchecked (root); }
+    PLONK_INLINE_LOW int getNumGroups() const throw()              { return numGroups; }
+
+    /** Number the groups once all the roots have been walked. */
+    void findGroups() throw();
+    
+    /** Changes whenever an input of an existing channel is replaced with InputDictionary::replace().
+     Anything caching the result of a walk should walk again when this changes. */
+    static int getInputsRevision() throw();
+    
+    /** Called by InputDictionary::replace() when an input is re-plugged. */
+    static void inputsChanged() throw();
+    
+private:
+    int find (int root) throw();
+    void join (const int rootA, const int rootB) throw();
+    void grow() throw();
+    
+    ObjectArray<const void*> nodes;
+    IntArray nodeRoots;
+    IntArray parents;
+    IntArray groups;
+    int numNodes;
+    int numRoots;
+    int numGroups;
+    bool serial;
+};
+
+#endif // PLONK_GRAPHDEPENDENCIES_H
@@ -52,6 +52,13 @@ InputDictionary::InputDictionary (InputDictionary const& copy) throw()
 {
 }            
 
+Dynamic InputDictionary::replace (const int key, Dynamic const& value) throw()
+{
+    const Dynamic oldValue = this->put (key, value);
+    GraphDependencies::inputsChanged();
+    return oldValue;
+}
+
 const BlockSize InputDictionary::getMaxBlockSize() const throw()
 {
     const DynamicArray& items = this->getValues();
@@ -60,6 +60,12 @@ public:
     /** Copy constructor. */
     InputDictionary (InputDictionary const& copy) throw();
     
+    /** Replace an input of a channel that may already be processing.
+     Unlike put() the change is noted so that anything caching the structure 
+     of the graph (see GraphDependencies) knows to look again, use this to 
+     re-plug a running graph. Returns the previous input. */
+    Dynamic replace (const int key, Dynamic const& value) throw();
+    
     /** Find the minimum Unit block size in this dictionary. 
      This is not recursive but does search each channel of the units. */
     const BlockSize getMinBlockSize() const throw();
@@ -0,0 +1,289 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_PARAMEVENTS_H
+#define PLONK_PARAMEVENTS_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../../containers/plonk_DynamicContainer.h"
+#include "../../containers/plonk_RingQueue.h"
+
+#include "../../core/plonk_SmartPointer.h"
+#include "../utility/plonk_TimeStamp.h"
+
+
+template<class SampleType>
+class ParamEventsInternal : public SmartPointer
+{
+public:
+    typedef ParamEventsBase<SampleType>     Container;
+    
+    struct Event
+    {
+        TimeStamp time;
+        int target;
+        SampleType value;
+    };
+    
+    typedef RingQueue<Event>                QueueType;
+    typedef ObjectArray<QueueType>          QueueArray;
+    typedef ObjectArray<Event>              EventArray;
+    typedef ObjectArray<AtomicInt>          AtomicIntArray;
+    
+    ParamEventsInternal (const int numTargetsToUse, 
+                         const int capacity, 
+                         const int maxPendingToUse) throw()
+    :   pending (EventArray::withSize (plonk::max (1, numTargetsToUse) * plonk::max (1, maxPendingToUse))),
+        numPending (IntArray::newClear (plonk::max (1, numTargetsToUse))),
+        readers (AtomicIntArray::withSize (plonk::max (1, numTargetsToUse))),
+        numTargets (plonk::max (1, numTargetsToUse)),
+        maxPending (plonk::max (1, maxPendingToUse))
+    {
+        // a queue per target so each target's reader is the only consumer of its events
+        for (int i = 0; i < numTargets; ++i)
+            incoming.add (QueueType (capacity, QueueType::MPMC));
+    }
+    
+    bool push (const int target, SampleType const& value, TimeStamp const& time) throw()
+    {
+        if ((target < 0) || (target >= numTargets))
+            return false;
+        
+        Event event;
+        event.time = time;
+        event.target = target;
+        event.value = value;
+        
+        return incoming.atUnchecked (target).push (event);
+    }
+    
+    void drain (const int target) throw()
+    {
+        plonk_assert ((target >= 0) && (target < numTargets));
+        
+        const bool isOnlyReader = readers.atUnchecked (target).compareAndSwap (0, 1);
+        plonk_assert (isOnlyReader); // two units are reading this target at once
+#ifndef PLONK_DEBUG
+        (void)isOnlyReader;
+#endif
+        
+        QueueType& queue = incoming.atUnchecked (target);
+        Event event;
+        
+        while (queue.pop (event))
+            insert (event);
+    }
+    
+    const Event* getPending (const int target, int& count) const throw()
+    {
+        plonk_assert ((target >= 0) && (target < numTargets));
+        
+        count = numPending.atUnchecked (target);
+        return pending.getArray() + target * maxPending;
+    }
+    
+    void consume (const int target, const int numConsumed) throw()
+    {
+        plonk_assert ((target >= 0) && (target < numTargets));
+        
+        Event* const events = pending.getArray() + target * maxPending;
+        int& count = numPending.atUnchecked (target);
+        
+        plonk_assert ((numConsumed >= 0) && (numConsumed <= count));
+        
+        for (int i = numConsumed; i < count; ++i)
+            events[i - numConsumed] = events[i];
+        
+        count -= numConsumed;
+        readers.atUnchecked (target).setValue (0);
+    }
+    
+    int getNumTargets() const throw()
+    {
+        return numTargets;
+    }
+    
+private:
+    void insert (Event const& event) throw()
+    {
+        Event* const events = pending.getArray() + event.target * maxPending;
+        int& count = numPending.atUnchecked (event.target);
+        
+        if (count == maxPending)
+        {
+            // drop the latest, the imminent events matter most
+            if (! (event.time < events[count - 1].time))
+                return;
+            
+            --count;
+        }
+        
+        // keep each target's events in time order, equal times in arrival order
+        int i = count;
+        
+        while ((i > 0) && (event.time < events[i - 1].time))
+        {
+            events[i] = events[i - 1];
+            --i;
+        }
+        
+        events[i] = event;
+        ++count;
+    }
+    
+    QueueArray incoming;
+    EventArray pending;
+    IntArray numPending;
+    AtomicIntArray readers;
+    int numTargets;
+    int maxPending;
+};
+
+//------------------------------------------------------------------------------
+
+/** A lock-free queue of timestamped parameter changes.
+ Any number of non-audio threads may push (target, value, time) events with a 
+ single lock-free push each. Each target has its own queue which the 
+ ParamEvent unit reading it drains once per block, applying each event at the 
+ sample offset given by its time stamp. Events with a time stamp earlier than 
+ the current block (e.g., TimeStamp::getZero(), the default) are applied at 
+ the start of the next block. Each target must be read by only one ParamEvent 
+ unit, but units reading different targets may run on different threads.
+ @see ParamEventUnit */
+template<class SampleType>
+class ParamEventsBase : public SmartPointerContainer< ParamEventsInternal<SampleType> >
+{
+public:
+    typedef ParamEventsInternal<SampleType>         Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    typedef WeakPointerContainer<ParamEventsBase>   Weak;
+    typedef typename Internal::Event                Event;
+    
+    enum Constants
+    {
+        DefaultCapacity = 1024,
+        DefaultMaxPending = 64
+    };
+    
+    /** Create an event queue.
+     @param numTargets  The number of separate parameters addressed by the events.
+     @param capacity    The maximum number of events waiting to be drained per target, rounded up to a power of 2.
+     @param maxPending  The maximum number of drained events waiting for their time per target, 
+                        if more arrive the one with the latest time is dropped. */
+    ParamEventsBase (const int numTargets = 1, 
+                     const int capacity = DefaultCapacity, 
+                     const int maxPending = DefaultMaxPending) throw()
+    :   Base (new Internal (numTargets, capacity, maxPending))
+    {
+    }
+    
+    explicit ParamEventsBase (Internal* internalToUse) throw()
+	:	Base (internalToUse)
+	{
+	}
+    
+    ParamEventsBase (ParamEventsBase const& copy) throw()
+	:	Base (static_cast<Base const&> (copy))
+	{
+	}
+    
+    ParamEventsBase (Dynamic const& other) throw()
+    :   Base (other.as<ParamEventsBase>().getInternal())
+    {
+    }
+    
+    /** Assignment operator. */
+    ParamEventsBase& operator= (ParamEventsBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */
+    static ParamEventsBase fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }
+    
+    static const ParamEventsBase& getNull() throw()
+	{
+		static ParamEventsBase null;
+		return null;
+	}
+    
+    /** Queue a change of value for a target.
+     This may be called from any thread. Returns false if the target's queue was full. */
+    PLONK_INLINE_LOW bool push (const int target, SampleType const& value, TimeStamp const& time = TimeStamp::getZero()) throw()
+    {
+        return this->getInternal()->push (target, value, time);
+    }
+    
+    /** Move newly pushed events for a target to its pending events.
+     Only the one unit reading the target may call this, followed by consume()
+     once it has finished with the pending events. */
+    PLONK_INLINE_LOW void drain (const int target) throw()
+    {
+        this->getInternal()->drain (target);
+    }
+    
+    /** The drained events for a target in time order. */
+    PLONK_INLINE_LOW const Event* getPending (const int target, int& count) const throw()
+    {
+        return this->getInternal()->getPending (target, count);
+    }
+    
+    /** Remove the first numConsumed pending events for a target and end the drain() for it. */
+    PLONK_INLINE_LOW void consume (const int target, const int numConsumed) throw()
+    {
+        this->getInternal()->consume (target, numConsumed);
+    }
+    
+    PLONK_INLINE_LOW int getNumTargets() const throw()
+    {
+        return this->getInternal()->getNumTargets();
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(ParamEventsBase);
+};
+
+
+#endif // PLONK_PARAMEVENTS_H
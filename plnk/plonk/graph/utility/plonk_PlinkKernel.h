@@ -0,0 +1,113 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_PLINKKERNEL_H
+#define PLONK_PLINKKERNEL_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+
+/** Describes a channel's processing as a single call to a Plink process function.
+ Channels that are implemented with Plink fill this in from 
+ ChannelInternalBase::getPlinkKernel() so a FreezeUnit can call the function
+ directly from its schedule rather than through the channel. The function is 
+ called with a PlinkProcess whose first buffer is the output and whose 
+ remaining buffers are the inputs in the order they were added here. Unit 
+ inputs are resolved to the channel with the same index as the caller, other
+ inputs (e.g., wavetables) are fixed sample arrays. 
+ @see FreezeUnit */
+template<class SampleType>
+class PlinkKernel
+{
+public:
+    typedef void (*Function)(void* process, void* state);
+    typedef UnitBase<SampleType> UnitType;
+    
+    enum Limits { MaxInputs = 3 };
+    
+    PlinkKernel() throw()
+    :   function (0),
+        state (0),
+        numInputs (0)
+    {
+    }
+    
+    PLONK_INLINE_LOW void setFunction (Function kernelFunction, void* kernelState) throw()
+    {
+        function = kernelFunction;
+        state = kernelState;
+    }
+    
+    /** Add a unit input, this is resolved per channel. */
+    PLONK_INLINE_LOW void addInput (UnitType& unit) throw()
+    {
+        plonk_assert (numInputs < MaxInputs);
+        units[numInputs] = &unit;
+        samples[numInputs] = 0;
+        lengths[numInputs] = 0;
+        ++numInputs;
+    }
+    
+    /** Add a fixed array of samples. */
+    PLONK_INLINE_LOW void addInput (const SampleType* inputSamples, const int length) throw()
+    {
+        plonk_assert (numInputs < MaxInputs);
+        units[numInputs] = 0;
+        samples[numInputs] = inputSamples;
+        lengths[numInputs] = length;
+        ++numInputs;
+    }
+    
+    PLONK_INLINE_LOW Function getFunction() const throw()                              { return function; }
+    PLONK_INLINE_LOW void* getState() const throw()                                    { return state; }
+    PLONK_INLINE_LOW int getNumInputs() const throw()                                  { return numInputs; }
+    
+    /** Get a unit input, or null if this input is a fixed array. */
+    PLONK_INLINE_LOW UnitType* getInputUnit (const int index) const throw()            { return units[index]; }
+    PLONK_INLINE_LOW const SampleType* getInputSamples (const int index) const throw() { return samples[index]; }
+    PLONK_INLINE_LOW int getInputLength (const int index) const throw()                { return lengths[index]; }
+    
+private:
+    Function function;
+    void* state;
+    int numInputs;
+    UnitType* units[MaxInputs];
+    const SampleType* samples[MaxInputs];
+    int lengths[MaxInputs];
+};
+
+#endif // PLONK_PLINKKERNEL_H
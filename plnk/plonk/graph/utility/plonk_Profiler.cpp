@@ -0,0 +1,338 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+PLONK_PROFILE_THREADLOCAL LongLong Profiler::childTicks = 0;
+
+ProfileRecord::ProfileRecord (Text const& nameToUse, Text const& labelToUse) throw()
+:   state (Active),
+    name (nameToUse),
+    label (labelToUse),
+    next (0)
+{
+    Memory::zero (counts);
+    Memory::zero (base);
+}
+
+//------------------------------------------------------------------------------
+
+Profiler::Profiler() throw()
+:   lock (Lock::MutexLock),
+    startTicks (getTicks()),
+    startTime (pl_TimeNow()),
+    ticksPerSecond (0.0)
+{
+}
+
+Profiler::~Profiler()
+{
+    // channels that outlive the profiler may still write to their records
+    // so these are left alone
+}
+
+Profiler& Profiler::getDefault() throw()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+bool Profiler::isEnabled() throw()
+{
+#if PLONK_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+ProfileRecord* Profiler::add (Text const& name, Text const& label) throw()
+{
+    ProfileRecord* const record = new ProfileRecord (name, label);
+    ProfileRecord* head;
+    
+    do
+    {
+        head = records.getValue();
+        record->next = head;
+    } while (! records.compareAndSwap (head, record));
+    
+    return record;
+}
+
+void Profiler::setLabel (ProfileRecord* record, Text const& label) throw()
+{
+    const AutoLock l (lock);
+    record->label = label;
+}
+
+void Profiler::unlink (ProfileRecord* previous, ProfileRecord* record) throw()
+{
+    // only the head is changed by other threads, new records are pushed in 
+    // front of it so if the swap fails the record is still in the list
+    if (previous == 0)
+    {
+        if (records.compareAndSwap (record, record->next))
+            return;
+        
+        previous = records.getValue();
+        
+        while (previous->next != record)
+            previous = previous->next;
+    }
+    
+    previous->next = record->next;
+}
+
+void Profiler::addToRows (Rows& rows, Text const& name, Text const& label, ProfileCounts const& counts, const int numChannels) throw()
+{
+    const int numRows = rows.length();
+    
+    for (int i = 0; i < numRows; ++i)
+    {
+        Row& row = rows.atUnchecked (i);
+        
+        if ((strcmp (row.name.getArray(), name.getArray()) == 0) && 
+            (strcmp (row.label.getArray(), label.getArray()) == 0))
+        {
+            row.numChannels += numChannels;
+            row.counts.numCalls += counts.numCalls;
+            row.counts.numSkips += counts.numSkips;
+            row.counts.numLate += counts.numLate;
+            row.counts.totalTicks += counts.totalTicks;
+            row.counts.numBytes += counts.numBytes;
+            
+            if (counts.maximumTicks > row.counts.maximumTicks)
+                row.counts.maximumTicks = counts.maximumTicks;
+            
+            return;
+        }
+    }
+    
+    Row row;
+    row.name = name;
+    row.label = label;
+    row.numChannels = numChannels;
+    row.counts = counts;
+    rows.add (row);
+}
+
+static PLONK_INLINE_LOW ProfileCounts profileCountsSince (ProfileCounts const& counts, ProfileCounts const& base) throw()
+{
+    ProfileCounts result;
+    result.numCalls = counts.numCalls - base.numCalls;
+    result.numSkips = counts.numSkips - base.numSkips;
+    result.numLate = counts.numLate - base.numLate;
+    result.totalTicks = counts.totalTicks - base.totalTicks;
+    result.maximumTicks = counts.maximumTicks;
+    result.numBytes = counts.numBytes - base.numBytes;
+    return result;
+}
+
+Profiler::Rows Profiler::getRows() throw()
+{
+    const AutoLock l (lock);
+    
+    ProfileRecord* previous = 0;
+    ProfileRecord* record = records.getValue();
+    
+    // fold deleted channels into the retired totals first
+    while (record != 0)
+    {
+        ProfileRecord* const next = record->next;
+        
+        if (record->isRetired())
+        {
+            addToRows (retired, record->name, record->label, profileCountsSince (record->counts, record->base), 1);
+            unlink (previous, record);
+            delete record;
+        }
+        else
+        {
+            previous = record;
+        }
+        
+        record = next;
+    }
+    
+    Rows rows;
+    const int numRetired = retired.length();
+    
+    for (int i = 0; i < numRetired; ++i)
+    {
+        Row const& row = retired.atUnchecked (i);
+        addToRows (rows, row.name, row.label, row.counts, 0);
+    }
+    
+    for (record = records.getValue(); record != 0; record = record->next)
+        addToRows (rows, record->name, record->label, profileCountsSince (record->counts, record->base), 1);
+    
+    // sort by total time, largest first
+    const int numRows = rows.length();
+    
+    for (int i = 1; i < numRows; ++i)
+    {
+        const Row row = rows.atUnchecked (i);
+        int j = i;
+        
+        for (; (j > 0) && (rows.atUnchecked (j - 1).counts.totalTicks < row.counts.totalTicks); --j)
+            rows.atUnchecked (j) = rows.atUnchecked (j - 1);
+        
+        rows.atUnchecked (j) = row;
+    }
+    
+    return rows;
+}
+
+void Profiler::reset() throw()
+{
+    const AutoLock l (lock);
+    
+    retired.clear();
+    
+    for (ProfileRecord* record = records.getValue(); record != 0; record = record->next)
+    {
+        record->base = record->counts;
+        record->counts.maximumTicks = 0;
+    }
+}
+
+double Profiler::getTicksPerSecond() throw()
+{
+    if (ticksPerSecond > 0.0)
+        return ticksPerSecond;
+    
+#if PLANK_WIN
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency (&frequency);
+    ticksPerSecond = double (frequency.QuadPart);
+#elif defined(__i386__) || defined(__x86_64__)
+    // the TSC rate isn't available portably so measure it against the clock
+    const double minimumDuration = 0.1;
+    double duration = pl_TimeNow() - startTime;
+    
+    if (duration < minimumDuration)
+    {
+        Threading::sleep (minimumDuration - duration);
+        duration = pl_TimeNow() - startTime;
+    }
+    
+    ticksPerSecond = double (getTicks() - startTicks) / duration;
+#elif defined(__aarch64__) || defined(__arm64__)
+    LongLong frequency;
+    __asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r" (frequency));
+    ticksPerSecond = double (frequency);
+#else
+    ticksPerSecond = 1000000000.0;
+#endif
+    
+    return ticksPerSecond;
+}
+
+JSON Profiler::getReportJSON() throw()
+{
+    const Rows rows = getRows();
+    const double nanosecondsPerTick = 1000000000.0 / getTicksPerSecond();
+    const int numRows = rows.length();
+    
+    JSON units = JSON::array();
+    
+    for (int i = 0; i < numRows; ++i)
+    {
+        Row const& row = rows.atUnchecked (i);
+        const LongLong numCalls = row.counts.numCalls;
+        const double totalNs = double (row.counts.totalTicks) * nanosecondsPerTick;
+        
+        JSON item = JSON::object();
+        item.add ("name", JSON (row.name));
+        item.add ("label", JSON (row.label));
+        item.add ("channels", JSON (row.numChannels));
+        item.add ("calls", JSON (numCalls));
+        item.add ("skips", JSON (row.counts.numSkips));
+        item.add ("late", JSON (row.counts.numLate));
+        item.add ("totalNs", JSON (totalNs));
+        item.add ("meanNs", JSON (numCalls > 0 ? totalNs / double (numCalls) : 0.0));
+        item.add ("maxNs", JSON (double (row.counts.maximumTicks) * nanosecondsPerTick));
+        item.add ("bytes", JSON (row.counts.numBytes));
+        units.add (item);
+    }
+    
+    JSON report = JSON::object();
+    report.add ("enabled", JSON (isEnabled() ? 1 : 0));
+    report.add ("ticksPerSecond", JSON (getTicksPerSecond()));
+    report.add ("units", units);
+    
+    return report;
+}
+
+Text Profiler::getReportTable() throw()
+{
+    const Rows rows = getRows();
+    const double microsecondsPerTick = 1000000.0 / getTicksPerSecond();
+    const int numRows = rows.length();
+    
+    char line[256];
+    snprintf (line, sizeof (line), "%-40s %-16s %8s %12s %10s %8s %12s %10s %10s %14s\n",
+              "name", "label", "channels", "calls", "skips", "late", "total(us)", "mean(us)", "max(us)", "bytes");
+    
+    Text table (line);
+    
+    for (int i = 0; i < numRows; ++i)
+    {
+        Row const& row = rows.atUnchecked (i);
+        const double total = double (row.counts.totalTicks) * microsecondsPerTick;
+        
+        snprintf (line, sizeof (line), "%-40s %-16s %8d %12lld %10lld %8lld %12.1f %10.3f %10.3f %14lld\n",
+                  row.name.getArray(), row.label.getArray(), row.numChannels,
+                  row.counts.numCalls, row.counts.numSkips, row.counts.numLate,
+                  total,
+                  row.counts.numCalls > 0 ? total / double (row.counts.numCalls) : 0.0,
+                  double (row.counts.maximumTicks) * microsecondsPerTick,
+                  row.counts.numBytes);
+        
+        table.add (line);
+    }
+    
+    return table;
+}
+
+END_PLONK_NAMESPACE
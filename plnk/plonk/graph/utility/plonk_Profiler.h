@@ -0,0 +1,259 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_PROFILER_H
+#define PLONK_PROFILER_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "plonk_TimeStamp.h"
+#include "plonk_ProcessInfo.h"
+
+#if PLANK_WIN
+    #define PLONK_PROFILE_THREADLOCAL __declspec(thread)
+#else
+    #define PLONK_PROFILE_THREADLOCAL __thread
+#endif
+
+/** Counts gathered for a channel, or for a group of channels in a report.
+ Times are in the profiler's ticks, use Profiler::getTicksPerSecond() to 
+ convert them to seconds. */
+struct ProfileCounts
+{
+    LongLong numCalls;      ///< The number of times the channel processed.
+    LongLong numSkips;      ///< The number of times it was asked to process but was already up to date.
+    LongLong numLate;       ///< The number of times it was asked to process after its next timestamp had passed,
+                            ///  channels with a shorter block than the graph (e.g., control rate) are late on every call.
+    LongLong totalTicks;    ///< Time spent processing, excluding the time spent processing inputs.
+    LongLong maximumTicks;  ///< The longest single call.
+    LongLong numBytes;      ///< The number of bytes written to the output buffer.
+};
+
+/** The profile data for a single channel. 
+ The channel's audio thread is the only writer of the counts so these are 
+ updated without locks or atomics, the reader may see a count that's one 
+ call behind. When the channel is deleted the record is marked as retired
+ and is later folded into the totals and freed by the reader. 
+ @see Profiler */
+class ProfileRecord
+{
+public:
+    enum States
+    {
+        Active,
+        Retired
+    };
+    
+    ProfileRecord (Text const& name, Text const& label) throw();
+    
+    PLONK_INLINE_LOW void retire() throw()                    { state.setValue (Retired); }
+    PLONK_INLINE_LOW bool isRetired() const throw()           { return state.getValue() == Retired; }
+    
+    PLONK_INLINE_LOW void skip() throw()                      { ++counts.numSkips; }
+    
+    PLONK_INLINE_LOW void add (const LongLong ticks, const LongLong numBytes, const bool late) throw()
+    {
+        ++counts.numCalls;
+        counts.numLate += late ? 1 : 0;
+        counts.totalTicks += ticks;
+        counts.numBytes += numBytes;
+        
+        if (ticks > counts.maximumTicks)
+            counts.maximumTicks = ticks;
+    }
+        
+private:
+    ProfileCounts counts;   // written by the audio thread
+    ProfileCounts base;     // written by the reader on Profiler::reset()
+    AtomicInt state;
+    Text name;
+    Text label;
+    ProfileRecord* next;
+    
+    friend class Profiler;
+    
+    ProfileRecord();
+    ProfileRecord (const ProfileRecord&);
+    const ProfileRecord& operator= (const ProfileRecord&);
+};
+
+/** Collects per-channel timings for the whole graph.
+ This is only active if PLONK_PROFILE=1 is defined for the whole build, 
+ otherwise nothing is added to ChannelInternalCore or ChannelBase::process()
+ and the reports are empty. 
+ 
+ Each channel adds a ProfileRecord when it is initialised, these are pushed 
+ on to a lock-free list so channels can be created on any thread. Times
+ are exclusive: the time a channel spends processing its inputs is taken 
+ out of its own total. 
+ 
+ Reports may be taken from any thread other than the audio thread. Channels 
+ with the same name and label are combined into a single row, rows are 
+ sorted by their total time. */
+class Profiler
+{
+public:
+    /** A row in a report. */
+    struct Row
+    {
+        Text name;
+        Text label;
+        int numChannels;
+        ProfileCounts counts;
+    };
+    
+    typedef ObjectArray<Row> Rows;
+    
+    ~Profiler();
+    
+    static Profiler& getDefault() throw();
+    
+    /** Returns @c true if profiling was compiled in using PLONK_PROFILE=1. */
+    static bool isEnabled() throw();
+    
+    /** Add a record for a new channel. */
+    ProfileRecord* add (Text const& name, Text const& label) throw();
+    
+    /** Update the label of a record. */
+    void setLabel (ProfileRecord* record, Text const& label) throw();
+
+    /** Take a snapshot of all the channels. 
+     This includes channels that have been deleted since the last reset. */
+    Rows getRows() throw();
+    
+    /** Get a report as JSON.
+     This is an object with the tick rate and an array of rows, the times
+     are in nanoseconds. */
+    JSON getReportJSON() throw();
+    
+    /** Get a report as a table with one line per row. */
+    Text getReportTable() throw();
+    
+    /** Start counting from zero. 
+     The maximum of a call that is in progress may survive the reset. */
+    void reset() throw();
+    
+    /** The rate of the ticks that are used for timing. */
+    double getTicksPerSecond() throw();
+    
+    /** The current value of the tick counter. */
+    static PLONK_INLINE_HIGH LongLong getTicks() throw()
+    {
+#if PLANK_WIN
+        LARGE_INTEGER now;
+        QueryPerformanceCounter (&now);
+        return LongLong (now.QuadPart);
+#elif defined(__i386__) || defined(__x86_64__)
+        unsigned int low, high;
+        __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+        return (LongLong (high) << 32) | LongLong (low);
+#elif defined(__aarch64__) || defined(__arm64__)
+        LongLong now;
+        __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (now));
+        return now;
+#else
+        struct timespec now;
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        return LongLong (now.tv_sec) * 1000000000 + LongLong (now.tv_nsec);
+#endif
+    }
+    
+    /** Time spent in nested channels on this thread. 
+     @see ProfileScope */
+    static PLONK_PROFILE_THREADLOCAL LongLong childTicks;
+    
+private:
+    Profiler() throw();
+    
+    void unlink (ProfileRecord* previous, ProfileRecord* record) throw();
+    static void addToRows (Rows& rows, Text const& name, Text const& label, ProfileCounts const& counts, const int numChannels) throw();
+
+    AtomicValue<ProfileRecord*> records;
+    Lock lock;
+    Rows retired;
+    LongLong startTicks;
+    double startTime;
+    double ticksPerSecond;
+};
+
+/** Times a single call to a channel's process function. 
+ Used by ChannelBase::process() when PLONK_PROFILE=1. */
+class ProfileScope
+{
+public:
+    PLONK_INLINE_LOW ProfileScope (ProfileRecord* recordToUse, 
+                                   ProcessInfo const& info, 
+                                   TimeStamp const& nextTimeStamp,
+                                   const LongLong numBytesToUse) throw()
+    :   record (recordToUse),
+        numBytes (numBytesToUse),
+        late ((nextTimeStamp > TimeStamp::getZero()) && (info.getTimeStamp() > nextTimeStamp)),
+        parentTicks (Profiler::childTicks),
+        start (Profiler::getTicks())
+    {
+        Profiler::childTicks = 0;
+    }
+    
+    PLONK_INLINE_LOW ~ProfileScope()
+    {
+        const LongLong elapsed = Profiler::getTicks() - start;
+        
+        if (record != 0)
+            record->add (elapsed - Profiler::childTicks, numBytes, late);
+        
+        Profiler::childTicks = parentTicks + elapsed;
+    }
+    
+    static PLONK_INLINE_LOW void skip (ProfileRecord* record) throw()
+    {
+        if (record != 0)
+            record->skip();
+    }
+    
+private:
+    ProfileRecord* const record;
+    const LongLong numBytes;
+    const bool late;
+    const LongLong parentTicks;
+    const LongLong start;
+    
+    ProfileScope();
+    ProfileScope (const ProfileScope&);
+    const ProfileScope& operator= (const ProfileScope&);
+};
+
+#endif // PLONK_PROFILER_H
@@ -0,0 +1,510 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+ by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_OFFLINEAUDIOHOST_H
+#define PLONK_OFFLINEAUDIOHOST_H
+
+/** An audio host that renders to and from files rather than an audio device.
+ startHost() builds the graph using constructGraph() then renders it block by 
+ block as fast as possible, returning when rendering is finished. Inputs are 
+ read from the files added with addInputFile() (each file feeding the next 
+ host inputs) and the outputs are written to the file set with setOutputFile(). 
+ Either can be omitted, with no output file the host just runs the graph which
+ is useful for benchmarking.
+ 
+ Unlike device hosts the inputs are not written to the global busses named by 
+ the input index, each host has its own busses so several hosts can run one 
+ after another or at the same time. The graph should read them using 
+ getInputBusses(), e.g., BusRead::ar (getInputBusses()) in constructGraph().
+ 
+ Rendering stops after the duration set with setDuration() or, if this is 0, 
+ once all of the input files have ended. Input files are not resampled so 
+ should match the preferred host sample rate.
+ 
+ Several hosts can be rendered at once across a TaskPool using 
+ renderParallel(). These must all use the same sample rate and graph block
+ size since these are set globally when the graphs are constructed.
+ @see AudioHostBase */
+template<class SampleType>
+class OfflineAudioHostBase : public AudioHostBase<SampleType>
+{
+public:
+    typedef AudioHostBase<SampleType>               Base;
+    typedef NumericalArray<SampleType>              Buffer;
+    typedef AudioFileWriter<SampleType>             WriterType;
+    typedef ObjectArray<AudioFileReader>            ReaderArray;
+    typedef NumericalArray<OfflineAudioHostBase*>   HostArray;
+    typedef typename Base::BusType                  BusType;
+    typedef typename Base::BussesType               BussesType;
+    
+    /** Default constructor. */
+    OfflineAudioHostBase() throw();
+    ~OfflineAudioHostBase();
+    
+    Text getHostName() const throw();
+    Text getNativeHostName() const throw();
+    Text getInputName() const throw();
+    Text getOutputName() const throw();
+    
+    /** Get the time spent rendering as a proportion of the audio rendered. 
+     For example, 0.1 means that the graph renders ten times faster than real time. */
+    double getCpuUsage() const throw();
+    
+    /** Get the duration of audio rendered per second of rendering time. */
+    double getRealTimeFactor() const throw();
+    
+    /** Get the number of frames rendered by the last call to startHost(). */
+    PLONK_INLINE_LOW LongLong getNumFramesRendered() const throw() { return numFramesRendered; }
+    
+    /** Add a file to read inputs from. 
+     Its channels are fed to the host inputs after those of any files already 
+     added and the number of inputs is updated to suit. Once the file ends 
+     its inputs are silent. This must be called before startHost(). */
+    void addInputFile (AudioFileReader const& reader) throw();
+    
+    /** Set the file to write the outputs to. 
+     This must have the same number of channels as there are outputs, the file
+     is closed once rendering is finished. This must be called before startHost(). */
+    void setOutputFile (WriterType const& writer) throw();
+    
+    /** Get the busses carrying the host inputs.
+     These belong to this host and are replaced each time rendering starts so 
+     should be read from within constructGraph(). */
+    PLONK_INLINE_LOW BussesType getInputBusses() const throw() { return this->getBusses(); }
+    
+    /** Set the duration to render in seconds.
+     If this is 0 rendering continues until all the input files have ended. */
+    PLONK_INLINE_LOW void setDuration (const double seconds) throw() { duration = seconds; }
+    
+    /** Get the duration to render in seconds. */
+    PLONK_INLINE_LOW double getDuration() const throw() { return duration; }
+    
+    /** Render the graph, this returns once rendering is finished. */
+    void startHost() throw();
+    
+    /** Stop rendering early.
+     This may be called from another thread (or from the graph). */
+    void stopHost() throw();
+    
+    /** Render several hosts in parallel.
+     The graphs are constructed in turn on the calling thread, then rendered on
+     the pool's threads (and the calling thread). This returns once they are all 
+     finished. */
+    static void renderParallel (HostArray const& hosts, TaskPool& pool = TaskPool::getDefault()) throw();
+    
+private:
+    class RenderBatchInternal : public TaskBatchInternal
+    {
+    public:
+        RenderBatchInternal (HostArray const& hostsToRender) throw()
+        :   hosts (hostsToRender)
+        {
+        }
+        
+        void runItem (const int index) throw()
+        {
+            OfflineAudioHostBase* const host = hosts.atUnchecked (index);
+            
+            while (host->renderBlock())
+                ;
+        }
+        
+    private:
+        HostArray hosts;
+    };
+    
+    BusType createInputBus (const int index) throw();
+    
+    bool prepare() throw();
+    bool renderBlock() throw();
+    void finish() throw();
+    
+    int readInputs (const int blockSize) throw();
+    void writeOutputs (const int numFrames) throw();
+    
+    ReaderArray inputFiles;
+    IntArray inputEnded;
+    WriterType outputFile;
+    
+    Buffer inputFrames;
+    Buffer inputBuffers;
+    Buffer outputFrames;
+    Buffer outputBuffers;
+    
+    double duration;
+    LongLong numFramesToRender;
+    LongLong numFramesRendered;
+    double startTime;
+    double renderTime;
+    AtomicInt stopRequested;
+};
+
+/** An offline host for the default sample type. 
+ @see OfflineAudioHostBase */
+typedef OfflineAudioHostBase<PLONK_TYPE_DEFAULT> OfflineAudioHost;
+
+//------------------------------------------------------------------------------
+
+template<class SampleType>
+OfflineAudioHostBase<SampleType>::OfflineAudioHostBase() throw()
+:   duration (0.0),
+    numFramesToRender (0),
+    numFramesRendered (0),
+    startTime (0.0),
+    renderTime (0.0),
+    stopRequested (false)
+{
+    this->setPreferredHostBlockSize (512);
+    this->setPreferredGraphBlockSize (128);
+    this->setPreferredHostSampleRate (44100.0);
+    this->setNumInputs (0);
+    this->setNumOutputs (2);
+}
+
+template<class SampleType>
+OfflineAudioHostBase<SampleType>::~OfflineAudioHostBase()
+{
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getHostName() const throw()
+{
+    return "Offline (" + TypeUtility<SampleType>::getTypeName() + ")";
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getNativeHostName() const throw()
+{
+    return "None";
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getInputName() const throw()
+{
+    return inputFiles.length() > 0 ? "Files" : "None";
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getOutputName() const throw()
+{
+    return outputFile.isReady() ? "File" : "None";
+}
+
+template<class SampleType>
+double OfflineAudioHostBase<SampleType>::getCpuUsage() const throw()
+{
+    const double rendered = numFramesRendered / this->getPreferredHostSampleRate();
+    return rendered > 0.0 ? renderTime / rendered : 0.0;
+}
+
+template<class SampleType>
+double OfflineAudioHostBase<SampleType>::getRealTimeFactor() const throw()
+{
+    const double rendered = numFramesRendered / this->getPreferredHostSampleRate();
+    return renderTime > 0.0 ? rendered / renderTime : 0.0;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::addInputFile (AudioFileReader const& reader) throw()
+{
+    plonk_assert (! this->getIsRunning());
+    plonk_assert (reader.getNumChannels() > 0);
+    
+    inputFiles.add (reader);
+    this->setNumInputs (this->getNumInputs() + reader.getNumChannels());
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::setOutputFile (WriterType const& writer) throw()
+{
+    plonk_assert (! this->getIsRunning());
+    plonk_assert (writer.isReady());
+    outputFile = writer;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::startHost() throw()
+{
+    if (prepare())
+    {
+        while (renderBlock())
+            ;
+        
+        finish();
+    }
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::stopHost() throw()
+{
+    stopRequested = true;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::renderParallel (HostArray const& hosts, TaskPool& pool) throw()
+{
+    const int numHosts = hosts.length();
+    HostArray prepared;
+    
+    for (int i = 0; i < numHosts; ++i)
+    {
+        OfflineAudioHostBase* const host = hosts.atUnchecked (i);
+        
+        if (host->prepare())
+            prepared.add (host);
+    }
+    
+    if (prepared.length() > 0)
+    {
+        SmartPointerContainer<RenderBatchInternal> batch (new RenderBatchInternal (prepared));
+        batch->run (pool, prepared.length());
+        
+        for (int i = 0; i < prepared.length(); ++i)
+            prepared.atUnchecked (i)->finish();
+    }
+}
+
+template<class SampleType>
+typename OfflineAudioHostBase<SampleType>::BusType OfflineAudioHostBase<SampleType>::createInputBus (const int index) throw()
+{
+    (void)index;
+    
+    // unnamed and with their own sizes so no buffers are shared with other hosts,
+    // the rate is the default as BusRead channels take the default rate
+    const int hostBlockSize = plonk::max (1, this->getPreferredHostBlockSize());
+    const int bufferSize = plonk::max (BusType::getDefaultBufferSize().getValue(), hostBlockSize * 2);
+    
+    return BusType (BlockSize (bufferSize), 
+                    BlockSize (hostBlockSize), 
+                    SampleRate::getDefault());
+}
+
+template<class SampleType>
+bool OfflineAudioHostBase<SampleType>::prepare() throw()
+{
+    const int hostBlockSize = this->getPreferredHostBlockSize();
+    const int numInputs = this->getNumInputs();
+    const int numOutputs = this->getNumOutputs();
+    int maxFileChannels = 0;
+    
+    plonk_assert (! this->getIsRunning());
+    plonk_assert (hostBlockSize > 0);
+    
+    if (outputFile.isReady())
+    {
+        plonk_assert (outputFile.getNumChannels() == numOutputs);
+        
+        if (outputFile.getNumChannels() != numOutputs)
+            return false;
+    }
+    
+    inputEnded.setSize (inputFiles.length(), false);
+    
+    for (int i = 0; i < inputFiles.length(); ++i)
+    {
+        maxFileChannels = plonk::max (maxFileChannels, inputFiles.atUnchecked (i).getNumChannels());
+        inputEnded.atUnchecked (i) = 0;
+    }
+    
+    inputFrames.setSize (hostBlockSize * maxFileChannels, false);
+    inputBuffers = Buffer::newClear (hostBlockSize * numInputs);
+    outputFrames.setSize (hostBlockSize * numOutputs, false);
+    outputBuffers.setSize (hostBlockSize * numOutputs, false);
+    
+    BussesType& busses = this->getBusses();
+    
+    // fresh busses for this render at the rate and block size it will use
+    this->initFormat();
+    
+    for (int i = 0; i < busses.length(); ++i)
+        busses.atUnchecked (i) = createInputBus (i);
+    
+    numFramesToRender = LongLong (duration * this->getPreferredHostSampleRate() + 0.5);
+    numFramesRendered = 0;
+    renderTime = 0.0;
+    stopRequested = false;
+    
+    // the inputs must have something to end if no duration was set
+    plonk_assert ((numFramesToRender > 0) || (inputFiles.length() > 0));
+    
+    this->startHostInternal();
+    startTime = pl_TimeNow();
+    
+    return true;
+}
+
+template<class SampleType>
+bool OfflineAudioHostBase<SampleType>::renderBlock() throw()
+{
+    const int hostBlockSize = this->getPreferredHostBlockSize();
+    int numFrames = hostBlockSize;
+    
+    if (stopRequested.getValueUnchecked())
+        return false;
+    
+    if (numFramesToRender > 0)
+    {
+        const LongLong numFramesRemaining = numFramesToRender - numFramesRendered;
+        
+        if (numFramesRemaining <= 0)
+            return false;
+        
+        numFrames = int (plonk::min (LongLong (hostBlockSize), numFramesRemaining));
+    }
+    
+    const int numInputFrames = readInputs (hostBlockSize);
+    
+    if (numFramesToRender == 0)
+    {
+        // render until the longest input ends
+        if (numInputFrames == 0)
+            return false;
+        
+        numFrames = numInputFrames;
+    }
+    
+    typename Base::ConstBufferArray& inputs = this->getInputs();
+    typename Base::BufferArray& outputs = this->getOutputs();
+    const SampleType* const inputBuffersArray = inputBuffers.getArray();
+    SampleType* const outputBuffersArray = outputBuffers.getArray();
+    int i;
+    
+    for (i = 0; i < inputs.length(); ++i)
+        inputs.atUnchecked (i) = inputBuffersArray + i * hostBlockSize;
+    
+    for (i = 0; i < outputs.length(); ++i)
+        outputs.atUnchecked (i) = outputBuffersArray + i * hostBlockSize;
+    
+    this->process();
+    writeOutputs (numFrames);
+    
+    numFramesRendered += numFrames;
+    return true;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::finish() throw()
+{
+    renderTime = pl_TimeNow() - startTime;
+    
+#ifdef PLONK_DEBUG
+    // process() marked the rendering thread as the audio thread but the
+    // graph may now be freed from any thread
+    Threading::setAudioThreadID (0);
+#endif
+    
+    if (outputFile.isReady())
+    {
+        outputFile.close();
+        outputFile = WriterType();
+    }
+    
+    this->setIsRunning (false);
+    this->hostStopped();
+}
+
+template<class SampleType>
+int OfflineAudioHostBase<SampleType>::readInputs (const int blockSize) throw()
+{
+    const int numFiles = inputFiles.length();
+    SampleType* inputBuffersArray = inputBuffers.getArray();
+    int maxFramesRead = 0;
+    
+    for (int file = 0; file < numFiles; ++file)
+    {
+        AudioFileReader& reader = inputFiles.atUnchecked (file);
+        const int numChannels = reader.getNumChannels();
+        int numFramesRead = 0;
+        
+        if (! inputEnded.atUnchecked (file))
+        {
+            inputFrames.setSize (blockSize * numChannels, false);
+            reader.readFrames (inputFrames);
+            numFramesRead = inputFrames.length() / numChannels;
+            
+            if (reader.didHitEOF() || (numFramesRead < blockSize))
+                inputEnded.atUnchecked (file) = 1;
+            
+            maxFramesRead = plonk::max (maxFramesRead, numFramesRead);
+        }
+        
+        const SampleType* const inputFramesArray = inputFrames.getArray();
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            SampleType* const buffer = inputBuffersArray + channel * blockSize;
+            const SampleType* frame = inputFramesArray + channel;
+            int i;
+            
+            for (i = 0; i < numFramesRead; ++i, frame += numChannels)
+                buffer[i] = *frame;
+            
+            if (numFramesRead < blockSize)
+                Buffer::zeroData (buffer + numFramesRead, blockSize - numFramesRead);
+        }
+        
+        inputBuffersArray += numChannels * blockSize;
+    }
+    
+    return maxFramesRead;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::writeOutputs (const int numFrames) throw()
+{
+    if (outputFile.isReady())
+    {
+        const int hostBlockSize = this->getPreferredHostBlockSize();
+        const int numOutputs = this->getNumOutputs();
+        const SampleType* const outputBuffersArray = outputBuffers.getArray();
+        SampleType* const outputFramesArray = outputFrames.getArray();
+        
+        for (int channel = 0; channel < numOutputs; ++channel)
+        {
+            const SampleType* const buffer = outputBuffersArray + channel * hostBlockSize;
+            SampleType* frame = outputFramesArray + channel;
+            
+            for (int i = 0; i < numFrames; ++i, frame += numOutputs)
+                *frame = buffer[i];
+        }
+        
+        outputFile.writeFrames (numFrames, outputFramesArray);
+    }
+}
+
+#endif // PLONK_OFFLINEAUDIOHOST_H
@@ -44,7 +44,7 @@ template<class SampleType>
 class AudioHostBase;
 
 /** An abstract class to interface with audio devices.
- @see PortAudioAudioHost, IOSAudioHost, JuceAudioHost */
+ @see PortAudioAudioHost, IOSAudioHost, JuceAudioHost, OfflineAudioHost */
 template<class SampleType>
 class AudioHostBase : public PlonkBase
 {
@@ -138,6 +138,16 @@ protected:
     /** Get the output buffers. @internal */
     PLONK_INLINE_LOW BufferArray& getOutputs() throw()                    { return this->outputs; }
 
+    /** Get the input busses. @internal */
+    PLONK_INLINE_LOW const BussesType& getBusses() const throw()          { return this->busses; }
+    
+    /** Get the input busses. @internal */
+    PLONK_INLINE_LOW BussesType& getBusses() throw()                      { return this->busses; }
+    
+    /** Create the bus that carries an input to the graph.
+     By default this is the global bus named by the index of the input. */
+    virtual BusType createInputBus (const int index) throw()              { return BusType (index); }
+
     /** Get the name of the audio host. */
     virtual Text getHostName() const = 0;
     
@@ -242,6 +252,24 @@ protected:
     }
     
 protected:
+    /** Set the default sample rate and block size from the preferred settings. 
+     This is called by startHostInternal() before constructing the graph. */
+    PLONK_INLINE_LOW void initFormat() throw()
+    {
+        SampleRate::getDefault().setValue (preferredHostSampleRate);
+        
+        // preferredGraphBlockSize must be less that the hardware size 
+        // and divide into the hardware size without a remainder.
+        if ((preferredGraphBlockSize == 0) ||
+            (preferredHostBlockSize <= preferredGraphBlockSize) ||
+            ((preferredHostBlockSize % preferredGraphBlockSize) != 0))
+        {
+            preferredGraphBlockSize = preferredHostBlockSize;
+        }
+        
+        BlockSize::getDefault().setValue (preferredGraphBlockSize); 
+    }
+    
     /** Set a flag to indicate the audio host is running.
      NB This does not start or stop the host use startHost() and stopHost() 
      respectively. */
@@ -262,23 +290,6 @@ private:
     BussesType busses;
     ConstBufferArray inputs;
     BufferArray outputs;    
-    
-    PLONK_INLINE_LOW void initFormat() throw()
-    {
-        SampleRate::getDefault().setValue (preferredHostSampleRate);
-        
-        // preferredGraphBlockSize must be less that the hardware size 
-        // and divide into the hardware size without a remainder.
-        if ((preferredGraphBlockSize == 0) ||
-            (preferredHostBlockSize <= preferredGraphBlockSize) ||
-            ((preferredHostBlockSize % preferredGraphBlockSize) != 0))
-        {
-            preferredGraphBlockSize = preferredHostBlockSize;
-        }
-        
-        BlockSize::getDefault().setValue (preferredGraphBlockSize); 
-    }
-
 };
 
 //------------------------------------------------------------------------------
@@ -299,7 +310,7 @@ void AudioHostBase<SampleType>::setNumInputs (const int numInputs) throw()
             for (int i = 0; i < numInputs; ++i)
             {
                 this->inputs.atUnchecked (i) = 0;
-                this->busses.add (BusType (i));
+                this->busses.add (this->createInputBus (i));
             }
         }
         else this->inputs.clear();
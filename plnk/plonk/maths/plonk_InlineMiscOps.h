@@ -224,6 +224,7 @@ template<class ValueType, class IndexType, signed Extension, signed Offset> clas
 template<class ValueType, class IndexType> class InterpNone;
 template<class ValueType, class IndexType> class InterpLinear;
 template<class ValueType, class IndexType> class InterpLagrange3;
+template<class ValueType, class IndexType, int HalfWidth> class InterpSinc;
 
 class Interp
 {
@@ -233,6 +234,9 @@ public:
         None,
         Linear,
         Lagrange3,
+        SincFast,
+        Sinc,
+        SincBest,
         NumTypes
     };
 };
@@ -263,6 +267,27 @@ public:
     typedef InterpLagrange3<ValueType,IndexType> InterpType;
 };
 
+template<class ValueType, class IndexType>
+class InterpSelect<ValueType, IndexType, Interp::SincFast>
+{
+public:
+    typedef InterpSinc<ValueType,IndexType,8> InterpType;
+};
+
+template<class ValueType, class IndexType>
+class InterpSelect<ValueType, IndexType, Interp::Sinc>
+{
+public:
+    typedef InterpSinc<ValueType,IndexType,16> InterpType;
+};
+
+template<class ValueType, class IndexType>
+class InterpSelect<ValueType, IndexType, Interp::SincBest>
+{
+public:
+    typedef InterpSinc<ValueType,IndexType,32> InterpType;
+};
+
 
 template<class ValueType, class IndexType, signed Extension, signed Offset>
 class InterpBase : public Interp
@@ -0,0 +1,479 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_INTERPSINC_H
+#define PLONK_INTERPSINC_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "../containers/plonk_ContainerForwardDeclarations.h"
+#include "../core/plonk_SmartPointer.h"
+#include "../core/plonk_SmartPointerContainer.h"
+#include "plonk_InlineMiscOps.h"
+
+template<class SampleType> class SincFilterBankBase;
+
+/** The dot product at the heart of the sinc filters.
+ The float and double versions use the Plank vector functions so these are
+ vectorised when a vector library (e.g., PLANK_VEC_SIMD) is enabled. */
+template<class SampleType>
+class SincFilterDot
+{
+public:
+    static PLONK_INLINE_HIGH SampleType dot (const SampleType* a, const SampleType* b, const int n) throw()
+    {
+        SampleType sum (0);
+        
+        for (int i = 0; i < n; ++i)
+            sum += a[i] * b[i];
+        
+        return sum;
+    }
+};
+
+template<>
+class SincFilterDot<float>
+{
+public:
+    static PLONK_INLINE_HIGH float dot (const float* a, const float* b, const int n) throw()
+    {
+        float sum;
+        pl_VectorAddMulF_1NN (&sum, a, b, n);
+        return sum;
+    }
+};
+
+template<>
+class SincFilterDot<double>
+{
+public:
+    static PLONK_INLINE_HIGH double dot (const double* a, const double* b, const int n) throw()
+    {
+        double sum;
+        pl_VectorAddMulD_1NN (&sum, a, b, n);
+        return sum;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class SampleType>
+class SincFilterBankInternal : public SmartPointer
+{
+public:
+    typedef NumericalArray<SampleType>  Buffer;
+    typedef SincFilterDot<SampleType>   Dot;
+    
+    enum Constants
+    {
+        NumPhases = 256,
+        DesignMargin = 2    // dB the Kaiser estimates can fall short by
+    };
+    
+    SincFilterBankInternal (const int halfWidthToUse, const double scaleToUse) throw()
+    :   halfWidth (plonk::max (1, halfWidthToUse)),
+        numTaps (halfWidth * 2),
+        scale (plonk::clip (scaleToUse, 0.0, 1.0)),
+        coeffs (Buffer::newClear ((NumPhases + 1) * numTaps))
+    {
+        design();
+    }
+    
+    PLONK_INLINE_LOW int getHalfWidth() const throw()   { return halfWidth; }
+    PLONK_INLINE_LOW double getScale() const throw()    { return scale; }
+    
+    /** Filter the samples around a position between two of them.
+     @param samples The halfWidth * 2 samples around the position, the position
+                    lies between samples[halfWidth - 1] and samples[halfWidth].
+     @param frac    The fractional position from samples[halfWidth - 1]. */
+    PLONK_INLINE_HIGH SampleType interpolate (const SampleType* samples, const double frac) const throw()
+    {
+        const double phasePosition = frac * double (NumPhases);
+        const int phase = int (phasePosition);
+        const SampleType phaseFrac = SampleType (phasePosition - double (phase));
+        const SampleType* const row = coeffs.getArray() + phase * numTaps;
+        const SampleType value0 = Dot::dot (samples, row, numTaps);
+        
+        if (phaseFrac == SampleType (0))
+            return value0;
+        
+        // the extra row at the end means phase + 1 is always valid
+        const SampleType value1 = Dot::dot (samples, row + numTaps, numTaps);
+        return value0 + (value1 - value0) * phaseFrac;
+    }
+    
+    /** The stopband attenuation in dB with this many taps. 
+     This is the filters' own, a test signal needs a lower noise floor to 
+     show it (e.g., a float table lookup is only good to about 63dB). */
+    static double getAttenuation (const int halfWidth) throw()
+    {
+        return 20.0 * std::log ((double) halfWidth) / std::log (2.0) - 10.0; // 50dB for 8, 70dB for 16, 90dB for 32
+    }
+    
+private:
+    static double besselI0 (const double x) throw()
+    {
+        const double halfX = x * 0.5;
+        double sum = 1.0;
+        double term = 1.0;
+        
+        for (int k = 1; k < 64; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+            
+            if (term < (sum * 1.0e-16))
+                break;
+        }
+        
+        return sum;
+    }
+    
+    /** Make a Kaiser windowed sinc for each phase.
+     The window is sized for the attenuation plus a margin as the Kaiser 
+     formulae are estimates, the transition band is placed below the scaled 
+     Nyquist frequency and each phase is normalised for unity gain at DC. */
+    void design() throw()
+    {
+        const double pi = Math<double>::getPi();
+        const double attenuation = getAttenuation (halfWidth) + DesignMargin;
+        const double beta = 0.1102 * (attenuation - 8.7);
+        const double transition = (attenuation - 8.0) / (2.285 * (numTaps - 1) * pi);
+        const double cutoff = scale * (1.0 - transition * 0.5);
+        const double i0Beta = besselI0 (beta);
+        
+        DoubleArray row (DoubleArray::newClear (numTaps));
+        double* const rowValues = row.getArray();
+        SampleType* phaseCoeffs = coeffs.getArray();
+        
+        for (int phase = 0; phase <= NumPhases; ++phase, phaseCoeffs += numTaps)
+        {
+            const double frac = double (phase) / double (NumPhases);
+            double sum = 0.0;
+            
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                const double x = double (tap - (halfWidth - 1)) - frac;
+                const double r = x / double (halfWidth);
+                const double window = (r * r) < 1.0 ? besselI0 (beta * std::sqrt (1.0 - r * r)) / i0Beta : 0.0;
+                const double sinc = x == 0.0 ? cutoff : std::sin (pi * cutoff * x) / (pi * x);
+                
+                rowValues[tap] = sinc * window;
+                sum += rowValues[tap];
+            }
+            
+            for (int tap = 0; tap < numTaps; ++tap)
+                phaseCoeffs[tap] = SampleType (rowValues[tap] / sum);
+        }
+    }
+    
+    const int halfWidth;
+    const int numTaps;
+    const double scale;
+    Buffer coeffs;
+};
+
+//------------------------------------------------------------------------------
+
+/** A polyphase bank of windowed-sinc interpolation filters.
+ The bank holds the filter for 256 fractional positions, positions between 
+ these interpolate between the two nearest filters. The scale sets the 
+ cutoff relative to the Nyquist frequency of the input: 1 for playing back
+ at the same or a lower rate, 1/ratio to anti-alias when the increment 
+ through the input is greater than 1. 
+ 
+ Designing a bank is expensive so banks are cached and shared, use get() 
+ rather than creating them directly, and not on the audio thread.
+ @see InterpSinc, InterpKernel */
+template<class SampleType>
+class SincFilterBankBase : public SmartPointerContainer< SincFilterBankInternal<SampleType> >
+{
+public:
+    typedef SincFilterBankInternal<SampleType>      Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    typedef ObjectArray<SincFilterBankBase>         Banks;
+    
+    SincFilterBankBase() throw()
+    :   Base (static_cast<Internal*> (0))
+    {
+    }
+    
+    SincFilterBankBase (const int halfWidth, const double scale) throw()
+    :   Base (new Internal (halfWidth, scale))
+    {
+    }
+    
+    explicit SincFilterBankBase (Internal* internalToUse) throw()
+	:	Base (internalToUse)
+	{
+	}
+    
+    SincFilterBankBase (SincFilterBankBase const& copy) throw()
+	:	Base (static_cast<Base const&> (copy))
+	{
+	}
+    
+    /** Assignment operator. */
+    SincFilterBankBase& operator= (SincFilterBankBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    static const SincFilterBankBase& getNull() throw()
+	{
+		static SincFilterBankBase null;
+		return null;
+	}
+    
+    /** Get a bank from the cache, designing it if this is the first request. 
+     The scale is rounded to the nearest 1/4096 for the cache key. */
+    static SincFilterBankBase get (const int halfWidth, const double scale) throw()
+    {
+        static Lock lock;
+        static Banks banks;
+        
+        const double key = std::floor (plonk::clip (scale, 0.0, 1.0) * 4096.0 + 0.5) / 4096.0;
+        const AutoLock l (lock);
+        
+        for (int i = 0; i < banks.length(); ++i)
+        {
+            const SincFilterBankBase& bank = banks.atUnchecked (i);
+            
+            if ((bank.getHalfWidth() == halfWidth) && (bank.getScale() == key))
+                return bank;
+        }
+        
+        SincFilterBankBase bank (halfWidth, key);
+        banks.add (bank);
+        return bank;
+    }
+    
+    PLONK_INLINE_LOW int getHalfWidth() const throw()
+    {
+        return this->getInternal()->getHalfWidth();
+    }
+    
+    PLONK_INLINE_LOW double getScale() const throw()
+    {
+        return this->getInternal()->getScale();
+    }
+    
+    PLONK_INLINE_HIGH SampleType interpolate (const SampleType* samples, const double frac) const throw()
+    {
+        return this->getInternal()->interpolate (samples, frac);
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(SincFilterBankBase);
+};
+
+//------------------------------------------------------------------------------
+
+/** Windowed-sinc interpolation.
+ This uses HalfWidth samples either side of the position. The static lookup() 
+ uses the full band filter so it doesn't anti-alias if the table is read 
+ faster than 1 sample per sample, use InterpKernel (e.g., via ResampleUnit) 
+ for that. Only float and double values are supported. 
+ @see SincFilterBankBase */
+template<class ValueType, class IndexType, int HalfWidth>
+class InterpSinc : public InterpBase<ValueType,IndexType,HalfWidth * 2 - 1,HalfWidth - 1>
+{
+public:
+    typedef SincFilterBankBase<ValueType> Bank;
+    
+    static PLONK_INLINE_LOW const Bank& getBank() throw()
+    {
+        static const Bank bank (Bank::get (HalfWidth, 1.0));
+        return bank;
+    }
+    
+    static PLONK_INLINE_HIGH ValueType lookup (const ValueType* table, IndexType const& index) throw()
+    {
+        return lookup (getBank(), table, index);
+    }
+    
+    static PLONK_INLINE_HIGH ValueType lookup (Bank const& bank, const ValueType* table, IndexType const& index) throw()
+    {
+        const int index0 = int (index);
+        return bank.interpolate (table + index0 - (HalfWidth - 1), double (index - IndexType (index0)));
+    }
+};
+
+template<class ValueType, int HalfWidth>
+class InterpSinc<ValueType,int,HalfWidth> : public InterpBase<ValueType,int,HalfWidth * 2 - 1,HalfWidth - 1>
+{
+public:
+    typedef int IndexType;
+    
+    static PLONK_INLINE_HIGH ValueType lookup (const ValueType* table, IndexType const& index) throw()
+    {
+        return table[index];
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Interpolates a table at positions moving by an increment. 
+ This is for units like ResampleChannelInternal that read through their input
+ at a known rate. This general version simply calls the interpolator's lookup()
+ for each sample. */
+template<class SampleType, class IndexType, Interp::TypeCode InterpTypeCode>
+class InterpKernel
+{
+public:
+    typedef typename InterpSelect<SampleType,IndexType,InterpTypeCode>::InterpType InterpType;
+    
+    /** Set the increment the following lookups will be made with. */
+    PLONK_INLINE_LOW void setIncrement (IndexType const& increment) throw()
+    {
+        (void)increment;
+    }
+    
+    PLONK_INLINE_HIGH SampleType lookup (const SampleType* table, IndexType const& index) const throw()
+    {
+        return InterpType::lookup (table, index);
+    }
+    
+    /** Fill an output buffer from position onwards until either numSamples 
+     are done or the position reaches positionMax. 
+     @return The number of samples written. */
+    PLONK_INLINE_HIGH int render (SampleType* output, const int numSamples,
+                                  const SampleType* table, IndexType& position, 
+                                  IndexType const& increment, IndexType const& positionMax) const throw()
+    {
+        int i;
+        
+        for (i = 0; (i < numSamples) && (position < positionMax); ++i)
+        {
+            output[i] = InterpType::lookup (table, position);
+            position += increment;
+        }
+        
+        return i;
+    }
+};
+
+/** The sinc interpolating kernel.
+ This holds banks for increments up to 8 in half octave steps. 
+ setIncrement() picks the first bank whose cutoff is at or below the Nyquist
+ frequency of the output, so reading faster than 1 sample per sample is 
+ anti-aliased. The tap count stays the same so the transition band gets 
+ wider as the increment rises. */
+template<class SampleType, class IndexType, int HalfWidth>
+class InterpSincKernel
+{
+public:
+    typedef InterpSinc<SampleType,IndexType,HalfWidth>  InterpType;
+    typedef SincFilterBankBase<SampleType>              Bank;
+    typedef ObjectArray<Bank>                           Banks;
+    
+    enum Constants
+    {
+        NumBanks = 7
+    };
+    
+    InterpSincKernel() throw()
+    :   banks (Banks::withSize (NumBanks)),
+        current (0)
+    {
+        for (int i = 0; i < NumBanks; ++i)
+            banks.atUnchecked (i) = Bank::get (HalfWidth, 1.0 / getIncrementLimit (i));
+    }
+    
+    PLONK_INLINE_LOW void setIncrement (IndexType const& increment) throw()
+    {
+        const double absIncrement = plonk::abs (double (increment));
+        int i = 0;
+        
+        while ((i < (NumBanks - 1)) && (absIncrement > getIncrementLimit (i)))
+            ++i;
+        
+        current = i;
+    }
+    
+    PLONK_INLINE_HIGH SampleType lookup (const SampleType* table, IndexType const& index) const throw()
+    {
+        return InterpType::lookup (banks.atUnchecked (current), table, index);
+    }
+    
+    PLONK_INLINE_HIGH int render (SampleType* output, const int numSamples,
+                                  const SampleType* table, IndexType& position,
+                                  IndexType const& increment, IndexType const& positionMax) const throw()
+    {
+        const Bank& bank = banks.atUnchecked (current);
+        const SampleType* const start = table - (HalfWidth - 1);
+        int i;
+        
+        for (i = 0; (i < numSamples) && (position < positionMax); ++i)
+        {
+            const int index0 = int (position);
+            output[i] = bank.interpolate (start + index0, double (position - IndexType (index0)));
+            position += increment;
+        }
+        
+        return i;
+    }
+    
+private:
+    static PLONK_INLINE_LOW double getIncrementLimit (const int index) throw()
+    {
+        static const double limits[NumBanks] = { 1.0, 1.4142135623730951, 2.0, 2.8284271247461903, 4.0, 5.6568542494923806, 8.0 };
+        return limits[index];
+    }
+    
+    Banks banks;
+    int current;
+};
+
+template<class SampleType, class IndexType>
+class InterpKernel<SampleType,IndexType,Interp::SincFast> : public InterpSincKernel<SampleType,IndexType,8>
+{
+};
+
+template<class SampleType, class IndexType>
+class InterpKernel<SampleType,IndexType,Interp::Sinc> : public InterpSincKernel<SampleType,IndexType,16>
+{
+};
+
+template<class SampleType, class IndexType>
+class InterpKernel<SampleType,IndexType,Interp::SincBest> : public InterpSincKernel<SampleType,IndexType,32>
+{
+};
+
+#endif // PLONK_INTERPSINC_H
@@ -173,6 +173,39 @@ private:
         ResultCode result = pl_NeuralNetworkF_BackProp (&network, inputs.getArray(), targets.getArray());
         plonk_assert (result == PlankResult_OK);
         
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    PLONK_INLINE_LOW void propogateBatch (VectorType& outputs, VectorType const& inputs) throw()
+    {
+        const int numVectors = inputs.length() / this->getNumInputs();
+        
+        plonk_assert ((inputs.length() % this->getNumInputs()) == 0);
+        ResultCode result = pl_NeuralNetworkF_PropogateBatch (&network, inputs.getArray(), numVectors);
+        plonk_assert (result == PlankResult_OK);
+        
+        outputs.setSize (numVectors * this->getNumOutputs(), false);
+        VectorType::copyData (outputs.getArray(),
+                              pl_NeuralNetworkF_GetBatchOutputsPtr (&network),
+                              outputs.length());
+        
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    PLONK_INLINE_LOW void backPropBatch (VectorType const& inputs, VectorType const& targets) throw()
+    {
+        const int numVectors = inputs.length() / this->getNumInputs();
+
+        plonk_assert ((inputs.length() % this->getNumInputs()) == 0);
+        plonk_assert (targets.length() == (numVectors * this->getNumOutputs()));
+        
+        ResultCode result = pl_NeuralNetworkF_BackPropBatch (&network, inputs.getArray(), targets.getArray(), numVectors);
+        plonk_assert (result == PlankResult_OK);
+        
 #ifndef PLONK_DEBUG
         (void)result;
 #endif
@@ -347,6 +380,20 @@ public:
         return this->getInternal()->backProp (inputs, targets);
     }
     
+    /** Propogate a batch of input vectors stored one after another in @c inputs.
+     The output vectors are stored one after another in @c outputs. */
+    PLONK_INLINE_LOW void propogateBatch (VectorType& outputs, VectorType const& inputs) throw()
+    {
+        return this->getInternal()->propogateBatch (outputs, inputs);
+    }
+    
+    /** Train on a batch of input and target vectors each stored one after another.
+     The average of the weight changes for the whole batch is applied. */
+    PLONK_INLINE_LOW void backPropBatch (VectorType const& inputs, VectorType const& targets) throw()
+    {
+        return this->getInternal()->backPropBatch (inputs, targets);
+    }
+    
     PLONK_INLINE_LOW void train (Patterns const& patterns, const int numEpochs) throw()
     {
         const int numPatterns = patterns.length();
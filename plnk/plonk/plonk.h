@@ -53,6 +53,7 @@
 
 /* config macors
  PLONK_USEPLINK=1   -   Use Plink for float processes where implemented (also uses optimisations if enabled in Plank)
+ PLONK_PROFILE=1    -   Time each channel's process function, see Profiler (must be the same for the whole build)
  */
 
 // this must be before the standard header incase we want it different in user code?
@@ -67,6 +68,7 @@ BEGIN_PLONK_NAMESPACE
 #if PLONK_USEPLINK
     #include "graph/simple/plonk_BinaryOpPlink.h"
     #include "graph/simple/plonk_UnaryOpPlink.h"
+    #include "graph/converters/plonk_FreezeChannel.h"
 #endif
 
 END_PLONK_NAMESPACE
@@ -48,6 +48,11 @@ RNGInternal::RNGInternal() throw()
     pl_RNG_Init (&rng);
 }
 
+RNGInternal::RNGInternal (PlankRNG const& state) throw()
+:   rng (state)
+{
+}
+
 RNGInternal::~RNGInternal()
 {
     pl_RNG_DeInit (&rng);
@@ -73,6 +78,11 @@ RNG& RNG::operator= (RNG const& other) throw()
     return *this;
 }
 
+RNG::RNG (PlankRNG const& state) throw()
+:   Base (new Internal (state))
+{
+}
+
 RNG& RNG::global() throw()
 {
     static RNG random;
@@ -90,6 +100,26 @@ void RNG::seed (const unsigned int value) throw()
     pl_RNG_Seed (this->getInternal()->getRNGRef(), value);
 }
 
+void RNG::setStream (const UnsignedLongLong stream) throw()
+{
+    pl_RNG_SetStream (this->getInternal()->getRNGRef(), stream);
+}
+
+UnsignedLongLong RNG::getStream() throw()
+{
+    return pl_RNG_GetStream (this->getInternal()->getRNGRef());
+}
+
+void RNG::setPosition (const UnsignedLongLong position) throw()
+{
+    pl_RNG_SetPosition (this->getInternal()->getRNGRef(), position);
+}
+
+UnsignedLongLong RNG::getPosition() throw()
+{
+    return pl_RNG_GetPosition (this->getInternal()->getRNGRef());
+}
+
 unsigned int RNG::uniformInt() throw()
 {
     return pl_RNG_Next (this->getInternal()->getRNGRef());
@@ -169,6 +199,34 @@ double RNG::exponential (const double min, const double max) throw()
                           min, max);
 }
 
+void RNG::uniform (float* const dst, const int numValues, const float min, const float max) throw()
+{
+    pl_RNG_FillF (this->getInternal()->getRNGRef(), dst, numValues);
+    pl_VectorMulAddF_NN11 (dst, dst, max - min, min, numValues);
+}
+
+void RNG::uniform (double* const dst, const int numValues, const double min, const double max) throw()
+{
+    pl_RNG_FillD (this->getInternal()->getRNGRef(), dst, numValues);
+    pl_VectorMulAddD_NN11 (dst, dst, max - min, min, numValues);
+}
+
+void RNG::exponential (float* const dst, const int numValues, const float min, const float max) throw()
+{
+    pl_RNG_FillF (this->getInternal()->getRNGRef(), dst, numValues);
+    
+    for (int i = 0; i < numValues; ++i)
+        dst[i] = plonk::linexp (dst[i], 0.0f, 1.0f, min, max);
+}
+
+void RNG::exponential (double* const dst, const int numValues, const double min, const double max) throw()
+{
+    pl_RNG_FillD (this->getInternal()->getRNGRef(), dst, numValues);
+    
+    for (int i = 0; i < numValues; ++i)
+        dst[i] = plonk::linexp (dst[i], 0.0, 1.0, min, max);
+}
+
 
 
 END_PLONK_NAMESPACE
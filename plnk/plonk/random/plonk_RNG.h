@@ -50,6 +50,7 @@ class RNGInternal : public SmartPointer
 {
 public:
     RNGInternal() throw();
+    RNGInternal (PlankRNG const& state) throw();
     ~RNGInternal();
     
     friend class RNG;
@@ -71,6 +72,9 @@ public:
     RNG() throw();
     RNG (RNG const& copy) throw();
     RNG& operator= (RNG const& other) throw();
+    
+    /** Create a random number generator that continues from the state of a Plank RNG. */
+    explicit RNG (PlankRNG const& state) throw();
 
     /** Get the global random number generator. */
     static RNG& global() throw();
@@ -82,6 +86,21 @@ public:
     /** Seed this random number generator. */
     void seed (const unsigned int value) throw();
     
+    /** Select an independent stream of values for this seed, e.g., one per voice or thread. 
+     This also resets the position to the start of the stream. */
+    void setStream (const UnsignedLongLong stream) throw();
+    
+    /** Get the current stream. */
+    UnsignedLongLong getStream() throw();
+    
+    /** Jump to a position in the current stream.
+     The position is the number of integers generated since the start of the stream 
+     (floats and doubles each use one). */
+    void setPosition (const UnsignedLongLong position) throw();
+    
+    /** Get the position in the current stream. */
+    UnsignedLongLong getPosition() throw();
+    
     /** Generate a random integer. */
     unsigned int uniformInt() throw();
     
@@ -121,6 +140,28 @@ public:
     /** Generate a exponentially distributed random double between min and max. */
     double exponential (const double min, const double max) throw();     
     
+    /** Fill an array with uniformly distributed random floats between min and max. 
+     This gives the same values as calling uniform() for each item but is much faster. */
+    void uniform (float* const dst, const int numValues, const float min, const float max) throw();
+    
+    /** Fill an array with uniformly distributed random doubles between min and max. 
+     This gives the same values as calling uniform() for each item but is much faster. */
+    void uniform (double* const dst, const int numValues, const double min, const double max) throw();
+    
+    /** Fill an array with uniformly distributed random values between min and max. */
+    template<class ValueType, class LimitType>
+    void uniform (ValueType* const dst, const int numValues, const LimitType min, const LimitType max) throw()
+    {
+        for (int i = 0; i < numValues; ++i)
+            dst[i] = ValueType (uniform (min, max));
+    }
+    
+    /** Fill an array with exponentially distributed random floats between min and max. */
+    void exponential (float* const dst, const int numValues, const float min, const float max) throw();
+    
+    /** Fill an array with exponentially distributed random doubles between min and max. */
+    void exponential (double* const dst, const int numValues, const double min, const double max) throw();
+    
     PLONK_OBJECTARROWOPERATOR(RNG);
 };
 
@@ -202,5 +243,41 @@ PLONK_INLINE_HIGH double exprand (const int min, const int max) throw()
 	return RNG::global().exponential (double (min), double (max));
 }
 
+//------------------------------------------------------------------------------
+
+template<class ValueType>
+PLONK_INLINE_LOW void rand (ValueType* const dst, const int numValues, const ValueType min, const ValueType max) throw()
+{
+    for (int i = 0; i < numValues; ++i)
+        dst[i] = plonk::rand (min, max);
+}
+
+PLONK_INLINE_LOW void rand (float* const dst, const int numValues, const float min, const float max) throw()
+{
+	RNG::global().uniform (dst, numValues, min, max);
+}
+
+PLONK_INLINE_LOW void rand (double* const dst, const int numValues, const double min, const double max) throw()
+{
+	RNG::global().uniform (dst, numValues, min, max);
+}
+
+template<class ValueType>
+PLONK_INLINE_LOW void exprand (ValueType* const dst, const int numValues, const ValueType min, const ValueType max) throw()
+{
+    for (int i = 0; i < numValues; ++i)
+        dst[i] = plonk::exprand (min, max);
+}
+
+PLONK_INLINE_LOW void exprand (float* const dst, const int numValues, const float min, const float max) throw()
+{
+	RNG::global().exponential (dst, numValues, min, max);
+}
+
+PLONK_INLINE_LOW void exprand (double* const dst, const int numValues, const double min, const double max) throw()
+{
+	RNG::global().exponential (dst, numValues, min, max);
+}
+
 
 #endif // PLONK_RNG_H